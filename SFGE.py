@@ -40,6 +40,10 @@ class Sprite:
     def load_texture(self, texture_name: str):
         pass
 
+class Prefab:
+    name: str
+
+
 class Timer:
     """Timer used for update loop and """
     def __init__(self, time, period):
@@ -106,9 +110,31 @@ class SceneManager(System):
     def load_scene(self, scene_name):
         pass
 
+    def load_scene_async(self, scene_name):
+        pass
+
+    def is_loading_scene(self):
+        pass
+
+    def get_loading_progress(self):
+        pass
+
+    def load_prefab(self, prefab_path):
+        pass
+
+    def instantiate_prefab(self, prefab, positions):
+        pass
+
 
 class Transform2dManager(System, ComponentManager):
-    pass
+    def set_parent(self, child, parent):
+        pass
+
+    def get_parent(self, entity):
+        pass
+
+    def get_world_transform(self, entity):
+        pass
 
 
 class PythonEngine(System):
@@ -124,6 +150,15 @@ class EntityManager(System):
     def destroy_entity(self, entity):
         pass
 
+    def is_alive(self, entity):
+        pass
+
+    def get_entity_handle(self, entity):
+        pass
+
+    def get_entity_from_handle(self, handle):
+        pass
+
     def has_components(self, entity, component):
         pass
 
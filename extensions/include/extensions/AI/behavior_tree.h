@@ -25,18 +25,33 @@ SOFTWARE.
 #define SFGE_EXT_BEHAVIOR_TREE_H
 
 //#define AI_DEBUG_COUNT_TIME
+//Leaves call the DwarfManager and write the per entity flags, only enable with thread-safe leaves
+//#define AI_MULTI_THREAD
 
 #include <vector>
 #include <memory>
 
 #include <engine/system.h>
+#include <engine/job_system.h>
 #include <engine/globals.h>
+#include <engine/frame_budget.h>
 
 #include <extensions/dwarf_manager.h>
 #include <extensions/AI/behavior_tree_nodes_core.h>
 
 namespace sfge::ext::behavior_tree
 {
+/**
+ * \brief Each frame the behavior tree ticks 1/BEHAVIOR_TREE_STAGGER_FRAME_NMB of the dwarfs
+ */
+const size_t BEHAVIOR_TREE_STAGGER_FRAME_NMB = 4;
+/**
+ * \brief Entities ticked between two checks of the frame budget
+ */
+const int BEHAVIOR_TREE_BUDGET_CHUNK = 64;
+//Microseconds of ticks per frame, the FrameBudget keeps it between these when the frames are late
+const std::int64_t BEHAVIOR_TREE_MIN_BUDGET = 500;
+const std::int64_t BEHAVIOR_TREE_MAX_BUDGET = 4'000;
 
 /**
 * author Nicolas Schneider
@@ -101,6 +116,11 @@ private:
 
 	std::vector<dwarfIndex> m_ActiveEntity;
 	int m_IndexActiveEntity = 0;
+	/**
+	 * \brief Where each stagger slice starts in its active entities, so the ones cut by the budget go first
+	 */
+	BudgetCursor m_ActiveCursor{ BEHAVIOR_TREE_STAGGER_FRAME_NMB };
+	BudgetId m_Budget = 0;
 
 #ifdef AI_DEBUG_COUNT_TIME
 	unsigned __int64 m_TimerMilli = 0u;
@@ -108,7 +128,7 @@ private:
 	int m_TimerCounter = 0;
 #endif
 
-	ctpl::thread_pool* m_ThreadPool;
+	JobSystem* m_JobSystem = nullptr;
 };
 }
 
@@ -29,6 +29,8 @@ SOFTWARE.
 #include <graphics/graphics2d.h>
 
 #include <engine/system.h>
+#include <engine/frame_allocator.h>
+#include <engine/frame_budget.h>
 #include <engine/vector.h>
 
 
@@ -83,8 +85,11 @@ public:
 	void AskForPath(unsigned int index, Vec2f origin, Vec2f destination);
 
 private:
-	std::vector<Vec2f> GetPathFromTo(Vec2f& origin, Vec2f& destination);
-	std::vector<Vec2f> GetPathFromTo(unsigned int originIndex, unsigned int destinationIndex);
+	/**
+	 * \brief The path is in the frame arena of the thread, it must be copied to be kept after the frame
+	 */
+	FrameVector<Vec2f> GetPathFromTo(Vec2f& origin, Vec2f& destination);
+	FrameVector<Vec2f> GetPathFromTo(unsigned int originIndex, unsigned int destinationIndex);
 
 	void BuildGraphFromArray(Tilemap* tilemap, std::vector<std::vector<int>>& map);
 
@@ -116,6 +121,10 @@ private:
 	const static short NORMAL_COST = 2;
 
 	const int m_MaxPathForOneUpdate = 100'000;
+	//Microseconds of path finding per frame, the FrameBudget keeps it between these when the frames are late
+	const std::int64_t m_MinPathFindingBudget = 500;
+	const std::int64_t m_MaxPathFindingBudget = 8'000;
+	BudgetId m_PathFindingBudget = 0;
 
 	std::vector<GraphNode> m_Graph;
 
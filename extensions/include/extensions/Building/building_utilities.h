@@ -82,6 +82,11 @@ namespace sfge::ext
 		CROSS = 31
 	};
 
+	/**
+	 * \brief A RoadCase is the road bit and the bits of its 4 neighbours
+	 */
+	const int ROAD_CASE_NMB = 32;
+
 	enum BuildingType : unsigned char
 	{
 		NO_BUILDING_TYPE,
@@ -117,6 +122,10 @@ namespace sfge::ext
 
 	const unsigned int EMPTY_INVENTORY = 0U;
 	const unsigned short CONTAINER_RESERVATION = 2000;
+	/**
+	 * \brief Runs per second of the economy systems, their cooldowns advance of the fixed steps skipped
+	 */
+	const float ECONOMY_TICK_RATE = 2.0f;
 	
 }
 #endif
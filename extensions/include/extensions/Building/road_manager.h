@@ -25,6 +25,8 @@ SOFTWARE.
 #ifndef ROAD_MANAGER_H
 #define ROAD_MANAGER_H
 
+#include <array>
+
 #include <engine/system.h>
 #include <graphics/graphics2d.h>
 
@@ -51,6 +53,11 @@ namespace sfge::ext
 		
 		void SpawnRoad(Vec2f position, int roadBitMask);
 
+		/**
+		 * \brief Spawn the roads of the same case with one prefab instantiation
+		 */
+		void SpawnRoads(const std::vector<Vec2f>& positions, int roadBitMask);
+
 		void SpawnRoad(std::vector<TileTypeId> tilesTypeVector, const int LengthX, const int LengthY, Vec2f positionFirstTile, Vec2f size, const unsigned int roadType);
 
 		void DestroyRoad(const Entity entity);
@@ -59,18 +66,12 @@ namespace sfge::ext
 
 
 	private:
-		bool CheckEmptySlot(const Entity entity, Transform2d* transform2d, int roadBitMask);
-
-		void RoadTextureSelection(const Entity entity, Transform2d* transform2d, int roadBitMask);
+		bool CheckEmptySlot(const Entity entity);
 
-		void SetupTexture(const Entity entity, sf::Texture* texture, const TextureId textureId, const std::string texturePath);
+		void LoadRoadPrefab(RoadCase roadCase, const std::string& texturePath, Vec2f scale);
 
 
-		Transform2dManager* m_Transform2DManager;
-		TextureManager* m_TextureManager;
-		SpriteManager* m_SpriteManager;
-		EntityManager* m_EntityManager;
-		Configuration* m_Configuration;
+		SceneManager* m_SceneManager;
 
 		bool m_Init = false;
 
@@ -80,45 +81,10 @@ namespace sfge::ext
 		unsigned int m_NmbReservation = 0;
 
 #pragma region Graphics section
-		// Road cross 4 texture
-		std::string m_CrossTexturePath;
-		TextureId m_CrossTextureId;
-		sf::Texture* m_CrossTexture;
-
-		// Road threeWay texture
-		std::string m_ThreeWayTexturePath;
-		TextureId m_ThreeWayTextureId;
-		sf::Texture* m_ThreeWayTexture;
-
-		// Road OneWay texture
-		std::string m_OneWayTexturePath;
-		TextureId m_OneWayTextureId;
-		sf::Texture* m_OneWayTexture;
-
-		// Road End texture
-		std::string m_EndTexturePath;
-		TextureId m_EndTextureId;
-		sf::Texture* m_EndTexture;
-
-		// Road TurnNS texture
-		std::string m_TurnNSTexturePath;
-		TextureId m_TurnNSTextureId;
-		sf::Texture* m_TurnNSTexture;
-
-		// Road TurnWE texture
-		std::string m_TurnWETexturePath;
-		TextureId m_TurnWETextureId;
-		sf::Texture* m_TurnWETexture;
-
-		// Road TurnWE texture
-		std::string m_SoloTexturePath;
-		TextureId m_SoloTextureId;
-		sf::Texture* m_SoloTexture;
-
-		// Road TurnWE texture
-		std::string m_GroundTexturePath;
-		TextureId m_GroundTextureId;
-		sf::Texture* m_GroundTexture;
+		/**
+		 * \brief Transform and sprite of each road case, indexed by RoadCase
+		 */
+		std::array<const Prefab*, ROAD_CASE_NMB> m_RoadPrefabs{};
 #pragma endregion 
 	};
 }
@@ -79,18 +79,13 @@ namespace sfge::ext
 
 		bool CheckFreeSlot(Entity newEntity);
 
-		void SetupTexture(const Entity entity);
-
 		void ReserveContainer(const size_t newSize);
 
 		void AttributeContainer();
 
 
 		EntityManager * m_EntityManager;
-		Transform2dManager* m_Transform2DManager;
-		TextureManager* m_TextureManager;
-		SpriteManager* m_SpriteManager;
-		Configuration* m_Configuration;
+		SceneManager* m_SceneManager;
 
 		bool m_Init = false;
 
@@ -123,10 +118,8 @@ namespace sfge::ext
 #pragma endregion
 
 
-		//Warehouse texture
-		std::string m_TexturePath;
-		TextureId m_TextureId;
-		sf::Texture* m_Texture;
+		//Transform and sprite of a warehouse, its texture is loaded once
+		const Prefab* m_Prefab = nullptr;
 	};
 }
 #endif
\ No newline at end of file
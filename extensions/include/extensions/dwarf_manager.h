@@ -27,6 +27,7 @@ SOFTWARE.
 #include <ppl.h>
 
 #include <engine/system.h>
+#include <engine/job_system.h>
 #include <graphics/graphics2d.h>
 #include <extensions/AI/navigation_graph_manager.h>
 #include <extensions/Building/building_utilities.h>
@@ -65,6 +66,12 @@ public:
 	 */
 	void InstantiateDwarf(const Vec2f pos);
 
+	/**
+	 * \brief Spawn one dwarf per given position, the dwarf prefab is instantiated once for the whole batch
+	 * \param positions where the dwarfs will spawn
+	 */
+	void InstantiateDwarfs(const std::vector<Vec2f>& positions);
+
 	/**
 	 * \brief Destroy a dwarf using its entity
 	 * \param entity to destroy
@@ -121,7 +128,7 @@ public:
 	 * \param index 
 	 * \param path 
 	 */
-	void SetPath(unsigned int index, std::vector<Vec2f> path);
+	void SetPath(unsigned int index, const FrameVector<Vec2f>& path);
 
 	/**
 	 * \brief call from the behaviour tree to add a request for a new path
@@ -238,7 +245,7 @@ private:
 	void Batch();
 
 	void ResizeContainers();
-	int GetIndexForNewEntity();
+	int GetIndexForNewEntity(int firstIndex = 0);
 
 	void UpdatePositionRange(int startIndex, int endIndex, float vel);
 
@@ -247,8 +254,7 @@ private:
 
 	//System
 	Transform2dManager* m_Transform2DManager;
-	TextureManager* m_TextureManager;
-	SpriteManager* m_SpriteManager;
+	SceneManager* m_SceneManager;
 	NavigationGraphManager* m_NavigationGraphManager;
 	BuildingManager* m_BuildingManager;
 
@@ -264,15 +270,12 @@ private:
 	std::vector<Vec2f> m_VelocitiesComponents;
 	std::vector<float> m_DistanceRemaining;
 
-	std::vector<Vec2f*> m_Positions;
+	std::vector<const Vec2f*> m_Positions;
 
 	//Forces
 	float m_FixedDeltaTime = 0.0f;
 	const float m_SpeedDwarf = 30;
 
-	//Threads
-	std::vector<std::future<void>> m_BatchThreads;
-
 #ifdef DEBUG_DRAW_PATH
 	std::vector<sf::Color> m_Colors{
 		sf::Color::Black,
@@ -302,10 +305,8 @@ private:
 
 	std::vector<DwarfActivity> m_DwarfActivities;
 
-	//Dwarfs texture
-	std::string m_TexturePath;
-	TextureId m_TextureId;
-	sf::Texture* m_Texture;
+	//Transform and sprite of a dwarf, its texture is loaded once
+	const Prefab* m_DwarfPrefab = nullptr;
 
 	//Dwelling
 	std::vector<Entity> m_AssociatedDwelling;
@@ -366,7 +367,7 @@ private:
 	Vec2f m_ScreenSize;
 #endif
 
-	ctpl::thread_pool* m_ThreadPool;
+	JobSystem* m_JobSystem = nullptr;
 };
 }
 
@@ -21,13 +21,18 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
+#include <algorithm>
+
 #include <python/python_engine.h>
 
 #include <extensions/AI/behavior_tree.h>
 
 namespace sfge::ext::behavior_tree
 {
-BehaviorTree::BehaviorTree(Engine& engine) : System(engine) {}
+BehaviorTree::BehaviorTree(Engine& engine) : System(engine)
+{
+	SetStaggerFrameNmb(BEHAVIOR_TREE_STAGGER_FRAME_NMB);
+}
 
 BehaviorTree::~BehaviorTree()
 {
@@ -39,9 +44,12 @@ BehaviorTree::~BehaviorTree()
 
 void BehaviorTree::Init()
 {
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D), 0);
 	dwarfManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<DwarfManager>("DwarfManager");
 
-	m_ThreadPool = &m_Engine.GetThreadPool();
+	m_JobSystem = &m_Engine.GetJobSystem();
+	m_Budget = m_Engine.GetFrameBudget().RegisterWorkload("BehaviorTree",
+		BEHAVIOR_TREE_MIN_BUDGET, BEHAVIOR_TREE_MAX_BUDGET);
 }
 
 void BehaviorTree::Update(float dt)
@@ -50,8 +58,9 @@ void BehaviorTree::Update(float dt)
 	const auto t1 = std::chrono::high_resolution_clock::now();
 #endif
 
-	//Pre batch active / sleeping entities
-	for(size_t i = 0; i < m_Entities->size(); i++)
+	//Pre batch active / sleeping entities of the slice of this frame
+	const auto staggerRange = GetStaggerRange(m_Entities->size());
+	for(size_t i = staggerRange.begin; i < staggerRange.end; i++)
 	{
 		if(!sleepingEntity[i] && m_Entities->at(i) != INVALID_ENTITY){
 			m_ActiveEntity[m_IndexActiveEntity] = i;
@@ -59,26 +68,27 @@ void BehaviorTree::Update(float dt)
 		}
 	}
 
-	const auto coreNmb = m_ThreadPool->size();
-
-	if (m_IndexActiveEntity > 0) {
-		UpdateRange(0, m_IndexActiveEntity - 1);
-	}
-	/*else {
-		std::vector<std::future<void>> joinFutures(coreNmb);
-		for (auto threadIndex = 0; threadIndex < coreNmb; threadIndex++)
-		{
-			auto start = (threadIndex + 1)*m_IndexActiveEntity / (coreNmb + 1);
-			auto end = (threadIndex + 2)*m_IndexActiveEntity / (coreNmb + 1) - 1;
-			auto updateFunction = std::bind(&BehaviorTree::UpdateRange, this, start, end);
-			joinFutures[threadIndex] = m_ThreadPool->push(updateFunction);
-		}
-		UpdateRange(0, m_IndexActiveEntity / (coreNmb + 1) - 1);
-		for (auto i = 0; i < coreNmb; i++)
+	//Chunks of entities from the cursor of the slice until the budget is spent, the others wait the next turn of their slice
+	BudgetTimer budgetTimer(m_Engine.GetFrameBudget(), m_Budget);
+#ifdef AI_MULTI_THREAD
+	//A batch gives a chunk to each thread, the budget is checked between the batches
+	const size_t batchSize = BEHAVIOR_TREE_BUDGET_CHUNK * (m_JobSystem->GetThreadNmb());
+#else
+	const size_t batchSize = BEHAVIOR_TREE_BUDGET_CHUNK;
+#endif
+	m_ActiveCursor.Run(GetTickState().staggerFrame, m_IndexActiveEntity, batchSize,
+		[&budgetTimer]() { return budgetTimer.HasTimeLeft(); },
+		[this](size_t begin, size_t end)
+	{
+#ifdef AI_MULTI_THREAD
+		m_JobSystem->ParallelFor(begin, end, BEHAVIOR_TREE_BUDGET_CHUNK, [this](size_t start, size_t stop)
 		{
-			joinFutures[i].get();
-		}
-	}*/
+			UpdateRange(static_cast<int>(start), static_cast<int>(stop) - 1);
+		});
+#else
+		UpdateRange(static_cast<int>(begin), static_cast<int>(end) - 1);
+#endif
+	});
 
 	m_IndexActiveEntity = 0;
 
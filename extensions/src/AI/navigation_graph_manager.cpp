@@ -42,7 +42,10 @@ NavigationGraphManager::~NavigationGraphManager()
 
 void NavigationGraphManager::Init()
 {
+	DeclareAccess(static_cast<int>(ComponentType::TILEMAP), 0);
 	m_Graphics2DManager = m_Engine.GetGraphics2dManager();
+	m_PathFindingBudget = m_Engine.GetFrameBudget().RegisterWorkload("PathFinding",
+		m_MinPathFindingBudget, m_MaxPathFindingBudget);
 	m_DwarfManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<DwarfManager>(
 		"DwarfManager");
 
@@ -125,9 +128,11 @@ void NavigationGraphManager::Init()
 
 void NavigationGraphManager::Update(float dt)
 {
+	//At least one path per frame, the others wait the next frame once the budget is spent
+	BudgetTimer budgetTimer(m_Engine.GetFrameBudget(), m_PathFindingBudget);
 	for (size_t i = 0; i < m_MaxPathForOneUpdate; i++)
 	{
-		if (m_WaitingPaths.empty())
+		if (m_WaitingPaths.empty() || (i > 0 && !budgetTimer.HasTimeLeft()))
 		{
 			break;
 		}
@@ -264,7 +269,7 @@ void NavigationGraphManager::BuildGraphFromArray(Tilemap* tilemap, std::vector<s
 	}
 }
 
-std::vector<Vec2f> NavigationGraphManager::GetPathFromTo(Vec2f& origin, Vec2f& destination)
+FrameVector<Vec2f> NavigationGraphManager::GetPathFromTo(Vec2f& origin, Vec2f& destination)
 {
 #ifdef  AI_PATH_FINDING_DEBUG_COUNT_TIME_PRECISE
 	const auto t1 = std::chrono::high_resolution_clock::now();
@@ -316,7 +321,7 @@ float Sqrt(float x) {
 	return r * x;
 }
 
-std::vector<Vec2f> NavigationGraphManager::GetPathFromTo(const unsigned int originIndex,
+FrameVector<Vec2f> NavigationGraphManager::GetPathFromTo(const unsigned int originIndex,
                                                          const unsigned int destinationIndex)
 {
 #ifdef  AI_PATH_FINDING_DEBUG_COUNT_TIME_PRECISE
@@ -384,7 +389,8 @@ std::vector<Vec2f> NavigationGraphManager::GetPathFromTo(const unsigned int orig
 		}
 	}
 
-	std::vector<Vec2f> pathPos;
+	//The path finding runs on the JobSystem threads, each has an arena
+	auto pathPos = FrameVector<Vec2f>(FrameAllocator<Vec2f>(*m_Engine.GetFrameArena()));
 	auto currentNodeIndex = destinationIndex;
 	
 	while (currentNodeIndex != originIndex)
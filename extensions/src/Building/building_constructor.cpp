@@ -31,6 +31,12 @@ namespace sfge::ext
 
 	void BuildingConstructor::Init()
 	{
+		DeclareAccess(
+			static_cast<int>(ComponentType::TILEMAP) | static_cast<int>(ComponentType::TILE) |
+			static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D) |
+			static_cast<int>(ComponentType::TILE),
+			static_cast<int>(SystemResource::ENTITIES));
 		m_BuildingManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<BuildingManager>(
 			"BuildingManager");
 		m_TransformManager = m_Engine.GetTransform2dManager();
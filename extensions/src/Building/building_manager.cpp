@@ -32,6 +32,8 @@ namespace sfge::ext
 
 	void BuildingManager::Init()
 	{
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 		m_DwellingManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<DwellingManager>(
 			"DwellingManager");
 
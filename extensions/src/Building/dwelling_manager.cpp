@@ -28,10 +28,15 @@ SOFTWARE.
 
 namespace sfge::ext
 {
-	DwellingManager::DwellingManager(Engine & engine) : System(engine) {}
+	DwellingManager::DwellingManager(Engine & engine) : System(engine)
+	{
+		SetTickRate(ECONOMY_TICK_RATE);
+	}
 
 	void DwellingManager::Init()
 	{
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 		m_EntityManager = m_Engine.GetEntityManager();
 		m_Transform2DManager = m_Engine.GetTransform2dManager();
 		m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
@@ -218,20 +223,24 @@ namespace sfge::ext
 				continue;
 			}
 
-			m_ProgressionCoolDown[i] += m_DwarfSlots[i].dwarfIn;
+			m_ProgressionCoolDown[i] += static_cast<unsigned short>(m_DwarfSlots[i].dwarfIn * m_TickState.stepNmb);
 
 			if (m_ProgressionCoolDown[i] < m_CoolDownGoal)
 			{
 				continue;
 			}
 
-			m_ProgressionCoolDown[i] = 0;
-			m_ResourcesInventories[i]--;
-
-			if(m_ResourcesInventories[i] <= m_MaxCapacity - (m_ReservedImportStackNumber[i] * stackSizeNeeded + stackSizeNeeded))
+			//A tick can cross several goals, the overshoot is kept for the next one
+			while (m_ProgressionCoolDown[i] >= m_CoolDownGoal && m_ResourcesInventories[i] > 0)
 			{
-				m_ReservedImportStackNumber[i]++;
-				m_BuildingManager->RegistrationBuildingToBeFill(m_EntityIndex[i], BuildingType::DWELLING, m_ResourceTypeNeeded);
+				m_ProgressionCoolDown[i] -= m_CoolDownGoal;
+				m_ResourcesInventories[i]--;
+
+				if(m_ResourcesInventories[i] <= m_MaxCapacity - (m_ReservedImportStackNumber[i] * stackSizeNeeded + stackSizeNeeded))
+				{
+					m_ReservedImportStackNumber[i]++;
+					m_BuildingManager->RegistrationBuildingToBeFill(m_EntityIndex[i], BuildingType::DWELLING, m_ResourceTypeNeeded);
+				}
 			}
 		}
 	}
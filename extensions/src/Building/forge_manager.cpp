@@ -32,6 +32,8 @@ namespace sfge::ext
 
 	void ForgeManager::Init()
 	{
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 		m_EntityManager = m_Engine.GetEntityManager();
 
 		m_Transform2DManager = m_Engine.GetTransform2dManager();
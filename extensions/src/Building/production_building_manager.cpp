@@ -29,10 +29,15 @@ SOFTWARE.
 namespace sfge::ext
 {
 
-	ProductionBuildingManager::ProductionBuildingManager(Engine& engine) : System(engine) {}
+	ProductionBuildingManager::ProductionBuildingManager(Engine& engine) : System(engine)
+	{
+		SetTickRate(ECONOMY_TICK_RATE);
+	}
 
 	void ProductionBuildingManager::Init()
 	{
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 		m_EntityManager = m_Engine.GetEntityManager();
 		m_Transform2DManager = m_Engine.GetTransform2dManager();
 		m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
@@ -252,20 +257,24 @@ namespace sfge::ext
 				continue;
 			}
 
-			m_ProgressionCoolDowns[i] += m_DwarfSlots[i].dwarfIn;
+			m_ProgressionCoolDowns[i] += static_cast<unsigned short>(m_DwarfSlots[i].dwarfIn * m_TickState.stepNmb);
 
 			if (m_ProgressionCoolDowns[i] < m_CoolDownGoal)
 			{
 				continue;
 			}
 
-			m_ProgressionCoolDowns[i] = 0;
-			m_ResourcesInventories[i]++;
-
-			if(m_ResourcesInventories[i] >= m_ReservedExportStackNumber[i] * GetStackSizeByResourceType(m_ResourceTypes[i]) + GetStackSizeByResourceType(m_ResourceTypes[i]))
+			//A tick can cross several goals, the overshoot is kept for the next one
+			while (m_ProgressionCoolDowns[i] >= m_CoolDownGoal && m_ResourcesInventories[i] < m_MaxCapacity)
 			{
-				m_ReservedExportStackNumber[i]++;
-				m_BuildingManager->RegistrationBuildingToBeEmptied(m_EntityIndex[i], m_BuildingTypes[i], m_ResourceTypes[i]);
+				m_ProgressionCoolDowns[i] -= m_CoolDownGoal;
+				m_ResourcesInventories[i]++;
+
+				if(m_ResourcesInventories[i] >= m_ReservedExportStackNumber[i] * GetStackSizeByResourceType(m_ResourceTypes[i]) + GetStackSizeByResourceType(m_ResourceTypes[i]))
+				{
+					m_ReservedExportStackNumber[i]++;
+					m_BuildingManager->RegistrationBuildingToBeEmptied(m_EntityIndex[i], m_BuildingTypes[i], m_ResourceTypes[i]);
+				}
 			}
 		}
 	}
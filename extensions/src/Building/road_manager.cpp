@@ -30,52 +30,33 @@ namespace sfge::ext
 
 	void RoadManager::Init()
 	{
-		m_EntityManager = m_Engine.GetEntityManager();
-		m_Transform2DManager = m_Engine.GetTransform2dManager();
-		m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
-		m_SpriteManager = m_Engine.GetGraphics2dManager()->GetSpriteManager();
-		m_EntityManager = m_Engine.GetEntityManager();
-		m_Configuration = m_Engine.GetConfig();
-
-		//Load Texture
-		m_CrossTexturePath = "data/sprites/SP_path_4ways.png";
-		m_CrossTextureId = m_TextureManager->LoadTexture(m_CrossTexturePath);
-		m_CrossTexture = m_TextureManager->GetTexture(m_CrossTextureId);
-
-		//Load Texture
-		m_ThreeWayTexturePath = "data/sprites/SP_path_3ways.png";
-		m_ThreeWayTextureId = m_TextureManager->LoadTexture(m_ThreeWayTexturePath);
-		m_ThreeWayTexture = m_TextureManager->GetTexture(m_ThreeWayTextureId);
-
-		//Load Texture
-		m_OneWayTexturePath = "data/sprites/SP_path_1way.png";
-		m_OneWayTextureId = m_TextureManager->LoadTexture(m_OneWayTexturePath);
-		m_OneWayTexture = m_TextureManager->GetTexture(m_OneWayTextureId);
-
-		//Load Texture
-		m_EndTexturePath = "data/sprites/SP_path_end.png";
-		m_EndTextureId = m_TextureManager->LoadTexture(m_EndTexturePath);
-		m_EndTexture = m_TextureManager->GetTexture(m_EndTextureId);
-
-		//Load Texture
-		m_TurnNSTexturePath = "data/sprites/SP_path_turnNS.png";
-		m_TurnNSTextureId = m_TextureManager->LoadTexture(m_TurnNSTexturePath);
-		m_TurnNSTexture = m_TextureManager->GetTexture(m_TurnNSTextureId);
-
-		//Load Texture
-		m_TurnWETexturePath = "data/sprites/SP_path_turnWE.png";
-		m_TurnWETextureId = m_TextureManager->LoadTexture(m_TurnWETexturePath);
-		m_TurnWETexture = m_TextureManager->GetTexture(m_TurnWETextureId);
-
-		//Load Texture
-		m_SoloTexturePath = "data/sprites/SP_path_solo.png";
-		m_SoloTextureId = m_TextureManager->LoadTexture(m_SoloTexturePath);
-		m_SoloTexture = m_TextureManager->GetTexture(m_SoloTextureId);
-
-		//Load Texture
-		m_GroundTexturePath = "data/sprites/SP_ground_clear.png";
-		m_GroundTextureId = m_TextureManager->LoadTexture(m_GroundTexturePath);
-		m_GroundTexture = m_TextureManager->GetTexture(m_GroundTextureId);
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
+		m_SceneManager = m_Engine.GetSceneManager();
+
+		//One prefab per road case, each texture is loaded once and the flips are in the prefab transform
+		const std::string endTexturePath = "data/sprites/SP_path_end.png";
+		const std::string turnWETexturePath = "data/sprites/SP_path_turnWE.png";
+		const std::string turnNSTexturePath = "data/sprites/SP_path_turnNS.png";
+		const std::string threeWayTexturePath = "data/sprites/SP_path_3ways.png";
+		const std::string oneWayTexturePath = "data/sprites/SP_path_1way.png";
+		LoadRoadPrefab(RoadCase::GROUND, "data/sprites/SP_ground_clear.png", Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::SOLO, "data/sprites/SP_path_solo.png", Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::END_TOP_LEFT, endTexturePath, Vec2f(1, -1));
+		LoadRoadPrefab(RoadCase::END_TOP_RIGHT, endTexturePath, Vec2f(-1, -1));
+		LoadRoadPrefab(RoadCase::END_BOTTOM_LEFT, endTexturePath, Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::END_BOTTOM_RIGHT, endTexturePath, Vec2f(-1, 1));
+		LoadRoadPrefab(RoadCase::TURN_WEST, turnWETexturePath, Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::TURN_EAST, turnWETexturePath, Vec2f(-1, 1));
+		LoadRoadPrefab(RoadCase::TURN_NORTH, turnNSTexturePath, Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::TURN_SOUTH, turnNSTexturePath, Vec2f(1, -1));
+		LoadRoadPrefab(RoadCase::THREE_WAY_NOT_TOP_LEFT, threeWayTexturePath, Vec2f(-1, 1));
+		LoadRoadPrefab(RoadCase::THREE_WAY_NOT_TOP_RIGHT, threeWayTexturePath, Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::THREE_WAY_NOT_BOTTOM_LEFT, threeWayTexturePath, Vec2f(-1, -1));
+		LoadRoadPrefab(RoadCase::THREE_WAY_NOT_BOTTOM_RIGHT, threeWayTexturePath, Vec2f(1, -1));
+		LoadRoadPrefab(RoadCase::TOP_LEFT_TO_BOTTOM_RIGHT, oneWayTexturePath, Vec2f(-1, 1));
+		LoadRoadPrefab(RoadCase::TOP_RIGHT_TO_BOTTOM_LEFT, oneWayTexturePath, Vec2f(1, 1));
+		LoadRoadPrefab(RoadCase::CROSS, "data/sprites/SP_path_4ways.png", Vec2f(1, 1));
 
 		m_Init = true;
 
@@ -100,121 +81,72 @@ namespace sfge::ext
 
 	void RoadManager::SpawnRoad(Vec2f position, int roadBitMask)
 	{
-		Entity newEntity = m_EntityManager->CreateEntity(INVALID_ENTITY);
-
-		editor::EntityInfo& entityInfo = m_EntityManager->GetEntityInfo(newEntity);
-		entityInfo.name = "Road " + std::to_string(m_BuildingIndexCount);
-
-		if (newEntity == INVALID_ENTITY)
-		{
-			m_EntityManager->ResizeEntityNmb(m_Configuration->currentEntitiesNmb + CONTAINER_RESERVATION);
-			newEntity = m_EntityManager->CreateEntity(INVALID_ENTITY);
-		}
-
-		//add transform
-		Transform2d* transformPtr = m_Transform2DManager->AddComponent(newEntity);
-		transformPtr->Position = Vec2f(position.x, position.y);
-
-		RoadTextureSelection(newEntity, transformPtr, roadBitMask);
+		SpawnRoads({ position }, roadBitMask);
+	}
 
-		if (CheckEmptySlot(newEntity, transformPtr, roadBitMask))
+	void RoadManager::SpawnRoads(const std::vector<Vec2f>& positions, int roadBitMask)
+	{
+		const Prefab* roadPrefab = m_RoadPrefabs[roadBitMask];
+		if (roadPrefab == nullptr || positions.empty())
 		{
 			return;
 		}
 
-		m_BuildingIndexCount++;
-
-
-
-		if (m_BuildingIndexCount >= CONTAINER_RESERVATION * m_NmbReservation)
+		const auto entities = m_SceneManager->InstantiatePrefab(*roadPrefab, positions);
+		for (size_t i = 0; i < entities.size(); i++)
 		{
-			m_EntityIndex.reserve(m_BuildingIndexCount + CONTAINER_RESERVATION);
-			m_NmbReservation++;
-		}
-
-		m_EntityIndex.emplace_back(newEntity);
+			const Entity newEntity = entities[i];
+			if (CheckEmptySlot(newEntity))
+			{
+				continue;
+			}
 
-		const size_t newWarehouse = m_BuildingIndexCount - 1;
+			m_BuildingIndexCount++;
 
-		m_EntityIndex[newWarehouse] = newEntity;
+			if (m_BuildingIndexCount >= CONTAINER_RESERVATION * m_NmbReservation)
+			{
+				m_EntityIndex.reserve(m_BuildingIndexCount + CONTAINER_RESERVATION);
+				m_NmbReservation++;
+			}
 
+			m_EntityIndex.emplace_back(newEntity);
+		}
 	}
 
 	void RoadManager::SpawnRoad(const std::vector<TileTypeId> tilesTypeVector, const int LengthX, const int LengthY, const Vec2f positionFirstTile, const Vec2f size, const unsigned int roadType)
 	{
-		int x = 0;
-		int y = 0;
-
 		Vec2f xPos = { size.x / 2, size.y / 2 };
 		Vec2f yPos = { -size.x / 2.0f, size.y / 2.0f };
 
-
-		int roadBitMask = 0;
-		
+		//The tiles are grouped by road case, each case is then spawned in one batch
+		std::array<std::vector<Vec2f>, ROAD_CASE_NMB> roadPositions;
 		for (int y = 0; y < LengthY; y++)
 		{
 			for (int x = 0; x < LengthX; x++)
 			{
-				roadBitMask = 0;
+				int roadBitMask = 0;
 
-				if (tilesTypeVector[y * LengthX + x] != roadType)
+				if (tilesTypeVector[y * LengthX + x] == roadType)
 				{
-					SpawnRoad(positionFirstTile + xPos * x + yPos * y, roadBitMask);
-					continue;
+					roadBitMask = 1;
+
+					if (x > 0 && tilesTypeVector[y * LengthX + x - 1] == roadType)
+						roadBitMask += 1 << 1;
+					if (y > 0 && tilesTypeVector[y * LengthX + x - LengthX] == roadType)
+						roadBitMask += 1 << 2;
+					if (y < LengthY - 1 && tilesTypeVector[y * LengthX + x + LengthX] == roadType)
+						roadBitMask += 1 << 3;
+					if (x < LengthX - 1 && tilesTypeVector[y * LengthX + x + 1] == roadType)
+						roadBitMask += 1 << 4;
 				}
 
-				roadBitMask = 1;
-
-				if (x > 0 && tilesTypeVector[y * LengthX + x - 1] == roadType)
-					roadBitMask += 1 << 1;
-				if (y > 0 && tilesTypeVector[y * LengthX + x - LengthX] == roadType)
-					roadBitMask += 1 << 2;
-				if (y < LengthY - 1 && tilesTypeVector[y * LengthX + x + LengthX] == roadType)
-					roadBitMask += 1 << 3;
-				if (x < LengthX - 1 && tilesTypeVector[y * LengthX + x + 1] == roadType)
-					roadBitMask += 1 << 4;
-
-				SpawnRoad(positionFirstTile + xPos * x + yPos * y, roadBitMask);
+				roadPositions[roadBitMask].push_back(positionFirstTile + xPos * x + yPos * y);
 			}
 		}
 
-		for (int i = 0; i < tilesTypeVector.size(); ++i)
+		for (int roadBitMask = 0; roadBitMask < ROAD_CASE_NMB; roadBitMask++)
 		{
-			roadBitMask = 0;
-
-			if (tilesTypeVector[i] != roadType)
-			{
-				SpawnRoad(positionFirstTile + xPos * x + yPos * y, roadBitMask);
-
-				x++;
-				if (x >= LengthX)
-				{
-					x = 0;
-					y++;
-				}
-				continue;
-			}
-
-			roadBitMask = 1;
-
-				if(x > 0 && tilesTypeVector[i - 1] == roadType)
-					roadBitMask += 1 << 1;
-				if (y > 0 && tilesTypeVector[i - LengthX] == roadType)
-					roadBitMask += 1 << 2;
-				if (y < LengthY - 1 && tilesTypeVector[i + LengthX] == roadType)
-					roadBitMask += 1 << 3;
-				if (x < LengthX - 1 && tilesTypeVector[i + 1] == roadType)
-					roadBitMask += 1 << 4;
-
-				SpawnRoad(positionFirstTile + xPos * x + yPos * y, roadBitMask);
-
-			x++;
-
-			if(x >= LengthX)
-			{
-				x = 0;
-				y++;
-			}
+			SpawnRoads(roadPositions[roadBitMask], roadBitMask);
 		}
 	}
 
@@ -224,7 +156,7 @@ namespace sfge::ext
 
 	}
 
-	bool RoadManager::CheckEmptySlot(const Entity entity, Transform2d* transform2d, int roadBitMask)
+	bool RoadManager::CheckEmptySlot(const Entity entity)
 	{
 		for (int i = 0; i < m_BuildingIndexCount; ++i)
 		{
@@ -240,91 +172,18 @@ namespace sfge::ext
 		return false;
 	}
 
-	void RoadManager::RoadTextureSelection(const Entity entity, Transform2d* transform2d, int roadBitMask)
-	{
-		switch (roadBitMask)
-		{
-		case RoadCase::GROUND :
-			SetupTexture(entity, m_GroundTexture, m_GroundTextureId, m_GroundTexturePath);
-			break;
-
-		case RoadCase::SOLO :
-			SetupTexture(entity, m_SoloTexture, m_SoloTextureId, m_SoloTexturePath);
-			break;
-
-		case RoadCase::END_TOP_LEFT:
-			transform2d->Scale = Vec2f(1, -1);
-			SetupTexture(entity, m_EndTexture, m_EndTextureId, m_EndTexturePath);
-			break;
-		case RoadCase::END_TOP_RIGHT:
-			transform2d->Scale = Vec2f(-1, -1);
-			SetupTexture(entity, m_EndTexture, m_EndTextureId, m_EndTexturePath);
-			break;
-		case RoadCase::END_BOTTOM_LEFT:
-			SetupTexture(entity, m_EndTexture, m_EndTextureId, m_EndTexturePath);
-			break;
-		case RoadCase::END_BOTTOM_RIGHT:
-			transform2d->Scale = Vec2f(-1, 1);
-			SetupTexture(entity, m_EndTexture, m_EndTextureId, m_EndTexturePath);
-			break;
-
-		case RoadCase::TURN_WEST:
-			SetupTexture(entity, m_TurnWETexture, m_TurnWETextureId, m_TurnWETexturePath);
-			break;
-		case RoadCase::TURN_EAST:
-			transform2d->Scale = Vec2f(-1, 1);
-			SetupTexture(entity, m_TurnWETexture, m_TurnWETextureId, m_TurnWETexturePath);
-			break;
-
-		case RoadCase::TURN_NORTH:
-			SetupTexture(entity, m_TurnNSTexture, m_TurnNSTextureId, m_TurnNSTexturePath);
-			break;
-		case RoadCase::TURN_SOUTH:
-			transform2d->Scale = Vec2f(1, -1);
-			SetupTexture(entity, m_TurnNSTexture, m_TurnNSTextureId, m_TurnNSTexturePath);
-			break;
-
-		case RoadCase::THREE_WAY_NOT_TOP_LEFT:
-			transform2d->Scale = Vec2f(-1, 1);
-			SetupTexture(entity, m_ThreeWayTexture, m_ThreeWayTextureId, m_ThreeWayTexturePath);
-			break;
-		case RoadCase::THREE_WAY_NOT_TOP_RIGHT:
-			SetupTexture(entity, m_ThreeWayTexture, m_ThreeWayTextureId, m_ThreeWayTexturePath);
-			break;
-		case RoadCase::THREE_WAY_NOT_BOTTOM_LEFT:
-			transform2d->Scale = Vec2f(-1, -1);
-			SetupTexture(entity, m_ThreeWayTexture, m_ThreeWayTextureId, m_ThreeWayTexturePath);
-			break;
-		case RoadCase::THREE_WAY_NOT_BOTTOM_RIGHT:
-			transform2d->Scale = Vec2f(1, -1);
-			SetupTexture(entity, m_ThreeWayTexture, m_ThreeWayTextureId, m_ThreeWayTexturePath);
-			break;
-
-		case RoadCase::TOP_LEFT_TO_BOTTOM_RIGHT:
-			transform2d->Scale = Vec2f(-1, 1);
-			SetupTexture(entity, m_OneWayTexture, m_OneWayTextureId, m_OneWayTexturePath);
-			break;
-		case RoadCase::TOP_RIGHT_TO_BOTTOM_LEFT:
-			SetupTexture(entity, m_OneWayTexture, m_OneWayTextureId, m_OneWayTexturePath);
-			break;
-
-		case RoadCase::CROSS:
-			SetupTexture(entity, m_CrossTexture, m_CrossTextureId, m_CrossTexturePath);
-			break;
-		}
-	}
-
-	void RoadManager::SetupTexture(const Entity entity, sf::Texture* texture, const TextureId textureId, const std::string texturePath)
+	void RoadManager::LoadRoadPrefab(const RoadCase roadCase, const std::string& texturePath, const Vec2f scale)
 	{
-		//Sprite Component part
-		Sprite* sprite = m_SpriteManager->AddComponent(entity);
-		sprite->SetTexture(texture);
-
-		auto& spriteInfo = m_SpriteManager->GetComponentInfo(entity);
-		spriteInfo.name = "Sprite";
-		spriteInfo.sprite = sprite;
-		spriteInfo.textureId = textureId;
-		spriteInfo.texturePath = texturePath;
+		json transformJson;
+		transformJson["type"] = static_cast<int>(ComponentType::TRANSFORM2D);
+		transformJson["scale"] = { scale.x, scale.y };
+		json spriteJson;
+		spriteJson["type"] = static_cast<int>(ComponentType::SPRITE2D);
+		spriteJson["path"] = texturePath;
+		json prefabJson;
+		prefabJson["name"] = "Road";
+		prefabJson["components"] = json::array({ transformJson, spriteJson });
+		m_RoadPrefabs[roadCase] = m_SceneManager->LoadPrefabFromJson("Road " + std::to_string(roadCase), prefabJson);
 	}
 
 }
\ No newline at end of file
@@ -30,18 +30,23 @@ namespace sfge::ext
 
 	void WarehouseManager::Init()
 	{
+		DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+			static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 		m_EntityManager = m_Engine.GetEntityManager();
-		m_Transform2DManager = m_Engine.GetTransform2dManager();
-		m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
-		m_SpriteManager = m_Engine.GetGraphics2dManager()->GetSpriteManager();
-		m_Configuration = m_Engine.GetConfig();
+		m_SceneManager = m_Engine.GetSceneManager();
 
 		m_Window = m_Engine.GetGraphics2dManager()->GetWindow();
 
-		//Load Texture
-		m_TexturePath = "data/sprites/warehouse.png";
-		m_TextureId = m_TextureManager->LoadTexture(m_TexturePath);
-		m_Texture = m_TextureManager->GetTexture(m_TextureId);
+		//Warehouse prefab, the texture is loaded once for all the warehouses
+		json transformJson;
+		transformJson["type"] = static_cast<int>(ComponentType::TRANSFORM2D);
+		json spriteJson;
+		spriteJson["type"] = static_cast<int>(ComponentType::SPRITE2D);
+		spriteJson["path"] = "data/sprites/warehouse.png";
+		json prefabJson;
+		prefabJson["name"] = "Warehouse";
+		prefabJson["components"] = json::array({ transformJson, spriteJson });
+		m_Prefab = m_SceneManager->LoadPrefabFromJson("Warehouse", prefabJson);
 
 		m_Init = true;
 
@@ -67,22 +72,8 @@ namespace sfge::ext
 	void WarehouseManager::SpawnBuilding(Vec2f position)
 	{
 
-		Entity newEntity = m_EntityManager->CreateEntity(INVALID_ENTITY);
-
-		if (newEntity == INVALID_ENTITY)
-		{
-			m_EntityManager->ResizeEntityNmb(m_Configuration->currentEntitiesNmb + CONTAINER_RESERVATION);
-			newEntity = m_EntityManager->CreateEntity(INVALID_ENTITY);
-		}
-
-		//add transform
-		Transform2d* transformPtr = m_Transform2DManager->AddComponent(newEntity);
-		transformPtr->Position = Vec2f(position.x, position.y);
-
-		SetupTexture(newEntity);
-
-		editor::EntityInfo& entityInfo = m_EntityManager->GetEntityInfo(newEntity);
-		entityInfo.name = "Warehouse " + std::to_string(m_BuildingIndexCount);
+		//The transform and the sprite come from the prefab
+		const Entity newEntity = m_SceneManager->InstantiatePrefab(*m_Prefab, { position })[0];
 
 		if (CheckFreeSlot(newEntity))
 		{
@@ -443,19 +434,6 @@ namespace sfge::ext
 		return false;
 	}
 
-	void WarehouseManager::SetupTexture(const Entity entity)
-	{
-		//Sprite Component part
-		Sprite* sprite = m_SpriteManager->AddComponent(entity);
-		sprite->SetTexture(m_Texture);
-
-		auto& spriteInfo = m_SpriteManager->GetComponentInfo(entity);
-		spriteInfo.name = "Sprite";
-		spriteInfo.sprite = sprite;
-		spriteInfo.textureId = m_TextureId;
-		spriteInfo.texturePath = m_TexturePath;
-	}
-
 	void WarehouseManager::ReserveContainer(const size_t newSize)
 	{
 		m_EntityIndex.reserve(newSize);
@@ -47,10 +47,11 @@ DwarfManager::~DwarfManager()
 
 void DwarfManager::Init()
 {
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D),
+		static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::SPRITE2D), static_cast<int>(SystemResource::ENTITIES));
 	//Get managers
 	m_Transform2DManager = m_Engine.GetTransform2dManager();
-	m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
-	m_SpriteManager = m_Engine.GetGraphics2dManager()->GetSpriteManager();
+	m_SceneManager = m_Engine.GetSceneManager();
 	m_NavigationGraphManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<NavigationGraphManager>(
 		"NavigationGraphManager");
 	m_BuildingManager = m_Engine.GetPythonEngine()->GetPySystemManager().GetPySystem<BuildingManager>(
@@ -65,10 +66,16 @@ void DwarfManager::Init()
 	//Read config
 	m_FixedDeltaTime = m_Config->fixedDeltaTime;
 
-	//Load texture
-	m_TexturePath = "data/sprites/triangle.png";
-	m_TextureId = m_TextureManager->LoadTexture(m_TexturePath);
-	m_Texture = m_TextureManager->GetTexture(m_TextureId);
+	//Dwarf prefab, the texture is loaded once for all the dwarfs
+	json transformJson;
+	transformJson["type"] = static_cast<int>(ComponentType::TRANSFORM2D);
+	json spriteJson;
+	spriteJson["type"] = static_cast<int>(ComponentType::SPRITE2D);
+	spriteJson["path"] = "data/sprites/triangle.png";
+	json prefabJson;
+	prefabJson["name"] = "Dwarf";
+	prefabJson["components"] = json::array({ transformJson, spriteJson });
+	m_DwarfPrefab = m_SceneManager->LoadPrefabFromJson("Dwarf", prefabJson);
 
 	//Init job 
 	//TODO changer la mani�re dont je cr�e la liste des boulots, il serait plus int�ressant de garder le % de chaque job actuellement attribu�
@@ -79,55 +86,37 @@ void DwarfManager::Init()
 	m_JobBuildingType.push(WAREHOUSE);
 	m_JobBuildingType.push(MUSHROOM_FARM);
 
-	m_ThreadPool = &m_Engine.GetThreadPool();
-
-	m_BatchThreads.resize(2);
+	m_JobSystem = &m_Engine.GetJobSystem();
 }
 
 void DwarfManager::InstantiateDwarf(const Vec2f pos)
 {
-	auto* entityManager = m_Engine.GetEntityManager();
+	InstantiateDwarfs({ pos });
+}
 
-	auto newEntity = entityManager->CreateEntity(INVALID_ENTITY);
+void DwarfManager::InstantiateDwarfs(const std::vector<Vec2f>& positions)
+{
+	//The transforms and the sprites are created per component type by the prefab
+	const auto entities = m_SceneManager->InstantiatePrefab(*m_DwarfPrefab, positions);
 
-	if (newEntity == INVALID_ENTITY)
+	//The free slots are searched from the last given one, so the lookup stays linear over the batch
+	auto indexNewDwarf = 0;
+	for (size_t i = 0; i < entities.size(); i++)
 	{
-		entityManager->ResizeEntityNmb(m_Config->currentEntitiesNmb + m_ContainersExtender);
-		newEntity = entityManager->CreateEntity(INVALID_ENTITY);
-	}
-
-	const auto indexNewDwarf = GetIndexForNewEntity();
-
-	auto& entityInfo = entityManager->GetEntityInfo(newEntity);
-	entityInfo.name = "Dwarf " + std::to_string(indexNewDwarf);
+		indexNewDwarf = GetIndexForNewEntity(indexNewDwarf);
 
+		if (indexNewDwarf + 1 > m_IndexDwarfsEntities)
+		{
+			m_IndexDwarfsEntities = indexNewDwarf + 1;
+		}
 
-	if(indexNewDwarf + 1 > m_IndexDwarfsEntities)
-	{
-		m_IndexDwarfsEntities = indexNewDwarf + 1;
+		//Update data for new dwarf in std::vectors
+		m_DwarfsEntities[indexNewDwarf] = entities[i];
+		m_Paths[indexNewDwarf] = std::vector<Vec2f>();
+		m_AssociatedDwelling[indexNewDwarf] = INVALID_ENTITY;
+		m_AssociatedWorkingPlace[indexNewDwarf] = INVALID_ENTITY;
+		m_DwarfActivities[indexNewDwarf] = DwarfActivity::IDLE;
 	}
-
-	//Update data for new dwarf in std::vectors
-	m_DwarfsEntities[indexNewDwarf] = newEntity;
-	m_Paths[indexNewDwarf] = std::vector<Vec2f>();
-	m_AssociatedDwelling[indexNewDwarf] = INVALID_ENTITY;
-	m_AssociatedWorkingPlace[indexNewDwarf] = INVALID_ENTITY;
-	m_DwarfActivities[indexNewDwarf] = DwarfActivity::IDLE;
-
-	//Add transform
-	auto* transformPtr = m_Transform2DManager->AddComponent(newEntity);
-	transformPtr->Position = pos;
-
-	//Add sprite
-	auto* sprite = m_SpriteManager->AddComponent(newEntity);
-	sprite->SetTexture(m_Texture);
-
-	//Set sprite infos
-	auto& spriteInfo = m_SpriteManager->GetComponentInfo(newEntity);
-	spriteInfo.name = "Sprite dwarf";
-	spriteInfo.sprite = sprite;
-	spriteInfo.textureId = m_TextureId;
-	spriteInfo.texturePath = m_TexturePath;
 }
 
 void DwarfManager::DestroyDwarfByIndex(const unsigned int index)
@@ -169,12 +158,12 @@ Entity DwarfManager::GetDwellingEntity(const unsigned int index)
 
 Vec2f DwarfManager::GetDwellingAssociatedPosition(const unsigned int index)
 {
-	return m_Transform2DManager->GetComponentPtr(m_AssociatedDwelling[index])->Position;
+	return m_Transform2DManager->GetLocalTransform(m_AssociatedDwelling[index]).Position;
 }
 
 Vec2f DwarfManager::GetWorkingPlaceAssociatedPosition(const unsigned int index)
 {
-	return m_Transform2DManager->GetComponentPtr(m_AssociatedWorkingPlace[index])->Position;
+	return m_Transform2DManager->GetLocalTransform(m_AssociatedWorkingPlace[index]).Position;
 }
 
 void DwarfManager::AskAssignDwellingToDwarf(const unsigned int index)
@@ -210,10 +199,10 @@ bool DwarfManager::HasPath(const unsigned int index)
 	return !m_Paths[index].empty();
 }
 
-void DwarfManager::SetPath(const unsigned int index, std::vector<Vec2f> path)
+void DwarfManager::SetPath(const unsigned int index, const FrameVector<Vec2f>& path)
 {
-	m_Paths[index] = path;
-	auto dir = path.back() - m_Transform2DManager->GetComponentPtr(m_DwarfsEntities[index])->Position;
+	m_Paths[index].assign(path.begin(), path.end());
+	auto dir = path.back() - m_Transform2DManager->GetLocalTransform(m_DwarfsEntities[index]).Position;
 	const auto distance = dir.GetMagnitude();
 	if(distance == 0)
 	{
@@ -247,14 +236,14 @@ void DwarfManager::AddInventoryTaskPathToGiver(const unsigned int index)
 {
 	m_DwarfActivities[index] = DwarfActivity::FIND_PATH;
 	m_DestinationForPathFinding[index] = m_Transform2DManager
-		->GetComponentPtr(m_InventoryTaskBT[index].giver)->Position;
+		->GetLocalTransform(m_InventoryTaskBT[index].giver).Position;
 }
 
 void DwarfManager::AddInventoryTaskPathToReceiver(const unsigned int index)
 {
 	m_DwarfActivities[index] = DwarfActivity::FIND_PATH;
 	m_DestinationForPathFinding[index] = m_Transform2DManager
-		->GetComponentPtr(m_InventoryTaskBT[index].receiver)->Position;
+		->GetLocalTransform(m_InventoryTaskBT[index].receiver).Position;
 }
 
 void DwarfManager::AddInventoryTaskBT(const unsigned int index)
@@ -326,7 +315,7 @@ void DwarfManager::BatchPosition()
 {
 	for (size_t i = 0; i < m_IndexDwarfsEntities; i++)
 	{
-		m_Positions[i] = &m_Transform2DManager->GetComponentPtr(m_DwarfsEntities[i])->Position;
+		m_Positions[i] = &m_Transform2DManager->GetLocalTransform(m_DwarfsEntities[i]).Position;
  	}
 }
 
@@ -415,13 +404,10 @@ void DwarfManager::BatchActivities()
 
 void DwarfManager::Batch()
 {
-	m_BatchThreads[0] = m_ThreadPool->push(std::bind(&DwarfManager::BatchPosition, this));
-	m_BatchThreads[1] = m_ThreadPool->push(std::bind(&DwarfManager::BatchActivities, this));
-
-	for (auto i = 0; i < 2; i++)
-	{
-		m_BatchThreads[i].get();
-	}
+	JobGroup batchGroup;
+	m_JobSystem->Schedule(batchGroup, [this]() { BatchPosition(); });
+	m_JobSystem->Schedule(batchGroup, [this]() { BatchActivities(); });
+	m_JobSystem->Wait(batchGroup);
 }
 
 void DwarfManager::ResizeContainers()
@@ -462,10 +448,10 @@ void DwarfManager::ResizeContainers()
 	m_DistanceRemaining.resize(newSize);
 }
 
-int DwarfManager::GetIndexForNewEntity()
+int DwarfManager::GetIndexForNewEntity(const int firstIndex)
 {
 	//Check if a place is free
-	for (auto i = 0; i < m_DwarfsEntities.size(); i++)
+	for (auto i = firstIndex; i < m_DwarfsEntities.size(); i++)
 	{
 		if (m_DwarfsEntities[i] == INVALID_ENTITY)
 		{
@@ -484,7 +470,9 @@ void DwarfManager::UpdatePositionRange(const int startIndex, const int endIndex,
 	for (size_t i = startIndex; i <= endIndex; ++i)
 	{
 		const auto indexDwarf = m_PathFollowBatch[i];
-		*m_Positions[indexDwarf] += m_VelocitiesComponents[indexDwarf] * vel;
+		//Written through the manager so the moved dwarfs are marked dirty
+		m_Transform2DManager->GetComponentRef(m_DwarfsEntities[indexDwarf]).Position +=
+			m_VelocitiesComponents[indexDwarf] * vel;
 		m_DistanceRemaining[indexDwarf] -= vel;
 	}
 }
@@ -42,6 +42,8 @@ PlanetSystem::PlanetSystem(Engine& engine):
 
 void PlanetSystem::Init()
 {
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::BODY2D),
+		static_cast<int>(ComponentType::TRANSFORM2D) | static_cast<int>(ComponentType::BODY2D));
 	m_Transform2DManager = m_Engine.GetTransform2dManager();
 	m_Body2DManager = m_Engine.GetPhysicsManager()->GetBodyManager();
 	m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
@@ -139,28 +141,16 @@ void PlanetSystem::FixedUpdate()
 {
 	rmt_ScopedCPUSample(PlanetSystemFixedUpdate,0);
 #ifdef MULTI_THREAD
-	auto& threadPool = m_Engine.GetThreadPool();
-	const auto coreNmb = threadPool.size();
-
-	std::vector<std::future<void>> joinFutures(coreNmb);
-	for(int threadIndex = 0; threadIndex < coreNmb;threadIndex++)
-	{
-		int start = (threadIndex + 1)*entitiesNmb/ (coreNmb + 1);
-		int end = (threadIndex + 2)*entitiesNmb / (coreNmb + 1)-1;
-		auto worldUpdateFunction = std::bind(&PlanetSystem::UpdateRange, this, start, end);
-		joinFutures[threadIndex] = threadPool.push(worldUpdateFunction);
-	}
-	UpdateRange(0, entitiesNmb / (coreNmb + 1) - 1);
-	for(int i = 0; i < coreNmb;i++)
+	m_Engine.GetJobSystem().ParallelFor(0, entitiesNmb, 0, [this](size_t start, size_t end)
 	{
-		joinFutures[i].get();
-	}
+		UpdateRange(static_cast<int>(start), static_cast<int>(end));
+	});
 #else
 	for(auto i = 0u; i < entitiesNmb ; i++)
 	{
 
 #ifdef WITH_PHYSICS
-		const auto transformPtr = m_Engine.GetTransform2dManager()->GetComponentPtr(i + 1);
+		const auto* transformPtr = &m_Engine.GetTransform2dManager()->GetLocalTransform(i + 1);
 		auto bodyPtr = m_Engine.GetPhysicsManager()->GetBodyManager()->GetComponentPtr(i + 1);
 		bodyPtr->ApplyForce(CalculateNewForce(transformPtr->Position));
 #else
@@ -62,6 +62,7 @@ public:
 	void Destroy() override;
 	void Clear() override;
 	void Collect() override;
+	void ReportMemory(MemoryReport& report) const override;
 protected:
 	SoundManager m_SoundManager {m_Engine};
 	SoundBufferManager m_SoundBufferManager{ m_Engine };
@@ -86,6 +86,10 @@ public:
 	void Clear() override;
 	
 	void Collect() override;
+	/**
+	 * \brief The loaded samples are counted as external memory
+	 */
+	void ReportMemory(MemoryReport& report) const override;
 
 	SoundBufferId LoadSoundBuffer(std::string filename);
 	sf::SoundBuffer* GetSoundBuffer(SoundBufferId soundBufferId);
@@ -129,6 +133,7 @@ public:
 	void Collect() override;
 
 	Sound* GetComponentPtr(Entity entity) override;
+	void DrawOnInspector(Entity entity) override;
 
 protected:
 	int GetFreeComponentIndex() override;
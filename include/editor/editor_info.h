@@ -47,7 +47,7 @@ public:
     Entity GetEntity();
     virtual void DrawOnInspector() = 0;
 protected:
-  	Entity m_Entity;
+  	Entity m_Entity = INVALID_ENTITY;
 
 };
 
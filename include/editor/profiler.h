@@ -27,14 +27,23 @@ SOFTWARE.
 
 #include <SFML/System/Time.hpp>
 
+#include <engine/memory_report.h>
+#include <engine/frame_budget.h>
+
 namespace sfge
 {
 class Engine;
+class SystemGraph;
+class SystemProfiler;
 struct ProfilerFrameData
 {
     sf::Time frameTotalTime;
     sf::Time frameFixedUpdate;
     sf::Time graphicsTime;
+    /**
+     * \brief Fixed steps run during the last fixed update frame
+     */
+    unsigned fixedSteps = 0;
 };
 namespace editor
 {
@@ -44,7 +53,32 @@ public:
     ProfilerEditorWindow(Engine& engine);
     void Update ();
 private:
+  /**
+   * \brief Systems of each frame phase with the earlier systems they wait for and their last duration
+   */
+  void DrawSystemGraph ();
+  /**
+   * \brief Min, average and p99 of each system over the samples kept by the SystemProfiler,
+   * recomputed only when the editor budget has the time for it
+   */
+  void DrawSystemTimings ();
+  /**
+   * \brief Budget and last used time of each degradable workload
+   */
+  void DrawFrameBudget ();
+  /**
+   * \brief Memory of each system, refreshed on demand since the Box2D estimate walks every body
+   */
+  void DrawMemory ();
+  Engine& m_Engine;
+  MemoryReport m_MemoryReport;
   ProfilerFrameData& m_ProfilerFrameData;
+  SystemGraph& m_SystemGraph;
+  SystemProfiler& m_SystemProfiler;
+  FrameBudget& m_FrameBudget;
+  BudgetId m_EditorBudget = 0;
+  std::vector<SystemTimingStats> m_SystemStats;
+  std::int64_t m_SystemStatsDuration = 0;
 };
 }
 }
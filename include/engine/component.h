@@ -29,13 +29,20 @@ SOFTWARE.
 #include <queue>
 #include <vector>
 #include <any>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <sstream>
 
 #include <engine/globals.h>
 #include <utility/log.h>
 #include <engine/entity.h>
+#include <engine/component_pool.h>
+#include <engine/memory_report.h>
 #include <engine/system.h>
 #include <engine/engine.h>
 #include <engine/scene.h>
+#include <engine/prefab.h>
 #include <editor/editor_info.h>
 #include <editor/editor.h>
 
@@ -65,12 +72,60 @@ enum class ComponentType : int
 	BUTTON = 1 << 14,
 };
 
+struct SceneBlock;
+class SceneBlockBuilder;
+
 class IComponentFactory
 {
  public:
   virtual void CreateComponent(json& componentJson, Entity entity) = 0;
+  /**
+   * \brief Create every component of one type of a scene, componentJsons[i] belongs to entities[i]. The managers
+   * whose components are independent override it to do the json decoding on the job system
+   */
+  virtual void CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons)
+  {
+	  for (size_t i = 0; i < entities.size(); i++)
+	  {
+		  CreateComponent(*componentJsons[i], entities[i]);
+	  }
+  }
+  /**
+   * \brief Create the components of a compiled SoA block, component i goes to entities[block.entityIndices[i]].
+   * Only the types with a SceneBlockCompiler, see scene_binary.cpp, have to override it
+   */
+  virtual void CreateComponents(const SceneBlock& block, const EntityRange& entities)
+  {
+	  (void) entities;
+	  (void) block;
+	  Log::GetInstance()->Error("[Error] This component manager cannot load a compiled scene block");
+  }
+  /**
+   * \brief Resolve once the assets of a prefab component into its resolvedData, called when the prefab is loaded
+   */
+  virtual void ResolvePrefabComponent(PrefabComponent& prefabComponent)
+  {
+	  (void) prefabComponent;
+  }
+  /**
+   * \brief Create the same prefab component on every entity, entity i being spawned at positions[i].
+   * By default one CreateComponent per entity from the prefab json
+   */
+  virtual void InstantiatePrefabComponents(const PrefabComponent& prefabComponent, const std::vector<Entity>& entities,
+	  const std::vector<Vec2f>& positions)
+  {
+	  (void) positions;
+	  auto componentJson = prefabComponent.componentJson;
+	  for (Entity entity : entities)
+	  {
+		  CreateComponent(componentJson, entity);
+	  }
+  }
+  virtual void DestroyComponent(Entity entity) = 0;
 };
 
+const size_t INVALID_COMPONENT_INDEX = std::numeric_limits<size_t>::max();
+
 template<typename T, ComponentType componentType>
 class ComponentManager:
     public System,
@@ -79,8 +134,12 @@ class ComponentManager:
 {
  protected:
   EntityManager* m_EntityManager = nullptr;
-  std::vector<T> m_Components;
+  ComponentPool<T> m_Components;
   std::vector<Entity> m_ConcernedEntities;
+  /**
+   * \brief Position of entity-1 in m_ConcernedEntities, INVALID_COMPONENT_INDEX when not concerned
+   */
+  std::vector<size_t> m_ConcernedIndex;
  public:
   ComponentManager(Engine& engine) : System(engine) {}
   ComponentManager(const ComponentManager&) = delete;
@@ -88,6 +147,16 @@ class ComponentManager:
 
   virtual T* AddComponent(Entity entity) = 0;
   virtual void DestroyComponent(Entity entity) = 0;
+  /**
+   * \brief Batched destruction, override it when the manager can do better than one DestroyComponent per entity
+   */
+  virtual void DestroyComponents(const std::vector<Entity>& entities)
+  {
+	  for (Entity entity : entities)
+	  {
+		  DestroyComponent(entity);
+	  }
+  }
 
   void Init() override
   {
@@ -104,7 +173,7 @@ class ComponentManager:
 
   virtual T* GetComponentPtr(Entity entity) = 0;
 
-  std::vector<T>& GetComponents()
+  ComponentPool<T>& GetComponents()
   {
     return m_Components;
   }
@@ -114,19 +183,76 @@ class ComponentManager:
 	  return m_ConcernedEntities;
   }
 
-  virtual void OnDestroy(Entity entity) override { (void) entity; }
+  virtual void OnDestroy(Entity entity) override
+  {
+	  if (componentType != ComponentType::NONE && m_EntityManager->HasComponent(entity, componentType))
+	  {
+		  DestroyComponent(entity);
+	  }
+  }
 
-void RemoveConcernedEntity(Entity entity)
- {
-	for (int i = 0U; i < m_ConcernedEntities.size(); i++)
-	{
-		if (m_ConcernedEntities[i] == entity)
-		{
-			m_ConcernedEntities.erase(m_ConcernedEntities.begin() + i);
-			return;
-		}
-	}
- }
+  virtual void OnDestroyEntities(const std::vector<Entity>& entities) override
+  {
+	  if (componentType == ComponentType::NONE)
+		  return;
+	  std::vector<Entity> concernedEntities;
+	  concernedEntities.reserve(entities.size());
+	  for (Entity entity : entities)
+	  {
+		  if (m_EntityManager->HasComponent(entity, componentType))
+			  concernedEntities.push_back(entity);
+	  }
+	  if (!concernedEntities.empty())
+	  {
+		  DestroyComponents(concernedEntities);
+	  }
+  }
+
+  bool IsConcernedEntity(Entity entity) const
+  {
+	  return entity != INVALID_ENTITY && entity <= m_ConcernedIndex.size() &&
+		  m_ConcernedIndex[entity - 1] != INVALID_COMPONENT_INDEX;
+  }
+
+  void AddConcernedEntity(Entity entity)
+  {
+	  if (entity == INVALID_ENTITY || IsConcernedEntity(entity))
+		  return;
+	  if (entity > m_ConcernedIndex.size())
+	  {
+		  m_ConcernedIndex.resize(entity, INVALID_COMPONENT_INDEX);
+	  }
+	  m_ConcernedIndex[entity - 1] = m_ConcernedEntities.size();
+	  m_ConcernedEntities.push_back(entity);
+  }
+
+  /**
+   * \brief Swap-and-pop removal, the order of m_ConcernedEntities is not kept
+   */
+  void RemoveConcernedEntity(Entity entity)
+  {
+	  if (!IsConcernedEntity(entity))
+		  return;
+	  const size_t index = m_ConcernedIndex[entity - 1];
+	  const Entity lastEntity = m_ConcernedEntities.back();
+	  m_ConcernedEntities[index] = lastEntity;
+	  m_ConcernedIndex[lastEntity - 1] = index;
+	  m_ConcernedEntities.pop_back();
+	  m_ConcernedIndex[entity - 1] = INVALID_COMPONENT_INDEX;
+  }
+
+  void ClearConcernedEntities()
+  {
+	  m_ConcernedEntities.clear();
+	  std::fill(m_ConcernedIndex.begin(), m_ConcernedIndex.end(), INVALID_COMPONENT_INDEX);
+  }
+
+  void ReportMemory(MemoryReport& report) const override
+  {
+	  report.AddContainer("Components", m_Components);
+	  report.AddContainer("ConcernedEntities", m_ConcernedEntities);
+	  report.AddContainer("ConcernedIndex", m_ConcernedIndex);
+  }
 };
 
 
@@ -140,9 +266,17 @@ public:
 
 	}
 
+	const LazyComponentPool<TInfo>& GetComponentsInfo() const
+	{
+		return m_ComponentsInfo;
+	}
 
 protected:
-	std::vector<TInfo> m_ComponentsInfo;
+	/**
+	 * \brief Editor data, only the chunks of the slots written to or inspected are allocated.
+	 * Adding a component does not touch it, the managers link an info to its component on first access
+	 */
+	LazyComponentPool<TInfo> m_ComponentsInfo;
 	ComponentType m_ComponentType;
 };
 
@@ -155,16 +289,6 @@ public:
     BasicComponentManager(Engine& engine) : ComponentManager<T, componentType>(engine), ComponentInfoManager<TInfo>(componentType)
     {
 
-    }
-    virtual void DrawOnInspector(Entity entity) override
-    {
-		for (auto &info : ComponentInfoManager<TInfo>::m_ComponentsInfo)
-		{
-			if (ComponentManager<T, componentType>::m_EntityManager->HasComponent(entity, componentType) && info.GetEntity() == entity)
-			{
-				info.DrawOnInspector();
-			}
-		}
     }
     virtual void Init() override
     {
@@ -172,6 +296,11 @@ public:
 		ComponentManager<T, componentType>::m_Engine.GetEditor()->AddDrawableObserver(this);
 		ComponentManager<T, componentType>::m_Engine.GetSceneManager()->AddComponentManager(this, componentType);
 	}
+	void ReportMemory(MemoryReport& report) const override
+	{
+		ComponentManager<T, componentType>::ReportMemory(report);
+		report.AddContainer("ComponentsInfo", ComponentInfoManager<TInfo>::m_ComponentsInfo);
+	}
 
 protected:
 	virtual int GetFreeComponentIndex() = 0;
@@ -185,13 +314,8 @@ class SingleComponentManager :
 public:
 	SingleComponentManager(Engine& engine):BasicComponentManager<T,TInfo, componentType>(engine)
 	{
-		BasicComponentManager<T,TInfo, componentType>::m_Components = std::vector<T>( INIT_ENTITY_NMB );
-        BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo = std::vector<TInfo>( INIT_ENTITY_NMB );
-        
-		for(int i = 0; i < INIT_ENTITY_NMB;i++)
-        {
-			BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo[i].SetEntity(i+1);
-        }
+		BasicComponentManager<T,TInfo, componentType>::m_Components.resize(INIT_ENTITY_NMB);
+		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo.resize(INIT_ENTITY_NMB);
 	}
 
 	virtual void Init() override
@@ -211,7 +335,19 @@ public:
 		{
 			Log::GetInstance()->Error("Trying to get component from INVALID_ENTITY");
 		}
-		return BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo[entity - 1];
+		//The info slot is allocated and linked to its entity on first access
+		auto& info = BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo[entity - 1];
+		info.SetEntity(entity);
+		LinkComponentInfo(entity - 1);
+		return info;
+	}
+
+	void DrawOnInspector(Entity entity) override
+	{
+		if (BasicComponentManager<T,TInfo, componentType>::m_EntityManager->HasComponent(entity, componentType))
+		{
+			GetComponentInfo(entity).DrawOnInspector();
+		}
 	}
 
 	virtual T* GetComponentPtr(Entity entity) override
@@ -233,22 +369,244 @@ public:
 		return BasicComponentManager<T,TInfo, componentType>::m_Components[entity - 1];
 	}
 
+	/**
+	 * \brief Only the new chunks are allocated, existing components keep their address
+	 */
 	void OnResize(size_t newSize) override
 	{
 		BasicComponentManager<T,TInfo, componentType>::m_Components.resize(newSize);
 		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo.resize(newSize);
+	}
+protected:
+	/**
+	 * \brief Called by GetComponentInfo, used to set the info back-pointer to m_Components[index]
+	 */
+	virtual void LinkComponentInfo(size_t index) { (void) index; }
+
+	virtual int GetFreeComponentIndex() override { return 0; };
+};
+
+/**
+ * \brief Sparse-set storage, m_ConcernedEntities[i] owns m_Components[i] and m_SparseIndex maps entity-1 to i.
+ * Removal moves the last component in the hole, so Update only walks the live components. The dense order changes
+ * with each removal, what must keep its order, like the drawing, goes through GetStableOrder
+ */
+template<class T, class TInfo, ComponentType componentType>
+class PackedComponentManager :
+		public BasicComponentManager<T, TInfo, componentType>,
+		public ResizeObserver
+{
+public:
+	PackedComponentManager(Engine& engine) : BasicComponentManager<T, TInfo, componentType>(engine)
+	{
+		m_SparseIndex = std::vector<size_t>(INIT_ENTITY_NMB, INVALID_COMPONENT_INDEX);
+	}
+
+	virtual void Init() override
+	{
+		BasicComponentManager<T, TInfo, componentType>::Init();
+		BasicComponentManager<T, TInfo, componentType>::m_EntityManager->AddResizeObserver(this);
+	}
 
-		for (size_t i = 0; i < newSize; i++)
+	virtual ~PackedComponentManager()
+	{
+	}
+
+	bool HasComponentIndex(Entity entity) const
+	{
+		return entity != INVALID_ENTITY && entity <= m_SparseIndex.size() &&
+			m_SparseIndex[entity - 1] != INVALID_COMPONENT_INDEX;
+	}
+
+	TInfo& GetComponentInfo(Entity entity)
+	{
+		//Linked on access, the infos are neither written by EmplacePackedComponent nor relinked by a removal
+		const auto index = GetComponentIndex(entity);
+		auto& info = BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo[index];
+		info.SetEntity(entity);
+		LinkComponentInfo(index);
+		return info;
+	}
+
+	virtual T* GetComponentPtr(Entity entity) override
+	{
+		if (!HasComponentIndex(entity))
+		{
+			return nullptr;
+		}
+		return &BasicComponentManager<T, TInfo, componentType>::m_Components[m_SparseIndex[entity - 1]];
+	}
+
+	T& GetComponentRef(Entity entity)
+	{
+		return BasicComponentManager<T, TInfo, componentType>::m_Components[GetComponentIndex(entity)];
+	}
+
+	virtual void DrawOnInspector(Entity entity) override
+	{
+		if (HasComponentIndex(entity))
+		{
+			GetComponentInfo(entity).DrawOnInspector();
+		}
+	}
+
+	void OnResize(size_t newSize) override
+	{
+		m_SparseIndex.resize(newSize, INVALID_COMPONENT_INDEX);
+	}
+
+	void Clear() override
+	{
+		BasicComponentManager<T, TInfo, componentType>::m_Components.clear();
+		BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo.clear();
+		BasicComponentManager<T, TInfo, componentType>::m_ConcernedEntities.clear();
+		std::fill(m_SparseIndex.begin(), m_SparseIndex.end(), INVALID_COMPONENT_INDEX);
+		m_DenseVersion++;
+	}
+
+	/**
+	 * \brief Dense indices sorted by the key of their component, e.g. its layer, then by entity. Rebuilt after an
+	 * addition or a removal, sorted again when a key changed, otherwise it only costs the check of the order
+	 */
+	template<class TKeyOf>
+	const std::vector<size_t>& GetStableOrder(TKeyOf keyOf)
+	{
+		auto& components = BasicComponentManager<T, TInfo, componentType>::m_Components;
+		auto& concernedEntities = BasicComponentManager<T, TInfo, componentType>::m_ConcernedEntities;
+		const auto less = [&](size_t index1, size_t index2)
+		{
+			const auto key1 = keyOf(components[index1]);
+			const auto key2 = keyOf(components[index2]);
+			if (key1 != key2)
+				return key1 < key2;
+			return concernedEntities[index1] < concernedEntities[index2];
+		};
+		if (m_StableOrderVersion != m_DenseVersion)
 		{
-			BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo[i].SetEntity(i + 1);
+			m_StableOrder.resize(components.size());
+			std::iota(m_StableOrder.begin(), m_StableOrder.end(), size_t(0));
+			std::sort(m_StableOrder.begin(), m_StableOrder.end(), less);
+			m_StableOrderVersion = m_DenseVersion;
 		}
+		else if (!std::is_sorted(m_StableOrder.begin(), m_StableOrder.end(), less))
+		{
+			std::sort(m_StableOrder.begin(), m_StableOrder.end(), less);
+		}
+		return m_StableOrder;
 	}
+
+	void ReportMemory(MemoryReport& report) const override
+	{
+		BasicComponentManager<T, TInfo, componentType>::ReportMemory(report);
+		report.AddContainer("SparseIndex", m_SparseIndex);
+	}
+
 protected:
-	virtual int GetFreeComponentIndex() override { return 0; };
+	size_t GetComponentIndex(Entity entity)
+	{
+		if (entity == INVALID_ENTITY)
+		{
+			Log::GetInstance()->Error("Trying to get component from INVALID_ENTITY");
+		}
+		else if (!HasComponentIndex(entity))
+		{
+			std::ostringstream oss;
+			oss << "Trying to get a missing component from entity: " << entity;
+			Log::GetInstance()->Error(oss.str());
+		}
+		return m_SparseIndex[entity - 1];
+	}
+
+	/**
+	 * \brief Append a default component for the entity, or return the existing one
+	 */
+	T* EmplacePackedComponent(Entity entity)
+	{
+		if (entity == INVALID_ENTITY)
+		{
+			Log::GetInstance()->Error("Trying to add component to INVALID_ENTITY");
+			return nullptr;
+		}
+		if (entity > m_SparseIndex.size())
+		{
+			m_SparseIndex.resize(entity, INVALID_COMPONENT_INDEX);
+		}
+		if (m_SparseIndex[entity - 1] != INVALID_COMPONENT_INDEX)
+		{
+			return &BasicComponentManager<T, TInfo, componentType>::m_Components[m_SparseIndex[entity - 1]];
+		}
+		auto& components = BasicComponentManager<T, TInfo, componentType>::m_Components;
+		auto& componentsInfo = BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo;
+		const size_t index = components.size();
+
+		components.emplace_back();
+		//Growing the info pool allocates no chunk
+		componentsInfo.resize(index + 1);
+		BasicComponentManager<T, TInfo, componentType>::m_ConcernedEntities.push_back(entity);
+		m_SparseIndex[entity - 1] = index;
+		m_DenseVersion++;
+		return &components[index];
+	}
+
+	/**
+	 * \brief Swap-and-pop removal, returns false if the entity did not own a component
+	 */
+	bool RemovePackedComponent(Entity entity)
+	{
+		if (!HasComponentIndex(entity))
+		{
+			return false;
+		}
+		auto& components = BasicComponentManager<T, TInfo, componentType>::m_Components;
+		auto& componentsInfo = BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo;
+		auto& concernedEntities = BasicComponentManager<T, TInfo, componentType>::m_ConcernedEntities;
+
+		const size_t index = m_SparseIndex[entity - 1];
+		const size_t lastIndex = components.size() - 1;
+		if (index != lastIndex)
+		{
+			const Entity lastEntity = concernedEntities[lastIndex];
+			components[index] = std::move(components[lastIndex]);
+			if (componentsInfo.IsAllocated(lastIndex))
+			{
+				componentsInfo[index] = std::move(componentsInfo[lastIndex]);
+			}
+			else if (componentsInfo.IsAllocated(index))
+			{
+				componentsInfo[index] = TInfo();
+			}
+			concernedEntities[index] = lastEntity;
+			m_SparseIndex[lastEntity - 1] = index;
+		}
+		components.pop_back();
+		componentsInfo.pop_back();
+		concernedEntities.pop_back();
+		m_SparseIndex[entity - 1] = INVALID_COMPONENT_INDEX;
+		m_DenseVersion++;
+		return true;
+	}
+
+	/**
+	 * \brief Called by GetComponentInfo, used to set the info back-pointer to m_Components[index]
+	 */
+	virtual void LinkComponentInfo(size_t index) { (void) index; }
+
+	virtual int GetFreeComponentIndex() override
+	{
+		return static_cast<int>(BasicComponentManager<T, TInfo, componentType>::m_Components.size());
+	}
+
+	std::vector<size_t> m_SparseIndex;
+	/**
+	 * \brief Changed by each addition and removal, the stable order is rebuilt when it differs
+	 */
+	size_t m_DenseVersion = 0;
+	size_t m_StableOrderVersion = std::numeric_limits<size_t>::max();
+	std::vector<size_t> m_StableOrder;
 };
 
 template<class T, class TInfo, ComponentType componentType>
-class MultipleComponentManager : 
+class MultipleComponentManager :
 	public BasicComponentManager<T,TInfo, componentType>,
 	public ResizeObserver
 {
@@ -256,13 +614,8 @@ class MultipleComponentManager :
  public:
 	MultipleComponentManager(Engine& engine): BasicComponentManager<T,TInfo, componentType>(engine)
 	{
-		BasicComponentManager<T,TInfo, componentType>::m_Components = std::vector<T>( INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER );
-		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo = std::vector<TInfo>( INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER );
-
-		for (int i = 0; i < INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER; i++)
-		{
-			BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo[i].SetEntity((i/MULTIPLE_COMPONENTS_MULTIPLIER) + 1);
-		}
+		BasicComponentManager<T,TInfo, componentType>::m_Components.resize(INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER);
+		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo.resize(INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER);
 	}
 
 	void Init() override
@@ -272,15 +625,13 @@ class MultipleComponentManager :
 		BasicComponentManager<T,TInfo, componentType>::m_EntityManager->AddResizeObserver(this);
     }
 
+    /**
+     * \brief Keeps the existing components and their address, only the new slots are default constructed
+     */
     virtual void OnResize(size_t newSize) override
     {
-		BasicComponentManager<T,TInfo, componentType>::m_Components = std::vector<T>( newSize * MULTIPLE_COMPONENTS_MULTIPLIER);
-		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo = std::vector<TInfo>( newSize * MULTIPLE_COMPONENTS_MULTIPLIER );
-
-		for (int i = 0; i < newSize * MULTIPLE_COMPONENTS_MULTIPLIER; i++)
-		{
-		  BasicComponentManager<T, TInfo, componentType>::m_ComponentsInfo[i].SetEntity((i / MULTIPLE_COMPONENTS_MULTIPLIER) + 1);
-		}
+		BasicComponentManager<T,TInfo, componentType>::m_Components.resize(newSize * MULTIPLE_COMPONENTS_MULTIPLIER);
+		BasicComponentManager<T,TInfo, componentType>::m_ComponentsInfo.resize(newSize * MULTIPLE_COMPONENTS_MULTIPLIER);
     }
 };
 
@@ -322,6 +673,9 @@ protected:
 	> m_LayerComponents{LayerComponent::LayerCompare};
 };
 
+using TransformVersion = std::uint32_t;
+const TransformVersion INVALID_TRANSFORM_VERSION = std::numeric_limits<TransformVersion>::max();
+
 class Offsetable
 {
 public:
@@ -329,8 +683,18 @@ public:
 	Offsetable(sf::Vector2f offset);
 	Vec2f GetOffset() const;
 	virtual void SetOffset(sf::Vector2f offset);
+	/**
+	 * \brief Returns true if the transform version differs from the last synced one and records it,
+	 * the owner only pushes the transform to SFML when it returns true
+	 */
+	bool SyncTransformVersion(TransformVersion transformVersion);
+	/**
+	 * \brief Force the next sync, e.g. when the offset or the drawable changed
+	 */
+	void InvalidateTransformVersion();
 protected:
 	Vec2f m_Offset;
+	TransformVersion m_SyncedTransformVersion = INVALID_TRANSFORM_VERSION;
 };
 
 }
@@ -0,0 +1,296 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_COMPONENT_POOL_H
+#define SFGE_COMPONENT_POOL_H
+
+#include <new>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+namespace sfge
+{
+
+/**
+ * \brief Number of components per chunk, a power of two so the chunk lookup is a shift and a mask
+ */
+const size_t COMPONENT_CHUNK_SHIFT = 10;
+const size_t COMPONENT_CHUNK_SIZE = size_t(1) << COMPONENT_CHUNK_SHIFT;
+
+/**
+ * \brief Paged component storage with the std::vector interface used by the managers. Components live in fixed-size
+ * chunks allocated on demand: growing only allocates the new chunks, never moves the existing components,
+ * so pointers to them (Info back-pointers, extension caches) stay valid until the component is removed.
+ */
+template<class T>
+class ComponentPool
+{
+public:
+	template<bool isConst>
+	class BaseIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<isConst, const T*, T*>;
+		using reference = std::conditional_t<isConst, const T&, T&>;
+		using PoolPtr = std::conditional_t<isConst, const ComponentPool*, ComponentPool*>;
+
+		BaseIterator(PoolPtr pool, size_t index) : m_Pool(pool), m_Index(index) {}
+
+		reference operator*() const { return (*m_Pool)[m_Index]; }
+		pointer operator->() const { return &(*m_Pool)[m_Index]; }
+		BaseIterator& operator++() { m_Index++; return *this; }
+		BaseIterator operator++(int) { BaseIterator tmp = *this; m_Index++; return tmp; }
+		bool operator==(const BaseIterator& other) const { return m_Index == other.m_Index; }
+		bool operator!=(const BaseIterator& other) const { return m_Index != other.m_Index; }
+	private:
+		PoolPtr m_Pool;
+		size_t m_Index;
+	};
+	using iterator = BaseIterator<false>;
+	using const_iterator = BaseIterator<true>;
+
+	ComponentPool() = default;
+	explicit ComponentPool(size_t size)
+	{
+		resize(size);
+	}
+	ComponentPool(const ComponentPool&) = delete;
+	ComponentPool& operator=(const ComponentPool&) = delete;
+	ComponentPool(ComponentPool&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+	ComponentPool& operator=(ComponentPool&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_Chunks = std::move(other.m_Chunks);
+			m_Size = other.m_Size;
+			other.m_Chunks.clear();
+			other.m_Size = 0;
+		}
+		return *this;
+	}
+	~ComponentPool()
+	{
+		Release();
+	}
+
+	T& operator[](size_t index)
+	{
+		return m_Chunks[index >> COMPONENT_CHUNK_SHIFT][index & (COMPONENT_CHUNK_SIZE - 1)];
+	}
+	const T& operator[](size_t index) const
+	{
+		return m_Chunks[index >> COMPONENT_CHUNK_SHIFT][index & (COMPONENT_CHUNK_SIZE - 1)];
+	}
+
+	size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+	size_t capacity() const { return m_Chunks.size() * COMPONENT_CHUNK_SIZE; }
+	T& back() { return (*this)[m_Size - 1]; }
+	const T& back() const { return (*this)[m_Size - 1]; }
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, m_Size); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, m_Size); }
+
+	/**
+	 * \brief Allocate the chunks needed for newCapacity components, the existing ones are not touched
+	 */
+	void reserve(size_t newCapacity)
+	{
+		while (capacity() < newCapacity)
+		{
+			m_Chunks.push_back(std::allocator<T>().allocate(COMPONENT_CHUNK_SIZE));
+		}
+	}
+
+	/**
+	 * \brief Default construct or destroy the components at the end, growing costs O(new components)
+	 */
+	void resize(size_t newSize)
+	{
+		reserve(newSize);
+		while (m_Size < newSize)
+		{
+			new (&(*this)[m_Size]) T();
+			m_Size++;
+		}
+		while (m_Size > newSize)
+		{
+			pop_back();
+		}
+	}
+
+	template<class... Args>
+	T& emplace_back(Args&&... args)
+	{
+		reserve(m_Size + 1);
+		T* component = new (&(*this)[m_Size]) T(std::forward<Args>(args)...);
+		m_Size++;
+		return *component;
+	}
+
+	void push_back(T&& component)
+	{
+		emplace_back(std::move(component));
+	}
+
+	void pop_back()
+	{
+		m_Size--;
+		(*this)[m_Size].~T();
+	}
+
+	/**
+	 * \brief Destroy the components but keep the chunks for the next resize
+	 */
+	void clear()
+	{
+		while (m_Size > 0)
+		{
+			pop_back();
+		}
+	}
+
+private:
+	void Release()
+	{
+		clear();
+		for (T* chunk : m_Chunks)
+		{
+			std::allocator<T>().deallocate(chunk, COMPONENT_CHUNK_SIZE);
+		}
+		m_Chunks.clear();
+	}
+
+	std::vector<T*> m_Chunks;
+	size_t m_Size = 0;
+};
+
+/**
+ * \brief Paged storage whose chunks are only allocated on the first write access, used for the editor infos:
+ * resizing never allocates and a chunk of infos exists only if one of its slots was touched
+ */
+template<class T>
+class LazyComponentPool
+{
+public:
+	T& operator[](size_t index)
+	{
+		auto& chunk = m_Chunks[index >> COMPONENT_CHUNK_SHIFT];
+		if (chunk == nullptr)
+		{
+			chunk = std::make_unique<T[]>(COMPONENT_CHUNK_SIZE);
+		}
+		return chunk[index & (COMPONENT_CHUNK_SIZE - 1)];
+	}
+
+	bool IsAllocated(size_t index) const
+	{
+		return index < m_Size && m_Chunks[index >> COMPONENT_CHUNK_SHIFT] != nullptr;
+	}
+
+	size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+	T& back() { return (*this)[m_Size - 1]; }
+
+	/**
+	 * \brief Only the chunk table grows, the released chunks past the new size are freed
+	 */
+	void resize(size_t newSize)
+	{
+		m_Chunks.resize((newSize + COMPONENT_CHUNK_SIZE - 1) >> COMPONENT_CHUNK_SHIFT);
+		for (size_t index = newSize; index < m_Size && index < capacity(); index++)
+		{
+			ResetSlot(index);
+		}
+		m_Size = newSize;
+	}
+
+	size_t capacity() const { return m_Chunks.size() * COMPONENT_CHUNK_SIZE; }
+
+	/**
+	 * \brief Number of chunks actually allocated
+	 */
+	size_t GetAllocatedChunkNmb() const
+	{
+		size_t chunkNmb = 0;
+		for (const auto& chunk : m_Chunks)
+		{
+			if (chunk != nullptr)
+				chunkNmb++;
+		}
+		return chunkNmb;
+	}
+
+	template<class... Args>
+	T& emplace_back(Args&&... args)
+	{
+		resize(m_Size + 1);
+		auto& slot = (*this)[m_Size - 1];
+		slot.~T();
+		return *new (&slot) T(std::forward<Args>(args)...);
+	}
+
+	void pop_back()
+	{
+		resize(m_Size - 1);
+	}
+
+	void clear()
+	{
+		m_Chunks.clear();
+		m_Size = 0;
+	}
+
+private:
+	void ResetSlot(size_t index)
+	{
+		if (m_Chunks[index >> COMPONENT_CHUNK_SHIFT] != nullptr)
+		{
+			//Rebuilt in place, some infos hold const members and cannot be assigned
+			auto& slot = (*this)[index];
+			slot.~T();
+			new (&slot) T();
+		}
+	}
+
+	std::vector<std::unique_ptr<T[]>> m_Chunks;
+	size_t m_Size = 0;
+};
+
+}
+
+#endif
@@ -63,12 +63,45 @@ struct Configuration
 	 */
 	unsigned int maxFramerate = 60;
 	float fixedDeltaTime = 0.02f;
+	/**
+	 * \brief Fixed steps run at most per frame to catch up, the time past it is dropped
+	 */
+	unsigned int maxFixedSteps = 5;
+	/**
+	 * \brief Render the physics bodies between their last two fixed step states
+	 */
+	bool fixedStepInterpolation = true;
+	/**
+	 * \brief Draw a snapshot of the tilemaps, sprites, animations and shapes of frame N while the next frame is simulated.
+	 * The UI and the python Draw are drawn over it after the simulation. It is ignored when the editor is enabled.
+	 * The simulation never touches the window: it reads the copies of Graphics2dManager::GetView and of the mouse
+	 * position, and the synchronous scene loads it requests wait for the main thread, see SceneManager::LoadSceneFromName.
+	 * The textures of the snapshot are pinned, see TextureManager::PinTextures
+	 */
+	bool pipelinedRendering = false;
+	/**
+	 * \brief Record the duration of every system in the SystemProfiler, can be toggled in the profiler window
+	 */
+	bool systemProfiling = false;
+	/**
+	 * \brief Chrome trace_event file written at exit with the last profiled samples, none when empty
+	 */
+	std::string profilerTracePath;
+	/**
+	 * \brief Tune the budgets of the degradable workloads to hold maxFramerate, see FrameBudget
+	 */
+	bool adaptiveFrameBudget = true;
 	int velocityIterations = 8;
 	int positionIterations = 2;
 	size_t currentEntitiesNmb = INIT_ENTITY_NMB;
 	
 	std::string scriptsDirname = "scripts/";
 	std::string dataDirname = "data/";
+	/**
+	 * \brief Manifest of the scene names found in dataDirname, only the changed scenes are read again at start.
+	 * None is written when empty
+	 */
+	std::string sceneIndexPath = "scene_index.json";
 	/**
 	* \brief Used to load the overall Configuration of the GameEngine at start
 	*/
@@ -29,10 +29,14 @@ SOFTWARE.
 
 #include <memory>
 #include <string>
-#include <ctpl_stl.h>
+#include <engine/job_system.h>
+#include <engine/system_graph.h>
+#include <engine/frame_allocator.h>
+#include <engine/frame_budget.h>
 
 #include <engine/config.h>
 #include <utility/json_utility.h>
+#include <utility/time_utility.h>
 
 #include <editor/profiler.h>
 #include <Remotery.h>
@@ -61,6 +65,7 @@ class RectTransformManager;
 class UIManager;
 class Editor;
 struct SystemsContainer;
+class MemoryReport;
 
 /* Paths to the folders used for save */
 const std::string DATA_FOLDER = "./data/";
@@ -85,6 +90,10 @@ public:
 	* \brief Starting the Game Engine after the Init()
 	*/
 	void Start();
+	/**
+	 * \brief Run one frame of dt without polling nor drawing the window, used by the headless benchmark
+	 */
+	void Step(float dt);
 
 	/**
 	 * \brief Destroy all the modules
@@ -121,16 +130,55 @@ public:
 	UIManager* GetUIManager();
 	Editor* GetEditor();
 
-	ctpl::thread_pool& GetThreadPool();
+	/**
+	 * \brief Work-stealing scheduler shared by every System, see JobSystem::ParallelFor
+	 */
+	JobSystem& GetJobSystem();
+	/**
+	 * \brief Systems run by Start for each frame phase, ordered by their component accesses
+	 */
+	SystemGraph& GetSystemGraph();
+	/**
+	 * \brief Per-system timings of the last frames, exported as a Chrome trace
+	 */
+	SystemProfiler& GetSystemProfiler();
+	/**
+	 * \brief Arena of the calling JobSystem thread, reset at the end of each frame.
+	 * Only the main thread and the job threads may allocate from it, any other thread gets nullptr
+	 */
+	FrameArena* GetFrameArena();
+	/**
+	 * \brief Microseconds given to the degradable workloads, tuned from the frame times
+	 */
+	FrameBudget& GetFrameBudget();
+	/**
+	 * \brief Bytes used and allocated by the containers of every system, with their external resources
+	 */
+	void ReportMemory(MemoryReport& report) const;
 	ProfilerFrameData& GetProfilerFrameData();
 	bool running = false;
 protected:
 	void InitModules();
-	ctpl::thread_pool m_ThreadPool;
+	void BuildSystemGraph();
+	/**
+	 * \brief Fixed steps, update and render preparation of one frame
+	 */
+	void Simulate(float dt);
+	/**
+	 * \brief Called when no job runs anymore, at the end of the frame
+	 */
+	void ResetFrameArenas();
+	JobSystem m_JobSystem;
+	SystemGraph m_SystemGraph;
+	SystemProfiler m_SystemProfiler;
+	std::vector<std::unique_ptr<FrameArena>> m_FrameArenas;
+	FrameBudget m_FrameBudget;
+	bool m_PipelinedRendering = false;
 	sf::RenderWindow* m_Window = nullptr;
 	std::unique_ptr<Configuration> m_Config;
 
-	Remotery* rmt;
+	FixedTimestep m_FixedTimestep{0.02f, 5};
+	Remotery* rmt = nullptr;
 	std::unique_ptr<SystemsContainer> m_SystemsContainer;
 
   	ProfilerFrameData m_FrameData;
@@ -27,15 +27,24 @@ SOFTWARE.
 
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 #include <engine/system.h>
 #include <editor/editor_info.h>
 #include <engine/globals.h>
+#include <engine/entity_view.h>
+#include <engine/entity_command.h>
 
 namespace sfge
 {
 enum class ComponentType : int;
 
+/**
+ * \brief Maps a component class to its ComponentType, specialized next to each component
+ */
+template<class T>
+struct ComponentTypeOf;
+
 class ResizeObserver
 {
 public:
@@ -46,6 +55,13 @@ class DestroyObserver
 {
 public:
 	virtual void OnDestroy(Entity entity) = 0;
+	virtual void OnDestroyEntities(const std::vector<Entity>& entities)
+	{
+		for (Entity entity : entities)
+		{
+			OnDestroy(entity);
+		}
+	}
 };
 /**
  * \brief Entity index number, starting from 1U
@@ -53,6 +69,19 @@ public:
 
 using EntityMask = int;
 
+/**
+ * \brief Contiguous block of entities returned by EntityManager::CreateEntities
+ */
+struct EntityRange
+{
+	Entity first = INVALID_ENTITY;
+	size_t count = 0;
+
+	Entity operator[](size_t index) const { return first + static_cast<Entity>(index); }
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+};
+
 namespace editor
 {
 
@@ -72,22 +101,94 @@ public:
 	void Clear() override;
 
 	EntityMask GetMask(Entity entity);
+	/**
+	 * \brief Pop a free entity from the free list, or reserve wantedEntity if it is free.
+	 * Returns INVALID_ENTITY when there is no room left, the caller is expected to ResizeEntityNmb
+	 */
 	Entity CreateEntity(Entity wantedEntity);
+	/**
+	 * \brief Reserve count contiguous entities, the lowest free run that fits or after the last alive entity,
+	 * growing the arrays if needed. A single entity comes from the free list
+	 */
+	EntityRange CreateEntities(size_t count);
+	/**
+	 * \brief Make room for a following CreateEntities(count), the arrays grow at least twice so that
+	 * repeated small batches like the prefab spawns do not resize every component manager each time
+	 */
+	void ReserveEntities(size_t count);
 	void DestroyEntity(Entity entity);
+	/**
+	 * \brief Destroy a batch of entities, each observer is notified once with the whole batch
+	 */
+	void DestroyEntities(const std::vector<Entity>& entities);
+	bool IsAlive(Entity entity) const;
+	EntityHandle GetEntityHandle(Entity entity) const;
+	/**
+	 * \brief Returns INVALID_ENTITY if the entity was destroyed since the handle was taken
+	 */
+	Entity GetEntityFromHandle(EntityHandle handle) const;
 	bool HasComponent(Entity entity, ComponentType componentType);
 	void AddComponentType(Entity entity, ComponentType componentType);
 	void RemoveComponentType(Entity entity, ComponentType componentType);
+	/**
+	 * \brief Created on first access, the default name "Entity: N" is generated then
+	 */
 	editor::EntityInfo& GetEntityInfo(Entity entity);
 
+	/**
+	 * \brief Entities owning every component type of the mask, e.g. for (Entity entity : View(mask))
+	 */
+	EntityView View(EntityMask mask) const;
+	template<class... TComponents>
+	EntityView View() const
+	{
+		return View((static_cast<EntityMask>(ComponentTypeOf<TComponents>::value) | ...));
+	}
+	EntityView GetAliveEntities() const;
+
+	/**
+	 * \brief Command buffer of the calling JobSystem thread, only the main thread and the job threads may record,
+	 * any other thread gets nullptr. Structural changes recorded during a parallel phase are applied by PlaybackCommands
+	 */
+	EntityCommandBuffer* GetCommandBuffer();
+	/**
+	 * \brief Sync point: apply every recorded command in one batch sorted by component type and entity.
+	 * Within the batch, creations come first, then component additions and removals in recording order, then destructions
+	 */
+	void PlaybackCommands();
+
 	void ResizeEntityNmb(size_t newSize);
+	void ReportMemory(MemoryReport& report) const override;
 	void AddResizeObserver(ResizeObserver *resizeObserver);
 	void AddDestroyObserver(DestroyObserver *destroyObserver);
 
 private:
+	void ReserveEntity(Entity entity);
+	/**
+	 * \brief First entity of the lowest run of count free entities, the run may continue past the end of the arrays
+	 */
+	Entity FindFreeRange(size_t count) const;
+	/**
+	 * \brief Rebuild the free list without the stale entries, the lowest entity on top
+	 */
+	void CompactFreeEntities();
+
 	std::vector<EntityMask> m_MaskArray = std::vector<EntityMask>( INIT_ENTITY_NMB );
-	std::vector<editor::EntityInfo> m_EntityInfos = std::vector<editor::EntityInfo>( INIT_ENTITY_NMB );
+	/**
+	 * \brief Allocated on the first GetEntityInfo, so entities nobody inspects or names carry no editor data
+	 */
+	std::unordered_map<Entity, editor::EntityInfo> m_EntityInfos;
+	std::vector<std::uint32_t> m_Generations = std::vector<std::uint32_t>( INIT_ENTITY_NMB );
+	EntityBitset m_AliveEntities{ INIT_ENTITY_NMB };
+	std::array<EntityBitset, EntityView::MAX_BITSET_NMB> m_ComponentBitsets;
+	/**
+	 * \brief Stack of free entities, the lowest on top. Entries reserved through a wanted entity are skipped lazily
+	 */
+	std::vector<Entity> m_FreeEntities;
+	Entity m_HighestEntity = INVALID_ENTITY;
 	std::set<ResizeObserver*> m_ResizeObservers;
 	std::set<DestroyObserver*> m_DestroyObservers;
+	std::vector<EntityCommandBuffer> m_CommandBuffers{ 1 };
 };
 
 /*
@@ -0,0 +1,101 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_ENTITY_COMMAND_H
+#define SFGE_ENTITY_COMMAND_H
+
+#include <vector>
+#include <cstdint>
+
+#include <engine/globals.h>
+#include <utility/json_utility.h>
+
+namespace sfge
+{
+enum class ComponentType : int;
+
+/**
+ * \brief Entities returned by EntityCommandBuffer::CreateEntity carry this bit until the playback gives them a real entity
+ */
+const Entity DEFERRED_ENTITY_FLAG = 1u << 31u;
+
+inline bool IsDeferredEntity(Entity entity)
+{
+	return (entity & DEFERRED_ENTITY_FLAG) != 0U;
+}
+
+/**
+ * \brief Structural change recorded during an update phase, applied by EntityManager::PlaybackCommands
+ */
+struct EntityCommand
+{
+	enum class Type : std::uint8_t
+	{
+		CREATE,
+		ADD_COMPONENT,
+		REMOVE_COMPONENT,
+		DESTROY
+	};
+	Type type = Type::CREATE;
+	Entity entity = INVALID_ENTITY;
+	ComponentType componentType{};
+	size_t jsonIndex = 0;
+	/**
+	 * \brief Recording order, keeps the commands of one entity and component type in order after the sort
+	 */
+	size_t order = 0;
+};
+
+/**
+ * \brief Records entity creation and destruction and component addition and removal without touching the EntityManager.
+ * Each thread writes only to its own buffer (see EntityManager::GetCommandBuffer) so recording needs no lock.
+ */
+class EntityCommandBuffer
+{
+public:
+	/**
+	 * \brief Returns a deferred entity usable in the following commands of this buffer
+	 */
+	Entity CreateEntity();
+	void DestroyEntity(Entity entity);
+	/**
+	 * \brief The component is created from componentJson by its manager, like a scene component
+	 */
+	void AddComponent(Entity entity, ComponentType componentType, json componentJson = json::object());
+	void RemoveComponent(Entity entity, ComponentType componentType);
+
+	bool Empty() const;
+	void Clear();
+
+	std::vector<EntityCommand>& GetCommands();
+	std::vector<json>& GetComponentJsons();
+	size_t GetCreatedEntityNmb() const;
+private:
+	std::vector<EntityCommand> m_Commands;
+	std::vector<json> m_ComponentJsons;
+	size_t m_CreatedEntityNmb = 0;
+};
+}
+
+#endif
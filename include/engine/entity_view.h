@@ -0,0 +1,135 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_ENTITY_VIEW_H
+#define SFGE_ENTITY_VIEW_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <engine/globals.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sfge
+{
+
+inline unsigned CountTrailingZeros(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return index;
+#else
+	return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+inline unsigned PopCount(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+	return static_cast<unsigned>(__popcnt64(bits));
+#else
+	return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+}
+
+/**
+ * \brief Two level bitset of entities (bit entity-1), each summary bit tells if a 64 entities word is non-zero,
+ * so scanning a sparse set skips the empty words 4096 entities at a time
+ */
+class EntityBitset
+{
+public:
+	explicit EntityBitset(size_t entityNmb = 0);
+
+	void Resize(size_t entityNmb);
+	void Clear();
+	void Set(Entity entity);
+	void Reset(Entity entity);
+	bool Test(Entity entity) const;
+	size_t Count() const;
+
+	const std::vector<std::uint64_t>& GetWords() const;
+	const std::vector<std::uint64_t>& GetSummary() const;
+private:
+	std::vector<std::uint64_t> m_Words;
+	std::vector<std::uint64_t> m_Summary;
+	size_t m_Count = 0;
+};
+
+/**
+ * \brief Entities present in every given bitset. The scan is driven by the summary of the smallest bitset
+ * and the other bitsets are only read on its non-empty words, so it costs O(capacity / 4096 + non-empty words)
+ */
+class EntityView
+{
+public:
+	//One per ComponentType bit of the EntityMask
+	static const size_t MAX_BITSET_NMB = 32;
+
+	class Iterator
+	{
+	public:
+		Iterator(const EntityView* view, bool end);
+
+		Entity operator*() const { return m_Current; }
+		Iterator& operator++();
+		bool operator!=(const Iterator& other) const { return m_Current != other.m_Current; }
+		bool operator==(const Iterator& other) const { return m_Current == other.m_Current; }
+	private:
+		void Advance();
+
+		const EntityView* m_View = nullptr;
+		size_t m_SummaryIndex = 0;
+		std::uint64_t m_SummaryBits = 0;
+		size_t m_WordIndex = 0;
+		std::uint64_t m_Bits = 0;
+		Entity m_Current = INVALID_ENTITY;
+	};
+
+	EntityView() = default;
+	void AddBitset(const EntityBitset* bitset);
+
+	Iterator begin() const;
+	Iterator end() const;
+	/**
+	 * \brief Number of matching entities, popcount of the intersected words
+	 */
+	size_t Count() const;
+	bool Empty() const;
+
+private:
+	std::uint64_t GetWord(size_t wordIndex) const;
+
+	std::array<const EntityBitset*, MAX_BITSET_NMB> m_Bitsets{};
+	size_t m_BitsetNmb = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_FRAME_ALLOCATOR_H
+#define SFGE_FRAME_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace sfge
+{
+
+const size_t DEFAULT_FRAME_ARENA_SIZE = 256 * 1024;
+
+/**
+ * \brief Bump allocator for the data living only until the end of the frame. Freeing is a no-op, Reset gives back
+ * everything at once. One arena per JobSystem thread, see Engine::GetFrameArena, so it allocates without lock
+ */
+class FrameArena
+{
+public:
+	explicit FrameArena(size_t blockSize = DEFAULT_FRAME_ARENA_SIZE);
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+	/**
+	 * \brief Called at the end of the frame. When the frame overflowed the first block, the blocks are merged
+	 * into one big enough for it, so the next frames do not go to the heap anymore
+	 */
+	void Reset();
+
+	size_t GetUsedBytes() const;
+	size_t GetCapacity() const;
+	/**
+	 * \brief Allocations since the last Reset
+	 */
+	size_t GetAllocationNmb() const;
+	/**
+	 * \brief Blocks taken from the heap since the creation of the arena
+	 */
+	size_t GetHeapAllocationNmb() const;
+private:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> data;
+		size_t size = 0;
+	};
+	void AddBlock(size_t size);
+
+	std::vector<Block> m_Blocks;
+	size_t m_BlockSize;
+	size_t m_Offset = 0;
+	size_t m_UsedBytes = 0;
+	size_t m_AllocationNmb = 0;
+	size_t m_HeapAllocationNmb = 0;
+};
+
+/**
+ * \brief STL allocator in a FrameArena, the container must not outlive the frame
+ */
+template<class T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	explicit FrameAllocator(FrameArena& arena) : m_Arena(&arena) {}
+	template<class U>
+	FrameAllocator(const FrameAllocator<U>& other) : m_Arena(other.GetArena()) {}
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(m_Arena->Allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T*, size_t) {}
+
+	FrameArena* GetArena() const { return m_Arena; }
+private:
+	FrameArena* m_Arena;
+};
+
+template<class T, class U>
+bool operator==(const FrameAllocator<T>& allocator1, const FrameAllocator<U>& allocator2)
+{
+	return allocator1.GetArena() == allocator2.GetArena();
+}
+
+template<class T, class U>
+bool operator!=(const FrameAllocator<T>& allocator1, const FrameAllocator<U>& allocator2)
+{
+	return !(allocator1 == allocator2);
+}
+
+template<class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_FRAME_BUDGET_H
+#define SFGE_FRAME_BUDGET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <engine/system_profiler.h>
+
+namespace sfge
+{
+
+using BudgetId = size_t;
+
+/**
+ * \brief Time given each frame to a degradable workload, in microseconds
+ */
+struct WorkloadBudget
+{
+	std::string name;
+	std::int64_t minBudget = 0;
+	std::int64_t maxBudget = 0;
+	std::int64_t budget = 0;
+	/**
+	 * \brief Time spent by the workload during the current frame
+	 */
+	std::int64_t used = 0;
+	/**
+	 * \brief Time spent during the last finished frame
+	 */
+	std::int64_t lastUsed = 0;
+};
+
+/**
+ * \brief Budgets of the degradable workloads (pathfinding, behavior tree ticks, off-screen animations, editor panels),
+ * tuned at the end of each frame from the measured frame cost to hold the target frame time.
+ * An overrun shrinks every budget by a quarter, a frame well under the target grows them back step by step.
+ * A workload is measured by one thread at a time, the workloads are registered during Init
+ */
+class FrameBudget
+{
+public:
+	void Init(std::int64_t targetFrameTime);
+	/**
+	 * \brief Disabled, every workload keeps its max budget
+	 */
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const;
+	/**
+	 * \brief Register a workload or get the one of the same name
+	 */
+	BudgetId RegisterWorkload(const std::string& name, std::int64_t minBudget, std::int64_t maxBudget);
+
+	void BeginFrame();
+	/**
+	 * \brief The frame cost is the time the frame worked, without the time waited for the framerate limit
+	 */
+	void EndFrame(std::int64_t frameCost);
+
+	std::int64_t GetBudget(BudgetId id) const;
+	/**
+	 * \brief Microseconds left to the workload in the current frame
+	 */
+	std::int64_t GetRemaining(BudgetId id) const;
+	void AddUsed(BudgetId id, std::int64_t duration);
+
+	std::int64_t GetTargetFrameTime() const;
+	/**
+	 * \brief Moving average of the frame cost
+	 */
+	std::int64_t GetAverageFrameCost() const;
+	/**
+	 * \brief Microseconds since BeginFrame
+	 */
+	std::int64_t GetFrameElapsed() const;
+	const std::vector<WorkloadBudget>& GetWorkloads() const;
+private:
+	std::vector<WorkloadBudget> m_Workloads;
+	std::int64_t m_TargetFrameTime = 16'666;
+	std::int64_t m_AverageFrameCost = 0;
+	ProfilerClock::time_point m_FrameStart = ProfilerClock::now();
+	bool m_Enabled = true;
+};
+
+/**
+ * \brief Measure a workload from its creation to its destruction, the time is added to the workload used time
+ */
+class BudgetTimer
+{
+public:
+	BudgetTimer(FrameBudget& frameBudget, BudgetId id);
+	~BudgetTimer();
+	BudgetTimer(const BudgetTimer&) = delete;
+	BudgetTimer& operator=(const BudgetTimer&) = delete;
+
+	/**
+	 * \brief Microseconds left to the workload, the time of this timer included
+	 */
+	std::int64_t GetRemaining() const;
+	bool HasTimeLeft() const;
+private:
+	std::int64_t GetElapsed() const;
+
+	FrameBudget& m_FrameBudget;
+	BudgetId m_Id;
+	ProfilerClock::time_point m_Start;
+};
+
+/**
+ * \brief Round robin over a workload that does not fit its budget, one cursor per stagger slice,
+ * so the items cut by the budget go first the next time their own slice runs
+ */
+class BudgetCursor
+{
+public:
+	explicit BudgetCursor(size_t sliceNmb = 1) : m_Cursors(std::max<size_t>(sliceNmb, 1), 0) {}
+	/**
+	 * \brief Call function(begin, end) on chunks of the count items of the slice from its cursor,
+	 * until all are done or hasTimeLeft returns false, the first chunk always runs. Return the number of items done
+	 */
+	template<class HasTimeLeft, class Function>
+	size_t Run(size_t slice, size_t count, size_t chunkSize, HasTimeLeft hasTimeLeft, Function function)
+	{
+		if (count == 0)
+			return 0;
+		chunkSize = std::max<size_t>(chunkSize, 1);
+		auto& cursor = m_Cursors[slice % m_Cursors.size()];
+		const auto start = cursor % count;
+		size_t doneNmb = 0;
+		while (doneNmb < count && (doneNmb == 0 || hasTimeLeft()))
+		{
+			const auto begin = (start + doneNmb) % count;
+			const auto chunkNmb = std::min({ chunkSize, count - doneNmb, count - begin });
+			function(begin, begin + chunkNmb);
+			doneNmb += chunkNmb;
+		}
+		cursor = (start + doneNmb) % count;
+		return doneNmb;
+	}
+private:
+	std::vector<size_t> m_Cursors;
+};
+
+}
+
+#endif
@@ -27,6 +27,9 @@
 #ifndef SFGE_GLOBALS_H
 #define SFGE_GLOBALS_H
 
+#include <cstddef>
+#include <cstdint>
+
 
 #define PATH_LIMIT 4096
 #define INIT_ENTITY_NMB 1200
@@ -35,6 +38,25 @@
 
 using Entity = unsigned;
 const Entity INVALID_ENTITY = 0U;
+/**
+ * \brief Generational handle, the low 32 bits are the Entity and the high 32 bits its generation.
+ * Destroying an entity bumps its generation so handles kept from before are detected as stale.
+ */
+using EntityHandle = std::uint64_t;
+const EntityHandle INVALID_ENTITY_HANDLE = 0U;
+
+inline EntityHandle MakeEntityHandle(Entity entity, std::uint32_t generation)
+{
+	return (static_cast<EntityHandle>(generation) << 32U) | entity;
+}
+inline Entity GetHandleEntity(EntityHandle handle)
+{
+	return static_cast<Entity>(handle & 0xFFFFFFFFU);
+}
+inline std::uint32_t GetHandleGeneration(EntityHandle handle)
+{
+	return static_cast<std::uint32_t>(handle >> 32U);
+}
 const size_t  MULTIPLE_COMPONENTS_MULTIPLIER = 4;
 enum class ModuleType
 {
@@ -0,0 +1,180 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_JOB_SYSTEM_H
+#define SFGE_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sfge
+{
+
+using JobFunction = std::function<void()>;
+/**
+ * \brief Called with a [start, end) sub-range of the ParallelFor range
+ */
+using RangeFunction = std::function<void(size_t start, size_t end)>;
+
+/**
+ * \brief Counter of the unfinished jobs scheduled with it, JobSystem::Wait returns when it reaches zero
+ */
+class JobGroup
+{
+public:
+	JobGroup() = default;
+	JobGroup(const JobGroup&) = delete;
+	JobGroup& operator=(const JobGroup&) = delete;
+
+	bool IsDone() const;
+private:
+	friend class JobSystem;
+	std::atomic<size_t> m_PendingJobNmb{ 0 };
+};
+
+/**
+ * \brief Work-stealing scheduler. Each thread owns a deque: it pushes and pops its own jobs at the back
+ * and idle threads steal the oldest jobs at the front of the others.
+ * Index 0 is the main thread, which only runs jobs while it waits, the workers are 1 to GetWorkerNmb().
+ * With no worker (single core) every job runs on the waiting thread.
+ */
+class JobSystem
+{
+public:
+	JobSystem();
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	 * \brief Start the workers, restarting them if already running
+	 */
+	void Init(size_t workerNmb);
+	/**
+	 * \brief Join the workers, the remaining jobs are run by the calling thread first
+	 */
+	void Destroy();
+
+	/**
+	 * \brief Workers to use beside the main thread, hardware_concurrency()-1 and 0 if it cannot be known
+	 */
+	static size_t GetDefaultWorkerNmb();
+	size_t GetWorkerNmb() const;
+	/**
+	 * \brief Workers plus the main thread
+	 */
+	size_t GetThreadNmb() const;
+	/**
+	 * \brief Index of the calling thread in this job system, 0 for the main thread and any thread not owned by it
+	 */
+	size_t GetThreadIndex() const;
+	/**
+	 * \brief True for the workers and the thread that called Init, false for other threads like a scene loading thread
+	 */
+	bool IsOwnThread() const;
+	/**
+	 * \brief True for the thread that called Init, the one drawing in the window
+	 */
+	bool IsMainThread() const;
+
+	/**
+	 * \brief Push a job on the queue of the calling thread, jobs can schedule and wait on other jobs
+	 */
+	void Schedule(JobGroup& group, JobFunction job);
+	/**
+	 * \brief Run and steal jobs until every job of the group is done
+	 */
+	void Wait(JobGroup& group);
+	/**
+	 * \brief Split [begin, end) in halves until they are smaller than grain and run them on every thread,
+	 * the calling thread included. A grain of 0 gives about four pieces per thread
+	 */
+	void ParallelFor(size_t begin, size_t end, size_t grain, const RangeFunction& function);
+
+private:
+	struct Job
+	{
+		JobFunction function;
+		JobGroup* group = nullptr;
+	};
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	void WorkerLoop(size_t threadIndex);
+	bool TryRunJob(size_t threadIndex);
+	bool PopJob(size_t threadIndex, Job& job);
+	void SplitRange(JobGroup& group, size_t begin, size_t end, size_t grain, const RangeFunction& function);
+
+	std::vector<std::unique_ptr<JobQueue>> m_Queues;
+	std::vector<std::thread> m_Workers;
+	std::atomic<size_t> m_QueuedJobNmb{ 0 };
+	std::atomic<bool> m_Running{ false };
+	std::thread::id m_MainThreadId = std::this_thread::get_id();
+	std::mutex m_SleepMutex;
+	std::condition_variable m_SleepCondition;
+};
+
+/**
+ * \brief Jobs with dependencies: a job is scheduled when the last of its dependencies is done
+ */
+class JobGraph
+{
+public:
+	size_t AddJob(JobFunction job);
+	/**
+	 * \brief job starts after dependency is done
+	 */
+	void AddDependency(size_t job, size_t dependency);
+	/**
+	 * \brief Run every job and return when they are all done. A graph with a cycle is not run and logs an error
+	 */
+	void Run(JobSystem& jobSystem);
+	void Clear();
+	size_t GetJobNmb() const;
+private:
+	struct Node
+	{
+		JobFunction function;
+		std::vector<size_t> successors;
+		size_t dependencyNmb = 0;
+	};
+	bool HasCycle() const;
+	void RunNode(JobSystem& jobSystem, JobGroup& group, size_t index);
+
+	std::vector<Node> m_Nodes;
+	std::unique_ptr<std::atomic<size_t>[]> m_RemainingDependencies;
+};
+
+}
+
+#endif
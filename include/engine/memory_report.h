@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_MEMORY_REPORT_H
+#define SFGE_MEMORY_REPORT_H
+
+#include <string>
+#include <vector>
+
+#include <engine/component_pool.h>
+
+namespace sfge
+{
+
+/**
+ * \brief Bytes of one container of a system
+ */
+struct MemoryUsage
+{
+	std::string system;
+	std::string container;
+	/**
+	 * \brief Bytes of the live elements
+	 */
+	size_t usedBytes = 0;
+	/**
+	 * \brief Bytes allocated, used or not
+	 */
+	size_t capacityBytes = 0;
+	/**
+	 * \brief Memory held outside the containers, e.g. estimated texture VRAM or Box2D allocations
+	 */
+	size_t externalBytes = 0;
+};
+
+/**
+ * \brief Filled by System::ReportMemory, each system adds its containers under the name given by SetSystem.
+ * Only the container storage is counted, not the heap owned by the elements themselves (strings, Python objects)
+ */
+class MemoryReport
+{
+public:
+	void SetSystem(const std::string& system);
+	void Add(const std::string& container, size_t usedBytes, size_t capacityBytes, size_t externalBytes = 0);
+	void AddExternal(const std::string& container, size_t externalBytes);
+
+	template<class T>
+	void AddContainer(const std::string& container, const std::vector<T>& values)
+	{
+		Add(container, values.size() * sizeof(T), values.capacity() * sizeof(T));
+	}
+	template<class T>
+	void AddContainer(const std::string& container, const ComponentPool<T>& pool)
+	{
+		Add(container, pool.size() * sizeof(T),
+			pool.capacity() * sizeof(T) + pool.capacity() / COMPONENT_CHUNK_SIZE * sizeof(T*));
+	}
+	/**
+	 * \brief Only the allocated chunks are counted as used
+	 */
+	template<class T>
+	void AddContainer(const std::string& container, const LazyComponentPool<T>& pool)
+	{
+		const auto chunkBytes = pool.GetAllocatedChunkNmb() * COMPONENT_CHUNK_SIZE * sizeof(T);
+		Add(container, chunkBytes, chunkBytes + pool.capacity() / COMPONENT_CHUNK_SIZE * sizeof(std::unique_ptr<T[]>));
+	}
+
+	const std::vector<MemoryUsage>& GetUsages() const;
+	/**
+	 * \brief One entry per system summing its containers, the biggest first
+	 */
+	std::vector<MemoryUsage> GetSystemTotals() const;
+	size_t GetUsedBytes() const;
+	size_t GetCapacityBytes() const;
+	size_t GetExternalBytes() const;
+	void Clear();
+private:
+	std::string m_System;
+	std::vector<MemoryUsage> m_Usages;
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_PREFAB_H
+#define SFGE_PREFAB_H
+
+#include <any>
+#include <string>
+#include <vector>
+
+#include <utility/json_utility.h>
+
+namespace sfge
+{
+enum class ComponentType : int;
+
+const std::string PREFAB_EXTENSION = ".prefab";
+
+/**
+ * \brief One component of a prefab, its json is read once when the prefab is loaded
+ */
+struct PrefabComponent
+{
+	ComponentType componentType{};
+	json componentJson;
+	/**
+	 * \brief Assets resolved once by IComponentFactory::ResolvePrefabComponent, the transform to copy,
+	 * the texture id, the collider shape or the script module, empty for the managers that do not resolve anything
+	 */
+	std::any resolvedData;
+};
+
+/**
+ * \brief Component set shared by many spawned entities, written like a scene entity: {"name", "components": [...]}.
+ * Loaded by SceneManager::LoadPrefab and instantiated with one bulk pass per component manager
+ */
+struct Prefab
+{
+	std::string name;
+	/**
+	 * \brief In increasing type order, the order they are instantiated in
+	 */
+	std::vector<PrefabComponent> components;
+};
+
+}
+
+#endif
@@ -26,13 +26,22 @@
 #ifndef SFGE_SCENE_H
 #define SFGE_SCENE_H
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <list>
+#include <vector>
 
 #include <engine/system.h>
 #include <utility/json_utility.h>
 #include <engine/entity.h>
+#include <engine/frame_budget.h>
+#include <engine/prefab.h>
+#include <engine/vector.h>
 
 
 
@@ -41,12 +50,53 @@ namespace sfge
 enum class ComponentType: int;
 class IComponentFactory;
 class PySystem;
+class SceneBinaryView;
+struct StreamedScene;
 
 namespace editor
 {
 struct SceneInfo;
 }
 
+/**
+ * \brief Time given each frame to the upload of the textures and the creation of the components of a streamed
+ * scene, at least one texture or one chunk of components is done each frame
+ */
+const std::int64_t SCENE_STREAMING_MIN_BUDGET = 500;
+const std::int64_t SCENE_STREAMING_MAX_BUDGET = 4'000;
+/**
+ * \brief Components of a CBOR block created per step of the instantiation of a streamed scene,
+ * a SoA block is always created in one step
+ */
+const size_t SCENE_STREAMING_COMPONENT_CHUNK = 1'024;
+
+/**
+ * \brief Duration in microseconds of each phase of the last scene loading
+ */
+struct SceneLoadingTimes
+{
+	/**
+	 * \brief Reading the json file, or mapping and validating the compiled scene.
+	 * For a streamed scene, the whole work of the loading thread
+	 */
+	std::int64_t parse = 0;
+	std::int64_t systems = 0;
+	/**
+	 * \brief First pass: entity reservation and grouping of the components by type
+	 */
+	std::int64_t entities = 0;
+	/**
+	 * \brief Second pass: bulk creation of each component type, in creation order
+	 */
+	std::vector<std::pair<ComponentType, std::int64_t>> components;
+	/**
+	 * \brief Asset collection and script initialization
+	 */
+	std::int64_t finish = 0;
+
+	std::int64_t GetTotal() const;
+};
+
 /**
 * \brief The Scene Manager do the transition between two scenes, read from the Engine Configuration the scenes build list
 */
@@ -54,16 +104,19 @@ class SceneManager : public System
 {
 public:
 	SceneManager(Engine& engine);
-	~SceneManager() = default;
+	~SceneManager();
 	void Init() override;
 
 	void SearchScenes(std::string& dataDirname);
 	/**
-	* \brief Finalize and delete everything created in the SceneManager
+	* \brief Finalize and delete everything created in the SceneManager.
+	* Called by a system while the SystemGraph runs, e.g. by a script, or outside the main thread, the load is
+	* deferred to the next UpdateSceneStreaming so it never clears the scene under the running systems or while the
+	* main thread draws it
 	*/
 	void LoadSceneFromName(const std::string& sceneName);
 	/**
-	* \brief Load a Scene and create all its GameObject
+	* \brief Load a Scene and create all its GameObject, deferred like LoadSceneFromName
 	* \param scenePath the scene path given by the configuration
 	* \return the heap Scene that is automatically destroyed when not used
 	*/
@@ -74,13 +127,64 @@ public:
 	* \return the heap Scene that is automatically destroyed when not used
 	*/
 	void LoadSceneFromJson(json& sceneJson, std::unique_ptr<editor::SceneInfo> sceneInfo = nullptr);
+	/**
+	 * \brief Load a scene compiled by CompileSceneFile, the file is memory mapped and each component block is
+	 * created by its manager in one call. Returns false without touching the current scene if the file is invalid
+	 */
+	bool LoadSceneFromBinary(const std::string& binaryPath, std::unique_ptr<editor::SceneInfo> sceneInfo = nullptr);
+	/**
+	 * \brief Load a scene without stopping the current one: a loading thread parses or maps the scene, decodes its
+	 * components and its textures, the textures are then uploaded under the SceneStreaming frame budget. The current
+	 * scene is then cleared and the new components are created over the next frames under the same budget. Meanwhile
+	 * no system runs on the new scene and the Engine keeps showing the last frame of the previous one, see
+	 * IsInstantiatingScene, so the new scene starts whole. The input and the PythonEngine keep running, the
+	 * PyComponents of the new scene wait for the swap.
+	 * \return false if the scene is unknown or another scene is already loading
+	 */
+	bool LoadSceneFromNameAsync(const std::string& sceneName);
+	bool LoadSceneFromPathAsync(const std::string& scenePath);
+	bool IsLoadingScene() const;
+	/**
+	 * \brief True between the clear of the current scene and the creation of the last component of the streamed one
+	 */
+	bool IsInstantiatingScene() const;
+	/**
+	 * \brief True when the next UpdateSceneStreaming clears the current scene, the last moment to copy what it draws
+	 */
+	bool IsSceneReadyToInstantiate() const;
+	/**
+	 * \brief Progress of the last asynchronous loading, from 0 to 1 when the scene is swapped in
+	 */
+	float GetLoadingProgress() const;
+	/**
+	 * \brief Advance the asynchronous loading, called by the Engine at the start of each frame, before the systems
+	 */
+	void UpdateSceneStreaming();
+	/**
+	 * \brief Load a .prefab json once and resolve its assets, the prefabs are dropped with the scene
+	 * \return nullptr if the file is not a valid prefab
+	 */
+	Prefab* LoadPrefab(const std::string& prefabPath);
+	/**
+	 * \brief Prefab from a json written like a scene entity, it replaces the prefab loaded with the same key
+	 */
+	Prefab* LoadPrefabFromJson(const std::string& prefabKey, const json& prefabJson);
+	/**
+	 * \brief Create one entity per position with the components of the prefab, one bulk pass per component manager
+	 */
+	EntityRange InstantiatePrefab(const Prefab& prefab, const std::vector<Vec2f>& positions);
 	/**
 	 * \brief Return a list of all the scenes available in the data folder, pretty useful for python and the editor
 	 * \return the list of scenes in the data folder
 	 */
 	std::list<std::string> GetAllScenes();
+	const SceneLoadingTimes& GetLoadingTimes() const;
 
 	void AddComponentManager(IComponentFactory* componentFactory, ComponentType componentType);
+	/**
+	 * \brief Returns nullptr if no manager registered the component type
+	 */
+	IComponentFactory* GetComponentManager(ComponentType componentType);
 
 	void Update(float dt) override;
 	void FixedUpdate() override;
@@ -90,12 +194,75 @@ public:
 	void Clear() override;
 private:
 
+	/**
+	 * \brief Log the phases of the scene just loaded
+	 */
+	void LogLoadingTimes(const std::string& sceneName) const;
+	void LoadSceneSystems(json& systemsJson);
+	/**
+	 * \brief Replace the current scene by a validated binary scene. The CBOR blocks already decoded in blockJsons
+	 * are not decoded again
+	 */
+	void LoadSceneFromBinaryView(const SceneBinaryView& sceneBinary, std::unique_ptr<editor::SceneInfo> sceneInfo,
+		std::int64_t parseDuration, std::vector<std::vector<json>>* blockJsons = nullptr);
+	/**
+	 * \brief Steps of the binary loading: clear the current scene, then systems, entities and components
+	 */
+	void BeginBinaryScene(const SceneBinaryView& sceneBinary, editor::SceneInfo& sceneInfo, std::int64_t parseDuration);
+	void LoadBinarySceneSystems(const SceneBinaryView& sceneBinary);
+	EntityRange CreateBinarySceneEntities(const SceneBinaryView& sceneBinary);
+	/**
+	 * \brief Create the components [begin, end) of a block, a SoA block is always created whole
+	 */
+	void CreateBinarySceneComponents(const SceneBinaryView& sceneBinary, size_t blockIndex, const EntityRange& entities,
+		size_t begin, size_t end, std::vector<std::vector<json>>* blockJsons);
+	/**
+	 * \brief Work of the loading thread, it only touches the returned scene and the progress.
+	 * It stops between two steps once cancelled is set
+	 */
+	static std::unique_ptr<StreamedScene> DecodeStreamedScene(const std::string& scenePath, std::atomic<float>& progress,
+		const std::atomic<bool>& cancelled);
+	void LogUnknownScene(const std::string& sceneName) const;
+	/**
+	 * \brief Common end of the json and binary loading, once every entity is created
+	 */
+	void FinishSceneLoading(std::unique_ptr<editor::SceneInfo> sceneInfo);
 	void InitScenePySystems();
 
 	std::vector<PySystem*> m_ScenePySystems;
+	/**
+	 * \brief Tick clocks of the scene systems, for Update and FixedUpdate
+	 */
+	std::vector<SystemTicker> m_UpdateTickers;
+	std::vector<SystemTicker> m_FixedUpdateTickers;
 	EntityManager* m_EntityManager = nullptr;
 	std::vector<IComponentFactory*> m_ComponentManager = std::vector<IComponentFactory*>(sizeof(ComponentType)*8);
 	std::map<std::string, std::string> m_ScenePathMap;
+	/**
+	 * \brief By path or by key, the pointers stay valid until the scene is cleared
+	 */
+	std::map<std::string, std::unique_ptr<Prefab>> m_Prefabs;
+	SceneLoadingTimes m_LoadingTimes;
+	/**
+	 * \brief Parse duration measured by LoadSceneFromPath for the following LoadSceneFromJson
+	 */
+	std::int64_t m_ParseDuration = 0;
+
+	std::future<std::unique_ptr<StreamedScene>> m_StreamingFuture;
+	/**
+	 * \brief Decoded scene waiting for its textures upload and its swap
+	 */
+	std::unique_ptr<StreamedScene> m_StreamedScene;
+	std::atomic<float> m_LoadingProgress{0.0f};
+	std::atomic<bool> m_StreamingCancelled{false};
+	/**
+	 * \brief Keep a synchronous load requested during the SystemGraph or outside the main thread for the next
+	 * UpdateSceneStreaming, returns false when the load can run right away
+	 */
+	bool DeferSceneLoad(std::function<void()> sceneLoad);
+	std::function<void()> m_PendingSceneLoad;
+	std::mutex m_PendingSceneMutex;
+	BudgetId m_StreamingBudget = 0;
 
 };
 }
@@ -0,0 +1,202 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_SCENE_BINARY_H
+#define SFGE_SCENE_BINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <engine/globals.h>
+#include <utility/json_utility.h>
+
+namespace sfge
+{
+enum class ComponentType : int;
+
+/**
+ * \brief "SFGS" read as a little-endian uint32
+ */
+const std::uint32_t SCENE_BINARY_MAGIC = 0x53474653;
+/**
+ * \brief Bumped on every layout change, the loader refuses the other versions and falls back to the json
+ */
+const std::uint32_t SCENE_BINARY_VERSION = 1;
+const std::string SCENE_BINARY_EXTENSION = ".sceneb";
+const std::uint32_t INVALID_SCENE_STRING = std::numeric_limits<std::uint32_t>::max();
+
+enum class SceneBlockEncoding : std::uint32_t
+{
+	/**
+	 * \brief One 4 bytes column per field, created by IComponentFactory::CreateComponents
+	 */
+	SOA = 0,
+	/**
+	 * \brief The CBOR of each component json, for the types without a compiler, created by CreateComponent
+	 */
+	CBOR = 1
+};
+
+/**
+ * \brief File layout, every section starts on 8 bytes:
+ * header | block headers | meta CBOR {name, systems} | entity names | strings | blocks.
+ * Names and strings are a uint32 offset table of nmb + 1 entries followed by the characters.
+ * A block is uint32 entity indices[count] then its columns or its CBOR offset table and data
+ */
+struct SceneBinaryHeader
+{
+	std::uint32_t magic = SCENE_BINARY_MAGIC;
+	std::uint32_t version = SCENE_BINARY_VERSION;
+	std::uint32_t entityNmb = 0;
+	std::uint32_t blockNmb = 0;
+	std::uint64_t metaOffset = 0;
+	std::uint64_t metaSize = 0;
+	std::uint64_t namesOffset = 0;
+	std::uint64_t namesSize = 0;
+	std::uint64_t stringsOffset = 0;
+	std::uint64_t stringsSize = 0;
+	std::uint32_t stringNmb = 0;
+	std::uint32_t reserved = 0;
+};
+
+struct SceneBlockHeader
+{
+	std::int32_t componentType = 0;
+	SceneBlockEncoding encoding = SceneBlockEncoding::SOA;
+	std::uint32_t count = 0;
+	std::uint32_t columnNmb = 0;
+	std::uint64_t offset = 0;
+	std::uint64_t size = 0;
+};
+
+class SceneBinaryView;
+
+/**
+ * \brief Components of one type in a mapped binary scene, the columns point directly into the file
+ */
+struct SceneBlock
+{
+	ComponentType componentType{};
+	SceneBlockEncoding encoding = SceneBlockEncoding::SOA;
+	size_t count = 0;
+	size_t columnNmb = 0;
+	/**
+	 * \brief Index of the entity in the scene of each component
+	 */
+	const std::uint32_t* entityIndices = nullptr;
+
+	const float* GetFloatColumn(size_t column) const;
+	const std::int32_t* GetIntColumn(size_t column) const;
+	const std::uint32_t* GetUintColumn(size_t column) const;
+	/**
+	 * \brief Entry of the scene string table, for the uint columns holding string indices
+	 */
+	std::string_view GetString(std::uint32_t stringIndex) const;
+	/**
+	 * \brief Decode the component json of a CBOR block
+	 */
+	json GetComponentJson(size_t index) const;
+
+	const SceneBinaryView* scene = nullptr;
+	const std::byte* data = nullptr;
+};
+
+/**
+ * \brief Validated read-only view over the bytes of a binary scene, usually a MappedFile
+ */
+class SceneBinaryView
+{
+public:
+	SceneBinaryView(const std::byte* data, size_t size);
+
+	/**
+	 * \brief Magic, version and every section inside the data
+	 */
+	bool IsValid() const;
+	size_t GetEntityNmb() const;
+	size_t GetBlockNmb() const;
+	SceneBlock GetBlock(size_t index) const;
+	/**
+	 * \brief {name, systems} of the source scene json
+	 */
+	json GetMetaJson() const;
+	std::string_view GetEntityName(size_t entityIndex) const;
+	std::string_view GetString(std::uint32_t stringIndex) const;
+private:
+	bool CheckSection(std::uint64_t offset, std::uint64_t size) const;
+	bool CheckStringTable(std::uint64_t offset, std::uint64_t size, size_t stringNmb) const;
+	static std::string_view GetTableString(const std::byte* table, size_t stringNmb, std::uint32_t index);
+
+	const std::byte* m_Data = nullptr;
+	size_t m_Size = 0;
+	const SceneBinaryHeader* m_Header = nullptr;
+	const SceneBlockHeader* m_Blocks = nullptr;
+	bool m_Valid = false;
+};
+
+/**
+ * \brief Column writer given to the SoA compilers, the columns are written in the order they are added
+ */
+class SceneBlockBuilder
+{
+public:
+	explicit SceneBlockBuilder(std::vector<std::string>& strings);
+
+	void AddFloatColumn(const std::vector<float>& column);
+	void AddIntColumn(const std::vector<std::int32_t>& column);
+	void AddUintColumn(const std::vector<std::uint32_t>& column);
+	/**
+	 * \brief Index of the string in the scene string table, each distinct string is stored once
+	 */
+	std::uint32_t AddString(const std::string& value);
+
+	const std::vector<std::vector<std::uint32_t>>& GetColumns() const;
+private:
+	std::vector<std::string>& m_Strings;
+	std::vector<std::vector<std::uint32_t>> m_Columns;
+};
+
+/**
+ * \brief Fill the SoA columns of a block from the component jsons of one type
+ */
+using SceneBlockCompiler = void(*)(const std::vector<const json*>& componentJsons, SceneBlockBuilder& builder);
+
+/**
+ * \brief Offline conversion of a .scene json to the binary layout, the json stays the authoring format.
+ * The component types with a SceneBlockCompiler become SoA blocks, the others CBOR blocks
+ */
+bool CompileScene(const json& sceneJson, std::vector<std::byte>& binary);
+bool CompileSceneFile(const std::string& scenePath, const std::string& binaryPath);
+/**
+ * \brief level.scene -> level.sceneb
+ */
+std::string GetCompiledScenePath(const std::string& scenePath);
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_SCENE_INDEX_H
+#define SFGE_SCENE_INDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace sfge
+{
+
+const std::uint32_t SCENE_INDEX_VERSION = 1;
+
+struct SceneIndexEntry
+{
+	std::string name;
+	std::int64_t writeTime = 0;
+	std::uint64_t fileSize = 0;
+};
+
+/**
+ * \brief Persisted name of every .scene of the data folder, keyed by path. A file is only read again when its
+ * modification time or its size changed since the manifest was written
+ */
+class SceneIndex
+{
+public:
+	/**
+	 * \brief Read the manifest, an unknown version or an invalid file gives an empty index
+	 */
+	bool Load(const std::string& manifestPath);
+	bool Save(const std::string& manifestPath) const;
+	/**
+	 * \brief Walk dataDirname, read the name of the new or changed scenes and drop the deleted ones.
+	 * Returns the number of scenes that had to be read
+	 */
+	size_t Update(const std::string& dataDirname);
+	/**
+	 * \brief The manifest is outdated since the last Load or Save
+	 */
+	bool IsDirty() const;
+	const std::map<std::string, SceneIndexEntry>& GetEntries() const;
+private:
+	std::map<std::string, SceneIndexEntry> m_Entries;
+	bool m_Dirty = false;
+};
+
+/**
+ * \brief Stream the scene file until its top-level "name" string, without parsing the rest of the json.
+ * Empty if the scene has no name
+ */
+std::string ReadSceneName(const std::string& scenePath);
+
+}
+
+#endif
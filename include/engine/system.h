@@ -25,10 +25,59 @@
 #ifndef SFGE_SYSTEM_H
 #define SFGE_SYSTEM_H
 
+#include <engine/system_tick.h>
+
 namespace sfge
 {
 
 class Engine;
+class MemoryReport;
+
+/**
+ * \brief Shared state used by a system that is not a component
+ */
+enum class SystemResource : int
+{
+	NONE = 0,
+	/**
+	 * \brief The render window, the system runs alone on the thread running the SystemGraph
+	 */
+	WINDOW = 1 << 0,
+	/**
+	 * \brief The Python interpreter, the engine runs the system with the GIL
+	 */
+	PYTHON = 1 << 1,
+	/**
+	 * \brief Entity creation and destruction, they resize every component pool
+	 */
+	ENTITIES = 1 << 2,
+};
+
+/**
+ * \brief ComponentType bits read and written by a system during its frame phase and the SystemResource bits
+ * it uses, see SystemGraph. A system that does not declare them is exclusive: it runs alone, on the main thread
+ */
+struct SystemAccess
+{
+	static constexpr int ALL_COMPONENTS = ~0;
+
+	int readComponents = 0;
+	int writeComponents = 0;
+	int resources = 0;
+	bool exclusive = true;
+
+	/**
+	 * \brief Two systems conflict if one writes what the other reads or writes, if they use the same resource
+	 * or if one creates entities while the other uses components
+	 */
+	bool Conflicts(const SystemAccess& other) const;
+	bool Uses(SystemResource resource) const;
+	/**
+	 * \brief Add the accesses of other, the result is exclusive if one of them is
+	 */
+	void Merge(const SystemAccess& other);
+};
+
 /**
 * \brief Systems are classes used by the Engine to init and update features, new features can be added through PySystem
 */
@@ -70,6 +119,10 @@ public:
 	* \brief Called after we load a scene
 	*/
 	virtual void Collect() {}
+	/**
+	 * \brief Add the bytes of the containers and external resources of the system, see Engine::ReportMemory
+	 */
+	virtual void ReportMemory(MemoryReport& report) const { (void) report; }
 
 	/**
 	 * \brief Called when the engine saves the game
@@ -80,10 +133,42 @@ public:
 
 	Engine& GetEngine() const;
 	bool GetInitlialized() const;
+	const SystemAccess& GetAccess() const;
+	const TickPolicy& GetTickPolicy() const;
+	/**
+	 * \brief Called by the runner of the system before Update or FixedUpdate, see SystemTicker
+	 */
+	void SetTickState(const TickState& tickState);
+	const TickState& GetTickState() const;
 protected:
+	/**
+	 * \brief Declare the component types and resources used by the system so it can run beside the ones it does
+	 * not conflict with
+	 */
+	void DeclareAccess(int readComponents, int writeComponents, int resources = 0);
+	/**
+	 * \brief Add the accesses of a system run by this one, called after DeclareAccess
+	 */
+	void AddAccess(const SystemAccess& access);
+	/**
+	 * \brief Run Update and FixedUpdate frequency times per second instead of every frame and fixed step,
+	 * GetTickState tells how many steps were skipped
+	 */
+	void SetTickRate(float frequency);
+	/**
+	 * \brief Process 1/frameNmb of the entities on each run, see GetStaggerRange
+	 */
+	void SetStaggerFrameNmb(size_t frameNmb);
+	/**
+	 * \brief Indices of the count entities processed by the current run
+	 */
+	StaggerRange GetStaggerRange(size_t count) const;
 	bool m_Enable = true;
 	Engine& m_Engine;
 	bool m_Initialized = false;
+	SystemAccess m_Access;
+	TickPolicy m_TickPolicy;
+	TickState m_TickState;
 };
 }
 #endif //SFGE_SYSTEM_H
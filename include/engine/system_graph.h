@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_SYSTEM_GRAPH_H
+#define SFGE_SYSTEM_GRAPH_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <engine/system.h>
+#include <engine/job_system.h>
+#include <engine/system_profiler.h>
+
+namespace sfge
+{
+
+enum class FramePhase : std::uint8_t
+{
+	INPUT,
+	FIXED_UPDATE,
+	UPDATE,
+	RENDER_PREP,
+	LENGTH
+};
+
+using SystemFunction = std::function<void(float dt)>;
+
+struct SystemNode
+{
+	std::string name;
+	SystemAccess access;
+	SystemFunction function;
+	/**
+	 * \brief The system giving the tick policy, nullptr runs every time
+	 */
+	System* system = nullptr;
+	SystemTicker ticker;
+	/**
+	 * \brief Earlier systems of the phase that conflict with this one and run before it
+	 */
+	std::vector<size_t> dependencies;
+	/**
+	 * \brief Index of the segment of the phase running the system
+	 */
+	size_t segment = 0;
+	/**
+	 * \brief Duration of the last run in microseconds, only measured with SFGE_PROFILE_SYSTEMS
+	 */
+	std::int64_t lastDuration = 0;
+	/**
+	 * \brief "Phase/name" interned in the profiler, nullptr without profiler
+	 */
+	const char* profileName = nullptr;
+};
+
+/**
+ * \brief Systems of each frame phase ordered by the components they read and write.
+ * Conflicting systems keep their registration order and the others run concurrently on the JobSystem,
+ * so a frame gives the same result as the serial order. Exclusive systems and the ones using the window
+ * run alone on the calling thread.
+ */
+class SystemGraph
+{
+public:
+	void AddSystem(FramePhase phase, std::string name, const SystemAccess& access, SystemFunction function);
+	/**
+	 * \brief The system runs with its TickPolicy, the function gets the time since its last run
+	 */
+	void AddSystem(FramePhase phase, std::string name, System& system, SystemFunction function);
+	/**
+	 * \brief Compute the dependencies and spread the tickers, called once every system is added
+	 */
+	void Build();
+	void Run(FramePhase phase, float dt, JobSystem& jobSystem);
+	void Clear();
+	/**
+	 * \brief A system changed its access, the dependencies are computed again before the next run.
+	 * The ticks are kept
+	 */
+	void InvalidateAccess();
+	/**
+	 * \brief A phase is running, the systems must not change the graph or the entities outside their access
+	 */
+	bool IsRunning() const;
+	/**
+	 * \brief Record every system run in the profiler, nullptr to stop. Set before Build
+	 */
+	void SetProfiler(SystemProfiler* profiler);
+
+	const std::vector<SystemNode>& GetNodes(FramePhase phase) const;
+	static const char* GetPhaseName(FramePhase phase);
+private:
+	/**
+	 * \brief Consecutive systems run together, an exclusive system is alone in its segment
+	 */
+	struct Segment
+	{
+		std::vector<size_t> nodes;
+		JobGraph graph;
+	};
+	struct Phase
+	{
+		std::vector<SystemNode> nodes;
+		std::vector<Segment> segments;
+		float deltaTime = 0.0f;
+	};
+	void BuildSegments(Phase& phase);
+	void RunNode(Phase& phase, size_t index);
+
+	std::array<Phase, static_cast<size_t>(FramePhase::LENGTH)> m_Phases;
+	SystemProfiler* m_Profiler = nullptr;
+	std::atomic<bool> m_AccessChanged{ false };
+	std::atomic<bool> m_Running{ false };
+};
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_SYSTEM_PROFILER_H
+#define SFGE_SYSTEM_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace sfge
+{
+class JobSystem;
+
+using ProfilerClock = std::chrono::high_resolution_clock;
+
+struct ProfileSample
+{
+	/**
+	 * \brief Static name, the SystemNode name or a string literal
+	 */
+	const char* name = nullptr;
+	/**
+	 * \brief Start in microseconds since the profiler Init
+	 */
+	std::int64_t start = 0;
+	std::int64_t duration = 0;
+};
+
+/**
+ * \brief Last samples of one thread. Only its thread pushes, without lock, the oldest samples are overwritten.
+ * It is read between frames, when the thread does not push anymore
+ */
+class ProfileRingBuffer
+{
+public:
+	void Resize(size_t capacity);
+	void Push(const ProfileSample& sample);
+	void Clear();
+	/**
+	 * \brief Samples still in the buffer, oldest first
+	 */
+	std::vector<ProfileSample> GetSamples() const;
+private:
+	std::vector<ProfileSample> m_Samples;
+	std::atomic<size_t> m_PushedNmb{0};
+};
+
+struct SystemTimingStats
+{
+	std::string name;
+	size_t sampleNmb = 0;
+	std::int64_t min = 0;
+	std::int64_t avg = 0;
+	std::int64_t p99 = 0;
+};
+
+/**
+ * \brief Timings of the systems run by the SystemGraph and of the scopes marked with SFGE_PROFILE_SCOPE,
+ * one ring buffer per JobSystem thread, the threads not owned by the JobSystem are not recorded.
+ * Export them as a Chrome trace_event file to open in chrome://tracing
+ */
+class SystemProfiler
+{
+public:
+	void Init(const JobSystem& jobSystem, size_t samplePerThreadNmb = 8192);
+	void SetEnabled(bool enabled);
+	bool IsEnabled() const;
+
+	/**
+	 * \brief Copy of the name kept until the profiler is destroyed, for the names that are not literals
+	 */
+	const char* InternName(const std::string& name);
+	void Record(const char* name, ProfilerClock::time_point start, ProfilerClock::time_point end);
+	void Clear();
+	/**
+	 * \brief Min, average and 99th percentile in microseconds of each name, sorted by name
+	 */
+	std::vector<SystemTimingStats> ComputeStats() const;
+	bool ExportChromeTrace(const std::string& path) const;
+private:
+	const JobSystem* m_JobSystem = nullptr;
+	std::vector<std::unique_ptr<ProfileRingBuffer>> m_Buffers;
+	ProfilerClock::time_point m_Epoch = ProfilerClock::now();
+	std::atomic<bool> m_Enabled{false};
+	std::set<std::string> m_Names;
+	std::mutex m_NamesMutex;
+};
+
+/**
+ * \brief Record the duration of its scope, does not read the clock when the profiler is disabled
+ */
+class ScopeTimer
+{
+public:
+	ScopeTimer(SystemProfiler& profiler, const char* name);
+	~ScopeTimer();
+	ScopeTimer(const ScopeTimer&) = delete;
+	ScopeTimer& operator=(const ScopeTimer&) = delete;
+private:
+	SystemProfiler* m_Profiler = nullptr;
+	const char* m_Name;
+	ProfilerClock::time_point m_Start;
+};
+
+}
+
+#define SFGE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SFGE_PROFILE_CONCAT(a, b) SFGE_PROFILE_CONCAT_IMPL(a, b)
+#ifdef SFGE_PROFILE_SYSTEMS
+#define SFGE_PROFILE_SCOPE(profiler, name) sfge::ScopeTimer SFGE_PROFILE_CONCAT(scopeTimer, __LINE__)(profiler, name)
+#else
+#define SFGE_PROFILE_SCOPE(profiler, name)
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_SYSTEM_TICK_H
+#define SFGE_SYSTEM_TICK_H
+
+#include <cstddef>
+#include <vector>
+
+namespace sfge
+{
+
+/**
+ * \brief How often a system runs, declared by the system and applied by the SystemTicker of its runner
+ */
+struct TickPolicy
+{
+	/**
+	 * \brief Runs per second, 0 runs every frame or fixed step
+	 */
+	float frequency = 0.0f;
+	/**
+	 * \brief The entities are split in staggerFrameNmb slices and each run processes one of them, see GetStaggerRange
+	 */
+	size_t staggerFrameNmb = 1;
+};
+
+/**
+ * \brief Given to the system before each of its runs
+ */
+struct TickState
+{
+	/**
+	 * \brief Frames or fixed steps since the last run, more than one when the system ticks slower than the frame
+	 */
+	size_t stepNmb = 1;
+	/**
+	 * \brief Time since the last run
+	 */
+	float deltaTime = 0.0f;
+	/**
+	 * \brief Slice processed by this run, in [0, staggerFrameNmb)
+	 */
+	size_t staggerFrame = 0;
+	/**
+	 * \brief Time since the current slice was last processed, the sum of the last staggerFrameNmb runs
+	 */
+	float staggerDeltaTime = 0.0f;
+};
+
+/**
+ * \brief Indices [begin, end) processed by one run
+ */
+struct StaggerRange
+{
+	size_t begin = 0;
+	size_t end = 0;
+
+	size_t size() const { return end - begin; }
+	bool empty() const { return begin == end; }
+};
+
+/**
+ * \brief Slice staggerFrame of the count indices cut in staggerFrameNmb even slices
+ */
+StaggerRange GetStaggerRange(size_t count, size_t staggerFrameNmb, size_t staggerFrame);
+
+/**
+ * \brief Tick clock of one system in one frame phase, advanced by the runner every frame or fixed step
+ */
+class SystemTicker
+{
+public:
+	/**
+	 * \brief The phase in [0, 1) is the part of the period already elapsed at the start, the runner gives
+	 * different phases to the systems of the same frequency so they do not all run on the same frame
+	 */
+	void Init(const TickPolicy& policy, float phase = 0.0f);
+	/**
+	 * \brief Advance of one frame or fixed step of dt, true when the system runs now
+	 */
+	bool Advance(float dt);
+	const TickState& GetState() const;
+	const TickPolicy& GetPolicy() const;
+private:
+	TickPolicy m_Policy;
+	TickState m_State;
+	float m_Elapsed = 0.0f;
+	float m_DeltaTime = 0.0f;
+	size_t m_StepNmb = 0;
+	size_t m_RunNmb = 0;
+	/**
+	 * \brief Delta time of the last staggerFrameNmb runs
+	 */
+	std::vector<float> m_RunDeltaTimes;
+};
+
+/**
+ * \brief Phase of each ticker so the ones of the same frequency are spread evenly over their period
+ */
+void SpreadTickers(const std::vector<SystemTicker*>& tickers);
+
+}
+
+#endif
@@ -25,6 +25,8 @@
 #ifndef SFGE_TRANSFORM_H_
 #define SFGE_TRANSFORM_H_
 
+#include <SFML/Graphics/Transform.hpp>
+
 #include <engine/entity.h>
 #include <engine/component.h>
 #include <engine/vector.h>
@@ -41,6 +43,38 @@ struct Transform2d
 	float EulerAngle = 0.0f;
 };
 
+/**
+ * \brief Parent link and cached world placement of a transform. The world is only recomputed when the transform
+ * was marked dirty or when one of its ancestors was
+ */
+struct Transform2dNode
+{
+	Entity parent = INVALID_ENTITY;
+	Entity firstChild = INVALID_ENTITY;
+	Entity nextSibling = INVALID_ENTITY;
+	Transform2d world;
+	sf::Transform worldMatrix;
+	/**
+	 * \brief Set by MarkDirty, the entity is then in the dirty list until the next update
+	 */
+	bool dirty = false;
+	/**
+	 * \brief Incremented each time the world is recomputed, compared by the managers that copy the transform
+	 */
+	TransformVersion version = 0;
+	/**
+	 * \brief Local transform of a physics body before the last fixed step
+	 */
+	Transform2d previous;
+	bool interpolated = false;
+};
+
+template<>
+struct ComponentTypeOf<Transform2d>
+{
+	static constexpr ComponentType value = ComponentType::TRANSFORM2D;
+};
+
 namespace editor
 {
 struct Transform2dInfo : ComponentInfo
@@ -55,13 +89,88 @@ class Transform2dManager :
 {
 public:
 	using SingleComponentManager::SingleComponentManager;
+	void Init() override;
 	Transform2d* AddComponent(Entity entity) override;
 	void CreateComponent(json& componentJson, Entity entity) override;
+	/**
+	 * \brief The transforms are added serially, then decoded on the job system
+	 */
+	void CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons) override;
+	void CreateComponents(const SceneBlock& block, const EntityRange& entities) override;
+	/**
+	 * \brief Scene compiler columns: position x, position y, scale x, scale y, angle
+	 */
+	static void CompileComponents(const std::vector<const json*>& componentJsons, SceneBlockBuilder& builder);
+	static void ReadTransformJson(const json& componentJson, Transform2d& transform);
+	void ResolvePrefabComponent(PrefabComponent& prefabComponent) override;
+	/**
+	 * \brief The prefab position is an offset added to each spawn position
+	 */
+	void InstantiatePrefabComponents(const PrefabComponent& prefabComponent, const std::vector<Entity>& entities,
+		const std::vector<Vec2f>& positions) override;
 	void DestroyComponent(Entity entity) override;
+	/**
+	 * \brief Only the dirty transforms and their subtrees are recomputed
+	 */
 	void Update(float dt) override;
 	json Save();
 
+	/**
+	 * \brief Mutable access marks the transform dirty, use GetLocalTransform to only read it
+	 */
+	Transform2d* GetComponentPtr(Entity entity) override;
+	Transform2d& GetComponentRef(Entity entity);
+	const Transform2d& GetLocalTransform(Entity entity) const;
+	/**
+	 * \brief The world of the entity and its subtree is recomputed by the next update. Needed after writing
+	 * through a pointer kept from an earlier frame. Not thread safe, the writers are serialized by their
+	 * TRANSFORM2D write access
+	 */
+	void MarkDirty(Entity entity);
+
 	void OnResize(size_t newSize) override;
+	void ReportMemory(MemoryReport& report) const override;
+
+	/**
+	 * \brief Attach child to parent, the child transform becomes relative to its parent.
+	 * INVALID_ENTITY detaches the child, returns false if it would create a cycle
+	 */
+	bool SetParent(Entity child, Entity parent);
+	Entity GetParent(Entity entity) const;
+	/**
+	 * \brief World placement computed by the last Update, interpolated for the physics bodies
+	 */
+	const Transform2d& GetWorldTransform(Entity entity) const;
+	const sf::Transform& GetWorldMatrix(Entity entity) const;
+	TransformVersion GetVersion(Entity entity) const;
+	/**
+	 * \brief Transforms sorted by depth, a parent always comes before its children
+	 */
+	const std::vector<Entity>& GetHierarchy();
+	/**
+	 * \brief Keep the local transform of the physics bodies, called before each fixed step
+	 */
+	void SaveFixedStepState();
+	/**
+	 * \brief The physics bodies are rendered at factor between their state before and after the last fixed step,
+	 * 1 renders the current state
+	 */
+	void SetInterpolationFactor(float factor);
+protected:
+	void LinkComponentInfo(size_t index) override;
+private:
+	void Detach(Entity entity);
+	void RebuildHierarchy();
+	void UpdateWorld(Entity entity);
+
+	ComponentPool<Transform2dNode> m_Nodes{ INIT_ENTITY_NMB };
+	std::vector<Entity> m_Hierarchy;
+	bool m_HierarchyDirty = true;
+	std::vector<Entity> m_DirtyEntities;
+	std::vector<Entity> m_DirtyRoots;
+	std::vector<Entity> m_TraversalStack;
+	std::vector<Entity> m_InterpolatedEntities;
+	float m_InterpolationFactor = 1.0f;
 };
 }
 
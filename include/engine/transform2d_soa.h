@@ -0,0 +1,146 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_TRANSFORM2D_SOA_H
+#define SFGE_TRANSFORM2D_SOA_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+#include <engine/globals.h>
+#include <engine/vector.h>
+
+namespace sfge
+{
+struct Transform2d;
+class Transform2dManager;
+
+/**
+ * \brief Allocator giving the streams the 32 bytes alignment of an AVX register
+ */
+template<class T>
+struct StreamAllocator
+{
+	using value_type = T;
+	static const std::size_t ALIGNMENT = 32;
+
+	StreamAllocator() = default;
+	template<class U>
+	StreamAllocator(const StreamAllocator<U>&) {}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ALIGNMENT)));
+	}
+	void deallocate(T* p, std::size_t n)
+	{
+		(void) n;
+		::operator delete(p, std::align_val_t(ALIGNMENT));
+	}
+	template<class U>
+	bool operator==(const StreamAllocator<U>&) const { return true; }
+	template<class U>
+	bool operator!=(const StreamAllocator<U>&) const { return false; }
+};
+
+using FloatStream = std::vector<float, StreamAllocator<float>>;
+
+class Transform2dStreams;
+
+/**
+ * \brief Reference to one transform of Transform2dStreams, reads and writes through to the streams
+ */
+class Transform2dRef
+{
+public:
+	Transform2dRef(Transform2dStreams& streams, size_t index);
+
+	Vec2f GetPosition() const;
+	void SetPosition(Vec2f position);
+	Vec2f GetScale() const;
+	void SetScale(Vec2f scale);
+	float GetEulerAngle() const;
+	void SetEulerAngle(float eulerAngle);
+
+	operator Transform2d() const;
+	Transform2dRef& operator=(const Transform2d& transform);
+private:
+	Transform2dStreams& m_Streams;
+	size_t m_Index;
+};
+
+/**
+ * \brief Structure-of-arrays layout of Transform2d for systems moving many entities at once: position, scale and
+ * angle are separate float streams so the batch kernels below process 8 (AVX) or 4 (SSE) transforms per instruction.
+ * The Transform2dManager components stay the reference for the rest of the engine, Load and Store copy a set of
+ * entities between both layouts. The copies cost more than the kernels save on a scattered set of entities,
+ * the streams pay off for a system keeping its own data in them.
+ */
+class Transform2dStreams
+{
+public:
+	void Resize(size_t size);
+	size_t Size() const;
+
+	Transform2dRef operator[](size_t index);
+
+	/**
+	 * \brief Gather the transforms of the entities, entities[i] goes to index i
+	 */
+	void Load(Transform2dManager& transformManager, const std::vector<Entity>& entities);
+	/**
+	 * \brief Scatter index i back to the transform of entities[i]
+	 */
+	void Store(Transform2dManager& transformManager, const std::vector<Entity>& entities) const;
+	/**
+	 * \brief Load and Store of the positions only, for the systems that only move their entities
+	 */
+	void LoadPositions(Transform2dManager& transformManager, const std::vector<Entity>& entities);
+	void StorePositions(Transform2dManager& transformManager, const std::vector<Entity>& entities) const;
+
+	/**
+	 * \brief Kernels over [begin, end)
+	 */
+	void Translate(size_t begin, size_t end, Vec2f moveValue);
+	void Scale(size_t begin, size_t end, float scaleValue);
+	/**
+	 * \brief Add rotateValue degrees and wrap the angle in [-180, 180] like Transform2d::Update
+	 */
+	void Rotate(size_t begin, size_t end, float rotateValue);
+	/**
+	 * \brief position += velocity * dt, velocitiesX and velocitiesY are indexed like the streams
+	 */
+	void IntegrateVelocity(size_t begin, size_t end, const float* velocitiesX, const float* velocitiesY, float dt);
+
+	FloatStream positionsX;
+	FloatStream positionsY;
+	FloatStream scalesX;
+	FloatStream scalesY;
+	FloatStream eulerAngles;
+};
+
+}
+
+#endif
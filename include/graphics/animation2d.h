@@ -32,6 +32,7 @@ SOFTWARE.
 //tool_engine
 #include <engine/component.h>
 #include <engine/transform2d.h>
+#include <engine/frame_budget.h>
 #include <editor/editor.h>
 #include <graphics/texture.h>
 
@@ -39,6 +40,9 @@ namespace sfge
 {
 
 const std::string ANIM_FOLER = "./data/animSaves/";
+//Microseconds per frame of the animations out of the view, the FrameBudget keeps it between these when the frames are late
+const std::int64_t OFF_SCREEN_ANIMATION_MIN_BUDGET = 200;
+const std::int64_t OFF_SCREEN_ANIMATION_MAX_BUDGET = 2'000;
 
 struct AnimationFrame
 {
@@ -60,9 +64,14 @@ public:
 	Animation(Transform2d* transform, sf::Vector2f offset);
 
 	void Init();
-	void Update(float dt, Transform2d* transform);
+	void Update(float dt, const Transform2d* transform);
+	/**
+	 * \brief Update skipped by the budget, its time is caught up by the next Update
+	 */
+	void SkipUpdate(float dt);
 	void Draw(sf::RenderWindow& window);
 	void SetAnimation(std::vector<AnimationFrame> newFrameList, float newSpeed, bool newIsLooped);
+	const sf::Sprite& GetSprite() const;
 
 protected:
 	std::vector<AnimationFrame> frameList;
@@ -74,6 +83,12 @@ protected:
 };
 
 
+template<>
+struct ComponentTypeOf<Animation>
+{
+	static constexpr ComponentType value = ComponentType::ANIMATION2D;
+};
+
 namespace editor
 {
 struct AnimationInfo : ComponentInfo
@@ -89,14 +104,18 @@ struct AnimationInfo : ComponentInfo
 /**
 * \brief Animation manager caching all the animations and rendering them at the end of the frame
 */
-class AnimationManager : public SingleComponentManager<Animation, editor::AnimationInfo, ComponentType::ANIMATION2D>,
+class AnimationManager : public PackedComponentManager<Animation, editor::AnimationInfo, ComponentType::ANIMATION2D>,
 	public LayerComponentManager<Animation>
 {
 public:
-	using SingleComponentManager::SingleComponentManager;
+	using PackedComponentManager::PackedComponentManager;
 	void Init() override;
 	void Update(float dt) override;
 	void DrawAnimations(sf::RenderWindow &window);
+	/**
+	 * \brief Indices of the animations by layer then entity, a removal does not reorder the others
+	 */
+	const std::vector<size_t>& GetDrawOrder();
 
 	void Reset();
 	void Collect() override;
@@ -104,11 +123,16 @@ public:
 	void CreateComponent(json& componentJson, Entity entity) override;
 	void DestroyComponent(Entity entity) override;
 
-	void OnResize(size_t newSize) override;
-
 protected:
+	void LinkComponentInfo(size_t index) override;
+
 	Graphics2dManager* m_GraphicsManager;
 	Transform2dManager* m_Transform2dManager;
+	BudgetId m_OffScreenBudget = 0;
+	/**
+	 * \brief First animation of the next update, the off-screen ones skipped by the budget go first
+	 */
+	size_t m_UpdateCursor = 0;
 };
 
 }
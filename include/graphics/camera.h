@@ -44,6 +44,8 @@ namespace sfge
 	{
 	public:
 		Camera& operator=(const Camera&) = delete;
+		Camera(Camera&&) = default;
+		Camera& operator=(Camera&&) = default;
 
 		/**
 		 * \brief Constructor Camera empty
@@ -100,6 +102,12 @@ namespace sfge
 		SpriteManager* m_SpriteManager;
 	};
 
+	template<>
+	struct ComponentTypeOf<Camera>
+	{
+		static constexpr ComponentType value = ComponentType::CAMERA;
+	};
+
 	namespace editor
 	{
 		struct CameraInfo : ComponentInfo
@@ -110,11 +118,11 @@ namespace sfge
 		};
 	}
 
-	class CameraManager : public SingleComponentManager<Camera, editor::CameraInfo, ComponentType::CAMERA>
+	class CameraManager : public PackedComponentManager<Camera, editor::CameraInfo, ComponentType::CAMERA>
 	{
 		const short MAINCAMERA = 0;
 	public:
-		using SingleComponentManager::SingleComponentManager;
+		using PackedComponentManager::PackedComponentManager;
 
 		CameraManager(Engine& engine);
 		~CameraManager();
@@ -131,11 +139,15 @@ namespace sfge
 		 */
 		void Update(float dt) override;
 		
+		/**
+		 * \brief The main camera is the first camera added, or one of the remaining cameras once it is destroyed
+		 */
 		Camera* GetMainCamera();
 		Camera* GetCameraCurrent();
 		void SetCameraCurrent(short newCurrent);
 
 		void Reset();
+		void Clear() override;
 		void Collect() override;
 		json Save();
 
@@ -143,11 +155,15 @@ namespace sfge
 		void CreateComponent(json& componentJson, Entity entity) override;
 		void DestroyComponent(Entity entity) override;
 	protected:
+		void LinkComponentInfo(size_t index) override;
+
 		Graphics2dManager* m_GraphicsManager;
 		Transform2dManager* m_Transform2dManager;
 		InputManager* m_InputManager;
 		std::vector<Camera> m_cameras;
 		short currentCamera = MAINCAMERA;
+		//Tracked by entity, the dense slot of a camera changes when another one is removed
+		Entity m_MainCamera = INVALID_ENTITY;
 	};
 }
 #endif
\ No newline at end of file
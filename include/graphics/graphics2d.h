@@ -35,6 +35,7 @@ SOFTWARE.
 #include <graphics/button.h>
 #include <graphics/image.h>
 #include <graphics/text.h>
+#include <graphics/render_snapshot.h>
 
 namespace sfge
 {
@@ -61,6 +62,30 @@ public:
 		* \param dt Delta time since last frame
 		*/
 	void Update(float dt) override;
+	/**
+	 * \brief Push the transforms to the tilemaps, sprites, animations and shapes without touching the window,
+	 * can run on a worker in the pipelined mode
+	 */
+	void SyncComponents(float dt);
+	/**
+	 * \brief Access of SyncComponents, GetAccess is the one of Update which also uses the window
+	 */
+	const SystemAccess& GetSyncAccess() const;
+	/**
+	 * \brief Main thread: refresh the window view from the cameras, then the copies of the view and of the window
+	 * size and position read by the simulation
+	 */
+	void UpdateCamera(float dt);
+	/**
+	 * \brief Copy the tilemaps, the visible sprites, the animations, the shapes and the window view into snapshot,
+	 * its textures are pinned until the next snapshot
+	 */
+	void TakeSnapshot(RenderSnapshot& snapshot);
+	void DrawSnapshot(RenderSnapshot& snapshot);
+	/**
+	 * \brief Empty snapshot and unpin its textures, the next Collect can free them
+	 */
+	void ReleaseSnapshot(RenderSnapshot& snapshot);
 
 	void Display();
 	/**
@@ -73,15 +98,21 @@ public:
 	void Clear() override;
 	
 	void Collect() override;
+	void ReportMemory(MemoryReport& report) const override;
 
 
 	void DrawLine(sf::Vector2f from, sf::Vector2f to, sf::Color color=sf::Color::Red);
 
 	/**
-	* \brief Getter of the window created in GraphicsManager
+	* \brief Getter of the window created in GraphicsManager, only for the main thread outside of the simulation:
+	* in the pipelined mode the main thread draws in it while the simulation runs on a worker
 	* \return The SFML window
 	*/
 	sf::RenderWindow* GetWindow();
+	/**
+	 * \brief The view, the size and the position of the window at the last UpdateCamera, safe from the simulation
+	 */
+	const sf::View& GetView() const;
 	sf::Vector2f GetSizeWindow();
 	sf::Vector2f GetPositionWindow();
 
@@ -107,6 +138,10 @@ protected:
 	CameraManager m_CameraManager{ m_Engine };
 	TilemapSystem m_TilemapSystem{ m_Engine };
 	std::unique_ptr<sf::RenderWindow> m_Window;
+	sf::View m_View;
+	sf::Vector2u m_WindowSize;
+	sf::Vector2i m_WindowPosition;
+	SystemAccess m_SyncAccess;
 };
 
 }
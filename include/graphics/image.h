@@ -85,6 +85,8 @@ namespace sfge
 
 		void OnResize(size_t newSize) override;
 	protected:
+		void LinkComponentInfo(size_t index) override;
+
 		RectTransformManager* m_RectTransformManager;
 		TextureManager* m_TextureManager;
 	};
@@ -88,6 +88,8 @@ namespace sfge
 
 		void OnResize(size_t newSize) override;
 	protected:
+		void LinkComponentInfo(size_t index) override;
+
 		CameraManager* m_CameraManager;
 	};
 }
@@ -0,0 +1,85 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SFGE_RENDER_SNAPSHOT_H
+#define SFGE_RENDER_SNAPSHOT_H
+
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/View.hpp>
+
+namespace sfge
+{
+
+/**
+ * \brief Flat copy of what the tilemaps, sprites, animations and shapes need to be drawn, taken once the simulation
+ * of a frame is done so drawing it can overlap the simulation of the next frame (see Configuration::pipelinedRendering).
+ * It draws in the order it was filled, Graphics2dManager::TakeSnapshot fills it in the order of Graphics2dManager::Draw
+ */
+class RenderSnapshot
+{
+public:
+	void Clear();
+	void AddSprite(const sf::Sprite& sprite);
+	/**
+	 * \brief The shape is copied as world space triangles of its fill color then of its outline, drawn after all
+	 * the sprites. Only untextured convex shapes, like the ones of the ShapeManager
+	 */
+	void AddShape(const sf::Shape& shape);
+	void SetView(const sf::View& view);
+
+	/**
+	 * \brief Consecutive sprites sharing a texture are batched in one draw call
+	 */
+	void Draw(sf::RenderTarget& target);
+	size_t GetSpriteNmb() const;
+	/**
+	 * \brief Textures read by Draw, they must stay alive until the snapshot is replaced
+	 */
+	const std::vector<const sf::Texture*>& GetTextures() const;
+private:
+	void Flush(sf::RenderTarget& target, const sf::Texture* texture);
+
+	std::vector<sf::Vector2f> m_Positions;
+	std::vector<sf::Vector2f> m_Origins;
+	std::vector<sf::Vector2f> m_Scales;
+	std::vector<float> m_Rotations;
+	std::vector<const sf::Texture*> m_Textures;
+	std::vector<sf::IntRect> m_TextureRects;
+	std::vector<sf::Color> m_Colors;
+	sf::VertexArray m_ShapeVertices{ sf::Triangles };
+	sf::View m_View;
+
+	sf::VertexArray m_Vertices{ sf::Quads };
+};
+
+}
+
+#endif
@@ -53,16 +53,23 @@ public:
 	Shape(Transform2d* transform, sf::Vector2f offset);
   	Shape ( Shape && ) = default; //move constructor
   	Shape ( const Shape & ) = delete; //delete copy constructor
+  	Shape& operator=( Shape && ) = default; //move assignment used by the packed storage
   	virtual ~Shape();
 	void Draw(sf::RenderWindow& window) const;
 	void SetFillColor(sf::Color color) const;
-	void Update(float dt, Transform2d* transform) const;
+	void Update(float dt, const Transform2d* transform) const;
 	void SetShape(std::unique_ptr<sf::Shape> shape);
 	sf::Shape* GetShape();
 protected:
 	std::unique_ptr<sf::Shape> m_Shape = nullptr;
 };
 
+template<>
+struct ComponentTypeOf<Shape>
+{
+	static constexpr ComponentType value = ComponentType::SHAPE2D;
+};
+
 namespace editor
 {
 
@@ -70,21 +77,25 @@ struct ShapeInfo : ComponentInfo
 {
 
 	void DrawOnInspector() override;
-	Shape* shapePtr;
+	Shape* shapePtr = nullptr;
 };
 
 }
 
 class ShapeManager :
-	public SingleComponentManager<Shape, editor::ShapeInfo, ComponentType::SHAPE2D>
+	public PackedComponentManager<Shape, editor::ShapeInfo, ComponentType::SHAPE2D>
 {
 
 public:
-	using SingleComponentManager::SingleComponentManager; 
+	using PackedComponentManager::PackedComponentManager;
 	ShapeManager(ShapeManager&& shapeManager) = default;
 
 	void Init() override;
 	void DrawShapes(sf::RenderWindow &window);
+	/**
+	 * \brief Indices of the shapes by entity, a removal does not reorder the others
+	 */
+	const std::vector<size_t>& GetDrawOrder();
 	void Update(float dt) override;
 	void Clear() override;
 
@@ -92,8 +103,9 @@ public:
 	void CreateComponent(json& componentJson, Entity entity) override;
 	void DestroyComponent(Entity entity) override;
 
-	void OnResize(size_t new_size) override;
 protected:
+	void LinkComponentInfo(size_t index) override;
+
 	Transform2dManager* m_Transform2dManager;
 };
 
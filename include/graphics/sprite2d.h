@@ -50,10 +50,11 @@ public:
 	Sprite(Transform2d* transform, sf::Vector2f offset);
 
 	void Init();
-	void Update(Transform2d* transform);
+	void Update(const Transform2d* transform);
 	void Draw(sf::RenderWindow& window);
 	const sf::Texture* GetTexture();
 	void SetTexture(sf::Texture* newTexture);
+	const sf::Sprite& GetSprite() const;
 
 
 	bool is_visible;
@@ -64,6 +65,12 @@ protected:
 };
 
 
+template<>
+struct ComponentTypeOf<Sprite>
+{
+	static constexpr ComponentType value = ComponentType::SPRITE2D;
+};
+
 namespace editor
 {
 struct SpriteInfo : ComponentInfo
@@ -75,29 +82,64 @@ struct SpriteInfo : ComponentInfo
 };
 }
 
+/**
+ * \brief Texture of a prefab sprite, loaded once with the prefab
+ */
+struct SpritePrefabData
+{
+	TextureId textureId = INVALID_TEXTURE;
+	sf::Texture* texture = nullptr;
+	int layer = 0;
+	std::string texturePath;
+};
+
 /**
 * \brief Sprite manager caching all the sprites and rendering them at the end of the frame
 */
-class SpriteManager : public SingleComponentManager<Sprite, editor::SpriteInfo, ComponentType::SPRITE2D>,
+class SpriteManager : public PackedComponentManager<Sprite, editor::SpriteInfo, ComponentType::SPRITE2D>,
 	public LayerComponentManager<Sprite>
 {
 public:
-	using SingleComponentManager::SingleComponentManager;
+	using PackedComponentManager::PackedComponentManager;
 
 	void Init() override;
 	void Update(float dt) override;
 	void DrawSprites(sf::RenderWindow &window);
+	/**
+	 * \brief Indices of the sprites by layer then entity, a removal does not reorder the others
+	 */
+	const std::vector<size_t>& GetDrawOrder();
 
 	void Reset();
 	void Collect() override;
 	Sprite* AddComponent(Entity entity) override;
 	void CreateComponent(json& componentJson, Entity entity) override;
+	/**
+	 * \brief Each distinct texture is loaded once, its image decoded on the job system
+	 */
+	void CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons) override;
+	void CreateComponents(const SceneBlock& block, const EntityRange& entities) override;
+	/**
+	 * \brief Scene compiler columns: texture path string, layer
+	 */
+	static void CompileComponents(const std::vector<const json*>& componentJsons, SceneBlockBuilder& builder);
+	/**
+	 * \brief Distinct texture paths of a compiled block, decoded ahead of the creation by the scene streaming
+	 */
+	static void CollectTexturePaths(const SceneBlock& block, std::vector<std::string>& texturePaths);
+	void ResolvePrefabComponent(PrefabComponent& prefabComponent) override;
+	/**
+	 * \brief The sprite infos are only filled for the editor
+	 */
+	void InstantiatePrefabComponents(const PrefabComponent& prefabComponent, const std::vector<Entity>& entities,
+		const std::vector<Vec2f>& positions) override;
 	void DestroyComponent(Entity entity) override;
 
 	json Save();
 
-	void OnResize(size_t new_size) override;
 protected:
+	void LinkComponentInfo(size_t index) override;
+
 	Graphics2dManager* m_GraphicsManager = nullptr;
 	Transform2dManager* m_Transform2dManager = nullptr;
 };
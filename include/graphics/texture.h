@@ -64,6 +64,16 @@ public:
 	* \return The strictly positive texture id > 0, if equals 0 then the texture was not loaded
 	*/
 	TextureId LoadTexture(std::string filename);
+	/**
+	 * \brief Decode the images of the textures not loaded yet on the job system and upload them on the calling thread,
+	 * the following LoadTexture of these files only take a reference
+	 */
+	void PreloadTextures(const std::vector<std::string>& filenames);
+	/**
+	 * \brief Upload an image decoded ahead of time, nothing is done if the texture is already loaded.
+	 * Like the preloaded ones, the texture is not referenced until LoadTexture
+	 */
+	void UploadTexture(const std::string& filename, const sf::Image& image);
 	/**
 	* \brief Used after loading the texture in the texture cache to get the pointer to the texture
 	* \param text_id The texture id striclty positive
@@ -76,20 +86,39 @@ public:
 	* \return The pointer to the path texture in memory
 	*/
 	std::string GetTexturePath(TextureId textureId);
+	/**
+	 * \brief Keep the given textures alive through Clear and Collect until the next call, the textures only kept
+	 * by the previous call are released. Used for the render snapshot drawn while the next frame is simulated
+	 */
+	void PinTextures(const std::vector<const sf::Texture*>& textures);
 	
 	void Clear() override;
 
 	void Collect() override;
+	/**
+	 * \brief The loaded textures are counted as external memory, 4 bytes per texel
+	 */
+	void ReportMemory(MemoryReport& report) const override;
 
 
 private:
   	bool HasValidExtension(std::string filename);
+	/**
+	 * \brief INVALID_TEXTURE if the path was never loaded
+	 */
+	TextureId FindTextureId(const std::string& filename) const;
+	/**
+	 * \brief INVALID_TEXTURE if the texture is not owned by the manager
+	 */
+	TextureId GetTextureId(const sf::Texture* texture) const;
 	void LoadTextures(std::string dataDirname);
 
 	std::vector<std::string> m_TexturePaths = std::vector<std::string>( INIT_ENTITY_NMB * 4 );
 	std::vector<sf::Texture> m_Textures = std::vector<sf::Texture>( INIT_ENTITY_NMB * 4 );
 	std::vector<size_t> m_TextureIdsRefCounts = std::vector<size_t>( INIT_ENTITY_NMB * 4, 0 );
 	TextureId m_IncrementId = 0U;
+	//Sorted
+	std::vector<TextureId> m_PinnedTextureIds;
 };
 }
 
@@ -33,6 +33,7 @@ SOFTWARE.
  //tool_engine
 #include <engine/component.h>
 #include <graphics/tile_asset.h>
+#include <graphics/render_snapshot.h>
 #include <sfml/Graphics.hpp>
 
 namespace sfge
@@ -67,6 +68,7 @@ public:
 	 * \brief Draw all the tiles on the window
 	 */
 	void Draw(sf::RenderWindow &window);
+	const std::vector<sf::Sprite>& GetTileSprites() const;
 
 	/**
 	 * \brief Save the tilemap.
@@ -190,6 +192,12 @@ protected:
 	bool m_IsIsometric = false;
 };
 
+template<>
+struct ComponentTypeOf<Tilemap>
+{
+	static constexpr ComponentType value = ComponentType::TILEMAP;
+};
+
 namespace editor
 {
 struct TilemapInfo : ComponentInfo
@@ -207,6 +215,10 @@ public:
 	void Init() override;
 	void Update(float dt) override;
 	void Draw(sf::RenderWindow &window);
+	/**
+	 * \brief Copy the tiles in the snapshot in the draw order of the tilemaps
+	 */
+	void TakeSnapshot(RenderSnapshot& snapshot);
 
 	void Clear();
 	void Collect() override;
@@ -215,6 +227,10 @@ public:
 
 	Tilemap* AddComponent(Entity entity) override;
 	void CreateComponent(json& componentJson, Entity entity) override;
+	/**
+	 * \brief The tilemap files are loaded and their tile types decoded on the job system
+	 */
+	void CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons) override;
 	void UpdateTile(Entity tilemapEntity, Vec2f pos, TileTypeId tileTypeId);
 	void DestroyComponent(Entity entity) override;
 	void OnResize(size_t new_size) override;
@@ -271,6 +287,21 @@ public:
 	 */
 	std::vector<Entity> GetAllTilemaps();
 protected:
+	/**
+	 * \brief Tilemap json of a component and its decoded tile types, read without touching the manager
+	 */
+	struct TilemapData
+	{
+		json loadedJson;
+		const json* tilemapJson = nullptr;
+		std::vector<TileTypeId> tileTypeIds;
+		Vec2f mapSize;
+	};
+	static bool ReadTilemapData(const json& componentJson, TilemapData& tilemapData);
+	static bool DecodeTileTypes(const json& map, std::vector<TileTypeId>& tileTypeIds, Vec2f& mapSize);
+	void CreateTilemap(Entity entity, const TilemapData& tilemapData);
+	void LinkComponentInfo(size_t index) override;
+
 	std::vector<Entity> m_Tilemaps;
 	std::vector<Entity> m_OrderToDrawTilemaps;
 
@@ -296,6 +327,7 @@ public:
 	void Update(float dt) override;
 
 	void DrawTilemaps(sf::RenderWindow &window);
+	void TakeSnapshot(RenderSnapshot& snapshot);
 
 	void Destroy() override;
 
@@ -304,6 +336,7 @@ public:
 	void Collect() override;
 
 	json Save();
+	void ReportMemory(MemoryReport& report) const override;
 
 	TilemapManager* GetTilemapManager();
 	TileTypeManager* GetTileTypeManager();
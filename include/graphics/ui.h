@@ -44,6 +44,7 @@ namespace sfge
 		void Init() override;
 		void Update(float dt) override;
 		void Draw() override;
+		void ReportMemory(MemoryReport& report) const override;
 
 		ButtonManager* GetButtonManager();
 		TextManager* GetTextManager();
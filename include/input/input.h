@@ -58,6 +58,9 @@ class MouseManager : public System
 public:
 	using System::System;
 	void Update(float dt) override;
+	/**
+	 * \brief Mouse position in the view, read from the window by Update so the simulation never touches the window
+	 */
 	sf::Vector2f GetLocalPosition() const;
 	sf::Vector2i GetWorldPosition() const;
 	bool IsButtonHeld(sf::Mouse::Button button) const;
@@ -66,6 +69,7 @@ public:
 	
 private:
 	std::array<KeyPressedStatus, sf::Mouse::Button::ButtonCount> buttonPressedStatusArray = {};
+	sf::Vector2f m_LocalPosition;
 };
 /**
 * \brief Handles Input like the Keyboard, the Joystick or the Mouse
@@ -51,6 +51,12 @@ private:
 	b2Body * m_Body = nullptr;
 };
 
+template<>
+struct ComponentTypeOf<Body2d>
+{
+	static constexpr ComponentType value = ComponentType::BODY2D;
+};
+
 namespace editor
 {
 struct Body2dInfo : ComponentInfo
@@ -77,6 +83,8 @@ public:
 
 	void OnResize(size_t new_size) override;
 
+protected:
+	void LinkComponentInfo(size_t index) override;
 private:
 	Transform2dManager* m_Transform2dManager;
 	std::weak_ptr<b2World> m_WorldPtr;
@@ -26,6 +26,8 @@ SOFTWARE.
 #ifndef SFGE_COLLIDER_H
 #define SFGE_COLLIDER_H
 
+#include <memory>
+
 #include <engine/entity.h>
 #include <Box2D/Box2D.h>
 #include <physics/body2d.h>
@@ -48,6 +50,16 @@ struct ColliderData
 	b2Fixture* fixture = nullptr;
 	b2Body* body = nullptr;
 };
+/**
+ * \brief Fixture read from a collider json, the shape can be shared by all the colliders of a prefab
+ * since Box2D clones it in each fixture
+ */
+struct ColliderDef
+{
+	b2FixtureDef fixtureDef;
+	std::shared_ptr<b2Shape> shape;
+};
+
 namespace editor
 {
 struct ColliderInfo : ComponentInfo
@@ -63,11 +75,29 @@ public:
 	void Init() override;
 	ColliderData* AddComponent(Entity entity) override;
 	void CreateComponent(json& componentJson, Entity entity)override;
+	/**
+	 * \brief The collider shape is built once for the prefab
+	 */
+	void ResolvePrefabComponent(PrefabComponent& prefabComponent) override;
+	void InstantiatePrefabComponents(const PrefabComponent& prefabComponent, const std::vector<Entity>& entities,
+		const std::vector<Vec2f>& positions) override;
+	/**
+	 * \brief Without a shape if the collider type is missing or invalid
+	 */
+	static ColliderDef ReadColliderJson(const json& componentJson);
 	void DestroyComponent(Entity entity) override;
   	ColliderData* GetComponentPtr(Entity entity) override;
+	/**
+	 * \brief The infos of the colliders are only linked to them when the entity is inspected
+	 */
+	void DrawOnInspector(Entity entity) override;
 protected:
 
   	int GetFreeComponentIndex() override;
+	/**
+	 * \brief Add the fixture to the body of the entity, which must have a Body2d
+	 */
+	void CreateCollider(Entity entity, const ColliderDef& colliderDef);
 	Body2dManager* m_BodyManager;
 };
 
@@ -85,6 +85,10 @@ public:
 
 	void Clear() override;
 	void Collect() override;
+	/**
+	 * \brief The b2World allocations are estimated from its bodies, fixtures, contacts and proxies
+	 */
+	void ReportMemory(MemoryReport& report) const override;
 
 
 	Body2dManager* GetBodyManager();
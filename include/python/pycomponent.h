@@ -106,9 +106,17 @@ public:
 	void FixedUpdate() override;
 
 	void CreateComponent(json& componentJson, Entity entity) override;
+	/**
+	 * \brief The script module is imported once for the prefab
+	 */
+	void ResolvePrefabComponent(PrefabComponent& prefabComponent) override;
+	void InstantiatePrefabComponents(const PrefabComponent& prefabComponent, const std::vector<Entity>& entities,
+		const std::vector<Vec2f>& positions) override;
 	virtual PyBehavior** AddComponent(Entity entity) override;
 	virtual void DestroyComponent(Entity entity) override;
+	void DestroyComponents(const std::vector<Entity>& entities) override;
 	virtual PyBehavior** GetComponentPtr(Entity entity) override;
+	void DrawOnInspector(Entity entity) override;
 
 	void OnTriggerEnter(Entity entity, ColliderData* colliderData);
 	void OnTriggerExit(Entity entity, ColliderData* colliderData);
@@ -116,6 +124,7 @@ public:
 	void OnCollisionExit(Entity entity, ColliderData* colliderData);
 
 	void OnResize(size_t newSize) override;
+	void ReportMemory(MemoryReport& report) const override;
 
 	void RemovePyComponentsFrom(Entity entity);
 
@@ -135,6 +144,10 @@ public:
 	InstanceId LoadPyComponent(ModuleId moduleId, Entity entity);
 
 	void InitPyComponents();
+	/**
+	 * \brief The components are not updated until the next InitPyComponents, for a scene created over several frames
+	 */
+	void PauseUntilInit();
 protected:
 	int GetFreeComponentIndex() override;
 	std::vector<py::object> m_PythonInstances = std::vector<py::object>( INIT_ENTITY_NMB * MULTIPLE_COMPONENTS_MULTIPLIER );
@@ -144,6 +157,7 @@ protected:
 	InstanceId m_IncrementalInstanceId = 1U;
 
 	PythonEngine* m_PythonEngine = nullptr;
+	bool m_Paused = false;
 };
 
 
@@ -38,12 +38,18 @@ using ModuleId = unsigned;
 class PySystem : public System
 {
 public:
-	using System::System;
+	/**
+	 * \brief A Python system may touch every component and create entities until it calls declare_access
+	 */
+	PySystem(Engine& engine);
 	void Init() override;
 	void Update(float dt) override;
 	void FixedUpdate() override;
 	void Draw() override;
-
+	//Let the Python systems declare their tick policy
+	using System::SetTickRate;
+	using System::SetStaggerFrameNmb;
+	using System::DeclareAccess;
 };
 
 class PySystemManager : public System
@@ -54,6 +60,7 @@ public:
 	void Init() override;
 
 	void Destroy() override;
+	void ReportMemory(MemoryReport& report) const override;
 
 	InstanceId LoadPySystem(ModuleId moduleId);
 	InstanceId LoadCppExtensionSystem(std::string systemClassName);
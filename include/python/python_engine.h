@@ -75,6 +75,7 @@ public:
 
 	void Collect() override;
 	void Clear() override;
+	void ReportMemory(MemoryReport& report) const override;
 
 	ModuleId LoadPyModule(std::string moduleFilename);
 
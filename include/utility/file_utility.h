@@ -32,6 +32,8 @@ namespace fs = std::experimental::filesystem;
 #endif
 #include <string>
 #include <fstream>
+#include <cstddef>
+#include <cstdint>
 
 namespace sfge
 {	
@@ -51,6 +53,42 @@ bool CreateDirectory(const std::string& dirname);
 bool RemoveDirectory(const std::string& dirname, bool removeAll=true);
 
 bool CopyFile(const std::string& source, const std::string& destination);
+
+/**
+ * \brief Last modification time of the file in the filesystem clock ticks, seconds on macOS, 0 if it does not exist
+ */
+std::int64_t GetFileWriteTime(const std::string& filename);
+
+/**
+ * \brief Size in bytes from the filesystem metadata, without opening the file, 0 if it does not exist
+ */
+std::uint64_t GetFileSize(const std::string& filename);
+
+/**
+ * \brief Read-only memory mapping of a whole file, the pages are loaded by the OS on first access
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& filename);
+	void Close();
+	bool IsOpen() const;
+
+	const std::byte* GetData() const;
+	size_t GetSize() const;
+private:
+	const std::byte* m_Data = nullptr;
+	size_t m_Size = 0;
+#ifdef WIN32
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#endif
+};
 }
 
 #endif
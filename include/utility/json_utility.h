@@ -37,10 +37,10 @@ using json = nlohmann::json;
 namespace sfge
 {
 	bool IsJsonValueNumeric(const json::value_type& jsonValue);
-	bool CheckJsonExists(const json& jsonObject, std::string parameterName);
-	bool CheckJsonParameter(const json& jsonObject, std::string parameterName, json::value_t expectedType);
-	bool CheckJsonNumber(const json& jsonObject, std::string parameterName);
-	sf::Vector2f GetVectorFromJson(const json& jsonObject, std::string parameterName);
+	bool CheckJsonExists(const json& jsonObject, const std::string& parameterName);
+	bool CheckJsonParameter(const json& jsonObject, const std::string& parameterName, json::value_t expectedType);
+	bool CheckJsonNumber(const json& jsonObject, const std::string& parameterName);
+	sf::Vector2f GetVectorFromJson(const json& jsonObject, const std::string& parameterName);
 	std::unique_ptr<json> LoadJson(std::string jsonPath);
 }
 #endif
@@ -48,6 +48,32 @@ private:
 	float m_Time;
 	float m_Period;
 };
+
+/**
+ * \brief Accumulates the frame time and gives the number of fixed steps to run, at most maxSteps per frame
+ * so a slow frame cannot make the next ones slower. The time past the cap is dropped
+ */
+class FixedTimestep
+{
+public:
+	FixedTimestep(float fixedDeltaTime, unsigned maxSteps);
+	/**
+	 * \brief Add the frame time and return the number of fixed steps to run
+	 */
+	unsigned Advance(float dt);
+	/**
+	 * \brief Part of a fixed step left in the accumulator, between 0 and 1,
+	 * used to interpolate between the states before and after the last fixed step
+	 */
+	float GetInterpolationFactor() const;
+	float GetFixedDeltaTime() const;
+	void SetFixedDeltaTime(float fixedDeltaTime);
+	void SetMaxSteps(unsigned maxSteps);
+private:
+	float m_FixedDeltaTime;
+	unsigned m_MaxSteps;
+	float m_Accumulator = 0.0f;
+};
 }
 
 #endif /* INCLUDE_UTILITY_TIME_UTILITY_H_ */
@@ -37,16 +37,13 @@ class PirateManager(System):
         self.bullets = []
         entity_manager.resize(self.piratesNmb*2)
         random.seed = 0
-        for i in range(self.piratesNmb):
-            print("Creating pirate "+str(i))
-            new_entity = entity_manager.create_entity(i+1)
-            transform = transform2d_manager.add_component(new_entity)
-            transform.position = Vec2f(random.randint(0, size_x),
-                                          random.randint(0, size_y))
-            sprite = graphics2d_manager.sprite_manager.create_component(new_entity, "data/pirates/Ships/ship (1).png")
-
+        # The ship texture is loaded once with the prefab and all the pirates are created in one call
+        ship_prefab = scene_manager.load_prefab("data/prefabs/pirate_ship.prefab")
+        positions = [Vec2f(random.randint(0, size_x), random.randint(0, size_y)) for i in range(self.piratesNmb)]
+        print("Creating "+str(self.piratesNmb)+" pirates")
+        for new_entity in scene_manager.instantiate_prefab(ship_prefab, positions):
             pirate_data = PirateData()
-            pirate_data.transform = transform
+            pirate_data.transform = transform2d_manager.get_component(new_entity)
             pirate_data.entity = new_entity
             #self.pirates.append(python_engine.load_pycomponent(new_entity, "scripts/pirate.py"))
             self.pirates.append(pirate_data)
@@ -6,5 +6,7 @@ class SwitchScene(Component):
         pass
 
     def update(self, dt):
+        if scene_manager.is_loading_scene():
+            return
         if input_manager.keyboard.is_key_down(KeyboardManager.Key.Space):
-            scene_manager.load_scene("SceneTest")
\ No newline at end of file
+            scene_manager.load_scene_async("SceneTest")
\ No newline at end of file
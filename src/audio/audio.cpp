@@ -62,6 +62,14 @@ void AudioManager::Collect()
 {
 	m_SoundManager.Collect();
 }
+
+void AudioManager::ReportMemory(MemoryReport& report) const
+{
+	report.SetSystem("SoundManager");
+	m_SoundManager.ReportMemory(report);
+	report.SetSystem("SoundBufferManager");
+	m_SoundBufferManager.ReportMemory(report);
+}
 void AudioManager::Destroy()
 {
 	Clear();
@@ -175,6 +175,16 @@ Sound *SoundManager::GetComponentPtr(Entity entity)
 	return nullptr;
 }
 
+void SoundManager::DrawOnInspector(Entity entity)
+{
+	//The infos are indexed by channel like the sounds, they are written when the sound is added
+	for (auto i = 0u; i < m_Components.size(); i++)
+	{
+		if (m_Components[i].GetEntity() == entity)
+			m_ComponentsInfo[i].DrawOnInspector();
+	}
+}
+
 int SoundManager::GetFreeComponentIndex()
 {
 	for (auto i = 0u; i < MAX_SOUND_CHANNELS; i++)
@@ -288,6 +298,22 @@ void SoundBufferManager::Collect()
 	}
 }
 
+void SoundBufferManager::ReportMemory(MemoryReport& report) const
+{
+	report.AddContainer("SoundBufferPaths", m_SoundBufferPaths);
+	report.AddContainer("SoundBufferCountRefs", m_SoundBufferCountRefs);
+	size_t sampleBytes = 0;
+	for (const auto& soundBuffer : m_SoundBuffers)
+	{
+		if (soundBuffer != nullptr)
+		{
+			sampleBytes += static_cast<size_t>(soundBuffer->getSampleCount()) * sizeof(sf::Int16) + sizeof(sf::SoundBuffer);
+		}
+	}
+	report.Add("SoundBuffers", m_SoundBuffers.size() * sizeof(std::unique_ptr<sf::SoundBuffer>),
+		m_SoundBuffers.capacity() * sizeof(std::unique_ptr<sf::SoundBuffer>), sampleBytes);
+}
+
 SoundBufferId SoundBufferManager::LoadSoundBuffer(std::string filename)
 {
 	if(!FileExists (filename))
@@ -0,0 +1,449 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <engine/engine.h>
+#include <engine/entity.h>
+#include <engine/scene.h>
+#include <engine/component.h>
+#include <engine/memory_report.h>
+#include <graphics/shape2d.h>
+#include <utility/log.h>
+
+/**
+ * \brief Heap allocations of the whole process, counted by the replaced global operator new
+ */
+static std::atomic<size_t> g_HeapAllocationNmb{0};
+
+void* operator new(size_t size)
+{
+	g_HeapAllocationNmb.fetch_add(1, std::memory_order_relaxed);
+	if (void* data = std::malloc(size == 0 ? 1 : size))
+		return data;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept
+{
+	std::free(data);
+}
+
+void operator delete(void* data, size_t) noexcept
+{
+	std::free(data);
+}
+
+/**
+ * \brief SFGE_BENCH [--scene path] [--entities nmb] [--frames nmb] [--dt seconds] [--seed nmb] [--json path] [--csv path]
+ * [--layout-entities nmb]
+ */
+struct BenchOptions
+{
+	std::string scenePath;
+	size_t entityNmb = 10'000;
+	/**
+	 * \brief Entities of the component layout comparison, 0 skips it
+	 */
+	size_t layoutEntityNmb = 100'000;
+	size_t frameNmb = 600;
+	float dt = 0.0f;
+	unsigned seed = 42;
+	std::string jsonPath = "bench_results.json";
+	std::string csvPath;
+};
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		if (i + 1 >= argc)
+		{
+			std::ostringstream oss;
+			oss << "[Error] Missing value after " << arg;
+			sfge::Log::GetInstance()->Error(oss.str());
+			return false;
+		}
+		const std::string value = argv[++i];
+		if (arg == "--scene")
+			options.scenePath = value;
+		else if (arg == "--entities")
+			options.entityNmb = std::stoul(value);
+		else if (arg == "--frames")
+			options.frameNmb = std::stoul(value);
+		else if (arg == "--dt")
+			options.dt = std::stof(value);
+		else if (arg == "--seed")
+			options.seed = static_cast<unsigned>(std::stoul(value));
+		else if (arg == "--json")
+			options.jsonPath = value;
+		else if (arg == "--csv")
+			options.csvPath = value;
+		else if (arg == "--layout-entities")
+			options.layoutEntityNmb = std::stoul(value);
+		else
+		{
+			std::ostringstream oss;
+			oss << "[Error] Unknown benchmark option " << arg;
+			sfge::Log::GetInstance()->Error(oss.str());
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Entities with a transform, a circle shape and a dynamic body, scattered with a seeded generator
+ */
+json CreateStressScene(size_t entityNmb, unsigned seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<float> distribution(0.0f, 10'000.0f);
+	json sceneJson;
+	sceneJson["name"] = "Stress Scene";
+	sceneJson["entities"] = json::array();
+	auto& entitiesJson = sceneJson["entities"];
+	for (size_t i = 0; i < entityNmb; i++)
+	{
+		json transformJson;
+		transformJson["type"] = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+		transformJson["position"] = { distribution(generator), distribution(generator) };
+		json shapeJson;
+		shapeJson["type"] = static_cast<int>(sfge::ComponentType::SHAPE2D);
+		shapeJson["shape_type"] = static_cast<int>(sfge::ShapeType::CIRCLE);
+		shapeJson["radius"] = 5.0f;
+		json bodyJson;
+		bodyJson["type"] = static_cast<int>(sfge::ComponentType::BODY2D);
+		bodyJson["body_type"] = static_cast<int>(b2_dynamicBody);
+		json entityJson;
+		entityJson["components"] = json::array({ transformJson, shapeJson, bodyJson });
+		entitiesJson.push_back(std::move(entityJson));
+	}
+	return sceneJson;
+}
+
+struct LayoutComponent
+{
+	void Update(float dt)
+	{
+		position += velocity * dt;
+	}
+	sfge::Vec2f position;
+	sfge::Vec2f velocity{1.0f, 1.0f};
+	float payload[12] = {};
+};
+
+struct LayoutComponentInfo : sfge::editor::ComponentInfo
+{
+	void DrawOnInspector() override {}
+};
+
+/**
+ * \brief Entity-indexed layout: one slot per entity, iterated through the concerned entities
+ */
+class EntityIndexedLayoutManager :
+	public sfge::SingleComponentManager<LayoutComponent, LayoutComponentInfo, sfge::ComponentType::NONE>
+{
+public:
+	using SingleComponentManager::SingleComponentManager;
+	LayoutComponent* AddComponent(Entity entity) override
+	{
+		AddConcernedEntity(entity);
+		return GetComponentPtr(entity);
+	}
+	void CreateComponent(json& componentJson, Entity entity) override { (void) componentJson; AddComponent(entity); }
+	void DestroyComponent(Entity entity) override { RemoveConcernedEntity(entity); }
+	void Update(float dt) override
+	{
+		for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
+			m_Components[m_ConcernedEntities[i] - 1].Update(dt);
+	}
+};
+
+/**
+ * \brief Packed sparse-set layout: only the live components, contiguous
+ */
+class PackedLayoutManager :
+	public sfge::PackedComponentManager<LayoutComponent, LayoutComponentInfo, sfge::ComponentType::NONE>
+{
+public:
+	using PackedComponentManager::PackedComponentManager;
+	LayoutComponent* AddComponent(Entity entity) override
+	{
+		return EmplacePackedComponent(entity);
+	}
+	void CreateComponent(json& componentJson, Entity entity) override { (void) componentJson; AddComponent(entity); }
+	void DestroyComponent(Entity entity) override { RemovePackedComponent(entity); }
+	void Update(float dt) override
+	{
+		for (auto i = 0u; i < m_Components.size(); i++)
+			m_Components[i].Update(dt);
+	}
+};
+
+/**
+ * \brief Update time of the entity-indexed and the packed component layouts at 1, 10 and 100% of the entities
+ */
+json BenchComponentLayouts(sfge::Engine& engine, const BenchOptions& options)
+{
+	const int updateIteration = 100;
+	std::mt19937 generator(options.seed);
+	json layoutsJson = json::array();
+	for (int density : {1, 10, 100})
+	{
+		EntityIndexedLayoutManager entityIndexedManager(engine);
+		PackedLayoutManager packedManager(engine);
+		entityIndexedManager.OnResize(options.layoutEntityNmb);
+		packedManager.OnResize(options.layoutEntityNmb);
+
+		std::uniform_int_distribution<int> distribution(0, 99);
+		for (Entity entity = 1; entity <= options.layoutEntityNmb; entity++)
+		{
+			if (distribution(generator) < density)
+			{
+				entityIndexedManager.AddComponent(entity);
+				packedManager.AddComponent(entity);
+			}
+		}
+
+		auto updateStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < updateIteration; i++)
+			entityIndexedManager.Update(options.dt);
+		const auto entityIndexedDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - updateStart).count();
+		updateStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < updateIteration; i++)
+			packedManager.Update(options.dt);
+		const auto packedDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - updateStart).count();
+
+		json layoutJson;
+		layoutJson["density"] = density;
+		layoutJson["components"] = packedManager.GetComponents().size();
+		layoutJson["updates"] = updateIteration;
+		layoutJson["entityIndexedTime"] = entityIndexedDuration;
+		layoutJson["entityIndexedBytes"] = entityIndexedManager.GetComponents().size() * sizeof(LayoutComponent);
+		layoutJson["packedTime"] = packedDuration;
+		layoutJson["packedBytes"] = packedManager.GetComponents().capacity() * sizeof(LayoutComponent);
+		layoutsJson.push_back(layoutJson);
+	}
+	return layoutsJson;
+}
+
+/**
+ * \brief Peak resident set size of the process in bytes
+ */
+size_t GetPeakRss()
+{
+#ifdef WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return counters.PeakWorkingSetSize;
+#else
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/**
+ * \brief Headless benchmark runner: load a scene or generate a stress scene, run a fixed number of frames
+ * with a fixed dt without window, ImGui nor Remotery, and write the per-frame and per-system timings
+ */
+int main(int argc, char** argv)
+{
+	BenchOptions options;
+	if (!ParseOptions(argc, argv, options))
+		return EXIT_FAILURE;
+
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	config->systemProfiling = true;
+	if (options.dt <= 0.0f)
+		options.dt = config->fixedDeltaTime;
+	//One fixed step per frame, a frame is always the same amount of simulation
+	config->fixedDeltaTime = options.dt;
+	config->fixedStepInterpolation = false;
+	engine.Init(std::move(config));
+	//Keep every sample of the run, a few systems per frame on each thread
+	auto& profiler = engine.GetSystemProfiler();
+	profiler.Init(engine.GetJobSystem(), options.frameNmb * 32);
+
+	const auto loadStart = std::chrono::high_resolution_clock::now();
+	if (options.scenePath.empty())
+	{
+		auto sceneJson = CreateStressScene(options.entityNmb, options.seed);
+		engine.GetSceneManager()->LoadSceneFromJson(sceneJson);
+	}
+	else
+	{
+		engine.GetSceneManager()->LoadSceneFromPath(options.scenePath);
+	}
+	const auto loadDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - loadStart).count();
+	const auto entityNmb = engine.GetEntityManager()->GetAliveEntities().Count();
+
+	std::vector<std::int64_t> frameDurations;
+	std::vector<size_t> frameAllocations;
+	frameDurations.reserve(options.frameNmb);
+	frameAllocations.reserve(options.frameNmb);
+	for (size_t frame = 0; frame < options.frameNmb; frame++)
+	{
+		const auto allocationStart = g_HeapAllocationNmb.load(std::memory_order_relaxed);
+		const auto frameStart = std::chrono::high_resolution_clock::now();
+		engine.Step(options.dt);
+		frameDurations.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::high_resolution_clock::now() - frameStart).count());
+		frameAllocations.push_back(g_HeapAllocationNmb.load(std::memory_order_relaxed) - allocationStart);
+	}
+	const auto peakRss = GetPeakRss();
+	sfge::MemoryReport memoryReport;
+	engine.ReportMemory(memoryReport);
+
+	json resultJson;
+	resultJson["scene"] = options.scenePath.empty() ? "stress" : options.scenePath;
+	resultJson["entities"] = entityNmb;
+	resultJson["frames"] = options.frameNmb;
+	resultJson["dt"] = options.dt;
+	resultJson["threads"] = engine.GetJobSystem().GetThreadNmb();
+	resultJson["loadTime"] = loadDuration;
+	{
+		const auto& loadingTimes = engine.GetSceneManager()->GetLoadingTimes();
+		json phasesJson;
+		phasesJson["parse"] = loadingTimes.parse;
+		phasesJson["systems"] = loadingTimes.systems;
+		phasesJson["entities"] = loadingTimes.entities;
+		phasesJson["components"] = json::array();
+		for (const auto& componentTime : loadingTimes.components)
+		{
+			phasesJson["components"].push_back({ { "type", static_cast<int>(componentTime.first) },
+				{ "duration", componentTime.second } });
+		}
+		phasesJson["finish"] = loadingTimes.finish;
+		resultJson["loadPhases"] = phasesJson;
+	}
+	resultJson["peakRss"] = peakRss;
+	resultJson["frameTimes"] = frameDurations;
+	resultJson["frameAllocations"] = frameAllocations;
+	resultJson["systems"] = json::array();
+	const auto systemStats = profiler.ComputeStats();
+	for (const auto& stats : systemStats)
+	{
+		json statsJson;
+		statsJson["name"] = stats.name;
+		statsJson["samples"] = stats.sampleNmb;
+		statsJson["min"] = stats.min;
+		statsJson["avg"] = stats.avg;
+		statsJson["p99"] = stats.p99;
+		resultJson["systems"].push_back(statsJson);
+	}
+	if (options.layoutEntityNmb > 0)
+	{
+		resultJson["componentLayouts"] = BenchComponentLayouts(engine, options);
+	}
+	resultJson["memory"] = json::array();
+	for (const auto& usage : memoryReport.GetUsages())
+	{
+		json usageJson;
+		usageJson["system"] = usage.system;
+		usageJson["container"] = usage.container;
+		usageJson["used"] = usage.usedBytes;
+		usageJson["capacity"] = usage.capacityBytes;
+		usageJson["external"] = usage.externalBytes;
+		resultJson["memory"].push_back(usageJson);
+	}
+	if (!options.jsonPath.empty())
+	{
+		std::ofstream jsonFile(options.jsonPath);
+		jsonFile << resultJson.dump(4);
+	}
+	if (!options.csvPath.empty())
+	{
+		//The frames, the systems and the memory, in files next to each other
+		std::ofstream framesFile(options.csvPath + "_frames.csv");
+		framesFile << "frame,time_us,heap_allocations\n";
+		for (size_t frame = 0; frame < frameDurations.size(); frame++)
+		{
+			framesFile << frame << "," << frameDurations[frame] << "," << frameAllocations[frame] << "\n";
+		}
+		std::ofstream systemsFile(options.csvPath + "_systems.csv");
+		systemsFile << "system,samples,min_us,avg_us,p99_us,entities,peak_rss\n";
+		for (const auto& stats : systemStats)
+		{
+			systemsFile << stats.name << "," << stats.sampleNmb << "," << stats.min << "," << stats.avg << ","
+				<< stats.p99 << "," << entityNmb << "," << peakRss << "\n";
+		}
+		std::ofstream memoryFile(options.csvPath + "_memory.csv");
+		memoryFile << "system,container,used_bytes,capacity_bytes,external_bytes\n";
+		for (const auto& usage : memoryReport.GetUsages())
+		{
+			memoryFile << usage.system << "," << usage.container << "," << usage.usedBytes << ","
+				<< usage.capacityBytes << "," << usage.externalBytes << "\n";
+		}
+	}
+
+	std::int64_t totalDuration = 0;
+	for (const auto duration : frameDurations)
+	{
+		totalDuration += duration;
+	}
+	size_t totalAllocations = 0;
+	for (const auto allocationNmb : frameAllocations)
+	{
+		totalAllocations += allocationNmb;
+	}
+	std::ostringstream oss;
+	oss << "Bench " << resultJson["scene"].get<std::string>() << ": " << entityNmb << " entities, "
+		<< options.frameNmb << " frames, avg frame " << (frameDurations.empty() ? 0 : totalDuration / static_cast<std::int64_t>(frameDurations.size()))
+		<< " us, avg heap allocations per frame " << (frameAllocations.empty() ? 0 : totalAllocations / frameAllocations.size())
+		<< ", peak RSS " << peakRss / (1024 * 1024) << " MB, engine containers "
+		<< memoryReport.GetCapacityBytes() / (1024 * 1024) << " MB";
+	sfge::Log::GetInstance()->Msg(oss.str());
+	engine.Destroy();
+	return EXIT_SUCCESS;
+}
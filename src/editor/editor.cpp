@@ -98,15 +98,12 @@ void Editor::Update(float dt)
 			ImGui::SetNextWindowSize(ImVec2(150.0f, configPtr->screenResolution.y), ImGuiCond_FirstUseEver);
 			ImGui::Begin("Entities");
 			
-			for (auto i = 0u; i < configPtr->currentEntitiesNmb; i++)
+			for (Entity entity : m_EntityManager->GetAliveEntities())
 			{
-				if(m_EntityManager->GetMask(i+1) != INVALID_ENTITY)
+				auto& entityInfo = m_EntityManager->GetEntityInfo(entity);
+				if(ImGui::Selectable(entityInfo.name.c_str(), selectedEntity == entity))
 				{
-					auto& entityInfo = m_EntityManager->GetEntityInfo(i+1);
-					if(ImGui::Selectable(entityInfo.name.c_str(), selectedEntity-1 == i))
-					{
-						selectedEntity = i + 1;
-					}
+					selectedEntity = entity;
 				}
 			}
 			
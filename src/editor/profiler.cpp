@@ -28,9 +28,10 @@ SOFTWARE.
 
 namespace sfge::editor
 {
-ProfilerEditorWindow::ProfilerEditorWindow(Engine& engine): m_ProfilerFrameData(engine.GetProfilerFrameData ())
+ProfilerEditorWindow::ProfilerEditorWindow(Engine& engine): m_Engine(engine), m_ProfilerFrameData(engine.GetProfilerFrameData ()),
+  m_SystemGraph(engine.GetSystemGraph ()), m_SystemProfiler(engine.GetSystemProfiler ()), m_FrameBudget(engine.GetFrameBudget ())
 {
-
+  m_EditorBudget = m_FrameBudget.RegisterWorkload ("EditorPanels", 100, 2'000);
 }
 void ProfilerEditorWindow::Update ()
 {
@@ -38,12 +39,180 @@ void ProfilerEditorWindow::Update ()
   {
     std::ostringstream oss;
     oss << "FPS: " << 1.0f / m_ProfilerFrameData.frameTotalTime.asSeconds() << "\n"
-    << "Fixed Update: " << m_ProfilerFrameData.frameFixedUpdate.asMicroseconds() << ", " <<m_ProfilerFrameData.frameFixedUpdate.asSeconds() / m_ProfilerFrameData.frameTotalTime.asSeconds() * 100.0f << "%\n"
+    << "Fixed Update: " << m_ProfilerFrameData.frameFixedUpdate.asMicroseconds() << ", " <<m_ProfilerFrameData.frameFixedUpdate.asSeconds() / m_ProfilerFrameData.frameTotalTime.asSeconds() * 100.0f << "%, "
+    << m_ProfilerFrameData.fixedSteps << " steps\n"
     << "Graphics Update: " << m_ProfilerFrameData.graphicsTime.asMicroseconds() << ", " <<m_ProfilerFrameData.graphicsTime.asSeconds() / m_ProfilerFrameData.frameTotalTime.asSeconds() * 100.0f;
 
     ImGui::Text("%s", oss.str().c_str());
   }
+  DrawSystemGraph ();
+  DrawSystemTimings ();
+  DrawFrameBudget ();
+  DrawMemory ();
 
   ImGui::End();
 }
+
+void ProfilerEditorWindow::DrawMemory ()
+{
+  if (!ImGui::CollapsingHeader ("Memory"))
+    return;
+  if (ImGui::Button ("Refresh") || m_MemoryReport.GetUsages ().empty ())
+  {
+    m_MemoryReport.Clear ();
+    m_Engine.ReportMemory (m_MemoryReport);
+  }
+  {
+    std::ostringstream oss;
+    oss << "Used: " << m_MemoryReport.GetUsedBytes () / 1024 << " KB, allocated: "
+    << m_MemoryReport.GetCapacityBytes () / 1024 << " KB, external: " << m_MemoryReport.GetExternalBytes () / 1024 << " KB";
+    ImGui::Text ("%s", oss.str ().c_str ());
+  }
+  const auto& usages = m_MemoryReport.GetUsages ();
+  for (const auto& systemTotal : m_MemoryReport.GetSystemTotals ())
+  {
+    std::ostringstream oss;
+    oss << systemTotal.system << ": " << systemTotal.usedBytes / 1024 << " / " << systemTotal.capacityBytes / 1024 << " KB";
+    if (systemTotal.externalBytes != 0)
+    {
+      oss << " + " << systemTotal.externalBytes / 1024 << " KB external";
+    }
+    if (!ImGui::TreeNode (systemTotal.system.c_str (), "%s", oss.str ().c_str ()))
+      continue;
+    for (const auto& usage : usages)
+    {
+      if (usage.system != systemTotal.system)
+        continue;
+      std::ostringstream usageOss;
+      usageOss << usage.container << ": " << usage.usedBytes / 1024 << " / " << usage.capacityBytes / 1024 << " KB";
+      if (usage.externalBytes != 0)
+      {
+        usageOss << " + " << usage.externalBytes / 1024 << " KB external";
+      }
+      ImGui::Text ("%s", usageOss.str ().c_str ());
+    }
+    ImGui::TreePop ();
+  }
+}
+
+void ProfilerEditorWindow::DrawSystemTimings ()
+{
+  if (!ImGui::CollapsingHeader ("System Timings"))
+    return;
+  bool enabled = m_SystemProfiler.IsEnabled ();
+  if (ImGui::Checkbox ("Record", &enabled))
+  {
+    m_SystemProfiler.SetEnabled (enabled);
+  }
+  ImGui::SameLine ();
+  if (ImGui::Button ("Clear"))
+  {
+    m_SystemProfiler.Clear ();
+  }
+  ImGui::SameLine ();
+  if (ImGui::Button ("Export Chrome Trace"))
+  {
+    m_SystemProfiler.ExportChromeTrace ("sfge_trace.json");
+  }
+  ImGui::Columns (5, "SystemTimings");
+  ImGui::Text ("System");
+  ImGui::NextColumn ();
+  ImGui::Text ("Samples");
+  ImGui::NextColumn ();
+  ImGui::Text ("Min (us)");
+  ImGui::NextColumn ();
+  ImGui::Text ("Avg (us)");
+  ImGui::NextColumn ();
+  ImGui::Text ("p99 (us)");
+  ImGui::NextColumn ();
+  {
+    //Sorting the samples grows with them, the last stats are kept when it does not fit in the budget
+    BudgetTimer budgetTimer (m_FrameBudget, m_EditorBudget);
+    if (m_SystemStats.empty () || m_SystemStatsDuration < budgetTimer.GetRemaining ())
+    {
+      const auto start = ProfilerClock::now ();
+      m_SystemStats = m_SystemProfiler.ComputeStats ();
+      m_SystemStatsDuration = std::chrono::duration_cast<std::chrono::microseconds> (ProfilerClock::now () - start).count ();
+    }
+  }
+  for (const auto& stats : m_SystemStats)
+  {
+    ImGui::Text ("%s", stats.name.c_str ());
+    ImGui::NextColumn ();
+    ImGui::Text ("%zu", stats.sampleNmb);
+    ImGui::NextColumn ();
+    ImGui::Text ("%lld", static_cast<long long>(stats.min));
+    ImGui::NextColumn ();
+    ImGui::Text ("%lld", static_cast<long long>(stats.avg));
+    ImGui::NextColumn ();
+    ImGui::Text ("%lld", static_cast<long long>(stats.p99));
+    ImGui::NextColumn ();
+  }
+  ImGui::Columns (1);
+}
+
+void ProfilerEditorWindow::DrawFrameBudget ()
+{
+  if (!ImGui::CollapsingHeader ("Frame Budget"))
+    return;
+  bool enabled = m_FrameBudget.IsEnabled ();
+  if (ImGui::Checkbox ("Adaptive", &enabled))
+  {
+    m_FrameBudget.SetEnabled (enabled);
+  }
+  ImGui::Text ("Target: %lld us, average frame cost: %lld us", static_cast<long long>(m_FrameBudget.GetTargetFrameTime ()),
+    static_cast<long long>(m_FrameBudget.GetAverageFrameCost ()));
+  ImGui::Columns (3, "FrameBudget");
+  ImGui::Text ("Workload");
+  ImGui::NextColumn ();
+  ImGui::Text ("Budget (us)");
+  ImGui::NextColumn ();
+  ImGui::Text ("Used (us)");
+  ImGui::NextColumn ();
+  for (const auto& workload : m_FrameBudget.GetWorkloads ())
+  {
+    ImGui::Text ("%s", workload.name.c_str ());
+    ImGui::NextColumn ();
+    ImGui::Text ("%lld", static_cast<long long>(workload.budget));
+    ImGui::NextColumn ();
+    ImGui::Text ("%lld", static_cast<long long>(workload.lastUsed));
+    ImGui::NextColumn ();
+  }
+  ImGui::Columns (1);
+}
+
+void ProfilerEditorWindow::DrawSystemGraph ()
+{
+  if (!ImGui::CollapsingHeader ("System Graph"))
+    return;
+  for (auto phaseIndex = 0u; phaseIndex < static_cast<unsigned>(FramePhase::LENGTH); phaseIndex++)
+  {
+    const auto phase = static_cast<FramePhase>(phaseIndex);
+    if (!ImGui::TreeNode (SystemGraph::GetPhaseName (phase)))
+      continue;
+    const auto& nodes = m_SystemGraph.GetNodes (phase);
+    for (const auto& node : nodes)
+    {
+      std::ostringstream oss;
+      oss << "[" << node.segment << "] " << node.name;
+#ifdef SFGE_PROFILE_SYSTEMS
+      oss << ": " << node.lastDuration << " us";
+#endif
+      if (node.access.exclusive)
+      {
+        oss << " (exclusive)";
+      }
+      if (!node.dependencies.empty ())
+      {
+        oss << ", after";
+        for (const auto dependency : node.dependencies)
+        {
+          oss << " " << nodes[dependency].name;
+        }
+      }
+      ImGui::Text ("%s", oss.str ().c_str ());
+    }
+    ImGui::TreePop ();
+  }
+}
 }
\ No newline at end of file
@@ -59,5 +59,19 @@ Vec2f Offsetable::GetOffset() const
 void Offsetable::SetOffset(sf::Vector2f offset)
 {
 	m_Offset = offset;
+	InvalidateTransformVersion();
+}
+
+bool Offsetable::SyncTransformVersion(TransformVersion transformVersion)
+{
+	if (m_SyncedTransformVersion == transformVersion)
+		return false;
+	m_SyncedTransformVersion = transformVersion;
+	return true;
+}
+
+void Offsetable::InvalidateTransformVersion()
+{
+	m_SyncedTransformVersion = INVALID_TRANSFORM_VERSION;
 }
 }
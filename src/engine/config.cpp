@@ -67,6 +67,22 @@ std::unique_ptr<Configuration> Configuration::LoadConfig(json& configJson)
 		);
 	}
 	newConfig->maxFramerate = configJson["maxFramerate"];
+	if (CheckJsonExists(configJson, "fixedDeltaTime"))
+		newConfig->fixedDeltaTime = configJson["fixedDeltaTime"];
+	if (CheckJsonExists(configJson, "maxFixedSteps"))
+		newConfig->maxFixedSteps = configJson["maxFixedSteps"];
+	if (CheckJsonExists(configJson, "fixedStepInterpolation"))
+		newConfig->fixedStepInterpolation = configJson["fixedStepInterpolation"];
+	if (CheckJsonExists(configJson, "pipelinedRendering"))
+		newConfig->pipelinedRendering = configJson["pipelinedRendering"];
+	if (CheckJsonExists(configJson, "systemProfiling"))
+		newConfig->systemProfiling = configJson["systemProfiling"];
+	if (CheckJsonExists(configJson, "profilerTracePath"))
+		newConfig->profilerTracePath = configJson["profilerTracePath"].get<std::string>();
+	if (CheckJsonExists(configJson, "adaptiveFrameBudget"))
+		newConfig->adaptiveFrameBudget = configJson["adaptiveFrameBudget"];
+	if (CheckJsonExists(configJson, "sceneIndexPath"))
+		newConfig->sceneIndexPath = configJson["sceneIndexPath"].get<std::string>();
 
 	if(CheckJsonExists(configJson, "devMode"))
 		newConfig->devMode = configJson["devMode"];
@@ -22,6 +22,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
 #include <memory>
 #include <iostream>
 
@@ -34,7 +35,9 @@ SOFTWARE.
 
 #include <utility/log.h>
 #include <utility/file_utility.h>
+#include <utility/time_utility.h>
 #include <engine/systems_container.h>
+#include <engine/memory_report.h>
 
 namespace sfge
 {
@@ -42,8 +45,8 @@ namespace sfge
 Engine::Engine()
 {
 	m_SystemsContainer = std::make_unique<SystemsContainer>(*this);
-
-	rmt_CreateGlobalInstance(&rmt);
+	//The main thread arena, the workers ones are added by InitModules
+	m_FrameArenas.push_back(std::make_unique<FrameArena>());
 }
 Engine::~Engine()
 {
@@ -85,7 +88,25 @@ void Engine::InitModules()
         oss << "Number of cores on machine: "<<std::thread::hardware_concurrency ();
         Log::GetInstance ()->Msg (oss.str ());
     }
-    m_ThreadPool.resize(std::thread::hardware_concurrency ()-1);
+	//Remotery opens a socket for its viewer, not wanted without window
+	if (m_Config != nullptr && !m_Config->windowLess && rmt == nullptr)
+	{
+		rmt_CreateGlobalInstance(&rmt);
+	}
+    m_JobSystem.Init(JobSystem::GetDefaultWorkerNmb());
+	m_SystemProfiler.Init(m_JobSystem);
+	m_SystemProfiler.SetEnabled(m_Config != nullptr && m_Config->systemProfiling);
+	while (m_FrameArenas.size() < m_JobSystem.GetThreadNmb())
+	{
+		m_FrameArenas.push_back(std::make_unique<FrameArena>());
+	}
+	if (m_Config != nullptr)
+	{
+		m_FixedTimestep = FixedTimestep(m_Config->fixedDeltaTime, m_Config->maxFixedSteps);
+		//The workloads are registered by the systems Init, after this
+		m_FrameBudget.Init(1'000'000 / (m_Config->maxFramerate != 0 ? m_Config->maxFramerate : 60));
+		m_FrameBudget.SetEnabled(m_Config->adaptiveFrameBudget);
+	}
 
 
 	m_SystemsContainer->entityManager.Init();
@@ -99,6 +120,14 @@ void Engine::InitModules()
     m_SystemsContainer->pythonEngine.Init();
     m_SystemsContainer->physicsManager.Init();
     m_SystemsContainer->editor.Init();
+	//The system graph registers the graphics differently when the window is left to the main thread
+	m_PipelinedRendering = m_Config != nullptr && m_Config->pipelinedRendering;
+	if (m_PipelinedRendering && m_Config->editor)
+	{
+		Log::GetInstance()->Msg("Pipelined rendering is disabled with the editor");
+		m_PipelinedRendering = false;
+	}
+	BuildSystemGraph();
 
 	m_Window = m_SystemsContainer->graphics2dManager.GetWindow();
 	running = true;
@@ -106,21 +135,25 @@ void Engine::InitModules()
 
 void Engine::Start()
 {
-	sf::Clock globalClock;
 	sf::Clock updateClock;
-	sf::Clock fixedUpdateClock;
 	sf::Clock graphicsUpdateClock;
-	sf::Time previousFixedUpdateTime = globalClock.getElapsedTime();
-	sf::Time deltaFixedUpdateTime = sf::Time();
 	sf::Time dt = sf::Time();
 
+	RenderSnapshot renderSnapshot;
+	//Without the pipelined mode the snapshot only keeps the previous scene on screen during a streamed load
+	bool previousSceneSnapshot = false;
+
 	rmt_BindOpenGL();
 	while (running && m_Window != nullptr)
 	{
 		rmt_ScopedOpenGLSample(SFGE_Frame_GL);
 		rmt_ScopedCPUSample(SFGE_Frame,0)
+		SFGE_PROFILE_SCOPE(m_SystemProfiler, "Frame");
+		m_FrameBudget.BeginFrame();
+		//The framerate limit sleeps in Display, it is not counted in the frame cost given to the FrameBudget
+		sf::Time displayTime;
+		sf::Time simulationTime;
 
-		bool isFixedUpdateFrame = false;
 		sf::Event event{};
 		while (m_Window != nullptr && 
 			m_Window->pollEvent(event))
@@ -137,58 +170,197 @@ void Engine::Start()
 		{
 			continue;
 		}
-
-        m_SystemsContainer->inputManager.Update(dt.asSeconds());
-		auto fixedUpdateTime = globalClock.getElapsedTime() - previousFixedUpdateTime;
-		if (fixedUpdateTime.asSeconds() > m_Config->fixedDeltaTime)
+		auto& sceneManager = m_SystemsContainer->sceneManager;
+		auto& graphics2dManager = m_SystemsContainer->graphics2dManager;
+		//The pipelined mode already holds the last frame of the current scene
+		if (!m_PipelinedRendering && sceneManager.IsSceneReadyToInstantiate())
 		{
-			fixedUpdateClock.restart ();
-			m_SystemsContainer->physicsManager.FixedUpdate();
-			previousFixedUpdateTime = globalClock.getElapsedTime();
-			m_SystemsContainer->pythonEngine.FixedUpdate();
-            m_SystemsContainer->sceneManager.FixedUpdate();
-			deltaFixedUpdateTime = fixedUpdateClock.getElapsedTime ();
-			m_FrameData.frameFixedUpdate = deltaFixedUpdateTime;
-			isFixedUpdateFrame = true;
+			graphics2dManager.TakeSnapshot(renderSnapshot);
+			previousSceneSnapshot = true;
+		}
+		//Out of the systems update, a streamed scene can replace the current one
+		sceneManager.UpdateSceneStreaming();
+		if (sceneManager.IsInstantiatingScene())
+		{
+			//No system runs on a half created scene and the window keeps showing the previous one,
+			//the input and the PythonEngine still run with the PyComponents of the new scene paused
+			m_SystemGraph.Run(FramePhase::INPUT, dt.asSeconds(), m_JobSystem);
+			m_SystemsContainer->pythonEngine.Update(dt.asSeconds());
+			graphicsUpdateClock.restart ();
+			graphics2dManager.DrawSnapshot(renderSnapshot);
+			m_SystemsContainer->pythonEngine.Draw();
+			{
+				sf::Clock displayClock;
+				graphics2dManager.Display();
+				displayTime = displayClock.getElapsedTime();
+			}
+			m_FrameData.graphicsTime = graphicsUpdateClock.getElapsedTime ();
+			ResetFrameArenas();
+			m_FrameBudget.EndFrame(m_FrameBudget.GetFrameElapsed() - displayTime.asMicroseconds());
+			dt = updateClock.restart();
+			m_FrameData.frameTotalTime = dt;
+			continue;
+		}
+		if (previousSceneSnapshot)
+		{
+			//The new scene is whole, the textures of the previous one can be collected
+			graphics2dManager.ReleaseSnapshot(renderSnapshot);
+			previousSceneSnapshot = false;
 		}
-        m_SystemsContainer->pythonEngine.Update(dt.asSeconds());
-
-        m_SystemsContainer->sceneManager.Update(dt.asSeconds());
-
 
-        m_SystemsContainer->editor.Update(dt.asSeconds());
-		graphicsUpdateClock.restart ();
-        m_SystemsContainer->transformManager.Update(dt.asSeconds());
+		m_SystemGraph.Run(FramePhase::INPUT, dt.asSeconds(), m_JobSystem);
+		if (m_PipelinedRendering)
+		{
+			//The next frame is simulated by the workers while the main thread draws the snapshot of the last one,
+			//the simulation leaves the window to the main thread (see Configuration::pipelinedRendering)
+			JobGroup simulationGroup;
+			m_JobSystem.Schedule(simulationGroup, [this, &dt, &simulationTime]()
+			{
+				py::gil_scoped_acquire acquire;
+				sf::Clock simulationClock;
+				Simulate(dt.asSeconds());
+				simulationTime = simulationClock.getElapsedTime();
+			});
+			{
+				py::gil_scoped_release release;
+				graphicsUpdateClock.restart ();
+				{
+					SFGE_PROFILE_SCOPE(m_SystemProfiler, "Graphics2dManager::DrawSnapshot");
+					m_SystemsContainer->graphics2dManager.DrawSnapshot(renderSnapshot);
+				}
+				m_FrameData.graphicsTime = graphicsUpdateClock.getElapsedTime ();
+				m_JobSystem.Wait(simulationGroup);
+			}
+			m_SystemsContainer->graphics2dManager.UpdateCamera(dt.asSeconds());
+			//The systems drawing straight in the window read the simulation state, they draw over the snapshot once it is done
+			graphicsUpdateClock.restart ();
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "SceneManager::Draw");
+				m_SystemsContainer->sceneManager.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "UIManager::Draw");
+				m_SystemsContainer->uiManager.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "PythonEngine::Draw");
+				m_SystemsContainer->pythonEngine.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "Graphics2dManager::Display");
+				sf::Clock displayClock;
+				m_SystemsContainer->graphics2dManager.Display();
+				displayTime = displayClock.getElapsedTime();
+			}
+			m_FrameData.graphicsTime += graphicsUpdateClock.getElapsedTime ();
+			SFGE_PROFILE_SCOPE(m_SystemProfiler, "Graphics2dManager::TakeSnapshot");
+			m_SystemsContainer->graphics2dManager.TakeSnapshot(renderSnapshot);
+		}
+		else
+		{
+			sf::Clock simulationClock;
+			Simulate(dt.asSeconds());
+			simulationTime = simulationClock.getElapsedTime();
 
-		m_SystemsContainer->rectTransformManager.Update(dt.asSeconds());
-		m_SystemsContainer->uiManager.Update(dt.asSeconds());
+			graphicsUpdateClock.restart ();
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "SceneManager::Draw");
+				m_SystemsContainer->sceneManager.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "UIManager::Draw");
+				m_SystemsContainer->uiManager.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "Graphics2dManager::Draw");
+				m_SystemsContainer->graphics2dManager.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "PythonEngine::Draw");
+				m_SystemsContainer->pythonEngine.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "Editor::Draw");
+				m_SystemsContainer->editor.Draw();
+			}
+			{
+				SFGE_PROFILE_SCOPE(m_SystemProfiler, "Graphics2dManager::Display");
+				sf::Clock displayClock;
+				m_SystemsContainer->graphics2dManager.Display();
+				displayTime = displayClock.getElapsedTime();
+			}
+			m_FrameData.graphicsTime = graphicsUpdateClock.getElapsedTime ();
+		}
 
-        m_SystemsContainer->graphics2dManager.Update(dt.asSeconds());
+		ResetFrameArenas();
+		//The pipelined simulation also runs during Display, it is at least the frame cost
+		m_FrameBudget.EndFrame(std::max<std::int64_t>(m_FrameBudget.GetFrameElapsed() - displayTime.asMicroseconds(),
+			simulationTime.asMicroseconds()));
+		dt = updateClock.restart();
+		m_FrameData.frameTotalTime = dt;
+	}
 
-		m_SystemsContainer->sceneManager.Draw();
+	rmt_UnbindOpenGL();
+	Destroy();
+}
 
-		m_SystemsContainer->uiManager.Draw();
-		m_SystemsContainer->graphics2dManager.Draw();
-		
-        m_SystemsContainer->pythonEngine.Draw();
-        m_SystemsContainer->editor.Draw();
-        m_SystemsContainer->graphics2dManager.Display();
+void Engine::Step(float dt)
+{
+	m_FrameBudget.BeginFrame();
+	{
+		SFGE_PROFILE_SCOPE(m_SystemProfiler, "Frame");
+		m_SystemsContainer->sceneManager.UpdateSceneStreaming();
+		if (!m_SystemsContainer->sceneManager.IsInstantiatingScene())
+		{
+			Simulate(dt);
+		}
+		else
+		{
+			//Like Start, the PythonEngine runs with the PyComponents of the new scene paused
+			m_SystemsContainer->pythonEngine.Update(dt);
+		}
+	}
+	ResetFrameArenas();
+	m_FrameBudget.EndFrame(m_FrameBudget.GetFrameElapsed());
+}
 
-		const sf::Time graphicsDt = graphicsUpdateClock.getElapsedTime ();
-		dt = updateClock.restart();
-		if(isFixedUpdateFrame)
+void Engine::Simulate(float dt)
+{
+	//The systems calling Python take the GIL on the thread running them, see BuildSystemGraph
+	py::gil_scoped_release release;
+	sf::Clock fixedUpdateClock;
+	//Catch up with the frame time, several fixed steps after a slow frame
+	const auto fixedSteps = m_FixedTimestep.Advance(dt);
+	if (fixedSteps > 0)
+	{
+		for (auto step = 0u; step < fixedSteps; step++)
 		{
-			m_FrameData.graphicsTime = graphicsDt;
-			m_FrameData.frameTotalTime = dt;
+			m_SystemsContainer->transformManager.SaveFixedStepState();
+			m_SystemGraph.Run(FramePhase::FIXED_UPDATE, m_FixedTimestep.GetFixedDeltaTime(), m_JobSystem);
 		}
+		m_FrameData.frameFixedUpdate = fixedUpdateClock.getElapsedTime ();
+		m_FrameData.fixedSteps = fixedSteps;
 	}
+	m_SystemsContainer->transformManager.SetInterpolationFactor(
+		m_Config->fixedStepInterpolation ? m_FixedTimestep.GetInterpolationFactor() : 1.0f);
+	m_SystemGraph.Run(FramePhase::UPDATE, dt, m_JobSystem);
+	m_SystemGraph.Run(FramePhase::RENDER_PREP, dt, m_JobSystem);
+}
 
-	rmt_UnbindOpenGL();
-	Destroy();
+void Engine::ResetFrameArenas()
+{
+	for (auto& frameArena : m_FrameArenas)
+	{
+		frameArena->Reset();
+	}
 }
 
 void Engine::Destroy() 
 {
+	if (m_Config != nullptr && !m_Config->profilerTracePath.empty())
+	{
+		m_SystemProfiler.ExportChromeTrace(m_Config->profilerTracePath);
+	}
 	m_SystemsContainer->pythonEngine.Destroy();
 	m_SystemsContainer->entityManager.Destroy();
 	m_SystemsContainer->graphics2dManager.Destroy();
@@ -197,7 +369,12 @@ void Engine::Destroy()
 	m_SystemsContainer->inputManager.Destroy();
 	m_SystemsContainer->editor.Destroy();
 	m_SystemsContainer->physicsManager.Destroy();
-	rmt_DestroyGlobalInstance(rmt);
+	m_JobSystem.Destroy();
+	if (rmt != nullptr)
+	{
+		rmt_DestroyGlobalInstance(rmt);
+		rmt = nullptr;
+	}
 }
 
 void Engine::Clear() 
@@ -271,7 +448,7 @@ void Engine::Save()
 
 	//Save of the scene file
 	//Loop on all the entities
-	for (int i = 1; i < INIT_ENTITY_NMB; i++)
+	for (Entity i : m_SystemsContainer->entityManager.GetAliveEntities())
 	{
 		// If a tile is found, we don't want to save it
 		if(m_SystemsContainer->entityManager.HasComponent(i, ComponentType::TILE))
@@ -409,9 +586,121 @@ Editor* Engine::GetEditor()
 	return m_SystemsContainer ? &m_SystemsContainer->editor : nullptr;
 }
 
-ctpl::thread_pool & Engine::GetThreadPool()
+SystemGraph& Engine::GetSystemGraph()
+{
+	return m_SystemGraph;
+}
+
+void Engine::BuildSystemGraph()
+{
+	auto& systems = *m_SystemsContainer;
+	m_SystemGraph.Clear();
+	m_SystemGraph.SetProfiler(&m_SystemProfiler);
+	//Simulate releases the GIL, the systems that can reach Python take it back on whichever thread runs them.
+	//The exclusive ones are included, they run arbitrary code on the calling thread
+	const auto withGil = [](SystemFunction function)
+	{
+		return [function](float dt)
+		{
+			py::gil_scoped_acquire acquire;
+			function(dt);
+		};
+	};
+	m_SystemGraph.AddSystem(FramePhase::INPUT, "InputManager", systems.inputManager,
+		[&systems](float dt) { systems.inputManager.Update(dt); });
+
+	//The contact listener calls the PyComponents
+	m_SystemGraph.AddSystem(FramePhase::FIXED_UPDATE, "Physics2dManager", systems.physicsManager,
+		withGil([&systems](float) { systems.physicsManager.FixedUpdate(); }));
+	m_SystemGraph.AddSystem(FramePhase::FIXED_UPDATE, "PythonEngine", systems.pythonEngine,
+		withGil([&systems](float) { systems.pythonEngine.FixedUpdate(); }));
+	m_SystemGraph.AddSystem(FramePhase::FIXED_UPDATE, "SceneManager", systems.sceneManager,
+		withGil([&systems](float) { systems.sceneManager.FixedUpdate(); }));
+
+	m_SystemGraph.AddSystem(FramePhase::UPDATE, "PythonEngine", systems.pythonEngine,
+		withGil([&systems](float dt) { systems.pythonEngine.Update(dt); }));
+	m_SystemGraph.AddSystem(FramePhase::UPDATE, "SceneManager", systems.sceneManager,
+		withGil([&systems](float dt) { systems.sceneManager.Update(dt); }));
+	//Sync point: apply the structural changes recorded during the update phase
+	m_SystemGraph.AddSystem(FramePhase::UPDATE, "EntityCommandPlayback", SystemAccess(),
+		withGil([&systems](float) { systems.entityManager.PlaybackCommands(); }));
+	m_SystemGraph.AddSystem(FramePhase::UPDATE, "Editor", systems.editor,
+		withGil([&systems](float dt) { systems.editor.Update(dt); }));
+
+	m_SystemGraph.AddSystem(FramePhase::RENDER_PREP, "Transform2dManager", systems.transformManager,
+		[&systems](float dt) { systems.transformManager.Update(dt); });
+	m_SystemGraph.AddSystem(FramePhase::RENDER_PREP, "RectTransformManager", systems.rectTransformManager,
+		[&systems](float dt) { systems.rectTransformManager.Update(dt); });
+	m_SystemGraph.AddSystem(FramePhase::RENDER_PREP, "UIManager", systems.uiManager,
+		[&systems](float dt) { systems.uiManager.Update(dt); });
+	//The pipelined mode leaves the window to the main thread, which draws the snapshot meanwhile
+	if (m_PipelinedRendering)
+	{
+		m_SystemGraph.AddSystem(FramePhase::RENDER_PREP, "Graphics2dManager", systems.graphics2dManager.GetSyncAccess(),
+			[&systems](float dt) { systems.graphics2dManager.SyncComponents(dt); });
+	}
+	else
+	{
+		m_SystemGraph.AddSystem(FramePhase::RENDER_PREP, "Graphics2dManager", systems.graphics2dManager,
+			[&systems](float dt) { systems.graphics2dManager.Update(dt); });
+	}
+	m_SystemGraph.Build();
+}
+
+JobSystem& Engine::GetJobSystem()
 {
-	return m_ThreadPool;
+	return m_JobSystem;
+}
+
+SystemProfiler& Engine::GetSystemProfiler()
+{
+	return m_SystemProfiler;
+}
+
+FrameArena* Engine::GetFrameArena()
+{
+	//A thread like the scene loading one would share the main thread arena without lock
+	if (!m_JobSystem.IsOwnThread())
+	{
+		Log::GetInstance()->Error("[Error] Frame arena requested from a thread outside the JobSystem");
+		return nullptr;
+	}
+	const auto index = m_JobSystem.GetThreadIndex();
+	if (index >= m_FrameArenas.size())
+	{
+		std::ostringstream oss;
+		oss << "[Error] No frame arena for thread: " << index;
+		Log::GetInstance()->Error(oss.str());
+		return nullptr;
+	}
+	return m_FrameArenas[index].get();
+}
+
+FrameBudget& Engine::GetFrameBudget()
+{
+	return m_FrameBudget;
+}
+
+void Engine::ReportMemory(MemoryReport& report) const
+{
+	const auto& systems = *m_SystemsContainer;
+	report.SetSystem("EntityManager");
+	systems.entityManager.ReportMemory(report);
+	report.SetSystem("Transform2dManager");
+	systems.transformManager.ReportMemory(report);
+	report.SetSystem("RectTransformManager");
+	systems.rectTransformManager.ReportMemory(report);
+	systems.graphics2dManager.ReportMemory(report);
+	systems.uiManager.ReportMemory(report);
+	systems.audioManager.ReportMemory(report);
+	report.SetSystem("PythonEngine");
+	systems.pythonEngine.ReportMemory(report);
+	systems.physicsManager.ReportMemory(report);
+	report.SetSystem("FrameArena");
+	for (size_t i = 0; i < m_FrameArenas.size(); i++)
+	{
+		report.Add("Thread " + std::to_string(i), m_FrameArenas[i]->GetUsedBytes(), m_FrameArenas[i]->GetCapacity());
+	}
 }
 
 ProfilerFrameData& Engine::GetProfilerFrameData()
@@ -26,8 +26,17 @@ SOFTWARE.
 #include <engine/config.h>
 #include <engine/entity.h>
 #include <engine/globals.h>
+#include <engine/scene.h>
+#include <engine/component.h>
+#include <utility/log.h>
 #include <python/python_engine.h>
 
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <sstream>
+#include <iterator>
+
 namespace sfge
 {
 void editor::EntityInfo::DrawOnInspector()
@@ -37,12 +46,42 @@ void editor::EntityInfo::DrawOnInspector()
 
 void EntityManager::Init()
 {
+	//One command buffer per worker of the thread pool and one for the main thread
+	m_CommandBuffers = std::vector<EntityCommandBuffer>(m_Engine.GetJobSystem().GetThreadNmb());
 	Clear();
 }
 
 void EntityManager::Clear()
 {
 	m_MaskArray = std::vector<EntityMask>(INIT_ENTITY_NMB, INVALID_ENTITY);
+	//Every entity alive before the clear becomes stale
+	for (Entity entity : GetAliveEntities())
+	{
+		m_Generations[entity - 1]++;
+	}
+	//The generations keep their high-water size, so the handles of the entities above the new size stay stale
+	if (m_Generations.size() < m_MaskArray.size())
+		m_Generations.resize(m_MaskArray.size());
+	m_AliveEntities.Clear();
+	m_AliveEntities.Resize(m_MaskArray.size());
+	for (auto& componentBitset : m_ComponentBitsets)
+	{
+		componentBitset.Clear();
+		componentBitset.Resize(m_MaskArray.size());
+	}
+
+	m_EntityInfos.clear();
+	m_FreeEntities.clear();
+	m_FreeEntities.reserve(m_MaskArray.size());
+	for (auto entity = static_cast<Entity>(m_MaskArray.size()); entity > INVALID_ENTITY; entity--)
+	{
+		m_FreeEntities.push_back(entity);
+	}
+	m_HighestEntity = INVALID_ENTITY;
+	for (auto& commandBuffer : m_CommandBuffers)
+	{
+		commandBuffer.Clear();
+	}
 }
 
 EntityMask EntityManager::GetMask(Entity entity)
@@ -52,44 +91,201 @@ EntityMask EntityManager::GetMask(Entity entity)
 
 Entity EntityManager::CreateEntity(Entity wantedEntity)
 {
-
-    if(wantedEntity == INVALID_ENTITY)
-    {
-        for (Entity entity = 1U; entity <= m_MaskArray.size(); entity++)
-        {
-            if(m_MaskArray[entity-1] == INVALID_ENTITY)
-            {
-				{
-					std::ostringstream oss;
-					oss << "Entity: " << entity;
-					m_EntityInfos[entity - 1].name = oss.str();
-				}
-                return entity;
-            }
-        }
-    }
-    else
-    {
-        if(m_MaskArray[wantedEntity-1] == INVALID_ENTITY)
-        {
+	if(wantedEntity == INVALID_ENTITY)
+	{
+		while (!m_FreeEntities.empty())
+		{
+			const Entity entity = m_FreeEntities.back();
+			m_FreeEntities.pop_back();
+			if (!m_AliveEntities.Test(entity))
 			{
-				std::ostringstream oss;
-				oss << "Entity: " << wantedEntity;
-				m_EntityInfos[wantedEntity - 1].name = oss.str();
+				ReserveEntity(entity);
+				return entity;
 			}
-        	return wantedEntity;
-        }
-    }
+		}
+	}
+	else if (wantedEntity <= m_MaskArray.size() && !m_AliveEntities.Test(wantedEntity))
+	{
+		ReserveEntity(wantedEntity);
+		return wantedEntity;
+	}
 	return INVALID_ENTITY;
 }
 
+EntityRange EntityManager::CreateEntities(size_t count)
+{
+	EntityRange range;
+	if (count == 0)
+		return range;
+	//A single entity is the top of the free list
+	if (count == 1)
+	{
+		range.first = CreateEntity(INVALID_ENTITY);
+		if (range.first != INVALID_ENTITY)
+		{
+			range.count = 1;
+			return range;
+		}
+	}
+
+	range.first = FindFreeRange(count);
+	range.count = count;
+	const size_t lastEntity = range.first + count - 1;
+	if (lastEntity > m_MaskArray.size())
+	{
+		ResizeEntityNmb(lastEntity);
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		ReserveEntity(range[i]);
+	}
+	//The free list entries of the range are now stale, they are dropped before they outnumber the entities
+	if (m_FreeEntities.size() > m_MaskArray.size())
+	{
+		CompactFreeEntities();
+	}
+	return range;
+}
+
+void EntityManager::ReserveEntities(size_t count)
+{
+	if (count == 0)
+		return;
+	const size_t lastEntity = FindFreeRange(count) + count - 1;
+	if (lastEntity > m_MaskArray.size())
+	{
+		ResizeEntityNmb(std::max(lastEntity, 2 * m_MaskArray.size()));
+	}
+}
+
+Entity EntityManager::FindFreeRange(size_t count) const
+{
+	//First fit over the runs of zero bits of the alive entities, a word at a time
+	const auto& words = m_AliveEntities.GetWords();
+	const size_t wordSize = 64;
+	const size_t entityNmb = m_MaskArray.size();
+	size_t runStart = 0;
+	size_t runLength = 0;
+	for (size_t wordIndex = 0; wordIndex < words.size(); wordIndex++)
+	{
+		const auto word = words[wordIndex];
+		size_t bitIndex = 0;
+		while (bitIndex < wordSize)
+		{
+			const auto bits = word >> bitIndex;
+			const size_t freeNmb = bits == 0U ? wordSize - bitIndex : CountTrailingZeros(bits);
+			if (freeNmb > 0)
+			{
+				if (runLength == 0)
+					runStart = wordIndex * wordSize + bitIndex;
+				runLength += freeNmb;
+				if (runLength >= count && runStart + count <= entityNmb)
+					return static_cast<Entity>(runStart + 1);
+				bitIndex += freeNmb;
+			}
+			if (bitIndex < wordSize)
+			{
+				runLength = 0;
+				const auto aliveBits = ~(word >> bitIndex);
+				bitIndex += aliveBits == 0U ? wordSize - bitIndex : CountTrailingZeros(aliveBits);
+			}
+		}
+	}
+	//The free entities at the end continue after the arrays
+	const size_t tailStart = runLength > 0 ? std::min(runStart, entityNmb) : entityNmb;
+	return static_cast<Entity>(tailStart + 1);
+}
+
+void EntityManager::CompactFreeEntities()
+{
+	m_FreeEntities.clear();
+	for (auto entity = static_cast<Entity>(m_MaskArray.size()); entity > INVALID_ENTITY; entity--)
+	{
+		if (!m_AliveEntities.Test(entity))
+			m_FreeEntities.push_back(entity);
+	}
+}
+
+void EntityManager::ReserveEntity(Entity entity)
+{
+	m_AliveEntities.Set(entity);
+	if (entity > m_HighestEntity)
+		m_HighestEntity = entity;
+}
+
 void EntityManager::DestroyEntity(Entity entity)
 {
+	if (!IsAlive(entity))
+		return;
     for(auto& destroyObserver : m_DestroyObservers)
 	{
     	destroyObserver->OnDestroy(entity);
 	}
+	auto bits = static_cast<unsigned>(m_MaskArray[entity - 1]);
+	while (bits != 0U)
+	{
+		m_ComponentBitsets[CountTrailingZeros(bits)].Reset(entity);
+		bits &= bits - 1;
+	}
 	m_MaskArray[entity-1] = INVALID_ENTITY;
+	m_AliveEntities.Reset(entity);
+	m_Generations[entity - 1]++;
+	m_FreeEntities.push_back(entity);
+	m_EntityInfos.erase(entity);
+}
+
+void EntityManager::DestroyEntities(const std::vector<Entity>& entities)
+{
+	//An entity given twice reaches the observers and is freed only once
+	std::vector<Entity> aliveEntities;
+	aliveEntities.reserve(entities.size());
+	EntityBitset listedEntities(m_MaskArray.size());
+	for (Entity entity : entities)
+	{
+		if (IsAlive(entity) && !listedEntities.Test(entity))
+		{
+			listedEntities.Set(entity);
+			aliveEntities.push_back(entity);
+		}
+	}
+	for (auto& destroyObserver : m_DestroyObservers)
+	{
+		destroyObserver->OnDestroyEntities(aliveEntities);
+	}
+	for (Entity entity : aliveEntities)
+	{
+		auto bits = static_cast<unsigned>(m_MaskArray[entity - 1]);
+		while (bits != 0U)
+		{
+			m_ComponentBitsets[CountTrailingZeros(bits)].Reset(entity);
+			bits &= bits - 1;
+		}
+		m_MaskArray[entity - 1] = INVALID_ENTITY;
+		m_AliveEntities.Reset(entity);
+		m_Generations[entity - 1]++;
+		m_FreeEntities.push_back(entity);
+		m_EntityInfos.erase(entity);
+	}
+}
+
+bool EntityManager::IsAlive(Entity entity) const
+{
+	return m_AliveEntities.Test(entity);
+}
+
+EntityHandle EntityManager::GetEntityHandle(Entity entity) const
+{
+	if (!IsAlive(entity))
+		return INVALID_ENTITY_HANDLE;
+	return MakeEntityHandle(entity, m_Generations[entity - 1]);
+}
+
+Entity EntityManager::GetEntityFromHandle(EntityHandle handle) const
+{
+	const Entity entity = GetHandleEntity(handle);
+	if (!IsAlive(entity) || m_Generations[entity - 1] != GetHandleGeneration(handle))
+		return INVALID_ENTITY;
+	return entity;
 }
 
 bool EntityManager::HasComponent(Entity entity, ComponentType componentType)
@@ -100,22 +296,93 @@ bool EntityManager::HasComponent(Entity entity, ComponentType componentType)
 void EntityManager::AddComponentType(Entity entity, ComponentType componentType)
 {
 	m_MaskArray[entity - 1] = m_MaskArray[entity - 1] | static_cast<int>(componentType);
+	auto bits = static_cast<unsigned>(componentType);
+	while (bits != 0U)
+	{
+		m_ComponentBitsets[CountTrailingZeros(bits)].Set(entity);
+		bits &= bits - 1;
+	}
+	//Entities can be used without CreateEntity, keep them out of the free list
+	if (!m_AliveEntities.Test(entity))
+	{
+		m_AliveEntities.Set(entity);
+		if (entity > m_HighestEntity)
+			m_HighestEntity = entity;
+	}
 }
 
 void EntityManager::RemoveComponentType(Entity entity, ComponentType componentType)
 {
 	m_MaskArray[entity - 1] &= ~static_cast<int>(componentType);
+	auto bits = static_cast<unsigned>(componentType);
+	while (bits != 0U)
+	{
+		m_ComponentBitsets[CountTrailingZeros(bits)].Reset(entity);
+		bits &= bits - 1;
+	}
+}
+
+EntityView EntityManager::View(EntityMask mask) const
+{
+	EntityView view;
+	auto bits = static_cast<unsigned>(mask);
+	while (bits != 0U)
+	{
+		view.AddBitset(&m_ComponentBitsets[CountTrailingZeros(bits)]);
+		bits &= bits - 1;
+	}
+	return view;
+}
+
+EntityView EntityManager::GetAliveEntities() const
+{
+	EntityView view;
+	view.AddBitset(&m_AliveEntities);
+	return view;
 }
 
 editor::EntityInfo& EntityManager::GetEntityInfo(Entity entity)
 {
-	return m_EntityInfos[entity - 1];
+	auto& entityInfo = m_EntityInfos[entity];
+	//Default names are only generated when someone asks for them
+	if (entityInfo.name.empty())
+	{
+		entityInfo.name = "Entity: " + std::to_string(entity);
+	}
+	return entityInfo;
 }
 
 void EntityManager::ResizeEntityNmb(size_t newSize)
 {
+	const size_t oldSize = m_MaskArray.size();
 	m_MaskArray.resize(newSize);
-	m_EntityInfos.resize(newSize);
+	if (m_Generations.size() < newSize)
+		m_Generations.resize(newSize);
+	m_AliveEntities.Resize(newSize);
+	for (auto& componentBitset : m_ComponentBitsets)
+	{
+		componentBitset.Resize(newSize);
+	}
+	if (newSize > oldSize)
+	{
+		//New entities go under the current free ones so lower entities are reused first
+		std::vector<Entity> newFreeEntities;
+		newFreeEntities.reserve(newSize - oldSize);
+		for (auto entity = static_cast<Entity>(newSize); entity > oldSize; entity--)
+		{
+			newFreeEntities.push_back(entity);
+		}
+		m_FreeEntities.insert(m_FreeEntities.begin(), newFreeEntities.begin(), newFreeEntities.end());
+	}
+	else
+	{
+		m_FreeEntities.erase(std::remove_if(m_FreeEntities.begin(), m_FreeEntities.end(), [newSize](Entity entity)
+		{
+			return entity > newSize;
+		}), m_FreeEntities.end());
+		if (m_HighestEntity > newSize)
+			m_HighestEntity = static_cast<Entity>(newSize);
+	}
 	for (auto* resizeObserver : m_ResizeObservers)
 	{
 		resizeObserver->OnResize(newSize);
@@ -126,6 +393,33 @@ void EntityManager::ResizeEntityNmb(size_t newSize)
 	}
 }
 
+void EntityManager::ReportMemory(MemoryReport& report) const
+{
+	report.AddContainer("Masks", m_MaskArray);
+	report.AddContainer("Generations", m_Generations);
+	report.AddContainer("FreeEntities", m_FreeEntities);
+	size_t bitsetUsedBytes = 0;
+	size_t bitsetCapacityBytes = 0;
+	const auto addBitset = [&bitsetUsedBytes, &bitsetCapacityBytes](const EntityBitset& bitset)
+	{
+		const auto& words = bitset.GetWords();
+		const auto& summary = bitset.GetSummary();
+		bitsetUsedBytes += (words.size() + summary.size()) * sizeof(std::uint64_t);
+		bitsetCapacityBytes += (words.capacity() + summary.capacity()) * sizeof(std::uint64_t);
+	};
+	addBitset(m_AliveEntities);
+	for (const auto& bitset : m_ComponentBitsets)
+	{
+		addBitset(bitset);
+	}
+	report.Add("Bitsets", bitsetUsedBytes, bitsetCapacityBytes);
+	//One node per info plus the bucket table
+	const auto infoBytes = m_EntityInfos.size() * (sizeof(std::pair<const Entity, editor::EntityInfo>) + 2 * sizeof(void*));
+	report.Add("EntityInfos", infoBytes, infoBytes + m_EntityInfos.bucket_count() * sizeof(void*));
+	report.Add("CommandBuffers", m_CommandBuffers.size() * sizeof(EntityCommandBuffer),
+		m_CommandBuffers.capacity() * sizeof(EntityCommandBuffer));
+}
+
 void EntityManager::AddResizeObserver(ResizeObserver *resizeObserver)
 {
 	m_ResizeObservers.emplace(resizeObserver);
@@ -135,4 +429,102 @@ void EntityManager::AddDestroyObserver(DestroyObserver *destroyObserver)
 	m_DestroyObservers.emplace(destroyObserver);
 }
 
+EntityCommandBuffer* EntityManager::GetCommandBuffer()
+{
+	auto& jobSystem = m_Engine.GetJobSystem();
+	//A thread like the scene loading one would share the main thread buffer without lock
+	if (!jobSystem.IsOwnThread())
+	{
+		Log::GetInstance()->Error("[Error] Command buffer requested from a thread outside the JobSystem");
+		return nullptr;
+	}
+	const auto index = jobSystem.GetThreadIndex();
+	if (index >= m_CommandBuffers.size())
+	{
+		std::ostringstream oss;
+		oss << "[Error] No command buffer for thread: " << index;
+		Log::GetInstance()->Error(oss.str());
+		return nullptr;
+	}
+	return &m_CommandBuffers[index];
+}
+
+void EntityManager::PlaybackCommands()
+{
+	auto& frameArena = *m_Engine.GetFrameArena();
+	auto commands = FrameVector<EntityCommand>(FrameAllocator<EntityCommand>(frameArena));
+	auto componentJsons = FrameVector<json>(FrameAllocator<json>(frameArena));
+	for (auto& commandBuffer : m_CommandBuffers)
+	{
+		if (commandBuffer.Empty())
+			continue;
+		//Deferred entities of a buffer become one contiguous range
+		const auto createdEntities = CreateEntities(commandBuffer.GetCreatedEntityNmb());
+		const size_t jsonOffset = componentJsons.size();
+		for (auto& command : commandBuffer.GetCommands())
+		{
+			if (command.type == EntityCommand::Type::CREATE)
+				continue;
+			if (IsDeferredEntity(command.entity))
+			{
+				command.entity = createdEntities[command.entity & ~DEFERRED_ENTITY_FLAG];
+			}
+			command.jsonIndex += jsonOffset;
+			command.order = commands.size();
+			commands.push_back(command);
+		}
+		auto& bufferJsons = commandBuffer.GetComponentJsons();
+		std::move(bufferJsons.begin(), bufferJsons.end(), std::back_inserter(componentJsons));
+		commandBuffer.Clear();
+	}
+	if (commands.empty())
+		return;
+
+	//Additions and removals share one phase so a removal followed by an addition keeps its recording order,
+	//the destructions come last
+	const auto commandPhase = [](EntityCommand::Type type)
+	{
+		return type == EntityCommand::Type::DESTROY ? 1 : 0;
+	};
+	std::sort(commands.begin(), commands.end(), [&commandPhase](const EntityCommand& command1, const EntityCommand& command2)
+	{
+		return std::make_tuple(commandPhase(command1.type), static_cast<int>(command1.componentType), command1.entity, command1.order) <
+			std::make_tuple(commandPhase(command2.type), static_cast<int>(command2.componentType), command2.entity, command2.order);
+	});
+
+	auto* sceneManager = m_Engine.GetSceneManager();
+	std::vector<Entity> destroyedEntities;
+	for (auto& command : commands)
+	{
+		if (!IsAlive(command.entity))
+			continue;
+		auto* componentManager = command.type == EntityCommand::Type::DESTROY ?
+			nullptr : sceneManager->GetComponentManager(command.componentType);
+		switch (command.type)
+		{
+		case EntityCommand::Type::ADD_COMPONENT:
+			if (componentManager != nullptr)
+				componentManager->CreateComponent(componentJsons[command.jsonIndex], command.entity);
+			else
+				AddComponentType(command.entity, command.componentType);
+			break;
+		case EntityCommand::Type::REMOVE_COMPONENT:
+			if (componentManager != nullptr)
+				componentManager->DestroyComponent(command.entity);
+			else
+				RemoveComponentType(command.entity, command.componentType);
+			break;
+		case EntityCommand::Type::DESTROY:
+			destroyedEntities.push_back(command.entity);
+			break;
+		default:
+			break;
+		}
+	}
+	if (!destroyedEntities.empty())
+	{
+		DestroyEntities(destroyedEntities);
+	}
+}
+
 }
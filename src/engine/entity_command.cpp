@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <engine/entity_command.h>
+
+namespace sfge
+{
+
+Entity EntityCommandBuffer::CreateEntity()
+{
+	const Entity deferredEntity = DEFERRED_ENTITY_FLAG | static_cast<Entity>(m_CreatedEntityNmb);
+	m_CreatedEntityNmb++;
+	EntityCommand command;
+	command.type = EntityCommand::Type::CREATE;
+	command.entity = deferredEntity;
+	command.order = m_Commands.size();
+	m_Commands.push_back(command);
+	return deferredEntity;
+}
+
+void EntityCommandBuffer::DestroyEntity(Entity entity)
+{
+	EntityCommand command;
+	command.type = EntityCommand::Type::DESTROY;
+	command.entity = entity;
+	command.order = m_Commands.size();
+	m_Commands.push_back(command);
+}
+
+void EntityCommandBuffer::AddComponent(Entity entity, ComponentType componentType, json componentJson)
+{
+	EntityCommand command;
+	command.type = EntityCommand::Type::ADD_COMPONENT;
+	command.entity = entity;
+	command.componentType = componentType;
+	command.jsonIndex = m_ComponentJsons.size();
+	command.order = m_Commands.size();
+	m_ComponentJsons.push_back(std::move(componentJson));
+	m_Commands.push_back(command);
+}
+
+void EntityCommandBuffer::RemoveComponent(Entity entity, ComponentType componentType)
+{
+	EntityCommand command;
+	command.type = EntityCommand::Type::REMOVE_COMPONENT;
+	command.entity = entity;
+	command.componentType = componentType;
+	command.order = m_Commands.size();
+	m_Commands.push_back(command);
+}
+
+bool EntityCommandBuffer::Empty() const
+{
+	return m_Commands.empty();
+}
+
+void EntityCommandBuffer::Clear()
+{
+	m_Commands.clear();
+	m_ComponentJsons.clear();
+	m_CreatedEntityNmb = 0;
+}
+
+std::vector<EntityCommand>& EntityCommandBuffer::GetCommands()
+{
+	return m_Commands;
+}
+
+std::vector<json>& EntityCommandBuffer::GetComponentJsons()
+{
+	return m_ComponentJsons;
+}
+
+size_t EntityCommandBuffer::GetCreatedEntityNmb() const
+{
+	return m_CreatedEntityNmb;
+}
+
+}
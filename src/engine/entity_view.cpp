@@ -0,0 +1,244 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include <engine/entity_view.h>
+
+namespace sfge
+{
+
+const size_t BITSET_WORD_SIZE = 64;
+
+EntityBitset::EntityBitset(size_t entityNmb)
+{
+	Resize(entityNmb);
+}
+
+void EntityBitset::Resize(size_t entityNmb)
+{
+	const size_t wordNmb = (entityNmb + BITSET_WORD_SIZE - 1) / BITSET_WORD_SIZE;
+	const size_t oldWordNmb = m_Words.size();
+	bool shrink = wordNmb < oldWordNmb;
+	m_Words.resize(wordNmb, 0U);
+	//The tail word can keep entities past the new size, even when the word count does not change
+	if (wordNmb != 0 && wordNmb <= oldWordNmb && entityNmb % BITSET_WORD_SIZE != 0)
+	{
+		const std::uint64_t tailMask = (std::uint64_t(1) << (entityNmb % BITSET_WORD_SIZE)) - 1;
+		if ((m_Words.back() & ~tailMask) != 0U)
+		{
+			m_Words.back() &= tailMask;
+			shrink = true;
+		}
+	}
+	m_Summary.resize((wordNmb + BITSET_WORD_SIZE - 1) / BITSET_WORD_SIZE, 0U);
+	if (shrink)
+	{
+		//Rebuild the summary and the count of the entities left
+		std::fill(m_Summary.begin(), m_Summary.end(), 0U);
+		m_Count = 0;
+		for (size_t wordIndex = 0; wordIndex < m_Words.size(); wordIndex++)
+		{
+			if (m_Words[wordIndex] != 0U)
+			{
+				m_Summary[wordIndex / BITSET_WORD_SIZE] |= std::uint64_t(1) << (wordIndex % BITSET_WORD_SIZE);
+				m_Count += PopCount(m_Words[wordIndex]);
+			}
+		}
+	}
+}
+
+void EntityBitset::Clear()
+{
+	std::fill(m_Words.begin(), m_Words.end(), 0U);
+	std::fill(m_Summary.begin(), m_Summary.end(), 0U);
+	m_Count = 0;
+}
+
+void EntityBitset::Set(Entity entity)
+{
+	const size_t index = entity - 1;
+	const size_t wordIndex = index / BITSET_WORD_SIZE;
+	if (wordIndex >= m_Words.size())
+	{
+		Resize(index + 1);
+	}
+	const std::uint64_t bit = std::uint64_t(1) << (index % BITSET_WORD_SIZE);
+	if ((m_Words[wordIndex] & bit) == 0U)
+	{
+		m_Words[wordIndex] |= bit;
+		m_Summary[wordIndex / BITSET_WORD_SIZE] |= std::uint64_t(1) << (wordIndex % BITSET_WORD_SIZE);
+		m_Count++;
+	}
+}
+
+void EntityBitset::Reset(Entity entity)
+{
+	const size_t index = entity - 1;
+	const size_t wordIndex = index / BITSET_WORD_SIZE;
+	if (wordIndex >= m_Words.size())
+		return;
+	const std::uint64_t bit = std::uint64_t(1) << (index % BITSET_WORD_SIZE);
+	if ((m_Words[wordIndex] & bit) != 0U)
+	{
+		m_Words[wordIndex] &= ~bit;
+		if (m_Words[wordIndex] == 0U)
+		{
+			m_Summary[wordIndex / BITSET_WORD_SIZE] &= ~(std::uint64_t(1) << (wordIndex % BITSET_WORD_SIZE));
+		}
+		m_Count--;
+	}
+}
+
+bool EntityBitset::Test(Entity entity) const
+{
+	if (entity == INVALID_ENTITY)
+		return false;
+	const size_t index = entity - 1;
+	const size_t wordIndex = index / BITSET_WORD_SIZE;
+	return wordIndex < m_Words.size() && (m_Words[wordIndex] >> (index % BITSET_WORD_SIZE)) & 1U;
+}
+
+size_t EntityBitset::Count() const
+{
+	return m_Count;
+}
+
+const std::vector<std::uint64_t>& EntityBitset::GetWords() const
+{
+	return m_Words;
+}
+
+const std::vector<std::uint64_t>& EntityBitset::GetSummary() const
+{
+	return m_Summary;
+}
+
+void EntityView::AddBitset(const EntityBitset* bitset)
+{
+	if (bitset == nullptr || m_BitsetNmb == MAX_BITSET_NMB)
+		return;
+	m_Bitsets[m_BitsetNmb] = bitset;
+	m_BitsetNmb++;
+	//The smallest bitset drives the scan
+	if (bitset->Count() < m_Bitsets[0]->Count())
+	{
+		std::swap(m_Bitsets[0], m_Bitsets[m_BitsetNmb - 1]);
+	}
+}
+
+std::uint64_t EntityView::GetWord(size_t wordIndex) const
+{
+	const auto& driverWords = m_Bitsets[0]->GetWords();
+	std::uint64_t bits = wordIndex < driverWords.size() ? driverWords[wordIndex] : 0U;
+	for (size_t i = 1; i < m_BitsetNmb && bits != 0U; i++)
+	{
+		const auto& words = m_Bitsets[i]->GetWords();
+		bits &= wordIndex < words.size() ? words[wordIndex] : 0U;
+	}
+	return bits;
+}
+
+EntityView::Iterator EntityView::begin() const
+{
+	return Iterator(this, m_BitsetNmb == 0);
+}
+
+EntityView::Iterator EntityView::end() const
+{
+	return Iterator(this, true);
+}
+
+size_t EntityView::Count() const
+{
+	if (m_BitsetNmb == 0)
+		return 0;
+	if (m_BitsetNmb == 1)
+		return m_Bitsets[0]->Count();
+	size_t count = 0;
+	const auto& summary = m_Bitsets[0]->GetSummary();
+	for (size_t summaryIndex = 0; summaryIndex < summary.size(); summaryIndex++)
+	{
+		std::uint64_t summaryBits = summary[summaryIndex];
+		while (summaryBits != 0U)
+		{
+			const size_t wordIndex = summaryIndex * BITSET_WORD_SIZE + CountTrailingZeros(summaryBits);
+			summaryBits &= summaryBits - 1;
+			count += PopCount(GetWord(wordIndex));
+		}
+	}
+	return count;
+}
+
+bool EntityView::Empty() const
+{
+	return !(begin() != end());
+}
+
+EntityView::Iterator::Iterator(const EntityView* view, bool end) : m_View(view)
+{
+	if (end)
+		return;
+	const auto& summary = m_View->m_Bitsets[0]->GetSummary();
+	if (!summary.empty())
+	{
+		m_SummaryBits = summary[0];
+		Advance();
+	}
+}
+
+EntityView::Iterator& EntityView::Iterator::operator++()
+{
+	Advance();
+	return *this;
+}
+
+void EntityView::Iterator::Advance()
+{
+	const auto& summary = m_View->m_Bitsets[0]->GetSummary();
+	while (true)
+	{
+		if (m_Bits != 0U)
+		{
+			m_Current = static_cast<Entity>(m_WordIndex * BITSET_WORD_SIZE + CountTrailingZeros(m_Bits) + 1);
+			m_Bits &= m_Bits - 1;
+			return;
+		}
+		while (m_SummaryBits == 0U)
+		{
+			m_SummaryIndex++;
+			if (m_SummaryIndex >= summary.size())
+			{
+				m_Current = INVALID_ENTITY;
+				return;
+			}
+			m_SummaryBits = summary[m_SummaryIndex];
+		}
+		m_WordIndex = m_SummaryIndex * BITSET_WORD_SIZE + CountTrailingZeros(m_SummaryBits);
+		m_SummaryBits &= m_SummaryBits - 1;
+		m_Bits = m_View->GetWord(m_WordIndex);
+	}
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <engine/frame_allocator.h>
+
+namespace sfge
+{
+
+FrameArena::FrameArena(size_t blockSize) : m_BlockSize(blockSize)
+{
+	AddBlock(m_BlockSize);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	m_AllocationNmb++;
+	auto* block = &m_Blocks.back();
+	auto address = reinterpret_cast<std::uintptr_t>(block->data.get()) + m_Offset;
+	auto padding = (alignment - address % alignment) % alignment;
+	if (m_Offset + padding + size > block->size)
+	{
+		AddBlock(std::max(m_BlockSize, size + alignment));
+		block = &m_Blocks.back();
+		address = reinterpret_cast<std::uintptr_t>(block->data.get());
+		padding = (alignment - address % alignment) % alignment;
+	}
+	auto* data = block->data.get() + m_Offset + padding;
+	m_Offset += padding + size;
+	m_UsedBytes += padding + size;
+	return data;
+}
+
+void FrameArena::Reset()
+{
+	if (m_Blocks.size() > 1)
+	{
+		const auto capacity = GetCapacity();
+		m_Blocks.clear();
+		AddBlock(capacity);
+	}
+	m_Offset = 0;
+	m_UsedBytes = 0;
+	m_AllocationNmb = 0;
+}
+
+size_t FrameArena::GetUsedBytes() const
+{
+	return m_UsedBytes;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+	size_t capacity = 0;
+	for (auto& block : m_Blocks)
+	{
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+size_t FrameArena::GetAllocationNmb() const
+{
+	return m_AllocationNmb;
+}
+
+size_t FrameArena::GetHeapAllocationNmb() const
+{
+	return m_HeapAllocationNmb;
+}
+
+void FrameArena::AddBlock(size_t size)
+{
+	Block block;
+	//Not value-initialized, make_unique would zero every block
+	block.data = std::unique_ptr<std::byte[]>(new std::byte[size]);
+	block.size = size;
+	m_Blocks.push_back(std::move(block));
+	m_Offset = 0;
+	m_HeapAllocationNmb++;
+}
+
+}
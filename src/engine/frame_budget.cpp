@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include <engine/frame_budget.h>
+
+namespace sfge
+{
+
+//An overrun cuts the budgets by a quarter, the growth takes 16 good frames from min to max
+const std::int64_t BUDGET_SHRINK_NUMERATOR = 3;
+const std::int64_t BUDGET_SHRINK_DENOMINATOR = 4;
+const std::int64_t BUDGET_GROW_STEP_NMB = 16;
+//The budgets grow back only when the average frame leaves this part of the target free
+const std::int64_t BUDGET_HEADROOM_PERCENT = 15;
+
+void FrameBudget::Init(std::int64_t targetFrameTime)
+{
+	m_TargetFrameTime = std::max<std::int64_t>(targetFrameTime, 1);
+	m_AverageFrameCost = 0;
+	for (auto& workload : m_Workloads)
+	{
+		workload.budget = workload.maxBudget;
+		workload.used = 0;
+		workload.lastUsed = 0;
+	}
+	m_FrameStart = ProfilerClock::now();
+}
+
+void FrameBudget::SetEnabled(bool enabled)
+{
+	m_Enabled = enabled;
+	if (!m_Enabled)
+	{
+		for (auto& workload : m_Workloads)
+		{
+			workload.budget = workload.maxBudget;
+		}
+	}
+}
+
+bool FrameBudget::IsEnabled() const
+{
+	return m_Enabled;
+}
+
+BudgetId FrameBudget::RegisterWorkload(const std::string& name, std::int64_t minBudget, std::int64_t maxBudget)
+{
+	for (BudgetId id = 0; id < m_Workloads.size(); id++)
+	{
+		if (m_Workloads[id].name == name)
+			return id;
+	}
+	WorkloadBudget workload;
+	workload.name = name;
+	workload.minBudget = std::min(minBudget, maxBudget);
+	workload.maxBudget = maxBudget;
+	workload.budget = maxBudget;
+	m_Workloads.push_back(workload);
+	return m_Workloads.size() - 1;
+}
+
+void FrameBudget::BeginFrame()
+{
+	m_FrameStart = ProfilerClock::now();
+}
+
+void FrameBudget::EndFrame(std::int64_t frameCost)
+{
+	m_AverageFrameCost = m_AverageFrameCost == 0 ? frameCost : (m_AverageFrameCost * 7 + frameCost) / 8;
+	for (auto& workload : m_Workloads)
+	{
+		workload.lastUsed = workload.used;
+		workload.used = 0;
+		if (!m_Enabled)
+			continue;
+		if (frameCost > m_TargetFrameTime)
+		{
+			workload.budget = std::max(workload.minBudget,
+				workload.budget * BUDGET_SHRINK_NUMERATOR / BUDGET_SHRINK_DENOMINATOR);
+		}
+		else if (m_AverageFrameCost * 100 < m_TargetFrameTime * (100 - BUDGET_HEADROOM_PERCENT))
+		{
+			const auto step = std::max<std::int64_t>((workload.maxBudget - workload.minBudget) / BUDGET_GROW_STEP_NMB, 1);
+			workload.budget = std::min(workload.maxBudget, workload.budget + step);
+		}
+	}
+}
+
+std::int64_t FrameBudget::GetBudget(BudgetId id) const
+{
+	return m_Workloads[id].budget;
+}
+
+std::int64_t FrameBudget::GetRemaining(BudgetId id) const
+{
+	return m_Workloads[id].budget - m_Workloads[id].used;
+}
+
+void FrameBudget::AddUsed(BudgetId id, std::int64_t duration)
+{
+	m_Workloads[id].used += duration;
+}
+
+std::int64_t FrameBudget::GetTargetFrameTime() const
+{
+	return m_TargetFrameTime;
+}
+
+std::int64_t FrameBudget::GetAverageFrameCost() const
+{
+	return m_AverageFrameCost;
+}
+
+std::int64_t FrameBudget::GetFrameElapsed() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(ProfilerClock::now() - m_FrameStart).count();
+}
+
+const std::vector<WorkloadBudget>& FrameBudget::GetWorkloads() const
+{
+	return m_Workloads;
+}
+
+BudgetTimer::BudgetTimer(FrameBudget& frameBudget, BudgetId id) :
+	m_FrameBudget(frameBudget), m_Id(id), m_Start(ProfilerClock::now())
+{
+}
+
+BudgetTimer::~BudgetTimer()
+{
+	m_FrameBudget.AddUsed(m_Id, GetElapsed());
+}
+
+std::int64_t BudgetTimer::GetRemaining() const
+{
+	return m_FrameBudget.GetRemaining(m_Id) - GetElapsed();
+}
+
+bool BudgetTimer::HasTimeLeft() const
+{
+	return GetRemaining() > 0;
+}
+
+std::int64_t BudgetTimer::GetElapsed() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(ProfilerClock::now() - m_Start).count();
+}
+
+}
@@ -0,0 +1,330 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+
+#include <engine/job_system.h>
+#include <utility/log.h>
+
+namespace sfge
+{
+
+namespace
+{
+thread_local const JobSystem* t_JobSystem = nullptr;
+thread_local size_t t_ThreadIndex = 0;
+}
+
+bool JobGroup::IsDone() const
+{
+	return m_PendingJobNmb.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem()
+{
+	m_Queues.push_back(std::make_unique<JobQueue>());
+}
+
+JobSystem::~JobSystem()
+{
+	Destroy();
+}
+
+void JobSystem::Init(size_t workerNmb)
+{
+	Destroy();
+	m_MainThreadId = std::this_thread::get_id();
+	m_Queues.clear();
+	for (size_t i = 0; i < workerNmb + 1; i++)
+	{
+		m_Queues.push_back(std::make_unique<JobQueue>());
+	}
+	m_Running = true;
+	for (size_t i = 0; i < workerNmb; i++)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+void JobSystem::Destroy()
+{
+	while (TryRunJob(0)) {}
+	{
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+		m_Running = false;
+	}
+	m_SleepCondition.notify_all();
+	for (auto& worker : m_Workers)
+	{
+		worker.join();
+	}
+	m_Workers.clear();
+	//Jobs pushed by the workers while they were stopping
+	while (TryRunJob(0)) {}
+}
+
+size_t JobSystem::GetDefaultWorkerNmb()
+{
+	const auto coreNmb = std::thread::hardware_concurrency();
+	return coreNmb > 1 ? coreNmb - 1 : 0;
+}
+
+size_t JobSystem::GetWorkerNmb() const
+{
+	return m_Workers.size();
+}
+
+size_t JobSystem::GetThreadNmb() const
+{
+	return m_Queues.size();
+}
+
+size_t JobSystem::GetThreadIndex() const
+{
+	return t_JobSystem == this ? t_ThreadIndex : 0;
+}
+
+bool JobSystem::IsOwnThread() const
+{
+	return t_JobSystem == this || std::this_thread::get_id() == m_MainThreadId;
+}
+
+bool JobSystem::IsMainThread() const
+{
+	return std::this_thread::get_id() == m_MainThreadId;
+}
+
+void JobSystem::Schedule(JobGroup& group, JobFunction job)
+{
+	group.m_PendingJobNmb.fetch_add(1, std::memory_order_relaxed);
+	{
+		auto& queue = *m_Queues[GetThreadIndex()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({ std::move(job), &group });
+	}
+	m_QueuedJobNmb.fetch_add(1, std::memory_order_release);
+	//Taking the lock orders the push with a worker checking the queued jobs before sleeping
+	{
+		std::lock_guard<std::mutex> lock(m_SleepMutex);
+	}
+	m_SleepCondition.notify_one();
+}
+
+void JobSystem::Wait(JobGroup& group)
+{
+	const auto threadIndex = GetThreadIndex();
+	while (!group.IsDone())
+	{
+		if (!TryRunJob(threadIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::ParallelFor(size_t begin, size_t end, size_t grain, const RangeFunction& function)
+{
+	if (begin >= end)
+		return;
+	if (grain == 0)
+	{
+		grain = std::max<size_t>(1, (end - begin) / (GetThreadNmb() * 4));
+	}
+	if (m_Workers.empty() || end - begin <= grain)
+	{
+		function(begin, end);
+		return;
+	}
+	JobGroup group;
+	SplitRange(group, begin, end, grain, function);
+	Wait(group);
+}
+
+void JobSystem::SplitRange(JobGroup& group, size_t begin, size_t end, size_t grain, const RangeFunction& function)
+{
+	//The upper halves are given away first, so a thief takes the biggest pieces left
+	while (end - begin > grain)
+	{
+		const size_t middle = begin + (end - begin) / 2;
+		Schedule(group, [this, &group, middle, end, grain, &function]()
+		{
+			SplitRange(group, middle, end, grain, function);
+		});
+		end = middle;
+	}
+	function(begin, end);
+}
+
+void JobSystem::WorkerLoop(size_t threadIndex)
+{
+	t_JobSystem = this;
+	t_ThreadIndex = threadIndex;
+	while (true)
+	{
+		if (TryRunJob(threadIndex))
+			continue;
+		std::unique_lock<std::mutex> lock(m_SleepMutex);
+		m_SleepCondition.wait(lock, [this]()
+		{
+			return !m_Running || m_QueuedJobNmb.load(std::memory_order_acquire) > 0;
+		});
+		if (!m_Running)
+			break;
+	}
+	t_JobSystem = nullptr;
+}
+
+bool JobSystem::TryRunJob(size_t threadIndex)
+{
+	Job job;
+	if (!PopJob(threadIndex, job))
+		return false;
+	job.function();
+	job.group->m_PendingJobNmb.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+bool JobSystem::PopJob(size_t threadIndex, Job& job)
+{
+	if (m_QueuedJobNmb.load(std::memory_order_acquire) == 0)
+		return false;
+	{
+		auto& queue = *m_Queues[threadIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			m_QueuedJobNmb.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	for (size_t i = 1; i < m_Queues.size(); i++)
+	{
+		auto& queue = *m_Queues[(threadIndex + i) % m_Queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			m_QueuedJobNmb.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t JobGraph::AddJob(JobFunction job)
+{
+	m_Nodes.push_back({ std::move(job), {}, 0 });
+	return m_Nodes.size() - 1;
+}
+
+void JobGraph::AddDependency(size_t job, size_t dependency)
+{
+	if (job >= m_Nodes.size() || dependency >= m_Nodes.size())
+	{
+		std::ostringstream oss;
+		oss << "[Error] JobGraph: invalid dependency " << dependency << " -> " << job;
+		Log::GetInstance()->Error(oss.str());
+		return;
+	}
+	m_Nodes[dependency].successors.push_back(job);
+	m_Nodes[job].dependencyNmb++;
+}
+
+void JobGraph::Run(JobSystem& jobSystem)
+{
+	if (HasCycle())
+	{
+		Log::GetInstance()->Error("[Error] JobGraph: the dependencies have a cycle, the graph is not run");
+		return;
+	}
+	m_RemainingDependencies = std::make_unique<std::atomic<size_t>[]>(m_Nodes.size());
+	for (size_t i = 0; i < m_Nodes.size(); i++)
+	{
+		m_RemainingDependencies[i] = m_Nodes[i].dependencyNmb;
+	}
+	JobGroup group;
+	for (size_t i = 0; i < m_Nodes.size(); i++)
+	{
+		if (m_Nodes[i].dependencyNmb == 0)
+		{
+			jobSystem.Schedule(group, [this, &jobSystem, &group, i]() { RunNode(jobSystem, group, i); });
+		}
+	}
+	jobSystem.Wait(group);
+}
+
+void JobGraph::RunNode(JobSystem& jobSystem, JobGroup& group, size_t index)
+{
+	m_Nodes[index].function();
+	for (const auto successor : m_Nodes[index].successors)
+	{
+		if (m_RemainingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			jobSystem.Schedule(group, [this, &jobSystem, &group, successor]() { RunNode(jobSystem, group, successor); });
+		}
+	}
+}
+
+bool JobGraph::HasCycle() const
+{
+	//Kahn's algorithm: every job is reached only if there is no cycle
+	std::vector<size_t> dependencyNmbs(m_Nodes.size());
+	std::vector<size_t> readyJobs;
+	for (size_t i = 0; i < m_Nodes.size(); i++)
+	{
+		dependencyNmbs[i] = m_Nodes[i].dependencyNmb;
+		if (dependencyNmbs[i] == 0)
+			readyJobs.push_back(i);
+	}
+	size_t reachedNmb = 0;
+	while (!readyJobs.empty())
+	{
+		const auto job = readyJobs.back();
+		readyJobs.pop_back();
+		reachedNmb++;
+		for (const auto successor : m_Nodes[job].successors)
+		{
+			if (--dependencyNmbs[successor] == 0)
+				readyJobs.push_back(successor);
+		}
+	}
+	return reachedNmb != m_Nodes.size();
+}
+
+void JobGraph::Clear()
+{
+	m_Nodes.clear();
+	m_RemainingDependencies.reset();
+}
+
+size_t JobGraph::GetJobNmb() const
+{
+	return m_Nodes.size();
+}
+
+}
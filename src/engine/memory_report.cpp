@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+
+#include <engine/memory_report.h>
+
+namespace sfge
+{
+
+void MemoryReport::SetSystem(const std::string& system)
+{
+	m_System = system;
+}
+
+void MemoryReport::Add(const std::string& container, size_t usedBytes, size_t capacityBytes, size_t externalBytes)
+{
+	MemoryUsage usage;
+	usage.system = m_System;
+	usage.container = container;
+	usage.usedBytes = usedBytes;
+	usage.capacityBytes = capacityBytes;
+	usage.externalBytes = externalBytes;
+	m_Usages.push_back(std::move(usage));
+}
+
+void MemoryReport::AddExternal(const std::string& container, size_t externalBytes)
+{
+	Add(container, 0, 0, externalBytes);
+}
+
+const std::vector<MemoryUsage>& MemoryReport::GetUsages() const
+{
+	return m_Usages;
+}
+
+std::vector<MemoryUsage> MemoryReport::GetSystemTotals() const
+{
+	std::vector<MemoryUsage> totals;
+	for (const auto& usage : m_Usages)
+	{
+		auto total = std::find_if(totals.begin(), totals.end(), [&usage](const MemoryUsage& systemTotal)
+		{
+			return systemTotal.system == usage.system;
+		});
+		if (total == totals.end())
+		{
+			MemoryUsage systemTotal;
+			systemTotal.system = usage.system;
+			totals.push_back(systemTotal);
+			total = totals.end() - 1;
+		}
+		total->usedBytes += usage.usedBytes;
+		total->capacityBytes += usage.capacityBytes;
+		total->externalBytes += usage.externalBytes;
+	}
+	std::sort(totals.begin(), totals.end(), [](const MemoryUsage& first, const MemoryUsage& second)
+	{
+		return first.capacityBytes + first.externalBytes > second.capacityBytes + second.externalBytes;
+	});
+	return totals;
+}
+
+size_t MemoryReport::GetUsedBytes() const
+{
+	size_t bytes = 0;
+	for (const auto& usage : m_Usages)
+	{
+		bytes += usage.usedBytes;
+	}
+	return bytes;
+}
+
+size_t MemoryReport::GetCapacityBytes() const
+{
+	size_t bytes = 0;
+	for (const auto& usage : m_Usages)
+	{
+		bytes += usage.capacityBytes;
+	}
+	return bytes;
+}
+
+size_t MemoryReport::GetExternalBytes() const
+{
+	size_t bytes = 0;
+	for (const auto& usage : m_Usages)
+	{
+		bytes += usage.externalBytes;
+	}
+	return bytes;
+}
+
+void MemoryReport::Clear()
+{
+	m_System.clear();
+	m_Usages.clear();
+}
+
+}
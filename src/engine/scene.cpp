@@ -26,10 +26,15 @@
 #endif
 
 #include <cmath>
+#include <iomanip>
 #include <vector>
 
 //SFGE includes
 #include <engine/scene.h>
+#include <engine/scene_binary.h>
+#include <engine/scene_index.h>
+#include <engine/system_profiler.h>
+#include <engine/component.h>
 #include <utility/log.h>
 #include <utility/json_utility.h>
 #include <editor/editor.h>
@@ -37,6 +42,8 @@
 #include <utility/file_utility.h>
 #include <engine/entity.h>
 #include <graphics/graphics2d.h>
+#include <graphics/sprite2d.h>
+#include <graphics/texture.h>
 #include <python/python_engine.h>
 #include <python/pysystem.h>
 #include <physics/physics2d.h>
@@ -48,15 +55,70 @@
 
 namespace sfge
 {
+static std::int64_t GetDurationSince(ProfilerClock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(ProfilerClock::now() - start).count();
+}
+
+/**
+ * \brief Loading progress at the end of each step of the streaming, the uploads fill the rest until the swap
+ */
+const float STREAMING_PARSED_PROGRESS = 0.4f;
+const float STREAMING_DECODED_PROGRESS = 0.5f;
+const float STREAMING_IMAGES_PROGRESS = 0.8f;
+const float STREAMING_UPLOADED_PROGRESS = 0.9f;
+/**
+ * \brief Scene staged by LoadSceneFromPathAsync, decoded by the loading thread and swapped in by the main thread
+ */
+struct StreamedScene
+{
+	SceneBinaryView GetView() const
+	{
+		return mappedFile.IsOpen() ? SceneBinaryView(mappedFile.GetData(), mappedFile.GetSize()) :
+			SceneBinaryView(binary.data(), binary.size());
+	}
+
+	std::string scenePath;
+	/**
+	 * \brief The up to date compiled scene is mapped, a json scene is compiled in memory
+	 */
+	MappedFile mappedFile;
+	std::vector<std::byte> binary;
+	/**
+	 * \brief Component jsons of the CBOR blocks, empty for the SoA blocks
+	 */
+	std::vector<std::vector<json>> blockJsons;
+	std::vector<std::string> texturePaths;
+	std::vector<sf::Image> images;
+	size_t uploadedNmb = 0;
+	std::int64_t decodeDuration = 0;
+	std::string error;
+	/**
+	 * \brief Once swapped in, the components are created block by block, chunk by chunk, over the next frames
+	 */
+	std::unique_ptr<editor::SceneInfo> sceneInfo;
+	EntityRange entities;
+	size_t blockIndex = 0;
+	size_t componentIndex = 0;
+	size_t createdNmb = 0;
+	size_t componentNmb = 0;
+};
+
 SceneManager::SceneManager(Engine& engine):
 	System(engine)
 	
 {
 }
 
+SceneManager::~SceneManager() = default;
+
 void SceneManager::Init()
 {
+	//The access is the one of the systems of the scene, see InitScenePySystems
+	DeclareAccess(0, 0);
 	m_EntityManager = m_Engine.GetEntityManager();
+	m_StreamingBudget = m_Engine.GetFrameBudget().RegisterWorkload("SceneStreaming",
+		SCENE_STREAMING_MIN_BUDGET, SCENE_STREAMING_MAX_BUDGET);
 	if(auto config = m_Engine.GetConfig())
 	{
 		SearchScenes(config->dataDirname);
@@ -69,51 +131,60 @@ void SceneManager::Init()
 
 void SceneManager::SearchScenes(std::string& dataDirname)
 {
-	std::function<void(std::string)> SearchAllScenes;
-	SearchAllScenes = [&SearchAllScenes, this](std::string entry)
+	const auto* config = m_Engine.GetConfig();
+	const std::string sceneIndexPath = config != nullptr ? config->sceneIndexPath : std::string();
+	SceneIndex sceneIndex;
+	if (!sceneIndexPath.empty())
 	{
-		
-		if (IsRegularFile(entry))
-		{
-			const std::string::size_type filenameExtensionIndex = entry.find_last_of('.');
-			const std::string extension = entry.substr(filenameExtensionIndex);
-			if(extension == ".scene")
-			{
-				const auto sceneJsonPtr = LoadJson(entry);
-				if(sceneJsonPtr && CheckJsonExists(*sceneJsonPtr, "name"))
-				{
-					m_ScenePathMap.insert(std::pair<std::string, std::string>((*sceneJsonPtr)["name"],entry));
-				}
-			}
-		}
-
-		if (IsDirectory(entry))
+		sceneIndex.Load(sceneIndexPath);
+	}
+	const auto readNmb = sceneIndex.Update(dataDirname);
+	if (!sceneIndexPath.empty() && sceneIndex.IsDirty())
+	{
+		sceneIndex.Save(sceneIndexPath);
+	}
+	for (const auto& pathEntry : sceneIndex.GetEntries())
+	{
+		if (!pathEntry.second.name.empty())
 		{
-			{
-				std::ostringstream oss;
-				oss << "Opening folder: " << entry << "\n";
-				Log::GetInstance()->Msg(oss.str());
-			}
-			IterateDirectory(entry, SearchAllScenes);
+			m_ScenePathMap.insert(std::pair<std::string, std::string>(pathEntry.second.name, pathEntry.first));
 		}
-	};
-	IterateDirectory(dataDirname, SearchAllScenes);
+	}
+	{
+		std::ostringstream oss;
+		oss << "Scene index: " << sceneIndex.GetEntries().size() << " scenes in " << dataDirname << ", " <<
+			readNmb << " read again";
+		Log::GetInstance()->Msg(oss.str());
+	}
 }
 
 
 void SceneManager::LoadSceneFromPath(const std::string& scenePath)
 {
+	if (DeferSceneLoad([this, scenePath]() { LoadSceneFromPath(scenePath); }))
+		return;
 	{
 		std::ostringstream oss;
 		oss << "Loading scene from: " << scenePath;
 		Log::GetInstance()->Msg(oss.str());
 	}
+	//The compiled scene is used as long as it is not older than the json it comes from
+	const auto binaryPath = GetCompiledScenePath(scenePath);
+	if (FileExists(binaryPath) && GetFileWriteTime(binaryPath) >= GetFileWriteTime(scenePath))
+	{
+		auto sceneInfo = std::make_unique<editor::SceneInfo>();
+		sceneInfo->path = scenePath;
+		if (LoadSceneFromBinary(binaryPath, std::move(sceneInfo)))
+			return;
+	}
+	const auto parseStart = ProfilerClock::now();
 	const auto sceneJsonPtr = LoadJson(scenePath);
 	
 	if(sceneJsonPtr != nullptr)
 	{
 		auto sceneInfo = std::make_unique<editor::SceneInfo>();
 		sceneInfo->path = scenePath;
+		m_ParseDuration = GetDurationSince(parseStart);
 		LoadSceneFromJson(*sceneJsonPtr, std::move(sceneInfo));
 	}
 	else
@@ -128,6 +199,9 @@ void SceneManager::LoadSceneFromPath(const std::string& scenePath)
 
 void SceneManager::LoadSceneFromJson(json& sceneJson, std::unique_ptr<editor::SceneInfo> sceneInfo)
 {
+	m_LoadingTimes = SceneLoadingTimes();
+	m_LoadingTimes.parse = m_ParseDuration;
+	m_ParseDuration = 0;
 	m_Engine.Clear();
 	if(!sceneInfo)
 		sceneInfo = std::make_unique<editor::SceneInfo>();
@@ -144,115 +218,516 @@ void SceneManager::LoadSceneFromJson(json& sceneJson, std::unique_ptr<editor::Sc
 		oss << "Loading scene: " << sceneInfo->name;
 		Log::GetInstance()->Msg(oss.str());
 	}
+	auto phaseStart = ProfilerClock::now();
 	if (CheckJsonParameter(sceneJson, "systems", json::value_t::array))
 	{
-		for (auto& systemJson : sceneJson["systems"])
+		LoadSceneSystems(sceneJson["systems"]);
+	}
+	m_LoadingTimes.systems = GetDurationSince(phaseStart);
+	if (CheckJsonParameter(sceneJson, "entities", json::value_t::array))
+	{
+		auto& entitiesJson = sceneJson["entities"];
+		const auto entityNmb = entitiesJson.size();
+		if(entityNmb > INIT_ENTITY_NMB)
 		{
-			auto* pythonEngine = m_Engine.GetPythonEngine();
-			if (CheckJsonExists(systemJson, "script_path"))
+			m_EntityManager->ResizeEntityNmb(entityNmb);
+		}
+
+		//First pass: reserve the scene entities and group their components by type
+		phaseStart = ProfilerClock::now();
+		const auto entities = m_EntityManager->CreateEntities(entityNmb);
+		std::vector<std::vector<Entity>> typeEntities(m_ComponentManager.size());
+		std::vector<std::vector<json*>> typeComponentJsons(m_ComponentManager.size());
+		for(size_t entityIndex = 0; entityIndex < entities.size(); entityIndex++)
+		{
+			auto& entityJson = entitiesJson[entityIndex];
+			const Entity entity = entities[entityIndex];
+			//Names are only kept for the editor, the others are generated on demand
+			if(m_Engine.GetConfig()->editor && CheckJsonExists(entityJson, "name"))
+			{
+				m_EntityManager->GetEntityInfo(entity).name = entityJson["name"].get<std::string>();
+			}
+			if (!CheckJsonExists(entityJson, "components"))
 			{
-				std::string path = systemJson["script_path"];
-				const ModuleId moduleId = pythonEngine->LoadPyModule(path);
-				if (moduleId != INVALID_MODULE)
+				std::ostringstream oss;
+				oss << "[Error] No components attached in the JSON entity: " << entity << "with json content: " << entityJson;
+				Log::GetInstance()->Error(oss.str());
+				continue;
+			}
+			for (auto& componentJson : entityJson["components"])
+			{
+				if (CheckJsonExists(componentJson, "type"))
 				{
-					//TODO Link PySystem into a container to be able to reference them
-					const InstanceId instanceId = pythonEngine->GetPySystemManager().LoadPySystem(moduleId);
-					PySystem* pySystem = pythonEngine->GetPySystemManager().GetPySystemFromInstanceId(instanceId);
-					if(pySystem != nullptr)
+					const ComponentType componentType = componentJson["type"];
+					const auto index = static_cast<int>(log2(static_cast<double>(componentType)));
+					if(index >= 0 && index < static_cast<int>(m_ComponentManager.size()) && m_ComponentManager[index] != nullptr)
 					{
-						m_ScenePySystems.push_back(pySystem);
+						typeEntities[index].push_back(entity);
+						typeComponentJsons[index].push_back(&componentJson);
 					}
 				}
 				else
 				{
 					std::ostringstream oss;
-					oss << "Could not load PySystem at "<<path;
+					oss << "[Error] No type specified for component with json content: " << componentJson;
 					Log::GetInstance()->Error(oss.str());
 				}
 			}
-			if(CheckJsonExists(systemJson, "systemClassName"))
+		}
+		m_LoadingTimes.entities = GetDurationSince(phaseStart);
+
+		//Second pass: one bulk creation per type. The types are created in increasing order, like they are listed
+		//in the entities, so transforms exist before the bodies and the bodies before their colliders
+		for (size_t index = 0; index < m_ComponentManager.size(); index++)
+		{
+			if (typeEntities[index].empty())
+				continue;
+			phaseStart = ProfilerClock::now();
+			const auto componentType = static_cast<ComponentType>(1 << index);
+			m_ComponentManager[index]->CreateComponentsFromJson(typeEntities[index], typeComponentJsons[index]);
+			for (Entity entity : typeEntities[index])
 			{
-				const std::string systemClassName = systemJson["systemClassName"];
-				auto instanceId = pythonEngine->GetPySystemManager().LoadCppExtensionSystem(systemClassName);
-				if(instanceId != INVALID_INSTANCE)
-				{
-					PySystem* pySystem = pythonEngine->GetPySystemManager().GetPySystemFromInstanceId(instanceId);
-					if(pySystem != nullptr)
-					{
-						m_ScenePySystems.push_back(pySystem);
-					}
-				}
+				m_EntityManager->AddComponentType(entity, componentType);
 			}
+			m_LoadingTimes.components.emplace_back(componentType, GetDurationSince(phaseStart));
 		}
 	}
-	if (CheckJsonParameter(sceneJson, "entities", json::value_t::array))
+	else
 	{
-		const auto entityNmb = sceneJson["entities"].size();
-		if(entityNmb > INIT_ENTITY_NMB)
-		{
-			m_EntityManager->ResizeEntityNmb(entityNmb);
-		}
+		std::ostringstream oss;
+		oss << "No Entities in " << sceneInfo->name;
+		Log::GetInstance()->Error(oss.str());
+	}
 
-		for(auto& entityJson : sceneJson["entities"])
+	FinishSceneLoading(std::move(sceneInfo));
+}
+
+void SceneManager::LoadSceneSystems(json& systemsJson)
+{
+	for (auto& systemJson : systemsJson)
+	{
+		auto* pythonEngine = m_Engine.GetPythonEngine();
+		if (CheckJsonExists(systemJson, "script_path"))
 		{
-			Entity entity = INVALID_ENTITY;
-			entity = m_EntityManager->CreateEntity(INVALID_ENTITY);
-			if(entity == INVALID_ENTITY)
-			{
-				std::ostringstream oss;
-				oss << "[Error] Scene: not enough entities left";
-				Log::GetInstance()->Error(oss.str());
-				continue;
-			}
-			if(CheckJsonExists(entityJson, "name"))
+			std::string path = systemJson["script_path"];
+			const ModuleId moduleId = pythonEngine->LoadPyModule(path);
+			if (moduleId != INVALID_MODULE)
 			{
-				m_EntityManager->GetEntityInfo(entity).name = entityJson["name"].get<std::string>();
+				//TODO Link PySystem into a container to be able to reference them
+				const InstanceId instanceId = pythonEngine->GetPySystemManager().LoadPySystem(moduleId);
+				PySystem* pySystem = pythonEngine->GetPySystemManager().GetPySystemFromInstanceId(instanceId);
+				if(pySystem != nullptr)
+				{
+					m_ScenePySystems.push_back(pySystem);
+				}
 			}
 			else
 			{
 				std::ostringstream oss;
-				oss << "Entity " << entity;
-				m_EntityManager->GetEntityInfo(entity).name = oss.str();
+				oss << "Could not load PySystem at "<<path;
+				Log::GetInstance()->Error(oss.str());
 			}
-			if (entity != INVALID_ENTITY && 
-				CheckJsonExists(entityJson, "components"))
+		}
+		if(CheckJsonExists(systemJson, "systemClassName"))
+		{
+			const std::string systemClassName = systemJson["systemClassName"];
+			auto instanceId = pythonEngine->GetPySystemManager().LoadCppExtensionSystem(systemClassName);
+			if(instanceId != INVALID_INSTANCE)
 			{
-				
-				for (auto& componentJson : entityJson["components"])
+				PySystem* pySystem = pythonEngine->GetPySystemManager().GetPySystemFromInstanceId(instanceId);
+				if(pySystem != nullptr)
 				{
-					if (CheckJsonExists(componentJson, "type"))
-					{
-						const ComponentType componentType = componentJson["type"];
-						const auto index = static_cast<int>(log2(static_cast<double>(componentType)));
-						if(m_ComponentManager[index] != nullptr)
-						{
-							m_ComponentManager[index]->CreateComponent(componentJson, entity);
-							m_EntityManager->AddComponentType(entity, componentType);
-						}
-					}
-					else
-					{
-						std::ostringstream oss;
-						oss << "[Error] No type specified for component with json content: " << componentJson;
-						Log::GetInstance()->Error(oss.str());
-					}
+					m_ScenePySystems.push_back(pySystem);
 				}
 			}
-			else
-			{
-				std::ostringstream oss;
-				oss << "[Error] No components attached in the JSON entity: " << entity << "with json content: " << entityJson;
-				Log::GetInstance()->Error(oss.str());
-			}
 		}
 	}
+}
+
+bool SceneManager::LoadSceneFromBinary(const std::string& binaryPath, std::unique_ptr<editor::SceneInfo> sceneInfo)
+{
+	auto phaseStart = ProfilerClock::now();
+	MappedFile mappedFile;
+	if (!mappedFile.Open(binaryPath))
+	{
+		std::ostringstream oss;
+		oss << "[Error] Could not map the compiled scene: " << binaryPath;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	const SceneBinaryView sceneBinary(mappedFile.GetData(), mappedFile.GetSize());
+	if (!sceneBinary.IsValid())
+	{
+		std::ostringstream oss;
+		oss << "[Error] Invalid or outdated compiled scene: " << binaryPath;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	LoadSceneFromBinaryView(sceneBinary, std::move(sceneInfo), GetDurationSince(phaseStart));
+	return true;
+}
+
+void SceneManager::LoadSceneFromBinaryView(const SceneBinaryView& sceneBinary,
+	std::unique_ptr<editor::SceneInfo> sceneInfo, std::int64_t parseDuration, std::vector<std::vector<json>>* blockJsons)
+{
+	if (!sceneInfo)
+		sceneInfo = std::make_unique<editor::SceneInfo>();
+	BeginBinaryScene(sceneBinary, *sceneInfo, parseDuration);
+	LoadBinarySceneSystems(sceneBinary);
+	const auto entities = CreateBinarySceneEntities(sceneBinary);
+	for (size_t blockIndex = 0; blockIndex < sceneBinary.GetBlockNmb(); blockIndex++)
+	{
+		CreateBinarySceneComponents(sceneBinary, blockIndex, entities, 0, sceneBinary.GetBlock(blockIndex).count,
+			blockJsons);
+	}
+
+	FinishSceneLoading(std::move(sceneInfo));
+}
+
+void SceneManager::BeginBinaryScene(const SceneBinaryView& sceneBinary, editor::SceneInfo& sceneInfo,
+	std::int64_t parseDuration)
+{
+	m_LoadingTimes = SceneLoadingTimes();
+	m_LoadingTimes.parse = parseDuration;
+	m_Engine.Clear();
+	auto metaJson = sceneBinary.GetMetaJson();
+	sceneInfo.name = CheckJsonParameter(metaJson, "name", json::value_t::string) ?
+		metaJson["name"].get<std::string>() : "NewScene";
+	{
+		std::ostringstream oss;
+		oss << "Loading compiled scene: " << sceneInfo.name;
+		Log::GetInstance()->Msg(oss.str());
+	}
+}
+
+void SceneManager::LoadBinarySceneSystems(const SceneBinaryView& sceneBinary)
+{
+	const auto phaseStart = ProfilerClock::now();
+	auto metaJson = sceneBinary.GetMetaJson();
+	if (CheckJsonParameter(metaJson, "systems", json::value_t::array))
+	{
+		LoadSceneSystems(metaJson["systems"]);
+	}
+	m_LoadingTimes.systems += GetDurationSince(phaseStart);
+}
+
+EntityRange SceneManager::CreateBinarySceneEntities(const SceneBinaryView& sceneBinary)
+{
+	//The scene entities are contiguous from the first free one, the blocks index them from 0
+	const auto entityNmb = sceneBinary.GetEntityNmb();
+	if (entityNmb > INIT_ENTITY_NMB)
+	{
+		m_EntityManager->ResizeEntityNmb(entityNmb);
+	}
+	const auto phaseStart = ProfilerClock::now();
+	const auto entities = m_EntityManager->CreateEntities(entityNmb);
+	if (m_Engine.GetConfig()->editor)
+	{
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			const auto name = sceneBinary.GetEntityName(i);
+			if (!name.empty())
+				m_EntityManager->GetEntityInfo(entities[i]).name = std::string(name);
+		}
+	}
+	m_LoadingTimes.entities = GetDurationSince(phaseStart);
+	return entities;
+}
+
+void SceneManager::CreateBinarySceneComponents(const SceneBinaryView& sceneBinary, size_t blockIndex,
+	const EntityRange& entities, size_t begin, size_t end, std::vector<std::vector<json>>* blockJsons)
+{
+	const auto phaseStart = ProfilerClock::now();
+	const auto block = sceneBinary.GetBlock(blockIndex);
+	auto* componentManager = GetComponentManager(block.componentType);
+	if (componentManager == nullptr)
+	{
+		if (begin == 0)
+		{
+			std::ostringstream oss;
+			oss << "[Error] No component manager for the compiled components of type " <<
+				static_cast<int>(block.componentType);
+			Log::GetInstance()->Error(oss.str());
+		}
+		return;
+	}
+	if (block.encoding == SceneBlockEncoding::SOA)
+	{
+		//The columns of a SoA block are created in one call
+		begin = 0;
+		end = block.count;
+		componentManager->CreateComponents(block, entities);
+	}
 	else
+	{
+		//The CBOR is decoded on the job system, unless the loading thread already did it,
+		//then the manager creates the batch like a json scene
+		const auto count = end - begin;
+		std::vector<json> decodedJsons;
+		const bool predecoded = blockJsons != nullptr && (*blockJsons)[blockIndex].size() == block.count;
+		if (!predecoded)
+			decodedJsons.resize(count);
+		std::vector<json*> componentJsonPtrs(count);
+		std::vector<Entity> blockEntities(count);
+		m_Engine.GetJobSystem().ParallelFor(0, count, 0, [&](size_t start, size_t stop)
+		{
+			for (auto i = start; i < stop; i++)
+			{
+				if (predecoded)
+				{
+					componentJsonPtrs[i] = &(*blockJsons)[blockIndex][begin + i];
+				}
+				else
+				{
+					decodedJsons[i] = block.GetComponentJson(begin + i);
+					componentJsonPtrs[i] = &decodedJsons[i];
+				}
+				blockEntities[i] = entities[block.entityIndices[begin + i]];
+			}
+		});
+		componentManager->CreateComponentsFromJson(blockEntities, componentJsonPtrs);
+	}
+	for (auto i = begin; i < end; i++)
+	{
+		m_EntityManager->AddComponentType(entities[block.entityIndices[i]], block.componentType);
+	}
+	//A block created in several steps is one phase
+	if (begin == 0)
+		m_LoadingTimes.components.emplace_back(block.componentType, 0);
+	m_LoadingTimes.components.back().second += GetDurationSince(phaseStart);
+}
+
+bool SceneManager::LoadSceneFromNameAsync(const std::string& sceneName)
+{
+	const auto scenePathIt = m_ScenePathMap.find(sceneName);
+	if (scenePathIt == m_ScenePathMap.end())
+	{
+		LogUnknownScene(sceneName);
+		return false;
+	}
+	return LoadSceneFromPathAsync(scenePathIt->second);
+}
+
+bool SceneManager::LoadSceneFromPathAsync(const std::string& scenePath)
+{
+	if (IsLoadingScene())
 	{
 		std::ostringstream oss;
-		oss << "No Entities in " << sceneInfo->name;
+		oss << "[Error] Cannot stream the scene " << scenePath << " while another scene is loading";
 		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	{
+		std::ostringstream oss;
+		oss << "Streaming scene from: " << scenePath;
+		Log::GetInstance()->Msg(oss.str());
 	}
+	m_LoadingProgress = 0.0f;
+	m_StreamingCancelled = false;
+	//A dedicated thread, a job would hold a worker of the job system during the whole parsing
+	m_StreamingFuture = std::async(std::launch::async, &SceneManager::DecodeStreamedScene, scenePath,
+		std::ref(m_LoadingProgress), std::cref(m_StreamingCancelled));
+	return true;
+}
 
+std::unique_ptr<StreamedScene> SceneManager::DecodeStreamedScene(const std::string& scenePath,
+	std::atomic<float>& progress, const std::atomic<bool>& cancelled)
+{
+	const auto decodeStart = ProfilerClock::now();
+	auto streamedScene = std::make_unique<StreamedScene>();
+	streamedScene->scenePath = scenePath;
+	const auto binaryPath = GetCompiledScenePath(scenePath);
+	const bool compiled = FileExists(binaryPath) && GetFileWriteTime(binaryPath) >= GetFileWriteTime(scenePath) &&
+		streamedScene->mappedFile.Open(binaryPath);
+	if (!compiled || !streamedScene->GetView().IsValid())
+	{
+		streamedScene->mappedFile.Close();
+		const auto sceneJsonPtr = LoadJson(scenePath);
+		if (sceneJsonPtr == nullptr || !CompileScene(*sceneJsonPtr, streamedScene->binary))
+		{
+			streamedScene->error = "Invalid JSON format for scene " + scenePath;
+			return streamedScene;
+		}
+	}
+	progress = STREAMING_PARSED_PROGRESS;
+
+	const auto cancelledScene = [&streamedScene]()
+	{
+		streamedScene->error = "Streaming of the scene " + streamedScene->scenePath + " cancelled";
+		return std::move(streamedScene);
+	};
+	const auto sceneBinary = streamedScene->GetView();
+	streamedScene->blockJsons.resize(sceneBinary.GetBlockNmb());
+	for (size_t blockIndex = 0; blockIndex < sceneBinary.GetBlockNmb(); blockIndex++)
+	{
+		const auto block = sceneBinary.GetBlock(blockIndex);
+		if (block.encoding == SceneBlockEncoding::CBOR)
+		{
+			auto& componentJsons = streamedScene->blockJsons[blockIndex];
+			componentJsons.reserve(block.count);
+			for (size_t i = 0; i < block.count; i++)
+			{
+				if (i % SCENE_STREAMING_COMPONENT_CHUNK == 0 && cancelled)
+					return cancelledScene();
+				componentJsons.push_back(block.GetComponentJson(i));
+			}
+		}
+		else if (block.componentType == ComponentType::SPRITE2D)
+		{
+			SpriteManager::CollectTexturePaths(block, streamedScene->texturePaths);
+		}
+	}
+	progress = STREAMING_DECODED_PROGRESS;
+
+	//A texture that fails here is reported by its sprite creation
+	const auto& texturePaths = streamedScene->texturePaths;
+	streamedScene->images.resize(texturePaths.size());
+	for (size_t i = 0; i < texturePaths.size(); i++)
+	{
+		if (cancelled)
+			return cancelledScene();
+		if (FileExists(texturePaths[i]))
+		{
+			streamedScene->images[i].loadFromFile(texturePaths[i]);
+		}
+		progress = STREAMING_DECODED_PROGRESS +
+			(STREAMING_IMAGES_PROGRESS - STREAMING_DECODED_PROGRESS) * (i + 1) / texturePaths.size();
+	}
+	progress = STREAMING_IMAGES_PROGRESS;
+	streamedScene->decodeDuration = GetDurationSince(decodeStart);
+	return streamedScene;
+}
+
+void SceneManager::UpdateSceneStreaming()
+{
+	//A load requested by the last simulation replaces the scene here, on the main thread between two frames
+	std::function<void()> pendingSceneLoad;
+	{
+		std::lock_guard<std::mutex> lock(m_PendingSceneMutex);
+		pendingSceneLoad.swap(m_PendingSceneLoad);
+	}
+	if (pendingSceneLoad)
+	{
+		pendingSceneLoad();
+	}
+	if (m_StreamingFuture.valid())
+	{
+		if (m_StreamingFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return;
+		m_StreamedScene = m_StreamingFuture.get();
+		if (!m_StreamedScene->error.empty())
+		{
+			Log::GetInstance()->Error(m_StreamedScene->error);
+			m_StreamedScene = nullptr;
+			m_LoadingProgress = 0.0f;
+		}
+		//The textures are uploaded from the next frame, the current scene is not cleared in this one
+		//even without texture, see IsSceneReadyToInstantiate
+		return;
+	}
+	if (m_StreamedScene == nullptr)
+		return;
+
+	auto& images = m_StreamedScene->images;
+	auto& uploadedNmb = m_StreamedScene->uploadedNmb;
+	if (uploadedNmb < images.size())
+	{
+		//The upload of one texture cannot be split, at least one is done each frame
+		BudgetTimer budgetTimer(m_Engine.GetFrameBudget(), m_StreamingBudget);
+		auto* textureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
+		do
+		{
+			if (images[uploadedNmb].getSize().x != 0U)
+			{
+				textureManager->UploadTexture(m_StreamedScene->texturePaths[uploadedNmb], images[uploadedNmb]);
+			}
+			images[uploadedNmb] = sf::Image();
+			uploadedNmb++;
+		} while (uploadedNmb < images.size() && budgetTimer.HasTimeLeft());
+		m_LoadingProgress = STREAMING_IMAGES_PROGRESS +
+			(STREAMING_UPLOADED_PROGRESS - STREAMING_IMAGES_PROGRESS) * uploadedNmb / images.size();
+		return;
+	}
+
+	BudgetTimer budgetTimer(m_Engine.GetFrameBudget(), m_StreamingBudget);
+	const auto sceneBinary = m_StreamedScene->GetView();
+	if (m_StreamedScene->sceneInfo == nullptr)
+	{
+		//Everything is decoded and uploaded, the current scene is replaced in this frame by the new entities,
+		//the clear drops the streamed scene so it is kept aside
+		auto streamedScene = std::move(m_StreamedScene);
+		streamedScene->sceneInfo = std::make_unique<editor::SceneInfo>();
+		streamedScene->sceneInfo->path = streamedScene->scenePath;
+		BeginBinaryScene(sceneBinary, *streamedScene->sceneInfo, streamedScene->decodeDuration);
+		streamedScene->entities = CreateBinarySceneEntities(sceneBinary);
+		m_Engine.GetPythonEngine()->GetPyComponentManager().PauseUntilInit();
+		for (size_t blockIndex = 0; blockIndex < sceneBinary.GetBlockNmb(); blockIndex++)
+		{
+			streamedScene->componentNmb += sceneBinary.GetBlock(blockIndex).count;
+		}
+		m_StreamedScene = std::move(streamedScene);
+	}
+
+	//The components are created in the order of the blocks, a chunk at least each frame
+	//Until the last component is created no system runs on the new scene, see IsInstantiatingScene
+	auto& streamedScene = *m_StreamedScene;
+	bool timeLeft = true;
+	while (streamedScene.blockIndex < sceneBinary.GetBlockNmb() && timeLeft)
+	{
+		const auto block = sceneBinary.GetBlock(streamedScene.blockIndex);
+		const auto begin = streamedScene.componentIndex;
+		const auto end = block.encoding == SceneBlockEncoding::SOA ? block.count :
+			std::min(block.count, begin + SCENE_STREAMING_COMPONENT_CHUNK);
+		CreateBinarySceneComponents(sceneBinary, streamedScene.blockIndex, streamedScene.entities, begin, end,
+			&streamedScene.blockJsons);
+		streamedScene.createdNmb += end - begin;
+		streamedScene.componentIndex = end;
+		if (end == block.count)
+		{
+			streamedScene.blockIndex++;
+			streamedScene.componentIndex = 0;
+		}
+		timeLeft = budgetTimer.HasTimeLeft();
+	}
+	if (streamedScene.blockIndex < sceneBinary.GetBlockNmb())
+	{
+		m_LoadingProgress = STREAMING_UPLOADED_PROGRESS + (1.0f - STREAMING_UPLOADED_PROGRESS) *
+			streamedScene.createdNmb / streamedScene.componentNmb;
+		return;
+	}
+
+	//The scene systems and scripts start once every component exists
+	auto finishedScene = std::move(m_StreamedScene);
+	LoadBinarySceneSystems(sceneBinary);
+	FinishSceneLoading(std::move(finishedScene->sceneInfo));
+	m_LoadingProgress = 1.0f;
+}
+
+bool SceneManager::IsLoadingScene() const
+{
+	return m_StreamingFuture.valid() || m_StreamedScene != nullptr;
+}
+
+bool SceneManager::IsInstantiatingScene() const
+{
+	return m_StreamedScene != nullptr && m_StreamedScene->sceneInfo != nullptr;
+}
+
+bool SceneManager::IsSceneReadyToInstantiate() const
+{
+	return m_StreamedScene != nullptr && m_StreamedScene->sceneInfo == nullptr &&
+		m_StreamedScene->uploadedNmb == m_StreamedScene->images.size();
+}
+
+float SceneManager::GetLoadingProgress() const
+{
+	return m_LoadingProgress;
+}
+
+void SceneManager::FinishSceneLoading(std::unique_ptr<editor::SceneInfo> sceneInfo)
+{
+	const auto finishStart = ProfilerClock::now();
+	const auto sceneName = sceneInfo->name;
 	//remove previous scene assets
 
 	m_Engine.Collect();
@@ -264,6 +739,37 @@ void SceneManager::LoadSceneFromJson(json& sceneJson, std::unique_ptr<editor::Sc
 	pythonEngine->InitScriptsInstances();
 
 	InitScenePySystems();	
+	m_LoadingTimes.finish = GetDurationSince(finishStart);
+	LogLoadingTimes(sceneName);
+}
+
+void SceneManager::LogLoadingTimes(const std::string& sceneName) const
+{
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(2) << "Scene " << sceneName << " loaded in " <<
+		m_LoadingTimes.GetTotal() / 1000.0 << " ms: parse " << m_LoadingTimes.parse / 1000.0 << ", systems " <<
+		m_LoadingTimes.systems / 1000.0 << ", entities " << m_LoadingTimes.entities / 1000.0;
+	for (const auto& componentTime : m_LoadingTimes.components)
+	{
+		oss << ", components " << static_cast<int>(componentTime.first) << " " << componentTime.second / 1000.0;
+	}
+	oss << ", finish " << m_LoadingTimes.finish / 1000.0;
+	Log::GetInstance()->Msg(oss.str());
+}
+
+const SceneLoadingTimes& SceneManager::GetLoadingTimes() const
+{
+	return m_LoadingTimes;
+}
+
+std::int64_t SceneLoadingTimes::GetTotal() const
+{
+	std::int64_t total = parse + systems + entities + finish;
+	for (const auto& componentTime : components)
+	{
+		total += componentTime.second;
+	}
+	return total;
 }
 
 std::list<std::string> SceneManager::GetAllScenes()
@@ -278,6 +784,8 @@ std::list<std::string> SceneManager::GetAllScenes()
 
 void SceneManager::LoadSceneFromName(const std::string& sceneName)
 {
+	if (DeferSceneLoad([this, sceneName]() { LoadSceneFromName(sceneName); }))
+		return;
 	if (m_ScenePathMap.find(sceneName) != m_ScenePathMap.end())
 	{
 
@@ -292,41 +800,182 @@ void SceneManager::LoadSceneFromName(const std::string& sceneName)
 		}
 	}
 	else
+	{
+		LogUnknownScene(sceneName);
+	}
+}
+
+bool SceneManager::DeferSceneLoad(std::function<void()> sceneLoad)
+{
+	if (m_Engine.GetJobSystem().IsMainThread() && !m_Engine.GetSystemGraph().IsRunning())
+		return false;
+	std::lock_guard<std::mutex> lock(m_PendingSceneMutex);
+	m_PendingSceneLoad = std::move(sceneLoad);
+	return true;
+}
+
+void SceneManager::LogUnknownScene(const std::string& sceneName) const
+{
+	std::ostringstream oss;
+	oss << "[ERROR] No scene is named: " << sceneName <<"\n";
+	oss << "Here are the list of scenes:\n";
+	for(auto& sceneNamePair : m_ScenePathMap)
+	{
+		oss << "- " << sceneNamePair.first << "\n";
+	}
+	Log::GetInstance()->Error(oss.str());
+}
+Prefab* SceneManager::LoadPrefab(const std::string& prefabPath)
+{
+	const auto prefabIt = m_Prefabs.find(prefabPath);
+	if (prefabIt != m_Prefabs.end())
+		return prefabIt->second.get();
+	const auto prefabJsonPtr = LoadJson(prefabPath);
+	if (prefabJsonPtr == nullptr)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Invalid JSON format for prefab " << prefabPath;
+		Log::GetInstance()->Error(oss.str());
+		return nullptr;
+	}
+	return LoadPrefabFromJson(prefabPath, *prefabJsonPtr);
+}
+
+Prefab* SceneManager::LoadPrefabFromJson(const std::string& prefabKey, const json& prefabJson)
+{
+	if (!CheckJsonParameter(prefabJson, "components", json::value_t::array))
 	{
 		std::ostringstream oss;
-		oss << "[ERROR] No scene is named: " << sceneName <<"\n";
-		oss << "Here are the list of scenes:\n";
-		for(auto& sceneNamePair : m_ScenePathMap)
+		oss << "[Error] No components in the prefab " << prefabKey;
+		Log::GetInstance()->Error(oss.str());
+		return nullptr;
+	}
+	auto prefab = std::make_unique<Prefab>();
+	prefab->name = CheckJsonParameter(prefabJson, "name", json::value_t::string) ?
+		prefabJson["name"].get<std::string>() : prefabKey;
+	for (const auto& componentJson : prefabJson["components"])
+	{
+		if (!CheckJsonExists(componentJson, "type"))
 		{
-			oss << "- " << sceneNamePair.first << "\n";
+			std::ostringstream oss;
+			oss << "[Error] No type specified for component with json content: " << componentJson;
+			Log::GetInstance()->Error(oss.str());
+			continue;
+		}
+		PrefabComponent prefabComponent;
+		prefabComponent.componentType = componentJson["type"];
+		prefabComponent.componentJson = componentJson;
+		auto* componentManager = GetComponentManager(prefabComponent.componentType);
+		if (componentManager == nullptr)
+		{
+			std::ostringstream oss;
+			oss << "[Error] No component manager for the prefab components of type " <<
+				static_cast<int>(prefabComponent.componentType);
+			Log::GetInstance()->Error(oss.str());
+			continue;
+		}
+		componentManager->ResolvePrefabComponent(prefabComponent);
+		prefab->components.push_back(std::move(prefabComponent));
+	}
+	//Created in increasing type order like a scene, the bodies need their transform and the colliders their body
+	std::stable_sort(prefab->components.begin(), prefab->components.end(),
+		[](const PrefabComponent& component1, const PrefabComponent& component2)
+	{
+		return static_cast<int>(component1.componentType) < static_cast<int>(component2.componentType);
+	});
+	auto& storedPrefab = m_Prefabs[prefabKey];
+	storedPrefab = std::move(prefab);
+	return storedPrefab.get();
+}
+
+EntityRange SceneManager::InstantiatePrefab(const Prefab& prefab, const std::vector<Vec2f>& positions)
+{
+	m_EntityManager->ReserveEntities(positions.size());
+	const auto entityRange = m_EntityManager->CreateEntities(positions.size());
+	std::vector<Entity> entities(entityRange.size());
+	for (size_t i = 0; i < entityRange.size(); i++)
+	{
+		entities[i] = entityRange[i];
+	}
+	for (const auto& prefabComponent : prefab.components)
+	{
+		GetComponentManager(prefabComponent.componentType)->InstantiatePrefabComponents(prefabComponent, entities,
+			positions);
+		for (Entity entity : entities)
+		{
+			m_EntityManager->AddComponentType(entity, prefabComponent.componentType);
 		}
-		Log::GetInstance()->Error(oss.str());
 	}
+	//Names are only kept for the editor, like the scene entities
+	if (m_Engine.GetConfig()->editor)
+	{
+		for (Entity entity : entities)
+		{
+			m_EntityManager->GetEntityInfo(entity).name = prefab.name + " " + std::to_string(entity);
+		}
+	}
+	return entityRange;
 }
+
 void SceneManager::AddComponentManager(IComponentFactory *componentFactory, ComponentType componentType)
 {
 	const auto index = static_cast<int>(log2((double)componentType));
 	m_ComponentManager[index] = componentFactory;
 }
+
+IComponentFactory* SceneManager::GetComponentManager(ComponentType componentType)
+{
+	const auto index = static_cast<int>(log2((double)componentType));
+	if (index < 0 || index >= static_cast<int>(m_ComponentManager.size()))
+		return nullptr;
+	return m_ComponentManager[index];
+}
 void SceneManager::Update(float dt)
 {
 	rmt_ScopedCPUSample(PySceneSystemUpdate,0);
-	for(auto* pySystem: m_ScenePySystems)
+	for(auto i = 0u; i < m_ScenePySystems.size(); i++)
 	{
-		pySystem->Update(dt);
+		auto& ticker = m_UpdateTickers[i];
+		if (!ticker.Advance(dt))
+			continue;
+		m_ScenePySystems[i]->SetTickState(ticker.GetState());
+		m_ScenePySystems[i]->Update(ticker.GetState().deltaTime);
 	}
 }
 void SceneManager::FixedUpdate()
 {
 	rmt_ScopedCPUSample(PySceneSystemFixedUpdate,0);
-	for(auto* pySystem: m_ScenePySystems)
+	const auto fixedDeltaTime = m_Engine.GetConfig()->fixedDeltaTime;
+	for(auto i = 0u; i < m_ScenePySystems.size(); i++)
 	{
-		pySystem->FixedUpdate();
+		auto& ticker = m_FixedUpdateTickers[i];
+		if (!ticker.Advance(fixedDeltaTime))
+			continue;
+		m_ScenePySystems[i]->SetTickState(ticker.GetState());
+		m_ScenePySystems[i]->FixedUpdate();
 	}
 }
 void SceneManager::Destroy()
 {
+	//A synchronous loading drops the streamed scene, the loading thread is stopped and joined first
+	if (m_StreamingFuture.valid())
+	{
+		m_StreamingCancelled = true;
+		m_StreamingFuture.wait();
+		m_StreamingFuture = std::future<std::unique_ptr<StreamedScene>>();
+	}
+	m_StreamedScene = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_PendingSceneMutex);
+		m_PendingSceneLoad = nullptr;
+	}
+	//The prefabs hold references on the assets of the scene
+	m_Prefabs.clear();
 	m_ScenePySystems.clear();
+	m_UpdateTickers.clear();
+	m_FixedUpdateTickers.clear();
+	DeclareAccess(0, 0);
+	m_Engine.GetSystemGraph().InvalidateAccess();
 }
 void SceneManager::InitScenePySystems()
 {
@@ -338,6 +987,29 @@ void SceneManager::InitScenePySystems()
 			pySystem->Init();
 		}
 	}
+	//The slow systems are spread over their period instead of all running on the same frame
+	m_UpdateTickers.resize(m_ScenePySystems.size());
+	m_FixedUpdateTickers.resize(m_ScenePySystems.size());
+	std::vector<SystemTicker*> updateTickers;
+	std::vector<SystemTicker*> fixedUpdateTickers;
+	for (auto i = 0u; i < m_ScenePySystems.size(); i++)
+	{
+		const auto policy = m_ScenePySystems[i] == nullptr ? TickPolicy() : m_ScenePySystems[i]->GetTickPolicy();
+		m_UpdateTickers[i].Init(policy);
+		m_FixedUpdateTickers[i].Init(policy);
+		updateTickers.push_back(&m_UpdateTickers[i]);
+		fixedUpdateTickers.push_back(&m_FixedUpdateTickers[i]);
+	}
+	SpreadTickers(updateTickers);
+	SpreadTickers(fixedUpdateTickers);
+	//The systems declare their access in Init
+	DeclareAccess(0, 0);
+	for (auto* pySystem : m_ScenePySystems)
+	{
+		if (pySystem != nullptr)
+			AddAccess(pySystem->GetAccess());
+	}
+	m_Engine.GetSystemGraph().InvalidateAccess();
 }
 void SceneManager::Draw()
 {
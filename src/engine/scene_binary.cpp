@@ -0,0 +1,495 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <engine/scene_binary.h>
+#include <engine/component.h>
+#include <engine/transform2d.h>
+#include <graphics/sprite2d.h>
+#include <utility/log.h>
+
+namespace sfge
+{
+
+const size_t SCENE_BINARY_ALIGNMENT = 8;
+
+static bool IsComponentTypeValue(std::int64_t componentType)
+{
+	return componentType > 0 && componentType <= std::numeric_limits<std::int32_t>::max() &&
+		(componentType & (componentType - 1)) == 0;
+}
+
+/**
+ * \brief The component types compiled to SoA columns, each one is loaded by the CreateComponents of its manager
+ */
+static SceneBlockCompiler GetSceneBlockCompiler(ComponentType componentType)
+{
+	switch (componentType)
+	{
+	case ComponentType::TRANSFORM2D:
+		return &Transform2dManager::CompileComponents;
+	case ComponentType::SPRITE2D:
+		return &SpriteManager::CompileComponents;
+	default:
+		return nullptr;
+	}
+}
+
+const float* SceneBlock::GetFloatColumn(size_t column) const
+{
+	return reinterpret_cast<const float*>(GetUintColumn(column));
+}
+
+const std::int32_t* SceneBlock::GetIntColumn(size_t column) const
+{
+	return reinterpret_cast<const std::int32_t*>(GetUintColumn(column));
+}
+
+const std::uint32_t* SceneBlock::GetUintColumn(size_t column) const
+{
+	if (encoding != SceneBlockEncoding::SOA || column >= columnNmb)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Scene binary: no column " << column << " in the block of component type " <<
+			static_cast<int>(componentType);
+		Log::GetInstance()->Error(oss.str());
+		return nullptr;
+	}
+	return reinterpret_cast<const std::uint32_t*>(data) + count * (column + 1);
+}
+
+std::string_view SceneBlock::GetString(std::uint32_t stringIndex) const
+{
+	return scene->GetString(stringIndex);
+}
+
+json SceneBlock::GetComponentJson(size_t index) const
+{
+	if (encoding != SceneBlockEncoding::CBOR || index >= count)
+		return json();
+	const auto* offsets = reinterpret_cast<const std::uint32_t*>(data) + count;
+	const auto* bytes = reinterpret_cast<const std::uint8_t*>(offsets + count + 1);
+	try
+	{
+		return json::from_cbor(bytes + offsets[index], bytes + offsets[index + 1]);
+	}
+	catch (json::exception& e)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Scene binary: invalid component json at index " << index << "\n" << e.what();
+		Log::GetInstance()->Error(oss.str());
+	}
+	return json();
+}
+
+SceneBinaryView::SceneBinaryView(const std::byte* data, size_t size) : m_Data(data), m_Size(size)
+{
+	if (m_Data == nullptr || m_Size < sizeof(SceneBinaryHeader))
+		return;
+	m_Header = reinterpret_cast<const SceneBinaryHeader*>(m_Data);
+	if (m_Header->magic != SCENE_BINARY_MAGIC || m_Header->version != SCENE_BINARY_VERSION)
+		return;
+	if (!CheckSection(sizeof(SceneBinaryHeader), std::uint64_t(m_Header->blockNmb) * sizeof(SceneBlockHeader)) ||
+		!CheckSection(m_Header->metaOffset, m_Header->metaSize) ||
+		!CheckStringTable(m_Header->namesOffset, m_Header->namesSize, m_Header->entityNmb) ||
+		!CheckStringTable(m_Header->stringsOffset, m_Header->stringsSize, m_Header->stringNmb))
+		return;
+	m_Blocks = reinterpret_cast<const SceneBlockHeader*>(m_Data + sizeof(SceneBinaryHeader));
+	for (size_t i = 0; i < m_Header->blockNmb; i++)
+	{
+		const auto& block = m_Blocks[i];
+		if (!IsComponentTypeValue(block.componentType) || !CheckSection(block.offset, block.size))
+			return;
+		std::uint64_t minSize = std::uint64_t(block.count) * sizeof(std::uint32_t);
+		switch (block.encoding)
+		{
+		case SceneBlockEncoding::SOA:
+			minSize += std::uint64_t(block.count) * block.columnNmb * sizeof(std::uint32_t);
+			break;
+		case SceneBlockEncoding::CBOR:
+			minSize += (std::uint64_t(block.count) + 1) * sizeof(std::uint32_t);
+			break;
+		default:
+			return;
+		}
+		if (block.size < minSize)
+			return;
+		const auto* entityIndices = reinterpret_cast<const std::uint32_t*>(m_Data + block.offset);
+		for (size_t j = 0; j < block.count; j++)
+		{
+			if (entityIndices[j] >= m_Header->entityNmb)
+				return;
+		}
+		if (block.encoding == SceneBlockEncoding::CBOR)
+		{
+			const auto* offsets = entityIndices + block.count;
+			if (offsets[block.count] > block.size - minSize)
+				return;
+			for (size_t j = 0; j < block.count; j++)
+			{
+				if (offsets[j] > offsets[j + 1])
+					return;
+			}
+		}
+	}
+	m_Valid = true;
+}
+
+bool SceneBinaryView::IsValid() const
+{
+	return m_Valid;
+}
+
+size_t SceneBinaryView::GetEntityNmb() const
+{
+	return m_Valid ? m_Header->entityNmb : 0;
+}
+
+size_t SceneBinaryView::GetBlockNmb() const
+{
+	return m_Valid ? m_Header->blockNmb : 0;
+}
+
+SceneBlock SceneBinaryView::GetBlock(size_t index) const
+{
+	SceneBlock block;
+	if (!m_Valid || index >= m_Header->blockNmb)
+		return block;
+	const auto& blockHeader = m_Blocks[index];
+	block.componentType = static_cast<ComponentType>(blockHeader.componentType);
+	block.encoding = blockHeader.encoding;
+	block.count = blockHeader.count;
+	block.columnNmb = blockHeader.columnNmb;
+	block.data = m_Data + blockHeader.offset;
+	block.entityIndices = reinterpret_cast<const std::uint32_t*>(block.data);
+	block.scene = this;
+	return block;
+}
+
+json SceneBinaryView::GetMetaJson() const
+{
+	if (!m_Valid || m_Header->metaSize == 0)
+		return json::object();
+	const auto* meta = reinterpret_cast<const std::uint8_t*>(m_Data + m_Header->metaOffset);
+	try
+	{
+		return json::from_cbor(meta, meta + m_Header->metaSize);
+	}
+	catch (json::exception& e)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Scene binary: invalid scene meta json\n" << e.what();
+		Log::GetInstance()->Error(oss.str());
+	}
+	return json::object();
+}
+
+std::string_view SceneBinaryView::GetEntityName(size_t entityIndex) const
+{
+	if (!m_Valid || entityIndex >= m_Header->entityNmb)
+		return std::string_view();
+	return GetTableString(m_Data + m_Header->namesOffset, m_Header->entityNmb, static_cast<std::uint32_t>(entityIndex));
+}
+
+std::string_view SceneBinaryView::GetString(std::uint32_t stringIndex) const
+{
+	if (!m_Valid || stringIndex >= m_Header->stringNmb)
+		return std::string_view();
+	return GetTableString(m_Data + m_Header->stringsOffset, m_Header->stringNmb, stringIndex);
+}
+
+bool SceneBinaryView::CheckSection(std::uint64_t offset, std::uint64_t size) const
+{
+	return offset % SCENE_BINARY_ALIGNMENT == 0 && offset <= m_Size && size <= m_Size - offset;
+}
+
+bool SceneBinaryView::CheckStringTable(std::uint64_t offset, std::uint64_t size, size_t stringNmb) const
+{
+	const std::uint64_t tableSize = (std::uint64_t(stringNmb) + 1) * sizeof(std::uint32_t);
+	if (!CheckSection(offset, size) || size < tableSize)
+		return false;
+	const auto* offsets = reinterpret_cast<const std::uint32_t*>(m_Data + offset);
+	for (size_t i = 0; i < stringNmb; i++)
+	{
+		if (offsets[i] > offsets[i + 1])
+			return false;
+	}
+	return offsets[stringNmb] <= size - tableSize;
+}
+
+std::string_view SceneBinaryView::GetTableString(const std::byte* table, size_t stringNmb, std::uint32_t index)
+{
+	const auto* offsets = reinterpret_cast<const std::uint32_t*>(table);
+	const auto* chars = reinterpret_cast<const char*>(offsets + stringNmb + 1);
+	return std::string_view(chars + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+SceneBlockBuilder::SceneBlockBuilder(std::vector<std::string>& strings) : m_Strings(strings)
+{
+}
+
+void SceneBlockBuilder::AddFloatColumn(const std::vector<float>& column)
+{
+	std::vector<std::uint32_t> bits(column.size());
+	std::memcpy(bits.data(), column.data(), column.size() * sizeof(float));
+	m_Columns.push_back(std::move(bits));
+}
+
+void SceneBlockBuilder::AddIntColumn(const std::vector<std::int32_t>& column)
+{
+	m_Columns.emplace_back(column.begin(), column.end());
+}
+
+void SceneBlockBuilder::AddUintColumn(const std::vector<std::uint32_t>& column)
+{
+	m_Columns.push_back(column);
+}
+
+std::uint32_t SceneBlockBuilder::AddString(const std::string& value)
+{
+	const auto it = std::find(m_Strings.begin(), m_Strings.end(), value);
+	if (it != m_Strings.end())
+		return static_cast<std::uint32_t>(it - m_Strings.begin());
+	m_Strings.push_back(value);
+	return static_cast<std::uint32_t>(m_Strings.size() - 1);
+}
+
+const std::vector<std::vector<std::uint32_t>>& SceneBlockBuilder::GetColumns() const
+{
+	return m_Columns;
+}
+
+static void AppendBytes(std::vector<std::byte>& binary, const void* data, size_t size)
+{
+	const auto* bytes = static_cast<const std::byte*>(data);
+	binary.insert(binary.end(), bytes, bytes + size);
+}
+
+static void AlignBinary(std::vector<std::byte>& binary)
+{
+	binary.resize((binary.size() + SCENE_BINARY_ALIGNMENT - 1) / SCENE_BINARY_ALIGNMENT * SCENE_BINARY_ALIGNMENT,
+		std::byte{0});
+}
+
+/**
+ * \brief Append an 8 bytes aligned offset table followed by the characters, returns its offset
+ */
+static std::uint64_t AppendStringTable(std::vector<std::byte>& binary, const std::vector<std::string>& strings)
+{
+	AlignBinary(binary);
+	const std::uint64_t offset = binary.size();
+	std::vector<std::uint32_t> offsets;
+	offsets.reserve(strings.size() + 1);
+	std::uint32_t charNmb = 0;
+	for (const auto& value : strings)
+	{
+		offsets.push_back(charNmb);
+		charNmb += static_cast<std::uint32_t>(value.size());
+	}
+	offsets.push_back(charNmb);
+	AppendBytes(binary, offsets.data(), offsets.size() * sizeof(std::uint32_t));
+	for (const auto& value : strings)
+	{
+		AppendBytes(binary, value.data(), value.size());
+	}
+	return offset;
+}
+
+bool CompileScene(const json& sceneJson, std::vector<std::byte>& binary)
+{
+	if (!CheckJsonParameter(sceneJson, "entities", json::value_t::array))
+	{
+		Log::GetInstance()->Error("[Error] Scene compiler: no entities array in the scene");
+		return false;
+	}
+	const auto& entitiesJson = sceneJson["entities"];
+
+	//Components grouped by type, in increasing type order
+	std::map<std::int64_t, std::vector<std::pair<std::uint32_t, const json*>>> componentsByType;
+	std::vector<std::string> entityNames;
+	entityNames.reserve(entitiesJson.size());
+	for (size_t entityIndex = 0; entityIndex < entitiesJson.size(); entityIndex++)
+	{
+		const auto& entityJson = entitiesJson[entityIndex];
+		entityNames.push_back(CheckJsonParameter(entityJson, "name", json::value_t::string) ?
+			entityJson["name"].get<std::string>() : std::string());
+		if (!CheckJsonParameter(entityJson, "components", json::value_t::array))
+			continue;
+		for (const auto& componentJson : entityJson["components"])
+		{
+			if (!CheckJsonNumber(componentJson, "type") ||
+				!IsComponentTypeValue(componentJson["type"].get<std::int64_t>()))
+			{
+				std::ostringstream oss;
+				oss << "[Error] Scene compiler: invalid component type with json content: " << componentJson;
+				Log::GetInstance()->Error(oss.str());
+				continue;
+			}
+			componentsByType[componentJson["type"].get<std::int64_t>()].emplace_back(
+				static_cast<std::uint32_t>(entityIndex), &componentJson);
+		}
+	}
+
+	json metaJson = json::object();
+	if (CheckJsonParameter(sceneJson, "name", json::value_t::string))
+		metaJson["name"] = sceneJson["name"];
+	if (CheckJsonParameter(sceneJson, "systems", json::value_t::array))
+		metaJson["systems"] = sceneJson["systems"];
+
+	SceneBinaryHeader header;
+	header.entityNmb = static_cast<std::uint32_t>(entitiesJson.size());
+	header.blockNmb = static_cast<std::uint32_t>(componentsByType.size());
+	std::vector<SceneBlockHeader> blockHeaders;
+	blockHeaders.reserve(componentsByType.size());
+
+	binary.clear();
+	binary.resize(sizeof(SceneBinaryHeader) + header.blockNmb * sizeof(SceneBlockHeader));
+
+	AlignBinary(binary);
+	const auto metaBytes = json::to_cbor(metaJson);
+	header.metaOffset = binary.size();
+	header.metaSize = metaBytes.size();
+	AppendBytes(binary, metaBytes.data(), metaBytes.size());
+
+	header.namesOffset = AppendStringTable(binary, entityNames);
+	header.namesSize = binary.size() - header.namesOffset;
+
+	//The strings are only known once the blocks are compiled, they are written after them
+	std::vector<std::string> strings;
+	for (auto& typeComponents : componentsByType)
+	{
+		const auto componentType = static_cast<ComponentType>(typeComponents.first);
+		const auto& components = typeComponents.second;
+		SceneBlockHeader blockHeader;
+		blockHeader.componentType = static_cast<std::int32_t>(typeComponents.first);
+		blockHeader.count = static_cast<std::uint32_t>(components.size());
+
+		std::vector<std::uint32_t> entityIndices;
+		std::vector<const json*> componentJsons;
+		entityIndices.reserve(components.size());
+		componentJsons.reserve(components.size());
+		for (const auto& component : components)
+		{
+			entityIndices.push_back(component.first);
+			componentJsons.push_back(component.second);
+		}
+
+		AlignBinary(binary);
+		blockHeader.offset = binary.size();
+		AppendBytes(binary, entityIndices.data(), entityIndices.size() * sizeof(std::uint32_t));
+		const auto blockCompiler = GetSceneBlockCompiler(componentType);
+		if (blockCompiler != nullptr)
+		{
+			SceneBlockBuilder builder(strings);
+			blockCompiler(componentJsons, builder);
+			blockHeader.encoding = SceneBlockEncoding::SOA;
+			blockHeader.columnNmb = static_cast<std::uint32_t>(builder.GetColumns().size());
+			for (const auto& column : builder.GetColumns())
+			{
+				if (column.size() != components.size())
+				{
+					std::ostringstream oss;
+					oss << "[Error] Scene compiler: column of " << column.size() << " values for " <<
+						components.size() << " components of type " << blockHeader.componentType;
+					Log::GetInstance()->Error(oss.str());
+					return false;
+				}
+				AppendBytes(binary, column.data(), column.size() * sizeof(std::uint32_t));
+			}
+		}
+		else
+		{
+			blockHeader.encoding = SceneBlockEncoding::CBOR;
+			std::vector<std::uint8_t> cborBytes;
+			std::vector<std::uint32_t> offsets;
+			offsets.reserve(componentJsons.size() + 1);
+			for (const auto* componentJson : componentJsons)
+			{
+				offsets.push_back(static_cast<std::uint32_t>(cborBytes.size()));
+				json::to_cbor(*componentJson, cborBytes);
+			}
+			offsets.push_back(static_cast<std::uint32_t>(cborBytes.size()));
+			AppendBytes(binary, offsets.data(), offsets.size() * sizeof(std::uint32_t));
+			AppendBytes(binary, cborBytes.data(), cborBytes.size());
+		}
+		blockHeader.size = binary.size() - blockHeader.offset;
+		blockHeaders.push_back(blockHeader);
+	}
+
+	header.stringNmb = static_cast<std::uint32_t>(strings.size());
+	header.stringsOffset = AppendStringTable(binary, strings);
+	header.stringsSize = binary.size() - header.stringsOffset;
+	AlignBinary(binary);
+
+	std::memcpy(binary.data(), &header, sizeof(SceneBinaryHeader));
+	std::memcpy(binary.data() + sizeof(SceneBinaryHeader), blockHeaders.data(),
+		blockHeaders.size() * sizeof(SceneBlockHeader));
+	return true;
+}
+
+bool CompileSceneFile(const std::string& scenePath, const std::string& binaryPath)
+{
+	const auto sceneJsonPtr = LoadJson(scenePath);
+	if (sceneJsonPtr == nullptr)
+		return false;
+	std::vector<std::byte> binary;
+	if (!CompileScene(*sceneJsonPtr, binary))
+	{
+		std::ostringstream oss;
+		oss << "[Error] Could not compile the scene: " << scenePath;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	std::ofstream binaryFile(binaryPath, std::ios::binary | std::ios::trunc);
+	binaryFile.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+	if (!binaryFile)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Could not write the compiled scene: " << binaryPath;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	std::ostringstream oss;
+	oss << "Compiled scene " << scenePath << " to " << binaryPath << " (" << binary.size() << " bytes)";
+	Log::GetInstance()->Msg(oss.str());
+	return true;
+}
+
+std::string GetCompiledScenePath(const std::string& scenePath)
+{
+	const auto extensionIndex = scenePath.find_last_of('.');
+	const auto separatorIndex = scenePath.find_last_of("/\\");
+	if (extensionIndex == std::string::npos ||
+		(separatorIndex != std::string::npos && extensionIndex < separatorIndex))
+		return scenePath + SCENE_BINARY_EXTENSION;
+	return scenePath.substr(0, extensionIndex) + SCENE_BINARY_EXTENSION;
+}
+
+}
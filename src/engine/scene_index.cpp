@@ -0,0 +1,319 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#include <engine/scene_index.h>
+#include <utility/file_utility.h>
+#include <utility/json_utility.h>
+#include <utility/log.h>
+
+namespace sfge
+{
+
+const size_t SCENE_READ_BUFFER_SIZE = 4096;
+
+/**
+ * \brief Buffered character reader over a file, only what the scan needs
+ */
+class SceneStreamReader
+{
+public:
+	explicit SceneStreamReader(const std::string& path) : m_File(path, std::ios::binary)
+	{
+	}
+
+	bool IsOpen() const
+	{
+		return m_File.is_open();
+	}
+
+	bool Next(char& c)
+	{
+		if (m_Position == m_Size)
+		{
+			m_File.read(m_Buffer, SCENE_READ_BUFFER_SIZE);
+			m_Size = static_cast<size_t>(m_File.gcount());
+			m_Position = 0;
+			if (m_Size == 0)
+				return false;
+		}
+		c = m_Buffer[m_Position++];
+		return true;
+	}
+
+	bool NextNonSpace(char& c)
+	{
+		while (Next(c))
+		{
+			if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * \brief Read a json string after its opening quote
+	 */
+	bool ReadString(std::string& value)
+	{
+		value.clear();
+		char c;
+		while (Next(c))
+		{
+			if (c == '"')
+				return true;
+			if (c != '\\')
+			{
+				value.push_back(c);
+				continue;
+			}
+			if (!Next(c))
+				return false;
+			switch (c)
+			{
+			case 'b': value.push_back('\b'); break;
+			case 'f': value.push_back('\f'); break;
+			case 'n': value.push_back('\n'); break;
+			case 'r': value.push_back('\r'); break;
+			case 't': value.push_back('\t'); break;
+			case 'u':
+			{
+				unsigned codePoint = 0;
+				for (int i = 0; i < 4; i++)
+				{
+					if (!Next(c))
+						return false;
+					codePoint <<= 4;
+					if (c >= '0' && c <= '9') codePoint |= c - '0';
+					else if (c >= 'a' && c <= 'f') codePoint |= c - 'a' + 10;
+					else if (c >= 'A' && c <= 'F') codePoint |= c - 'A' + 10;
+					else return false;
+				}
+				//Basic multilingual plane only, the scene names are plain text
+				if (codePoint < 0x80)
+				{
+					value.push_back(static_cast<char>(codePoint));
+				}
+				else if (codePoint < 0x800)
+				{
+					value.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+					value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				else
+				{
+					value.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+					value.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+					value.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				break;
+			}
+			default:
+				value.push_back(c);
+				break;
+			}
+		}
+		return false;
+	}
+private:
+	std::ifstream m_File;
+	char m_Buffer[SCENE_READ_BUFFER_SIZE];
+	size_t m_Position = 0;
+	size_t m_Size = 0;
+};
+
+std::string ReadSceneName(const std::string& scenePath)
+{
+	SceneStreamReader reader(scenePath);
+	if (!reader.IsOpen())
+		return std::string();
+	char c;
+	if (!reader.NextNonSpace(c) || c != '{')
+		return std::string();
+
+	//Only the keys of the root object matter, the nested values are skipped by tracking the depth
+	size_t depth = 1;
+	bool expectKey = true;
+	std::string value;
+	while (reader.Next(c))
+	{
+		switch (c)
+		{
+		case '"':
+		{
+			if (!reader.ReadString(value))
+				return std::string();
+			if (depth != 1 || !expectKey)
+				break;
+			expectKey = false;
+			if (!reader.NextNonSpace(c) || c != ':')
+				return std::string();
+			if (value == "name")
+			{
+				if (reader.NextNonSpace(c) && c == '"' && reader.ReadString(value))
+					return value;
+				return std::string();
+			}
+			break;
+		}
+		case '{':
+		case '[':
+			depth++;
+			break;
+		case '}':
+		case ']':
+			depth--;
+			if (depth == 0)
+				return std::string();
+			break;
+		case ',':
+			if (depth == 1)
+				expectKey = true;
+			break;
+		default:
+			break;
+		}
+	}
+	return std::string();
+}
+
+bool SceneIndex::Load(const std::string& manifestPath)
+{
+	m_Entries.clear();
+	m_Dirty = true;
+	if (!FileExists(manifestPath))
+		return false;
+	std::ifstream manifestFile(manifestPath);
+	json manifestJson;
+	try
+	{
+		manifestFile >> manifestJson;
+	}
+	catch (json::exception& e)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Invalid scene index at " << manifestPath << ", it will be rebuilt\n" << e.what();
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	if (!CheckJsonNumber(manifestJson, "version") || manifestJson["version"] != SCENE_INDEX_VERSION ||
+		!CheckJsonParameter(manifestJson, "scenes", json::value_t::array))
+		return false;
+	for (const auto& sceneJson : manifestJson["scenes"])
+	{
+		if (!CheckJsonParameter(sceneJson, "path", json::value_t::string) ||
+			!CheckJsonParameter(sceneJson, "name", json::value_t::string) ||
+			!CheckJsonNumber(sceneJson, "writeTime") || !CheckJsonNumber(sceneJson, "size"))
+			continue;
+		SceneIndexEntry entry;
+		entry.name = sceneJson["name"].get<std::string>();
+		entry.writeTime = sceneJson["writeTime"].get<std::int64_t>();
+		entry.fileSize = sceneJson["size"].get<std::uint64_t>();
+		m_Entries[sceneJson["path"].get<std::string>()] = std::move(entry);
+	}
+	m_Dirty = false;
+	return true;
+}
+
+bool SceneIndex::Save(const std::string& manifestPath) const
+{
+	json manifestJson;
+	manifestJson["version"] = SCENE_INDEX_VERSION;
+	manifestJson["scenes"] = json::array();
+	for (const auto& pathEntry : m_Entries)
+	{
+		json sceneJson;
+		sceneJson["path"] = pathEntry.first;
+		sceneJson["name"] = pathEntry.second.name;
+		sceneJson["writeTime"] = pathEntry.second.writeTime;
+		sceneJson["size"] = pathEntry.second.fileSize;
+		manifestJson["scenes"].push_back(sceneJson);
+	}
+	std::ofstream manifestFile(manifestPath, std::ios::trunc);
+	manifestFile << manifestJson.dump(1, '\t');
+	if (!manifestFile)
+	{
+		std::ostringstream oss;
+		oss << "[Error] Could not write the scene index at " << manifestPath;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	return true;
+}
+
+size_t SceneIndex::Update(const std::string& dataDirname)
+{
+	std::map<std::string, SceneIndexEntry> entries;
+	size_t readNmb = 0;
+	std::function<void(std::string)> indexEntry;
+	indexEntry = [&](std::string entry)
+	{
+		if (IsDirectory(entry))
+		{
+			IterateDirectory(entry, indexEntry);
+			return;
+		}
+		const auto extensionIndex = entry.find_last_of('.');
+		if (extensionIndex == std::string::npos || entry.compare(extensionIndex, std::string::npos, ".scene") != 0 ||
+			!IsRegularFile(entry))
+			return;
+		SceneIndexEntry sceneEntry;
+		sceneEntry.writeTime = GetFileWriteTime(entry);
+		sceneEntry.fileSize = GetFileSize(entry);
+		const auto previousEntry = m_Entries.find(entry);
+		if (previousEntry != m_Entries.end() && previousEntry->second.writeTime == sceneEntry.writeTime &&
+			previousEntry->second.fileSize == sceneEntry.fileSize)
+		{
+			sceneEntry.name = previousEntry->second.name;
+		}
+		else
+		{
+			sceneEntry.name = ReadSceneName(entry);
+			readNmb++;
+		}
+		entries[entry] = std::move(sceneEntry);
+	};
+	std::string dirname = dataDirname;
+	IterateDirectory(dirname, indexEntry);
+
+	//Deleted scenes are not in the new entries
+	if (readNmb > 0 || entries.size() != m_Entries.size())
+		m_Dirty = true;
+	m_Entries = std::move(entries);
+	return readNmb;
+}
+
+bool SceneIndex::IsDirty() const
+{
+	return m_Dirty;
+}
+
+const std::map<std::string, SceneIndexEntry>& SceneIndex::GetEntries() const
+{
+	return m_Entries;
+}
+
+}
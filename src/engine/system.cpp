@@ -43,4 +43,82 @@ bool System::GetInitlialized() const
 {
 	return m_Initialized;
 }
+
+const SystemAccess& System::GetAccess() const
+{
+	return m_Access;
+}
+
+void System::DeclareAccess(int readComponents, int writeComponents, int resources)
+{
+	m_Access.readComponents = readComponents;
+	m_Access.writeComponents = writeComponents;
+	m_Access.resources = resources;
+	m_Access.exclusive = false;
+}
+
+void System::AddAccess(const SystemAccess& access)
+{
+	m_Access.Merge(access);
+}
+
+const TickPolicy& System::GetTickPolicy() const
+{
+	return m_TickPolicy;
+}
+
+void System::SetTickState(const TickState& tickState)
+{
+	m_TickState = tickState;
+}
+
+const TickState& System::GetTickState() const
+{
+	return m_TickState;
+}
+
+void System::SetTickRate(float frequency)
+{
+	m_TickPolicy.frequency = frequency;
+}
+
+void System::SetStaggerFrameNmb(size_t frameNmb)
+{
+	m_TickPolicy.staggerFrameNmb = frameNmb == 0 ? 1 : frameNmb;
+}
+
+StaggerRange System::GetStaggerRange(size_t count) const
+{
+	return sfge::GetStaggerRange(count, m_TickPolicy.staggerFrameNmb, m_TickState.staggerFrame);
+}
+
+bool SystemAccess::Conflicts(const SystemAccess& other) const
+{
+	if (exclusive || other.exclusive)
+		return true;
+	if ((resources & other.resources) != 0)
+		return true;
+	const auto usesComponents = [](const SystemAccess& access)
+	{
+		return (access.readComponents | access.writeComponents) != 0;
+	};
+	if ((Uses(SystemResource::ENTITIES) && usesComponents(other)) ||
+		(other.Uses(SystemResource::ENTITIES) && usesComponents(*this)))
+		return true;
+	return (writeComponents & (other.readComponents | other.writeComponents)) != 0 ||
+		(other.writeComponents & readComponents) != 0;
+}
+
+bool SystemAccess::Uses(SystemResource resource) const
+{
+	return (resources & static_cast<int>(resource)) != 0;
+}
+
+void SystemAccess::Merge(const SystemAccess& other)
+{
+	readComponents |= other.readComponents;
+	writeComponents |= other.writeComponents;
+	resources |= other.resources;
+	exclusive = exclusive || other.exclusive;
+}
 }
@@ -0,0 +1,206 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <chrono>
+
+#include <engine/system_graph.h>
+
+namespace sfge
+{
+
+void SystemGraph::AddSystem(FramePhase phase, std::string name, const SystemAccess& access, SystemFunction function)
+{
+	auto& nodes = m_Phases[static_cast<size_t>(phase)].nodes;
+	SystemNode node;
+	node.name = std::move(name);
+	node.access = access;
+	node.function = std::move(function);
+	nodes.push_back(std::move(node));
+}
+
+void SystemGraph::AddSystem(FramePhase phase, std::string name, System& system, SystemFunction function)
+{
+	AddSystem(phase, std::move(name), system.GetAccess(), std::move(function));
+	m_Phases[static_cast<size_t>(phase)].nodes.back().system = &system;
+}
+
+void SystemGraph::Build()
+{
+	for (size_t phaseIndex = 0; phaseIndex < m_Phases.size(); phaseIndex++)
+	{
+		auto& phase = m_Phases[phaseIndex];
+		std::vector<SystemTicker*> tickers;
+		for (auto& node : phase.nodes)
+		{
+			node.ticker.Init(node.system == nullptr ? TickPolicy() : node.system->GetTickPolicy());
+			tickers.push_back(&node.ticker);
+			node.profileName = m_Profiler == nullptr ? nullptr : m_Profiler->InternName(
+				std::string(GetPhaseName(static_cast<FramePhase>(phaseIndex))) + "/" + node.name);
+		}
+		SpreadTickers(tickers);
+		BuildSegments(phase);
+	}
+	m_AccessChanged = false;
+}
+
+void SystemGraph::BuildSegments(Phase& phase)
+{
+	auto& nodes = phase.nodes;
+	phase.segments.clear();
+	//The access of a system can change after it is added, like the SceneManager running the systems of its scene
+	for (auto& node : nodes)
+	{
+		if (node.system != nullptr)
+			node.access = node.system->GetAccess();
+	}
+	const auto runsAlone = [](const SystemAccess& access)
+	{
+		return access.exclusive || access.Uses(SystemResource::WINDOW);
+	};
+	for (size_t index = 0; index < nodes.size(); index++)
+	{
+		auto& node = nodes[index];
+		node.dependencies.clear();
+		for (size_t previous = 0; previous < index; previous++)
+		{
+			if (nodes[previous].access.Conflicts(node.access))
+				node.dependencies.push_back(previous);
+		}
+
+		const bool newSegment = phase.segments.empty() || runsAlone(node.access) ||
+			runsAlone(nodes[phase.segments.back().nodes.back()].access);
+		if (newSegment)
+		{
+			phase.segments.emplace_back();
+		}
+		auto& segment = phase.segments.back();
+		node.segment = phase.segments.size() - 1;
+		const auto segmentBegin = segment.nodes.empty() ? index : segment.nodes.front();
+		segment.nodes.push_back(index);
+		const auto job = segment.graph.AddJob([this, &phase, index]() { RunNode(phase, index); });
+		for (const auto dependency : node.dependencies)
+		{
+			//The earlier segments are already done when this one starts
+			if (dependency >= segmentBegin)
+				segment.graph.AddDependency(job, dependency - segmentBegin);
+		}
+	}
+}
+
+void SystemGraph::Run(FramePhase phase, float dt, JobSystem& jobSystem)
+{
+	if (m_AccessChanged.exchange(false))
+	{
+		for (auto& otherPhase : m_Phases)
+		{
+			BuildSegments(otherPhase);
+		}
+	}
+	m_Running = true;
+	auto& currentPhase = m_Phases[static_cast<size_t>(phase)];
+	currentPhase.deltaTime = dt;
+	for (auto& segment : currentPhase.segments)
+	{
+		if (segment.nodes.size() == 1)
+		{
+			RunNode(currentPhase, segment.nodes.front());
+		}
+		else
+		{
+			segment.graph.Run(jobSystem);
+		}
+	}
+	m_Running = false;
+}
+
+void SystemGraph::InvalidateAccess()
+{
+	m_AccessChanged = true;
+}
+
+bool SystemGraph::IsRunning() const
+{
+	return m_Running;
+}
+
+void SystemGraph::RunNode(Phase& phase, size_t index)
+{
+	auto& node = phase.nodes[index];
+	if (!node.ticker.Advance(phase.deltaTime))
+		return;
+	if (node.system != nullptr)
+	{
+		node.system->SetTickState(node.ticker.GetState());
+	}
+#ifdef SFGE_PROFILE_SYSTEMS
+	const auto start = ProfilerClock::now();
+	node.function(node.ticker.GetState().deltaTime);
+	const auto end = ProfilerClock::now();
+	node.lastDuration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	if (m_Profiler != nullptr && node.profileName != nullptr)
+	{
+		m_Profiler->Record(node.profileName, start, end);
+	}
+#else
+	node.function(node.ticker.GetState().deltaTime);
+#endif
+}
+
+void SystemGraph::Clear()
+{
+	for (auto& phase : m_Phases)
+	{
+		phase.nodes.clear();
+		phase.segments.clear();
+	}
+}
+
+void SystemGraph::SetProfiler(SystemProfiler* profiler)
+{
+	m_Profiler = profiler;
+}
+
+const std::vector<SystemNode>& SystemGraph::GetNodes(FramePhase phase) const
+{
+	return m_Phases[static_cast<size_t>(phase)].nodes;
+}
+
+const char* SystemGraph::GetPhaseName(FramePhase phase)
+{
+	switch (phase)
+	{
+	case FramePhase::INPUT:
+		return "Input";
+	case FramePhase::FIXED_UPDATE:
+		return "Fixed Update";
+	case FramePhase::UPDATE:
+		return "Update";
+	case FramePhase::RENDER_PREP:
+		return "Render Prep";
+	default:
+		return "Unknown";
+	}
+}
+
+}
@@ -0,0 +1,203 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <engine/system_profiler.h>
+#include <engine/job_system.h>
+#include <utility/log.h>
+#include <utility/json_utility.h>
+
+namespace sfge
+{
+
+void ProfileRingBuffer::Resize(size_t capacity)
+{
+	m_Samples.assign(capacity, ProfileSample());
+	m_PushedNmb.store(0, std::memory_order_relaxed);
+}
+
+void ProfileRingBuffer::Push(const ProfileSample& sample)
+{
+	if (m_Samples.empty())
+		return;
+	const auto pushedNmb = m_PushedNmb.load(std::memory_order_relaxed);
+	m_Samples[pushedNmb % m_Samples.size()] = sample;
+	m_PushedNmb.store(pushedNmb + 1, std::memory_order_release);
+}
+
+void ProfileRingBuffer::Clear()
+{
+	m_PushedNmb.store(0, std::memory_order_relaxed);
+}
+
+std::vector<ProfileSample> ProfileRingBuffer::GetSamples() const
+{
+	std::vector<ProfileSample> samples;
+	const auto pushedNmb = m_PushedNmb.load(std::memory_order_acquire);
+	const auto sampleNmb = std::min(pushedNmb, m_Samples.size());
+	samples.reserve(sampleNmb);
+	for (auto i = pushedNmb - sampleNmb; i < pushedNmb; i++)
+	{
+		samples.push_back(m_Samples[i % m_Samples.size()]);
+	}
+	return samples;
+}
+
+void SystemProfiler::Init(const JobSystem& jobSystem, size_t samplePerThreadNmb)
+{
+	m_JobSystem = &jobSystem;
+	m_Epoch = ProfilerClock::now();
+	m_Buffers.clear();
+	for (size_t i = 0; i < std::max<size_t>(jobSystem.GetThreadNmb(), 1); i++)
+	{
+		m_Buffers.push_back(std::make_unique<ProfileRingBuffer>());
+		m_Buffers.back()->Resize(samplePerThreadNmb);
+	}
+}
+
+void SystemProfiler::SetEnabled(bool enabled)
+{
+	m_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool SystemProfiler::IsEnabled() const
+{
+	return m_Enabled.load(std::memory_order_relaxed);
+}
+
+const char* SystemProfiler::InternName(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_NamesMutex);
+	return m_Names.insert(name).first->c_str();
+}
+
+void SystemProfiler::Record(const char* name, ProfilerClock::time_point start, ProfilerClock::time_point end)
+{
+	if (!IsEnabled() || m_Buffers.empty())
+		return;
+	//The other threads would share the buffer of the main thread, which has a single writer
+	if (!m_JobSystem->IsOwnThread())
+		return;
+	const auto threadIndex = m_JobSystem->GetThreadIndex();
+	if (threadIndex >= m_Buffers.size())
+		return;
+	ProfileSample sample;
+	sample.name = name;
+	sample.start = std::chrono::duration_cast<std::chrono::microseconds>(start - m_Epoch).count();
+	sample.duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	m_Buffers[threadIndex]->Push(sample);
+}
+
+void SystemProfiler::Clear()
+{
+	for (auto& buffer : m_Buffers)
+	{
+		buffer->Clear();
+	}
+}
+
+std::vector<SystemTimingStats> SystemProfiler::ComputeStats() const
+{
+	std::map<std::string, std::vector<std::int64_t>> durations;
+	for (const auto& buffer : m_Buffers)
+	{
+		for (const auto& sample : buffer->GetSamples())
+		{
+			durations[sample.name].push_back(sample.duration);
+		}
+	}
+	std::vector<SystemTimingStats> statsList;
+	statsList.reserve(durations.size());
+	for (auto& nameDurations : durations)
+	{
+		auto& values = nameDurations.second;
+		std::sort(values.begin(), values.end());
+		SystemTimingStats stats;
+		stats.name = nameDurations.first;
+		stats.sampleNmb = values.size();
+		stats.min = values.front();
+		std::int64_t total = 0;
+		for (const auto value : values)
+		{
+			total += value;
+		}
+		stats.avg = total / static_cast<std::int64_t>(values.size());
+		//Nearest rank
+		const auto rank = (values.size() * 99 + 99) / 100;
+		stats.p99 = values[rank - 1];
+		statsList.push_back(stats);
+	}
+	return statsList;
+}
+
+bool SystemProfiler::ExportChromeTrace(const std::string& path) const
+{
+	std::ofstream traceFile(path);
+	if (!traceFile.is_open())
+	{
+		std::ostringstream oss;
+		oss << "[Error] Could not write the profiler trace: " << path;
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	traceFile << "{\"traceEvents\":[";
+	bool first = true;
+	for (size_t threadIndex = 0; threadIndex < m_Buffers.size(); threadIndex++)
+	{
+		for (const auto& sample : m_Buffers[threadIndex]->GetSamples())
+		{
+			if (!first)
+				traceFile << ",";
+			first = false;
+			//The names of the python systems and of InternName can hold any character
+			traceFile << "\n{\"name\":" << json(sample.name).dump() << ",\"cat\":\"system\",\"ph\":\"X\",\"ts\":" << sample.start
+				<< ",\"dur\":" << sample.duration << ",\"pid\":0,\"tid\":" << threadIndex << "}";
+		}
+	}
+	traceFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return true;
+}
+
+ScopeTimer::ScopeTimer(SystemProfiler& profiler, const char* name) : m_Name(name)
+{
+	if (profiler.IsEnabled())
+	{
+		m_Profiler = &profiler;
+		m_Start = ProfilerClock::now();
+	}
+}
+
+ScopeTimer::~ScopeTimer()
+{
+	if (m_Profiler != nullptr)
+	{
+		m_Profiler->Record(m_Name, m_Start, ProfilerClock::now());
+	}
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cmath>
+#include <map>
+#include <numeric>
+
+#include <engine/system_tick.h>
+
+namespace sfge
+{
+
+StaggerRange GetStaggerRange(size_t count, size_t staggerFrameNmb, size_t staggerFrame)
+{
+	if (staggerFrameNmb <= 1)
+		return { 0, count };
+	StaggerRange range;
+	range.begin = count * staggerFrame / staggerFrameNmb;
+	range.end = count * (staggerFrame + 1) / staggerFrameNmb;
+	return range;
+}
+
+void SystemTicker::Init(const TickPolicy& policy, float phase)
+{
+	m_Policy = policy;
+	if (m_Policy.staggerFrameNmb == 0)
+		m_Policy.staggerFrameNmb = 1;
+	m_State = TickState();
+	m_Elapsed = m_Policy.frequency > 0.0f ? phase / m_Policy.frequency : 0.0f;
+	m_DeltaTime = 0.0f;
+	m_StepNmb = 0;
+	m_RunNmb = 0;
+	m_RunDeltaTimes.assign(m_Policy.staggerFrameNmb, 0.0f);
+}
+
+bool SystemTicker::Advance(float dt)
+{
+	m_DeltaTime += dt;
+	m_StepNmb++;
+	if (m_Policy.frequency > 0.0f)
+	{
+		const auto period = 1.0f / m_Policy.frequency;
+		m_Elapsed += dt;
+		if (m_Elapsed < period)
+			return false;
+		//After a long frame the system runs once, not once per missed period
+		m_Elapsed = std::fmod(m_Elapsed, period);
+	}
+	m_State.stepNmb = m_StepNmb;
+	m_State.deltaTime = m_DeltaTime;
+	m_State.staggerFrame = m_RunNmb % m_Policy.staggerFrameNmb;
+	m_RunDeltaTimes[m_State.staggerFrame] = m_DeltaTime;
+	m_State.staggerDeltaTime = std::accumulate(m_RunDeltaTimes.begin(), m_RunDeltaTimes.end(), 0.0f);
+	m_RunNmb++;
+	m_StepNmb = 0;
+	m_DeltaTime = 0.0f;
+	return true;
+}
+
+const TickState& SystemTicker::GetState() const
+{
+	return m_State;
+}
+
+const TickPolicy& SystemTicker::GetPolicy() const
+{
+	return m_Policy;
+}
+
+void SpreadTickers(const std::vector<SystemTicker*>& tickers)
+{
+	std::map<float, std::vector<SystemTicker*>> frequencyTickers;
+	for (auto* ticker : tickers)
+	{
+		if (ticker->GetPolicy().frequency > 0.0f)
+			frequencyTickers[ticker->GetPolicy().frequency].push_back(ticker);
+	}
+	for (auto& sameFrequencyTickers : frequencyTickers)
+	{
+		auto& sameTickers = sameFrequencyTickers.second;
+		for (size_t i = 0; i < sameTickers.size(); i++)
+		{
+			sameTickers[i]->Init(sameTickers[i]->GetPolicy(), static_cast<float>(i) / sameTickers.size());
+		}
+	}
+}
+
+}
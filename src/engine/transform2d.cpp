@@ -7,7 +7,9 @@
 
 #include <engine/transform2d.h>
 #include <imgui.h>
+#include <sstream>
 #include <engine/engine.h>
+#include <engine/scene_binary.h>
 
 namespace sfge
 {
@@ -34,12 +36,26 @@ void editor::Transform2dInfo::DrawOnInspector()
 }
 
 
+void Transform2dManager::Init()
+{
+	SingleComponentManager::Init();
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D), static_cast<int>(ComponentType::TRANSFORM2D));
+}
+
 Transform2d* Transform2dManager::AddComponent(Entity entity)
 {
-	auto& transform = GetComponentRef(entity);
-	m_ComponentsInfo[entity - 1].transform = &transform;
-	m_ComponentsInfo[entity - 1].SetEntity(entity);
-	m_ConcernedEntities.push_back(entity);
+	auto& transform = SingleComponentManager::GetComponentRef(entity);
+	if (!IsConcernedEntity(entity))
+	{
+		//The version keeps counting so a reused slot never matches a stale synced version
+		const auto version = m_Nodes[entity - 1].version;
+		m_Nodes[entity - 1] = Transform2dNode();
+		m_Nodes[entity - 1].version = version;
+		m_HierarchyDirty = true;
+	}
+	//The caller writes the new transform through the returned pointer
+	MarkDirty(entity);
+	AddConcernedEntity(entity);
 	m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::TRANSFORM2D);
 	return &transform;
 }
@@ -49,16 +65,116 @@ void Transform2dManager::CreateComponent(json& componentJson, Entity entity)
 
 	//Log::GetInstance()->Msg("Create component Transform");
 	auto* transform = AddComponent(entity);
+	ReadTransformJson(componentJson, *transform);
+}
+
+void Transform2dManager::CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons)
+{
+	for (Entity entity : entities)
+	{
+		AddComponent(entity);
+	}
+	m_Engine.GetJobSystem().ParallelFor(0, entities.size(), 0, [this, &entities, &componentJsons](size_t start, size_t end)
+	{
+		for (auto i = start; i < end; i++)
+		{
+			ReadTransformJson(*componentJsons[i], m_Components[entities[i] - 1]);
+		}
+	});
+}
+
+void Transform2dManager::ReadTransformJson(const json& componentJson, Transform2d& transform)
+{
 	if (CheckJsonExists(componentJson, "position"))
-		transform->Position = GetVectorFromJson(componentJson, "position");
+		transform.Position = GetVectorFromJson(componentJson, "position");
 	if (CheckJsonExists(componentJson, "scale"))
-		transform->Scale = GetVectorFromJson(componentJson, "scale");
-	if (CheckJsonExists(componentJson, "angle") && CheckJsonNumber(componentJson, "angle"))
-		transform->EulerAngle = componentJson["angle"];
+		transform.Scale = GetVectorFromJson(componentJson, "scale");
+	if (CheckJsonNumber(componentJson, "angle"))
+		transform.EulerAngle = componentJson["angle"];
+}
+
+void Transform2dManager::ResolvePrefabComponent(PrefabComponent& prefabComponent)
+{
+	Transform2d prefabTransform;
+	ReadTransformJson(prefabComponent.componentJson, prefabTransform);
+	prefabComponent.resolvedData = prefabTransform;
+}
+
+void Transform2dManager::InstantiatePrefabComponents(const PrefabComponent& prefabComponent,
+	const std::vector<Entity>& entities, const std::vector<Vec2f>& positions)
+{
+	const auto* prefabTransform = std::any_cast<Transform2d>(&prefabComponent.resolvedData);
+	if (prefabTransform == nullptr)
+		return;
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		auto* transform = AddComponent(entities[i]);
+		transform->Position = prefabTransform->Position + positions[i];
+		transform->Scale = prefabTransform->Scale;
+		transform->EulerAngle = prefabTransform->EulerAngle;
+	}
+}
+
+void Transform2dManager::CreateComponents(const SceneBlock& block, const EntityRange& entities)
+{
+	const float* positionsX = block.GetFloatColumn(0);
+	const float* positionsY = block.GetFloatColumn(1);
+	const float* scalesX = block.GetFloatColumn(2);
+	const float* scalesY = block.GetFloatColumn(3);
+	const float* eulerAngles = block.GetFloatColumn(4);
+	if (eulerAngles == nullptr)
+		return;
+	for (size_t i = 0; i < block.count; i++)
+	{
+		auto* transform = AddComponent(entities[block.entityIndices[i]]);
+		transform->Position = Vec2f(positionsX[i], positionsY[i]);
+		transform->Scale = Vec2f(scalesX[i], scalesY[i]);
+		transform->EulerAngle = eulerAngles[i];
+	}
+}
+
+void Transform2dManager::CompileComponents(const std::vector<const json*>& componentJsons, SceneBlockBuilder& builder)
+{
+	std::vector<float> positionsX(componentJsons.size());
+	std::vector<float> positionsY(componentJsons.size());
+	std::vector<float> scalesX(componentJsons.size());
+	std::vector<float> scalesY(componentJsons.size());
+	std::vector<float> eulerAngles(componentJsons.size());
+	for (size_t i = 0; i < componentJsons.size(); i++)
+	{
+		Transform2d transform;
+		ReadTransformJson(*componentJsons[i], transform);
+		positionsX[i] = transform.Position.x;
+		positionsY[i] = transform.Position.y;
+		scalesX[i] = transform.Scale.x;
+		scalesY[i] = transform.Scale.y;
+		eulerAngles[i] = transform.EulerAngle;
+	}
+	builder.AddFloatColumn(positionsX);
+	builder.AddFloatColumn(positionsY);
+	builder.AddFloatColumn(scalesX);
+	builder.AddFloatColumn(scalesY);
+	builder.AddFloatColumn(eulerAngles);
 }
 
 void Transform2dManager::DestroyComponent(Entity entity)
 {
+	//The children become roots
+	auto child = m_Nodes[entity - 1].firstChild;
+	while (child != INVALID_ENTITY)
+	{
+		auto& childNode = m_Nodes[child - 1];
+		const auto nextSibling = childNode.nextSibling;
+		childNode.parent = INVALID_ENTITY;
+		childNode.nextSibling = INVALID_ENTITY;
+		MarkDirty(child);
+		child = nextSibling;
+	}
+	m_Nodes[entity - 1].firstChild = INVALID_ENTITY;
+	//A stale entry in the dirty list is skipped by the next update
+	m_Nodes[entity - 1].dirty = false;
+	Detach(entity);
+	m_HierarchyDirty = true;
 	RemoveConcernedEntity(entity);
 	m_Engine.GetEntityManager()->RemoveComponentType(entity, ComponentType::TRANSFORM2D);
 }
@@ -66,35 +182,269 @@ void Transform2dManager::DestroyComponent(Entity entity)
 
 void Transform2dManager::Update(float dt) {
     System::Update(dt);
-	for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
-		m_Components[m_ConcernedEntities[i] - 1].Update();
+	//A dirty entity below a dirty ancestor is recomputed with the subtree of that ancestor
+	m_DirtyRoots.clear();
+	for (Entity entity : m_DirtyEntities)
+	{
+		if (!m_Nodes[entity - 1].dirty)
+			continue;
+		auto ancestor = m_Nodes[entity - 1].parent;
+		while (ancestor != INVALID_ENTITY && !m_Nodes[ancestor - 1].dirty)
+		{
+			ancestor = m_Nodes[ancestor - 1].parent;
+		}
+		if (ancestor == INVALID_ENTITY)
+			m_DirtyRoots.push_back(entity);
+	}
+	m_DirtyEntities.clear();
+	//Depth first from each dirty root, a parent always comes before its children
+	for (Entity root : m_DirtyRoots)
+	{
+		//Already done if the entity was marked twice
+		if (!m_Nodes[root - 1].dirty)
+			continue;
+		m_TraversalStack.push_back(root);
+		while (!m_TraversalStack.empty())
+		{
+			const auto entity = m_TraversalStack.back();
+			m_TraversalStack.pop_back();
+			m_Components[entity - 1].Update();
+			UpdateWorld(entity);
+			for (auto child = m_Nodes[entity - 1].firstChild; child != INVALID_ENTITY; child = m_Nodes[child - 1].nextSibling)
+			{
+				m_TraversalStack.push_back(child);
+			}
+		}
+	}
 }
 
-json Transform2dManager::Save()
+Transform2d* Transform2dManager::GetComponentPtr(Entity entity)
 {
-	json j;
-	for (auto i = 0u; i < m_Components.size(); i++)
+	auto* transform = SingleComponentManager::GetComponentPtr(entity);
+	if (transform != nullptr)
+		MarkDirty(entity);
+	return transform;
+}
+
+Transform2d& Transform2dManager::GetComponentRef(Entity entity)
+{
+	MarkDirty(entity);
+	return SingleComponentManager::GetComponentRef(entity);
+}
+
+const Transform2d& Transform2dManager::GetLocalTransform(Entity entity) const
+{
+	return m_Components[entity - 1];
+}
+
+void Transform2dManager::MarkDirty(Entity entity)
+{
+	if (entity == INVALID_ENTITY)
+		return;
+	auto& node = m_Nodes[entity - 1];
+	if (node.dirty)
+		return;
+	node.dirty = true;
+	m_DirtyEntities.push_back(entity);
+}
+
+void Transform2dManager::UpdateWorld(Entity entity)
+{
+	auto& node = m_Nodes[entity - 1];
+	auto local = m_Components[entity - 1];
+	if (node.interpolated && m_InterpolationFactor < 1.0f)
+	{
+		local.Position = Vec2f::Lerp(node.previous.Position, local.Position, m_InterpolationFactor);
+		local.Scale = Vec2f::Lerp(node.previous.Scale, local.Scale, m_InterpolationFactor);
+		local.EulerAngle = node.previous.EulerAngle + (local.EulerAngle - node.previous.EulerAngle) * m_InterpolationFactor;
+	}
+	node.dirty = false;
+	node.version++;
+	if (node.version == INVALID_TRANSFORM_VERSION)
+		node.version = 0;
+	sf::Transform localMatrix;
+	localMatrix.translate(local.Position).rotate(local.EulerAngle).scale(local.Scale);
+	if (node.parent == INVALID_ENTITY)
+	{
+		node.world = local;
+		node.worldMatrix = localMatrix;
+	}
+	else
 	{
-		if (m_EntityManager->HasComponent(i + 1, ComponentType::TRANSFORM2D))
+		const auto& parentNode = m_Nodes[node.parent - 1];
+		node.worldMatrix = parentNode.worldMatrix * localMatrix;
+		node.world.Position = parentNode.worldMatrix.transformPoint(local.Position);
+		node.world.Scale = Vec2f(parentNode.world.Scale.x * local.Scale.x, parentNode.world.Scale.y * local.Scale.y);
+		node.world.EulerAngle = parentNode.world.EulerAngle + local.EulerAngle;
+	}
+}
+
+void Transform2dManager::SaveFixedStepState()
+{
+	for (Entity entity : m_InterpolatedEntities)
+	{
+		m_Nodes[entity - 1].interpolated = false;
+		MarkDirty(entity);
+	}
+	m_InterpolatedEntities.clear();
+	const auto bodyMask = static_cast<EntityMask>(ComponentType::TRANSFORM2D) | static_cast<EntityMask>(ComponentType::BODY2D);
+	for (Entity entity : m_EntityManager->View(bodyMask))
+	{
+		auto& node = m_Nodes[entity - 1];
+		node.previous = m_Components[entity - 1];
+		node.interpolated = true;
+		m_InterpolatedEntities.push_back(entity);
+	}
+}
+
+void Transform2dManager::SetInterpolationFactor(float factor)
+{
+	//The interpolated bodies move with the factor even when nobody writes them
+	if (factor != m_InterpolationFactor)
+	{
+		for (Entity entity : m_InterpolatedEntities)
+		{
+			MarkDirty(entity);
+		}
+	}
+	m_InterpolationFactor = factor;
+}
+
+void Transform2dManager::RebuildHierarchy()
+{
+	//Breadth first from the roots gives the depth order
+	m_Hierarchy.clear();
+	m_Hierarchy.reserve(m_ConcernedEntities.size());
+	for (Entity entity : m_ConcernedEntities)
+	{
+		if (m_Nodes[entity - 1].parent == INVALID_ENTITY)
+			m_Hierarchy.push_back(entity);
+	}
+	for (size_t i = 0; i < m_Hierarchy.size(); i++)
+	{
+		for (auto child = m_Nodes[m_Hierarchy[i] - 1].firstChild; child != INVALID_ENTITY; child = m_Nodes[child - 1].nextSibling)
+		{
+			m_Hierarchy.push_back(child);
+		}
+	}
+	m_HierarchyDirty = false;
+}
+
+void Transform2dManager::Detach(Entity entity)
+{
+	auto& node = m_Nodes[entity - 1];
+	if (node.parent == INVALID_ENTITY)
+		return;
+	auto* link = &m_Nodes[node.parent - 1].firstChild;
+	while (*link != INVALID_ENTITY && *link != entity)
+	{
+		link = &m_Nodes[*link - 1].nextSibling;
+	}
+	if (*link == entity)
+	{
+		*link = node.nextSibling;
+	}
+	node.parent = INVALID_ENTITY;
+	node.nextSibling = INVALID_ENTITY;
+}
+
+bool Transform2dManager::SetParent(Entity child, Entity parent)
+{
+	if (!IsConcernedEntity(child) || (parent != INVALID_ENTITY && !IsConcernedEntity(parent)))
+	{
+		std::ostringstream oss;
+		oss << "[Error] Cannot parent entity: " << child << " to entity: " << parent << ", both need a Transform2d";
+		Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	for (auto ancestor = parent; ancestor != INVALID_ENTITY; ancestor = m_Nodes[ancestor - 1].parent)
+	{
+		if (ancestor == child)
 		{
-			j[i]["type"] = static_cast<int>(ComponentType::TRANSFORM2D);
-			j[i]["position"][0] = m_Components[i].Position.x;
-			j[i]["position"][1] = m_Components[i].Position.y;
-			j[i]["angle"] = m_Components[i].EulerAngle;
-			j[i]["scale"][0] = m_Components[i].Scale.x;
-			j[i]["scale"][1] = m_Components[i].Scale.y;
+			std::ostringstream oss;
+			oss << "[Error] Cannot parent entity: " << child << " to its descendant: " << parent;
+			Log::GetInstance()->Error(oss.str());
+			return false;
 		}
 	}
+	Detach(child);
+	auto& node = m_Nodes[child - 1];
+	if (parent != INVALID_ENTITY)
+	{
+		auto& parentNode = m_Nodes[parent - 1];
+		node.parent = parent;
+		node.nextSibling = parentNode.firstChild;
+		parentNode.firstChild = child;
+	}
+	MarkDirty(child);
+	m_HierarchyDirty = true;
+	return true;
+}
+
+Entity Transform2dManager::GetParent(Entity entity) const
+{
+	return m_Nodes[entity - 1].parent;
+}
+
+const Transform2d& Transform2dManager::GetWorldTransform(Entity entity) const
+{
+	return m_Nodes[entity - 1].world;
+}
+
+const sf::Transform& Transform2dManager::GetWorldMatrix(Entity entity) const
+{
+	return m_Nodes[entity - 1].worldMatrix;
+}
+
+TransformVersion Transform2dManager::GetVersion(Entity entity) const
+{
+	return m_Nodes[entity - 1].version;
+}
+
+const std::vector<Entity>& Transform2dManager::GetHierarchy()
+{
+	if (m_HierarchyDirty)
+		RebuildHierarchy();
+	return m_Hierarchy;
+}
+
+json Transform2dManager::Save()
+{
+	json j;
+	for (Entity entity : m_EntityManager->View<Transform2d>())
+	{
+		const auto i = entity - 1;
+		j[i]["type"] = static_cast<int>(ComponentType::TRANSFORM2D);
+		j[i]["position"][0] = m_Components[i].Position.x;
+		j[i]["position"][1] = m_Components[i].Position.y;
+		j[i]["angle"] = m_Components[i].EulerAngle;
+		j[i]["scale"][0] = m_Components[i].Scale.x;
+		j[i]["scale"][1] = m_Components[i].Scale.y;
+	}
 	return j;
 }
 
 void Transform2dManager::OnResize(size_t newSize) {
 	m_Components.resize(newSize);
 	m_ComponentsInfo.resize(newSize);
+	m_Nodes.resize(newSize);
+}
 
-	for (size_t i = 0; i < newSize; ++i) {
-		m_ComponentsInfo[i].SetEntity(i + 1);
-		m_ComponentsInfo[i].transform = &m_Components[i];
-	}
+void Transform2dManager::LinkComponentInfo(size_t index)
+{
+	//The inspector writes through the info
+	MarkDirty(static_cast<Entity>(index + 1));
+	m_ComponentsInfo[index].transform = &m_Components[index];
+}
+
+void Transform2dManager::ReportMemory(MemoryReport& report) const
+{
+	SingleComponentManager::ReportMemory(report);
+	report.AddContainer("Nodes", m_Nodes);
+	report.AddContainer("Hierarchy", m_Hierarchy);
+	report.AddContainer("DirtyEntities", m_DirtyEntities);
+	report.AddContainer("DirtyRoots", m_DirtyRoots);
+	report.AddContainer("TraversalStack", m_TraversalStack);
+	report.AddContainer("InterpolatedEntities", m_InterpolatedEntities);
 }
 }
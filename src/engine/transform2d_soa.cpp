@@ -0,0 +1,288 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <engine/transform2d_soa.h>
+#include <engine/transform2d.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SFGE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace sfge
+{
+
+namespace
+{
+/**
+ * \brief stream[i] += value from begin to end
+ */
+void AddScalar(float* stream, size_t begin, size_t end, float value)
+{
+	size_t i = begin;
+#if defined(__AVX__)
+	const __m256 values = _mm256_set1_ps(value);
+	for (; i + 8 <= end; i += 8)
+	{
+		_mm256_storeu_ps(stream + i, _mm256_add_ps(_mm256_loadu_ps(stream + i), values));
+	}
+#elif defined(SFGE_SSE)
+	const __m128 values = _mm_set1_ps(value);
+	for (; i + 4 <= end; i += 4)
+	{
+		_mm_storeu_ps(stream + i, _mm_add_ps(_mm_loadu_ps(stream + i), values));
+	}
+#endif
+	for (; i < end; i++)
+	{
+		stream[i] += value;
+	}
+}
+
+void MulScalar(float* stream, size_t begin, size_t end, float value)
+{
+	size_t i = begin;
+#if defined(__AVX__)
+	const __m256 values = _mm256_set1_ps(value);
+	for (; i + 8 <= end; i += 8)
+	{
+		_mm256_storeu_ps(stream + i, _mm256_mul_ps(_mm256_loadu_ps(stream + i), values));
+	}
+#elif defined(SFGE_SSE)
+	const __m128 values = _mm_set1_ps(value);
+	for (; i + 4 <= end; i += 4)
+	{
+		_mm_storeu_ps(stream + i, _mm_mul_ps(_mm_loadu_ps(stream + i), values));
+	}
+#endif
+	for (; i < end; i++)
+	{
+		stream[i] *= value;
+	}
+}
+
+/**
+ * \brief stream[i] += factors[i] * value from begin to end
+ */
+void MulAdd(float* stream, const float* factors, size_t begin, size_t end, float value)
+{
+	size_t i = begin;
+#if defined(__AVX__)
+	const __m256 values = _mm256_set1_ps(value);
+	for (; i + 8 <= end; i += 8)
+	{
+		const __m256 delta = _mm256_mul_ps(_mm256_loadu_ps(factors + i), values);
+		_mm256_storeu_ps(stream + i, _mm256_add_ps(_mm256_loadu_ps(stream + i), delta));
+	}
+#elif defined(SFGE_SSE)
+	const __m128 values = _mm_set1_ps(value);
+	for (; i + 4 <= end; i += 4)
+	{
+		const __m128 delta = _mm_mul_ps(_mm_loadu_ps(factors + i), values);
+		_mm_storeu_ps(stream + i, _mm_add_ps(_mm_loadu_ps(stream + i), delta));
+	}
+#endif
+	for (; i < end; i++)
+	{
+		stream[i] += factors[i] * value;
+	}
+}
+
+float WrapAngle(float angle)
+{
+	if (angle > 180.0f)
+		angle -= 360.0f;
+	else if (angle < -180.0f)
+		angle += 360.0f;
+	return angle;
+}
+}
+
+Transform2dRef::Transform2dRef(Transform2dStreams& streams, size_t index) : m_Streams(streams), m_Index(index)
+{
+}
+
+Vec2f Transform2dRef::GetPosition() const
+{
+	return Vec2f(m_Streams.positionsX[m_Index], m_Streams.positionsY[m_Index]);
+}
+
+void Transform2dRef::SetPosition(Vec2f position)
+{
+	m_Streams.positionsX[m_Index] = position.x;
+	m_Streams.positionsY[m_Index] = position.y;
+}
+
+Vec2f Transform2dRef::GetScale() const
+{
+	return Vec2f(m_Streams.scalesX[m_Index], m_Streams.scalesY[m_Index]);
+}
+
+void Transform2dRef::SetScale(Vec2f scale)
+{
+	m_Streams.scalesX[m_Index] = scale.x;
+	m_Streams.scalesY[m_Index] = scale.y;
+}
+
+float Transform2dRef::GetEulerAngle() const
+{
+	return m_Streams.eulerAngles[m_Index];
+}
+
+void Transform2dRef::SetEulerAngle(float eulerAngle)
+{
+	m_Streams.eulerAngles[m_Index] = eulerAngle;
+}
+
+Transform2dRef::operator Transform2d() const
+{
+	Transform2d transform;
+	transform.Position = GetPosition();
+	transform.Scale = GetScale();
+	transform.EulerAngle = GetEulerAngle();
+	return transform;
+}
+
+Transform2dRef& Transform2dRef::operator=(const Transform2d& transform)
+{
+	SetPosition(transform.Position);
+	SetScale(transform.Scale);
+	SetEulerAngle(transform.EulerAngle);
+	return *this;
+}
+
+void Transform2dStreams::Resize(size_t size)
+{
+	positionsX.resize(size, 0.0f);
+	positionsY.resize(size, 0.0f);
+	scalesX.resize(size, 1.0f);
+	scalesY.resize(size, 1.0f);
+	eulerAngles.resize(size, 0.0f);
+}
+
+size_t Transform2dStreams::Size() const
+{
+	return positionsX.size();
+}
+
+Transform2dRef Transform2dStreams::operator[](size_t index)
+{
+	return Transform2dRef(*this, index);
+}
+
+void Transform2dStreams::Load(Transform2dManager& transformManager, const std::vector<Entity>& entities)
+{
+	Resize(entities.size());
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		(*this)[i] = transformManager.GetLocalTransform(entities[i]);
+	}
+}
+
+void Transform2dStreams::Store(Transform2dManager& transformManager, const std::vector<Entity>& entities) const
+{
+	for (size_t i = 0; i < entities.size() && i < Size(); i++)
+	{
+		auto& transform = transformManager.GetComponentRef(entities[i]);
+		transform.Position = Vec2f(positionsX[i], positionsY[i]);
+		transform.Scale = Vec2f(scalesX[i], scalesY[i]);
+		transform.EulerAngle = eulerAngles[i];
+	}
+}
+
+void Transform2dStreams::LoadPositions(Transform2dManager& transformManager, const std::vector<Entity>& entities)
+{
+	Resize(entities.size());
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		const auto& position = transformManager.GetLocalTransform(entities[i]).Position;
+		positionsX[i] = position.x;
+		positionsY[i] = position.y;
+	}
+}
+
+void Transform2dStreams::StorePositions(Transform2dManager& transformManager, const std::vector<Entity>& entities) const
+{
+	for (size_t i = 0; i < entities.size() && i < Size(); i++)
+	{
+		transformManager.GetComponentRef(entities[i]).Position = Vec2f(positionsX[i], positionsY[i]);
+	}
+}
+
+void Transform2dStreams::Translate(size_t begin, size_t end, Vec2f moveValue)
+{
+	AddScalar(positionsX.data(), begin, end, moveValue.x);
+	AddScalar(positionsY.data(), begin, end, moveValue.y);
+}
+
+void Transform2dStreams::Scale(size_t begin, size_t end, float scaleValue)
+{
+	MulScalar(scalesX.data(), begin, end, scaleValue);
+	MulScalar(scalesY.data(), begin, end, scaleValue);
+}
+
+void Transform2dStreams::Rotate(size_t begin, size_t end, float rotateValue)
+{
+	float* angles = eulerAngles.data();
+	size_t i = begin;
+#if defined(__AVX__)
+	const __m256 values = _mm256_set1_ps(rotateValue);
+	const __m256 halfTurn = _mm256_set1_ps(180.0f);
+	const __m256 minusHalfTurn = _mm256_set1_ps(-180.0f);
+	const __m256 fullTurn = _mm256_set1_ps(360.0f);
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 angle = _mm256_add_ps(_mm256_loadu_ps(angles + i), values);
+		angle = _mm256_sub_ps(angle, _mm256_and_ps(_mm256_cmp_ps(angle, halfTurn, _CMP_GT_OQ), fullTurn));
+		angle = _mm256_add_ps(angle, _mm256_and_ps(_mm256_cmp_ps(angle, minusHalfTurn, _CMP_LT_OQ), fullTurn));
+		_mm256_storeu_ps(angles + i, angle);
+	}
+#elif defined(SFGE_SSE)
+	const __m128 values = _mm_set1_ps(rotateValue);
+	const __m128 halfTurn = _mm_set1_ps(180.0f);
+	const __m128 minusHalfTurn = _mm_set1_ps(-180.0f);
+	const __m128 fullTurn = _mm_set1_ps(360.0f);
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 angle = _mm_add_ps(_mm_loadu_ps(angles + i), values);
+		angle = _mm_sub_ps(angle, _mm_and_ps(_mm_cmpgt_ps(angle, halfTurn), fullTurn));
+		angle = _mm_add_ps(angle, _mm_and_ps(_mm_cmplt_ps(angle, minusHalfTurn), fullTurn));
+		_mm_storeu_ps(angles + i, angle);
+	}
+#endif
+	for (; i < end; i++)
+	{
+		angles[i] = WrapAngle(angles[i] + rotateValue);
+	}
+}
+
+void Transform2dStreams::IntegrateVelocity(size_t begin, size_t end, const float* velocitiesX, const float* velocitiesY, float dt)
+{
+	MulAdd(positionsX.data(), velocitiesX, begin, end, dt);
+	MulAdd(positionsY.data(), velocitiesY, begin, end, dt);
+}
+
+}
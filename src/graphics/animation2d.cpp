@@ -44,6 +44,11 @@ Animation::Animation() : Offsetable(sf::Vector2f())
 Animation::Animation(Transform2d* transform, sf::Vector2f offset) : Offsetable(offset)
 {
 }
+const sf::Sprite& Animation::GetSprite() const
+{
+	return sprite;
+}
+
 void Animation::Draw(sf::RenderWindow& window)
 {
 	/*animation.setPosition(m_GameObject->GetTransform()->GetPosition()+m_Offset);
@@ -66,31 +71,45 @@ void Animation::Init()
 {
 }
 
-void Animation::Update(float dt, Transform2d* transform)
+void Animation::SkipUpdate(float dt)
+{
+	timeSinceChangedFrame += dt;
+}
+
+void Animation::Update(float dt, const Transform2d* transform)
 {
 	timeSinceChangedFrame += dt;
 	
-	if(timeSinceChangedFrame >= speed && !frameList.empty())
+	if(speed > 0.0f && timeSinceChangedFrame >= speed && !frameList.empty())
 	{
-		timeSinceChangedFrame = 0;
+		//Every frame change of the time elapsed, the skipped updates included, the whole cycles are dropped
+		auto frameStepNmb = static_cast<size_t>(timeSinceChangedFrame / speed);
+		timeSinceChangedFrame -= frameStepNmb * speed;
+		frameStepNmb %= frameList.size();
 
-		currentFrameKey++;
-		bool changed = false;
-		for(auto frame : frameList)
+		const AnimationFrame* currentFrame = nullptr;
+		for(size_t step = 0; step < frameStepNmb; step++)
 		{
-			if(frame.key == currentFrameKey)
+			currentFrameKey++;
+			currentFrame = nullptr;
+			for(auto& frame : frameList)
+			{
+				if(frame.key == currentFrameKey)
+				{
+					currentFrame = &frame;
+					break;
+				}
+			}
+			if(currentFrame == nullptr)
 			{
-				sprite.setTextureRect(frame.textureRect);
-				sprite.setTexture(*frame.texture);
-				changed = true;
-				break;
+				currentFrameKey = 0;
+				currentFrame = &frameList[currentFrameKey];
 			}
 		}
-		if(!changed)
+		if(currentFrame != nullptr)
 		{
-			currentFrameKey = 0;
-			sprite.setTextureRect(frameList[currentFrameKey].textureRect);
-			sprite.setTexture(*frameList[currentFrameKey].texture);
+			sprite.setTextureRect(currentFrame->textureRect);
+			sprite.setTexture(*currentFrame->texture);
 		}
 
 		//With Iterator (Doesn't work)
@@ -104,12 +123,11 @@ void Animation::Update(float dt, Transform2d* transform)
 		*/
 	}
 	
-	Vec2f pos = m_Offset;
+	//nullptr when the transform did not change since the last update
 	if(transform != nullptr)
 	{
-		pos += transform->Position;
+		sprite.setPosition(m_Offset + transform->Position);
 	}
-	sprite.setPosition(pos);
 }
 
 
@@ -134,29 +152,63 @@ void editor::AnimationInfo::DrawOnInspector()
 
 Animation* AnimationManager::AddComponent(Entity entity)
 {
-	auto& animation = GetComponentRef(entity);
-	auto& animationInfo = GetComponentInfo(entity);
-
-	animationInfo.animation = &animation;
-	m_ComponentsInfo[entity - 1].SetEntity(entity);
-
+	auto* animation = EmplacePackedComponent(entity);
 	m_EntityManager->AddComponentType(entity, ComponentType::ANIMATION2D);
-	return &animation;
+	return animation;
 }
 
 void AnimationManager::Init()
 {
-	SingleComponentManager::Init();
+	PackedComponentManager::Init();
 	m_GraphicsManager = m_Engine.GetGraphics2dManager();
 	m_Transform2dManager = m_Engine.GetTransform2dManager();
+	m_OffScreenBudget = m_Engine.GetFrameBudget().RegisterWorkload("OffScreenAnimation",
+		OFF_SCREEN_ANIMATION_MIN_BUDGET, OFF_SCREEN_ANIMATION_MAX_BUDGET);
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D), static_cast<int>(ComponentType::ANIMATION2D));
 }
 
 void AnimationManager::Update(float dt)
 {
 
 	rmt_ScopedCPUSample(Animation2dUpdate,0)
-		for (int i = 0; i < m_ConcernedEntities.size(); i++)
-			m_Components[m_ConcernedEntities[i] - 1].Update(dt, m_Transform2dManager->GetComponentPtr(m_ConcernedEntities[i]));
+	//Without window everything is treated as visible, the view is the copy taken by the last UpdateCamera
+	sf::FloatRect viewRect;
+	const bool hasView = m_GraphicsManager->GetWindow() != nullptr;
+	if (hasView)
+	{
+		const auto& view = m_GraphicsManager->GetView();
+		viewRect = sf::FloatRect(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+	}
+	//The animations out of the view only advance while their budget lasts, the skipped ones go first next frame
+	BudgetTimer budgetTimer(m_Engine.GetFrameBudget(), m_OffScreenBudget);
+	const auto componentNmb = m_Components.size();
+	auto nextCursor = 0u;
+	auto offScreenNmb = 0u;
+	bool offScreenTimeLeft = true;
+	//The frames always advance, the position is only pushed when the transform changed
+	for (auto k = 0u; k < componentNmb; k++)
+	{
+		const auto i = (m_UpdateCursor + k) % componentNmb;
+		if (hasView && !m_Components[i].GetSprite().getGlobalBounds().intersects(viewRect))
+		{
+			if (offScreenNmb % 64 == 0 && offScreenTimeLeft)
+			{
+				offScreenTimeLeft = budgetTimer.HasTimeLeft();
+				if (!offScreenTimeLeft)
+					nextCursor = i;
+			}
+			offScreenNmb++;
+			if (!offScreenTimeLeft)
+			{
+				m_Components[i].SkipUpdate(dt);
+				continue;
+			}
+		}
+		const auto entity = m_ConcernedEntities[i];
+		const bool transformChanged = m_Components[i].SyncTransformVersion(m_Transform2dManager->GetVersion(entity));
+		m_Components[i].Update(dt, transformChanged ? &m_Transform2dManager->GetWorldTransform(entity) : nullptr);
+	}
+	m_UpdateCursor = nextCursor;
 }
 
 
@@ -164,12 +216,16 @@ void AnimationManager::DrawAnimations(sf::RenderWindow &window)
 {
 
 	rmt_ScopedCPUSample(Animation2dDraw,0)
-	for (auto i = 0u; i<m_Components.size();i++)
+	for (const auto i : GetDrawOrder())
 	{
-		if(m_EntityManager->HasComponent(i + 1, ComponentType::ANIMATION2D))
-			m_Components[i].Draw(window);
+		m_Components[i].Draw(window);
 	}
-	
+
+}
+
+const std::vector<size_t>& AnimationManager::GetDrawOrder()
+{
+	return GetStableOrder([](const Animation& animation) { return animation.GetLayer(); });
 }
 
 void AnimationManager::Reset()
@@ -286,18 +342,13 @@ void AnimationManager::DestroyComponent(Entity entity)
 {
 	if (m_Engine.GetEntityManager()->HasComponent(entity, ComponentType::ANIMATION2D))
 	{
-		RemoveConcernedEntity(entity);
+		RemovePackedComponent(entity);
 		m_Engine.GetEntityManager()->RemoveComponentType(entity, ComponentType::ANIMATION2D);
 	}
 }
 
-void AnimationManager::OnResize(size_t newSize) {
-	m_Components.resize(newSize);
-	m_ComponentsInfo.resize(newSize);
-
-	for (size_t i = 0; i < newSize; ++i) {
-		m_ComponentsInfo[i].SetEntity(i + 1);
-		m_ComponentsInfo[i].animation = &m_Components[i];
-	}
+void AnimationManager::LinkComponentInfo(size_t index)
+{
+	m_ComponentsInfo[index].animation = &m_Components[index];
 }
 }
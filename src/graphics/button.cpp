@@ -57,9 +57,7 @@ namespace sfge
 	Button* ButtonManager::AddComponent(Entity entity)
 	{
 		auto& button = GetComponentRef(entity);
-		m_ComponentsInfo[entity - 1].button = &button;
-		m_ComponentsInfo[entity - 1].SetEntity(entity);
-		m_ConcernedEntities.push_back(entity);
+		AddConcernedEntity(entity);
 		m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::BUTTON);
 		return &button;
 	}
@@ -83,10 +81,10 @@ namespace sfge
 	{
 		m_Components.resize(newSize);
 		m_ComponentsInfo.resize(newSize);
+	}
 
-		for (size_t i = 0; i < newSize; ++i) {
-			m_ComponentsInfo[i].SetEntity(i + 1);
-			m_ComponentsInfo[i].button = &m_Components[i];
-		}
+	void ButtonManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].button = &m_Components[index];
 	}
 }
@@ -69,7 +69,7 @@ namespace sfge
 		window.setView(m_View);
 	}
 
-	CameraManager::CameraManager(Engine& engine): SingleComponentManager(engine)
+	CameraManager::CameraManager(Engine& engine): PackedComponentManager(engine)
 	{	
 	}
 	CameraManager::~CameraManager()
@@ -78,35 +78,41 @@ namespace sfge
 
 	Camera* CameraManager::GetMainCamera()
 	{
-		for(int i = 0; i < m_ConcernedEntities.size(); i++)
-			return &m_Components[m_ConcernedEntities[i] - 1];
+		if (m_Components.empty())
+			return nullptr;
+		if (!HasComponentIndex(m_MainCamera))
+		{
+			m_MainCamera = m_ConcernedEntities[MAINCAMERA];
+		}
+		return GetComponentPtr(m_MainCamera);
 	}
 
 	Camera* CameraManager::AddComponent(Entity entity)
 	{
-		auto& camera = GetComponentRef(entity);
-		auto& cameraInfo = GetComponentInfo(entity);
-
-		cameraInfo.camera = &camera;
-		m_ComponentsInfo[entity - 1].SetEntity(entity);
-		m_ConcernedEntities.push_back(entity);
+		auto* camera = EmplacePackedComponent(entity);
+		if (!HasComponentIndex(m_MainCamera))
+		{
+			m_MainCamera = entity;
+		}
 		m_EntityManager->AddComponentType(entity, ComponentType::CAMERA);
-		return &camera;
+		return camera;
 	}
 
 	void CameraManager::Init()
 	{
-		SingleComponentManager::Init();
+		PackedComponentManager::Init();
 		m_GraphicsManager = m_Engine.GetGraphics2dManager();
 		m_Transform2dManager = m_Engine.GetTransform2dManager();
 		m_InputManager = m_Engine.GetInputManager();
+		//Update sets the view of the main camera on the window
+		DeclareAccess(static_cast<int>(ComponentType::CAMERA), 0, static_cast<int>(SystemResource::WINDOW));
 	}
 
 	void CameraManager::Update(float dt)
 	{
 		rmt_ScopedCPUSample(CameraUpdate, 0)
-		for (auto i = 0U; i < m_ConcernedEntities.size(); i++)
-			m_Components[m_ConcernedEntities[i] - 1].Update(dt, (*m_GraphicsManager->GetWindow()));
+		for (auto i = 0U; i < m_Components.size(); i++)
+			m_Components[i].Update(dt, (*m_GraphicsManager->GetWindow()));
 	}
 
 	void CameraManager::SetCameraCurrent(short newCurrent)
@@ -118,6 +124,12 @@ namespace sfge
 	{
 	}
 
+	void CameraManager::Clear()
+	{
+		PackedComponentManager::Clear();
+		m_MainCamera = INVALID_ENTITY;
+	}
+
 	void CameraManager::Collect()
 	{
 
@@ -128,10 +140,7 @@ namespace sfge
 		json j;
 		for (auto i = 0u; i < m_Components.size(); i++)
 		{
-			if (m_EntityManager->HasComponent(i + 1, ComponentType::CAMERA))
-			{
-				j[i]["type"] = static_cast<int>(ComponentType::CAMERA);
-			}
+			j[m_ConcernedEntities[i] - 1]["type"] = static_cast<int>(ComponentType::CAMERA);
 		}
 		return j;
 	}
@@ -139,10 +148,6 @@ namespace sfge
 	void CameraManager::CreateComponent(json& componentJson, Entity entity)
 	{
 		auto * Camera = AddComponent(entity);
-		const int index = Camera - &m_Components[0];
-		auto* newCameraInfo = &m_ComponentsInfo[index];
-
-		newCameraInfo->camera = Camera;
 		Camera->SetPosition(sf::Vector2f(0.0f, 0.0f));
 	}
 
@@ -150,11 +155,16 @@ namespace sfge
 	{
 		if (m_Engine.GetEntityManager()->HasComponent(entity, ComponentType::CAMERA))
 		{
-			RemoveConcernedEntity(entity);
+			RemovePackedComponent(entity);
 			m_Engine.GetEntityManager()->RemoveComponentType(entity, ComponentType::CAMERA);
 		}
 	}
 
+	void CameraManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].camera = &m_Components[index];
+	}
+
 	void editor::CameraInfo::DrawOnInspector()
 	{
 		ImGui::Separator();
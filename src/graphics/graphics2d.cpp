@@ -56,6 +56,9 @@ void Graphics2dManager::Init()
 				m_Window->setFramerateLimit(configPtr->maxFramerate);
 				CheckVersion();
 			}
+			m_View = m_Window->getView();
+			m_WindowSize = m_Window->getSize();
+			m_WindowPosition = m_Window->getPosition();
 		}
 	}
 	else
@@ -68,6 +71,19 @@ void Graphics2dManager::Init()
 	m_SpriteManager.Init();
  	m_AnimationManager.Init();
 	m_CameraManager.Init();
+	//Without window Update does nothing
+	DeclareAccess(0, 0);
+	m_SyncAccess = GetAccess();
+	if (!m_Windowless)
+	{
+		AddAccess(m_TilemapSystem.GetTilemapManager()->GetAccess());
+		AddAccess(m_SpriteManager.GetAccess());
+		AddAccess(m_AnimationManager.GetAccess());
+		AddAccess(m_ShapeManager.GetAccess());
+		m_SyncAccess = GetAccess();
+		//Update also clears the window
+		AddAccess(m_CameraManager.GetAccess());
+	}
 }
 
 void Graphics2dManager::Update(float dt)
@@ -77,16 +93,84 @@ void Graphics2dManager::Update(float dt)
 		rmt_ScopedCPUSample(Graphics2dUpdate,0)
 		m_Window->clear();
 
-		m_TilemapSystem.Update(dt);
-		m_SpriteManager.Update(dt);
-		m_AnimationManager.Update(dt);
-		m_ShapeManager.Update(dt);
+		SyncComponents(dt);
 
-		//Refresh View Window
-		m_CameraManager.Update(dt);
+		UpdateCamera(dt);
 	}
 }
 
+void Graphics2dManager::SyncComponents(float dt)
+{
+	if (m_Windowless)
+		return;
+	m_TilemapSystem.Update(dt);
+	m_SpriteManager.Update(dt);
+	m_AnimationManager.Update(dt);
+	m_ShapeManager.Update(dt);
+}
+
+const SystemAccess& Graphics2dManager::GetSyncAccess() const
+{
+	return m_SyncAccess;
+}
+
+void Graphics2dManager::UpdateCamera(float dt)
+{
+	if (m_Windowless)
+		return;
+	m_WindowSize = m_Window->getSize();
+	m_WindowPosition = m_Window->getPosition();
+	//Refresh View Window
+	m_CameraManager.Update(dt);
+	m_View = m_Window->getView();
+}
+
+void Graphics2dManager::TakeSnapshot(RenderSnapshot& snapshot)
+{
+	rmt_ScopedCPUSample(Graphics2dSnapshot, 0)
+	snapshot.Clear();
+	if (m_Windowless)
+		return;
+	snapshot.SetView(m_Window->getView());
+	//Same order as Draw: tilemaps, sprites, animations then shapes, each through its draw order
+	m_TilemapSystem.TakeSnapshot(snapshot);
+	auto& sprites = m_SpriteManager.GetComponents();
+	for (const auto i : m_SpriteManager.GetDrawOrder())
+	{
+		if (sprites[i].is_visible)
+			snapshot.AddSprite(sprites[i].GetSprite());
+	}
+	auto& animations = m_AnimationManager.GetComponents();
+	for (const auto i : m_AnimationManager.GetDrawOrder())
+	{
+		snapshot.AddSprite(animations[i].GetSprite());
+	}
+	auto& shapes = m_ShapeManager.GetComponents();
+	for (const auto i : m_ShapeManager.GetDrawOrder())
+	{
+		if (auto* shape = shapes[i].GetShape())
+			snapshot.AddShape(*shape);
+	}
+	//A scene loaded during the next simulation must not free the textures drawn meanwhile
+	m_TextureManager.PinTextures(snapshot.GetTextures());
+}
+
+void Graphics2dManager::DrawSnapshot(RenderSnapshot& snapshot)
+{
+	rmt_ScopedCPUSample(Graphics2dDrawSnapshot, 0)
+	if (!m_Windowless)
+	{
+		m_Window->clear();
+		snapshot.Draw(*m_Window);
+	}
+}
+
+void Graphics2dManager::ReleaseSnapshot(RenderSnapshot& snapshot)
+{
+	snapshot.Clear();
+	m_TextureManager.PinTextures(snapshot.GetTextures());
+}
+
 void Graphics2dManager::Draw()
 {
 	rmt_ScopedCPUSample(Graphics2dDraw, 0)
@@ -125,20 +209,25 @@ sf::RenderWindow* Graphics2dManager::GetWindow()
 	return m_Window.get();
 }
 
+const sf::View& Graphics2dManager::GetView() const
+{
+	return m_View;
+}
+
 sf::Vector2f Graphics2dManager::GetSizeWindow()
 {
-	return sf::Vector2f(m_Window.get()->getSize());
+	return sf::Vector2f(m_WindowSize);
 }
 
 sf::Vector2f Graphics2dManager::GetPositionWindow()
 {
 	if(m_Engine.GetConfig()->styleWindow == sf::Style::Fullscreen)
 	{
-		return sf::Vector2f(m_Window.get()->getPosition());
+		return sf::Vector2f(m_WindowPosition);
 	}
 	if (m_Engine.GetConfig()->styleWindow == sf::Style::Default)
 	{
-		return sf::Vector2f(m_Window.get()->getPosition()) + sf::Vector2f(WINDOW_SIDES_WIDTH_PIXEL, WINDOW_TOP_HEIGTH_PIXEL);
+		return sf::Vector2f(m_WindowPosition) + sf::Vector2f(WINDOW_SIDES_WIDTH_PIXEL, WINDOW_TOP_HEIGTH_PIXEL);
 	}
 	return sf::Vector2f();
 }
@@ -164,6 +253,8 @@ void Graphics2dManager::OnChangeScreenMode()
 		m_Window->close();
 		m_Window->create(sf::VideoMode(configPtr->screenResolution.x, configPtr->screenResolution.y),
 			"SFGE 0.1", configPtr->styleWindow);
+		m_WindowSize = m_Window->getSize();
+		m_WindowPosition = m_Window->getPosition();
 	}
 }
 
@@ -225,7 +316,10 @@ void Graphics2dManager::Clear()
 {
 	m_TilemapSystem.Clear();
 	m_TextureManager.Clear();
-	m_SpriteManager.Reset();
+	m_SpriteManager.Clear();
+	m_AnimationManager.Clear();
+	m_ShapeManager.Clear();
+	m_CameraManager.Clear();
 }
 
 void Graphics2dManager::Collect()
@@ -235,4 +329,19 @@ void Graphics2dManager::Collect()
 	m_SpriteManager.Collect();
 }
 
+void Graphics2dManager::ReportMemory(MemoryReport& report) const
+{
+	report.SetSystem("TextureManager");
+	m_TextureManager.ReportMemory(report);
+	report.SetSystem("SpriteManager");
+	m_SpriteManager.ReportMemory(report);
+	report.SetSystem("AnimationManager");
+	m_AnimationManager.ReportMemory(report);
+	report.SetSystem("ShapeManager");
+	m_ShapeManager.ReportMemory(report);
+	report.SetSystem("CameraManager");
+	m_CameraManager.ReportMemory(report);
+	m_TilemapSystem.ReportMemory(report);
+}
+
 }
\ No newline at end of file
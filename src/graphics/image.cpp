@@ -130,9 +130,7 @@ namespace sfge
 	Image* ImageManager::AddComponent(Entity entity)
 	{
 		auto& image = GetComponentRef(entity);
-		m_ComponentsInfo[entity - 1].image = &image;
-		m_ComponentsInfo[entity - 1].SetEntity(entity);
-		m_ConcernedEntities.push_back(entity);
+		AddConcernedEntity(entity);
 		m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::IMAGE);
 		return &image;
 	}
@@ -165,6 +163,7 @@ namespace sfge
 		SingleComponentManager::Init();
 		m_RectTransformManager = m_Engine.GetRectTransformManager();
 		m_TextureManager = m_Engine.GetGraphics2dManager()->GetTextureManager();
+		DeclareAccess(static_cast<int>(ComponentType::RECTTRANSFORM), static_cast<int>(ComponentType::IMAGE));
 	}
 
 	void ImageManager::Update(float dt)
@@ -184,10 +183,10 @@ namespace sfge
 	{
 		m_Components.resize(newSize);
 		m_ComponentsInfo.resize(newSize);
+	}
 
-		for (size_t i = 0; i < newSize; ++i) {
-			m_ComponentsInfo[i].SetEntity(i + 1);
-			m_ComponentsInfo[i].image = &m_Components[i];
-		}
+	void ImageManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].image = &m_Components[index];
 	}
 }
@@ -136,9 +136,7 @@ namespace sfge
 	RectTransform* RectTransformManager::AddComponent(Entity entity)
 	{
 		auto& rectTransform = GetComponentRef(entity);
-		m_ComponentsInfo[entity - 1].rectTransform = &rectTransform;
-		m_ComponentsInfo[entity - 1].SetEntity(entity);
-		m_ConcernedEntities.push_back(entity);
+		AddConcernedEntity(entity);
 		m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::RECTTRANSFORM);
 		return &rectTransform;
 	}
@@ -156,6 +154,7 @@ namespace sfge
 	{
 		SingleComponentManager::Init();
 		m_CameraManager = m_Engine.GetGraphics2dManager()->GetCameraManager();
+		DeclareAccess(static_cast<int>(ComponentType::CAMERA), static_cast<int>(ComponentType::RECTTRANSFORM));
 	}
 	
 	void RectTransformManager::Update(float dt)
@@ -170,10 +169,10 @@ namespace sfge
 	{
 		m_Components.resize(newSize);
 		m_ComponentsInfo.resize(newSize);
+	}
 
-		for (size_t i = 0; i < newSize; ++i) {
-			m_ComponentsInfo[i].SetEntity(i + 1);
-			m_ComponentsInfo[i].rectTransform = &m_Components[i];
-		}
+	void RectTransformManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].rectTransform = &m_Components[index];
 	}
 }
@@ -0,0 +1,183 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cmath>
+
+#include <SFML/Graphics/Transform.hpp>
+
+#include <graphics/render_snapshot.h>
+
+namespace sfge
+{
+
+void RenderSnapshot::Clear()
+{
+	m_Positions.clear();
+	m_Origins.clear();
+	m_Scales.clear();
+	m_Rotations.clear();
+	m_Textures.clear();
+	m_TextureRects.clear();
+	m_Colors.clear();
+	m_ShapeVertices.clear();
+}
+
+void RenderSnapshot::AddSprite(const sf::Sprite& sprite)
+{
+	if (sprite.getTexture() == nullptr)
+		return;
+	m_Positions.push_back(sprite.getPosition());
+	m_Origins.push_back(sprite.getOrigin());
+	m_Scales.push_back(sprite.getScale());
+	m_Rotations.push_back(sprite.getRotation());
+	m_Textures.push_back(sprite.getTexture());
+	m_TextureRects.push_back(sprite.getTextureRect());
+	m_Colors.push_back(sprite.getColor());
+}
+
+void RenderSnapshot::AddShape(const sf::Shape& shape)
+{
+	const auto pointNmb = shape.getPointCount();
+	if (pointNmb < 3)
+		return;
+	//Fan from the first point, the circles and rectangles of the ShapeManager are convex
+	const auto& transform = shape.getTransform();
+	const auto color = shape.getFillColor();
+	const auto first = transform.transformPoint(shape.getPoint(0));
+	for (size_t i = 1; i + 1 < pointNmb; i++)
+	{
+		m_ShapeVertices.append(sf::Vertex(first, color));
+		m_ShapeVertices.append(sf::Vertex(transform.transformPoint(shape.getPoint(i)), color));
+		m_ShapeVertices.append(sf::Vertex(transform.transformPoint(shape.getPoint(i + 1)), color));
+	}
+
+	const auto thickness = shape.getOutlineThickness();
+	if (thickness == 0.0f)
+		return;
+	//Same outline as sf::Shape: each point is pushed along the mean normal of its two edges
+	sf::Vector2f center;
+	for (size_t i = 0; i < pointNmb; i++)
+	{
+		center += shape.getPoint(i);
+	}
+	center /= static_cast<float>(pointNmb);
+	const auto computeNormal = [&center](sf::Vector2f point1, sf::Vector2f point2)
+	{
+		sf::Vector2f normal(point1.y - point2.y, point2.x - point1.x);
+		const auto length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+		if (length != 0.0f)
+			normal /= length;
+		//Outward, away from the center
+		if (normal.x * (center.x - point2.x) + normal.y * (center.y - point2.y) > 0.0f)
+			normal = -normal;
+		return normal;
+	};
+	std::vector<sf::Vector2f> innerPoints(pointNmb);
+	std::vector<sf::Vector2f> outerPoints(pointNmb);
+	for (size_t i = 0; i < pointNmb; i++)
+	{
+		const auto point0 = shape.getPoint(i == 0 ? pointNmb - 1 : i - 1);
+		const auto point1 = shape.getPoint(i);
+		const auto point2 = shape.getPoint((i + 1) % pointNmb);
+		const auto normal1 = computeNormal(point0, point1);
+		const auto normal2 = computeNormal(point1, point2);
+		const auto factor = 1.0f + (normal1.x * normal2.x + normal1.y * normal2.y);
+		const auto normal = (normal1 + normal2) / factor;
+		innerPoints[i] = transform.transformPoint(point1);
+		outerPoints[i] = transform.transformPoint(point1 + normal * thickness);
+	}
+	const auto outlineColor = shape.getOutlineColor();
+	for (size_t i = 0; i < pointNmb; i++)
+	{
+		const auto next = (i + 1) % pointNmb;
+		m_ShapeVertices.append(sf::Vertex(innerPoints[i], outlineColor));
+		m_ShapeVertices.append(sf::Vertex(outerPoints[i], outlineColor));
+		m_ShapeVertices.append(sf::Vertex(outerPoints[next], outlineColor));
+		m_ShapeVertices.append(sf::Vertex(innerPoints[i], outlineColor));
+		m_ShapeVertices.append(sf::Vertex(outerPoints[next], outlineColor));
+		m_ShapeVertices.append(sf::Vertex(innerPoints[next], outlineColor));
+	}
+}
+
+void RenderSnapshot::SetView(const sf::View& view)
+{
+	m_View = view;
+}
+
+void RenderSnapshot::Draw(sf::RenderTarget& target)
+{
+	target.setView(m_View);
+	m_Vertices.clear();
+	const sf::Texture* currentTexture = nullptr;
+	for (size_t index = 0; index < m_Textures.size(); index++)
+	{
+		if (m_Textures[index] != currentTexture)
+		{
+			Flush(target, currentTexture);
+			currentTexture = m_Textures[index];
+		}
+		//Same quad as sf::Sprite: local bounds moved by the transformable
+		sf::Transform transform;
+		transform.translate(m_Positions[index]).rotate(m_Rotations[index]).scale(m_Scales[index]).translate(-m_Origins[index]);
+		const auto& rect = m_TextureRects[index];
+		const auto color = m_Colors[index];
+		const float width = static_cast<float>(std::abs(rect.width));
+		const float height = static_cast<float>(std::abs(rect.height));
+		const float left = static_cast<float>(rect.left);
+		const float right = left + rect.width;
+		const float top = static_cast<float>(rect.top);
+		const float bottom = top + rect.height;
+		m_Vertices.append(sf::Vertex(transform.transformPoint(0.0f, 0.0f), color, sf::Vector2f(left, top)));
+		m_Vertices.append(sf::Vertex(transform.transformPoint(width, 0.0f), color, sf::Vector2f(right, top)));
+		m_Vertices.append(sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)));
+		m_Vertices.append(sf::Vertex(transform.transformPoint(0.0f, height), color, sf::Vector2f(left, bottom)));
+	}
+	Flush(target, currentTexture);
+	if (m_ShapeVertices.getVertexCount() != 0)
+	{
+		target.draw(m_ShapeVertices);
+	}
+}
+
+void RenderSnapshot::Flush(sf::RenderTarget& target, const sf::Texture* texture)
+{
+	if (m_Vertices.getVertexCount() == 0)
+		return;
+	sf::RenderStates states;
+	states.texture = texture;
+	target.draw(m_Vertices, states);
+	m_Vertices.clear();
+}
+
+size_t RenderSnapshot::GetSpriteNmb() const
+{
+	return m_Textures.size();
+}
+
+const std::vector<const sf::Texture*>& RenderSnapshot::GetTextures() const
+{
+	return m_Textures;
+}
+
+}
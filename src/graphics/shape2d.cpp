@@ -62,7 +62,7 @@ void Shape::SetFillColor(sf::Color color) const
 		m_Shape->setFillColor(color);
 }
 
-void Shape::Update(float dt, Transform2d* transform) const
+void Shape::Update(float dt, const Transform2d* transform) const
 {
 	(void) dt;
 	auto newPosition = m_Offset;
@@ -80,6 +80,7 @@ void Shape::Update(float dt, Transform2d* transform) const
 void Shape::SetShape (std::unique_ptr<sf::Shape> shape)
 {
 	m_Shape = std::move(shape);
+	InvalidateTransformVersion();
 }
 sf::Shape *Shape::GetShape ()
 {
@@ -122,42 +123,48 @@ void editor::ShapeInfo::DrawOnInspector ()
 
 void ShapeManager::Init()
 {
-	SingleComponentManager::Init();
+	PackedComponentManager::Init();
 	m_Transform2dManager = m_Engine.GetTransform2dManager();
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D), static_cast<int>(ComponentType::SHAPE2D));
 }
 
 
 void ShapeManager::DrawShapes(sf::RenderWindow &window)
 {
 	rmt_ScopedCPUSample(ShapeDraw,0)
-	for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
-		m_Components[m_ConcernedEntities[i] - 1].Draw(window);
+	for (const auto i : GetDrawOrder())
+		m_Components[i].Draw(window);
+}
+
+const std::vector<size_t>& ShapeManager::GetDrawOrder()
+{
+	//The shapes have no layer, they are drawn by entity
+	return GetStableOrder([](const Shape&) { return 0; });
 }
 
 void ShapeManager::Update(const float dt)
 {
 
 	rmt_ScopedCPUSample(ShapeUpdate,0)
-	for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
-		m_Components[m_ConcernedEntities[i] - 1].Update(dt, m_Transform2dManager->GetComponentPtr(m_ConcernedEntities[i]));
+	for (auto i = 0u; i < m_Components.size(); i++)
+	{
+		const auto entity = m_ConcernedEntities[i];
+		if (m_Components[i].SyncTransformVersion(m_Transform2dManager->GetVersion(entity)))
+			m_Components[i].Update(dt, &m_Transform2dManager->GetWorldTransform(entity));
+	}
 }
 
 void ShapeManager::Clear()
 {
-	m_Components.clear ();
-	m_Components.resize (INIT_ENTITY_NMB);
-
+	PackedComponentManager::Clear();
 }
 
 
 
 Shape *ShapeManager::AddComponent (Entity entity)
 {
-	auto shapePtr = GetComponentPtr (entity);
-	GetComponentInfo (entity).shapePtr = shapePtr;
-	m_ConcernedEntities.push_back(entity);
+	auto shapePtr = EmplacePackedComponent(entity);
 	m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::SHAPE2D);
-	m_ComponentsInfo[entity - 1].SetEntity(entity);
 	return shapePtr;
 }
 
@@ -194,7 +201,7 @@ void ShapeManager::CreateComponent(json& componentJson, Entity entity)
 			circleShape->setRadius (radius);
 			circleShape->setOrigin (radius, radius);
 			shape->SetShape (std::move(circleShape));
-			shape->Update(0.0f, m_Transform2dManager->GetComponentPtr(entity));
+			shape->Update(0.0f, &m_Transform2dManager->GetLocalTransform(entity));
 		}
 			break;
 		case ShapeType::RECTANGLE:
@@ -213,7 +220,7 @@ void ShapeManager::CreateComponent(json& componentJson, Entity entity)
 			rect->setSize (size);
 			rect->setOrigin (size.x/2.0f, size.y/2.0f);
             shape->SetShape (std::move (rect));
-            shape->Update (0.0f, m_Transform2dManager->GetComponentPtr(entity));
+            shape->Update (0.0f, &m_Transform2dManager->GetLocalTransform(entity));
 			
 		}
 			break;
@@ -234,19 +241,15 @@ void ShapeManager::CreateComponent(json& componentJson, Entity entity)
 
 void ShapeManager::DestroyComponent(Entity entity)
 {
-	RemoveConcernedEntity(entity);
-	(void) entity;
+	if (RemovePackedComponent(entity))
+	{
+		m_Engine.GetEntityManager()->RemoveComponentType(entity, ComponentType::SHAPE2D);
+	}
 }
 
-void ShapeManager::OnResize(size_t new_size)
+void ShapeManager::LinkComponentInfo(size_t index)
 {
-	m_Components.resize(new_size);
-	m_ComponentsInfo.resize(new_size);
-
-	for (size_t i = 0; i < new_size; ++i) {
-		m_ComponentsInfo[i].SetEntity(i + 1);
-		m_ComponentsInfo[i].shapePtr = &m_Components[i];
-	}
+	m_ComponentsInfo[index].shapePtr = &m_Components[index];
 }
 
 }
@@ -22,6 +22,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <map>
+#include <set>
+#include <unordered_map>
+
 #include <graphics/graphics2d.h>
 #include <graphics/sprite2d.h>
 #include <graphics/texture.h>
@@ -31,6 +35,7 @@ SOFTWARE.
 #include <engine/engine.h>
 #include <engine/config.h>
 #include <engine/transform2d.h>
+#include <engine/scene_binary.h>
 
 #include <imgui.h>
 #include <imgui-SFML.h>
@@ -55,6 +60,11 @@ void Sprite::Draw(sf::RenderWindow& window)
 	
 	window.draw(sprite);
 }
+const sf::Sprite& Sprite::GetSprite() const
+{
+	return sprite;
+}
+
 const sf::Texture* Sprite::GetTexture()
 {
 	return sprite.getTexture();
@@ -70,7 +80,7 @@ void Sprite::Init()
 	is_visible = true;
 }
 
-void Sprite::Update(Transform2d* transform)
+void Sprite::Update(const Transform2d* transform)
 {
 	auto pos = m_Offset;
 
@@ -105,52 +115,46 @@ void editor::SpriteInfo::DrawOnInspector()
 
 void SpriteManager::Init()
 {
-	SingleComponentManager::Init();
+	PackedComponentManager::Init();
 	m_GraphicsManager = m_Engine.GetGraphics2dManager();
 	m_Transform2dManager = m_Engine.GetTransform2dManager();
+	DeclareAccess(static_cast<int>(ComponentType::TRANSFORM2D), static_cast<int>(ComponentType::SPRITE2D));
 }
 
 Sprite* SpriteManager::AddComponent(Entity entity)
 {
-	auto& sprite = GetComponentRef(entity);
-	auto& spriteInfo = GetComponentInfo(entity);
-
-	m_Components[entity - 1] = sprite;
-	m_ConcernedEntities.push_back(entity);
-
-	spriteInfo.sprite = &sprite;
-	spriteInfo.SetEntity(entity);
-
+	auto* sprite = EmplacePackedComponent(entity);
 	m_EntityManager->AddComponentType(entity, ComponentType::SPRITE2D);
-	return &sprite;
+	return sprite;
 }
 
 void SpriteManager::Update(float dt)
 {
 	(void) dt;
 	rmt_ScopedCPUSample(SpriteUpdate,0)
-	for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
-		m_Components[m_ConcernedEntities[i] - 1].Update(m_Transform2dManager->GetComponentPtr(m_ConcernedEntities[i]));
+	//Only the sprites whose transform changed since their last sync are pushed to SFML
+	for (auto i = 0u; i < m_Components.size(); i++)
+	{
+		const auto entity = m_ConcernedEntities[i];
+		if (m_Components[i].SyncTransformVersion(m_Transform2dManager->GetVersion(entity)))
+			m_Components[i].Update(&m_Transform2dManager->GetWorldTransform(entity));
+	}
 }
 
 void SpriteManager::DrawSprites(sf::RenderWindow &window)
 {
 
 	rmt_ScopedCPUSample(SpriteDraw,0)
-#ifdef COMPONENT_OPTIMIZATION
-	for(auto i = 0U; i < m_ConcernedEntities.size(); i++)
-	{
-		if(m_Components[m_ConcernedEntities[i] - 1].is_visible)
-			m_Components[m_ConcernedEntities[i] - 1].Draw(window);
-	}
-#else
-	for (auto i = 0u; i < m_Components.size();i++)
+	for (const auto i : GetDrawOrder())
 	{
-		if(m_EntityManager->HasComponent(i + 1, ComponentType::SPRITE2D))
-			if(m_Components[i].is_visible)
-				m_Components[i].Draw(window);
+		if(m_Components[i].is_visible)
+			m_Components[i].Draw(window);
 	}
-#endif
+}
+
+const std::vector<size_t>& SpriteManager::GetDrawOrder()
+{
+	return GetStableOrder([](const Sprite& sprite) { return sprite.GetLayer(); });
 }
 
 void SpriteManager::Reset()
@@ -210,11 +214,206 @@ void SpriteManager::CreateComponent(json& componentJson, Entity entity)
 	}
 }
 
+void SpriteManager::CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons)
+{
+	const size_t noPath = std::numeric_limits<size_t>::max();
+	std::vector<Sprite*> sprites(entities.size());
+	std::vector<size_t> spritePathIndices(entities.size(), noPath);
+	std::vector<std::string> paths;
+	std::unordered_map<std::string, size_t> pathIndices;
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		sprites[i] = AddComponent(entities[i]);
+		const json& componentJson = *componentJsons[i];
+		if (CheckJsonParameter(componentJson, "path", json::value_t::string))
+		{
+			const auto pathIndex = pathIndices.emplace(componentJson["path"].get<std::string>(), paths.size());
+			if (pathIndex.second)
+				paths.push_back(pathIndex.first->first);
+			spritePathIndices[i] = pathIndex.first->second;
+		}
+		else
+		{
+			Log::GetInstance()->Error("[Error] No Path for Sprite");
+		}
+	}
+
+	auto* textureManager = m_GraphicsManager->GetTextureManager();
+	textureManager->PreloadTextures(paths);
+	std::vector<sf::Texture*> textures(paths.size(), nullptr);
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		if (!FileExists(paths[i]))
+		{
+			std::ostringstream oss;
+			oss << "Texture file " << paths[i] << " does not exist";
+			Log::GetInstance()->Error(oss.str());
+			continue;
+		}
+		const TextureId textureId = textureManager->LoadTexture(paths[i]);
+		if (textureId != INVALID_TEXTURE)
+		{
+			textures[i] = textureManager->GetTexture(textureId);
+		}
+		else
+		{
+			std::ostringstream oss;
+			oss << "Texture file " << paths[i] << " cannot be loaded";
+			Log::GetInstance()->Error(oss.str());
+		}
+	}
+
+	m_Engine.GetJobSystem().ParallelFor(0, entities.size(), 0, [&](size_t start, size_t end)
+	{
+		for (auto i = start; i < end; i++)
+		{
+			if (spritePathIndices[i] != noPath && textures[spritePathIndices[i]] != nullptr)
+			{
+				sprites[i]->SetTexture(textures[spritePathIndices[i]]);
+			}
+			const json& componentJson = *componentJsons[i];
+			if (CheckJsonParameter(componentJson, "layer", json::value_t::number_integer))
+			{
+				sprites[i]->SetLayer(componentJson["layer"]);
+			}
+		}
+	});
+}
+
+void SpriteManager::CreateComponents(const SceneBlock& block, const EntityRange& entities)
+{
+	const std::uint32_t* pathIndices = block.GetUintColumn(0);
+	const std::int32_t* layers = block.GetIntColumn(1);
+	if (layers == nullptr)
+		return;
+	auto* textureManager = m_GraphicsManager->GetTextureManager();
+	//Each distinct path is resolved once for the whole block
+	std::map<std::uint32_t, sf::Texture*> textures;
+	for (size_t i = 0; i < block.count; i++)
+	{
+		auto* newSprite = AddComponent(entities[block.entityIndices[i]]);
+		const auto pathIndex = pathIndices[i];
+		if (pathIndex == INVALID_SCENE_STRING)
+		{
+			Log::GetInstance()->Error("[Error] No Path for Sprite");
+		}
+		else
+		{
+			auto textureIt = textures.find(pathIndex);
+			if (textureIt == textures.end())
+			{
+				const std::string path(block.GetString(pathIndex));
+				sf::Texture* texture = nullptr;
+				const TextureId textureId = FileExists(path) ? textureManager->LoadTexture(path) : INVALID_TEXTURE;
+				if (textureId != INVALID_TEXTURE)
+				{
+					texture = textureManager->GetTexture(textureId);
+				}
+				else
+				{
+					std::ostringstream oss;
+					oss << "Texture file " << path << " cannot be loaded";
+					Log::GetInstance()->Error(oss.str());
+				}
+				textureIt = textures.emplace(pathIndex, texture).first;
+			}
+			if (textureIt->second != nullptr)
+				newSprite->SetTexture(textureIt->second);
+		}
+		newSprite->SetLayer(layers[i]);
+	}
+}
+
+void SpriteManager::CompileComponents(const std::vector<const json*>& componentJsons, SceneBlockBuilder& builder)
+{
+	std::vector<std::uint32_t> pathIndices(componentJsons.size(), INVALID_SCENE_STRING);
+	std::vector<std::int32_t> layers(componentJsons.size(), 0);
+	for (size_t i = 0; i < componentJsons.size(); i++)
+	{
+		const auto& componentJson = *componentJsons[i];
+		if (CheckJsonParameter(componentJson, "path", json::value_t::string))
+			pathIndices[i] = builder.AddString(componentJson["path"].get<std::string>());
+		if (CheckJsonParameter(componentJson, "layer", json::value_t::number_integer))
+			layers[i] = componentJson["layer"].get<std::int32_t>();
+	}
+	builder.AddUintColumn(pathIndices);
+	builder.AddIntColumn(layers);
+}
+
+void SpriteManager::CollectTexturePaths(const SceneBlock& block, std::vector<std::string>& texturePaths)
+{
+	const std::uint32_t* pathIndices = block.GetUintColumn(0);
+	if (pathIndices == nullptr)
+		return;
+	std::set<std::uint32_t> collectedIndices;
+	for (size_t i = 0; i < block.count; i++)
+	{
+		if (pathIndices[i] != INVALID_SCENE_STRING && collectedIndices.insert(pathIndices[i]).second)
+		{
+			texturePaths.emplace_back(block.GetString(pathIndices[i]));
+		}
+	}
+}
+
+void SpriteManager::ResolvePrefabComponent(PrefabComponent& prefabComponent)
+{
+	const auto& componentJson = prefabComponent.componentJson;
+	SpritePrefabData spriteData;
+	if (CheckJsonParameter(componentJson, "layer", json::value_t::number_integer))
+		spriteData.layer = componentJson["layer"];
+	if (!CheckJsonParameter(componentJson, "path", json::value_t::string))
+	{
+		Log::GetInstance()->Error("[Error] No Path for Sprite");
+	}
+	else
+	{
+		spriteData.texturePath = componentJson["path"].get<std::string>();
+		auto* textureManager = m_GraphicsManager->GetTextureManager();
+		spriteData.textureId = FileExists(spriteData.texturePath) ?
+			textureManager->LoadTexture(spriteData.texturePath) : INVALID_TEXTURE;
+		if (spriteData.textureId != INVALID_TEXTURE)
+		{
+			spriteData.texture = textureManager->GetTexture(spriteData.textureId);
+		}
+		else
+		{
+			std::ostringstream oss;
+			oss << "Texture file " << spriteData.texturePath << " cannot be loaded";
+			Log::GetInstance()->Error(oss.str());
+		}
+	}
+	prefabComponent.resolvedData = spriteData;
+}
+
+void SpriteManager::InstantiatePrefabComponents(const PrefabComponent& prefabComponent,
+	const std::vector<Entity>& entities, const std::vector<Vec2f>& positions)
+{
+	(void) positions;
+	const auto* spriteData = std::any_cast<SpritePrefabData>(&prefabComponent.resolvedData);
+	if (spriteData == nullptr)
+		return;
+	const bool editor = m_Engine.GetConfig()->editor;
+	for (Entity entity : entities)
+	{
+		auto* sprite = AddComponent(entity);
+		if (spriteData->texture != nullptr)
+			sprite->SetTexture(spriteData->texture);
+		sprite->SetLayer(spriteData->layer);
+		if (editor)
+		{
+			auto& spriteInfo = GetComponentInfo(entity);
+			spriteInfo.sprite = sprite;
+			spriteInfo.textureId = spriteData->textureId;
+			spriteInfo.texturePath = spriteData->texturePath;
+		}
+	}
+}
+
 void SpriteManager::DestroyComponent(Entity entity)
 {
 	if (m_Engine.GetEntityManager()->HasComponent(entity, ComponentType::SPRITE2D))
 	{
-		RemoveConcernedEntity(entity);
+		RemovePackedComponent(entity);
 		m_Engine.GetEntityManager()->RemoveComponentType(entity, ComponentType::SPRITE2D);
 	}
 }
@@ -224,24 +423,16 @@ json SpriteManager::Save()
 	json j;
 	for (auto i = 0u; i < m_ComponentsInfo.size(); i++)
 	{
-		if (m_EntityManager->HasComponent(i + 1, ComponentType::SPRITE2D))
-		{	
-			j[i]["type"] = static_cast<int>(ComponentType::SPRITE2D);
-			j[i]["path"] = m_ComponentsInfo[i].texturePath;
-			j[i]["is_visible"] = m_Components[i].is_visible;
-		}
+		const auto entityIndex = m_ConcernedEntities[i] - 1;
+		j[entityIndex]["type"] = static_cast<int>(ComponentType::SPRITE2D);
+		j[entityIndex]["path"] = m_ComponentsInfo[i].texturePath;
+		j[entityIndex]["is_visible"] = m_Components[i].is_visible;
 	}
 	return j;
 }
 
-void SpriteManager::OnResize(size_t new_size)
+void SpriteManager::LinkComponentInfo(size_t index)
 {
-	m_Components.resize(new_size);
-	m_ComponentsInfo.resize(new_size);
-
-	for (size_t i = 0; i < new_size; ++i) {
-		m_ComponentsInfo[i].SetEntity(i + 1);
-		m_ComponentsInfo[i].sprite = &m_Components[i];
-	}
+	m_ComponentsInfo[index].sprite = &m_Components[index];
 }
 }
@@ -174,9 +174,7 @@ namespace sfge
 	Text* TextManager::AddComponent(Entity entity)
 	{
 		auto& text = GetComponentRef(entity);
-		m_ComponentsInfo[entity - 1].text = &text;
-		m_ComponentsInfo[entity - 1].SetEntity(entity);
-		m_ConcernedEntities.push_back(entity);
+		AddConcernedEntity(entity);
 		m_Engine.GetEntityManager()->AddComponentType(entity, ComponentType::TEXT);
 		return &text;
 	}
@@ -191,6 +189,7 @@ namespace sfge
 	{
 		SingleComponentManager::Init();
 		m_RectTransformManager = m_Engine.GetRectTransformManager();
+		DeclareAccess(static_cast<int>(ComponentType::RECTTRANSFORM), static_cast<int>(ComponentType::TEXT));
 	}
 
 	void TextManager::Update(float dt)
@@ -210,10 +209,10 @@ namespace sfge
 	{
 		m_Components.resize(newSize);
 		m_ComponentsInfo.resize(newSize);
+	}
 
-		for (size_t i = 0; i < newSize; ++i) {
-			m_ComponentsInfo[i].SetEntity(i + 1);
-			m_ComponentsInfo[i].text = &m_Components[i];
-		}
+	void TextManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].text = &m_Components[index];
 	}
 }
@@ -28,11 +28,13 @@ SOFTWARE.
 #include <list>
 #include <set>
 #include <memory>
+#include <algorithm>
 
 #include <graphics/texture.h>
 #include <utility/log.h>
 #include <engine/config.h>
 #include <engine/engine.h>
+#include <engine/memory_report.h>
 #include <utility/file_utility.h>
 
 
@@ -100,14 +102,7 @@ TextureId TextureManager::LoadTexture(std::string filename)
 		return INVALID_TEXTURE;
 	}
 
-	auto textureId = INVALID_TEXTURE;
-	for (TextureId checkedId = 1U; checkedId <= m_IncrementId; checkedId++)
-	{
-		if (filename == m_TexturePaths[checkedId-1])
-		{
-			textureId = checkedId;
-		}
-	}
+	auto textureId = FindTextureId(filename);
 	//Was or still is loaded
 	if (textureId != INVALID_TEXTURE)
 	{
@@ -160,6 +155,57 @@ TextureId TextureManager::LoadTexture(std::string filename)
 	return INVALID_TEXTURE;
 }
 
+void TextureManager::PreloadTextures(const std::vector<std::string>& filenames)
+{
+	std::vector<std::string> newFilenames;
+	for (const auto& filename : filenames)
+	{
+		const auto textureId = FindTextureId(filename);
+		const bool loaded = textureId != INVALID_TEXTURE && m_Textures[textureId - 1].getNativeHandle() != 0U;
+		if (!loaded && HasValidExtension(filename) && FileExists(filename) &&
+			std::find(newFilenames.begin(), newFilenames.end(), filename) == newFilenames.end())
+		{
+			newFilenames.push_back(filename);
+		}
+	}
+	if (newFilenames.empty())
+		return;
+
+	//Decoding is CPU only, the upload needs the OpenGL context of this thread
+	std::vector<sf::Image> images(newFilenames.size());
+	std::vector<char> decoded(newFilenames.size(), false);
+	m_Engine.GetJobSystem().ParallelFor(0, newFilenames.size(), 1, [&](size_t start, size_t end)
+	{
+		for (auto i = start; i < end; i++)
+		{
+			decoded[i] = images[i].loadFromFile(newFilenames[i]);
+		}
+	});
+	for (size_t i = 0; i < newFilenames.size(); i++)
+	{
+		if (decoded[i])
+		{
+			UploadTexture(newFilenames[i], images[i]);
+		}
+	}
+}
+
+void TextureManager::UploadTexture(const std::string& filename, const sf::Image& image)
+{
+	auto textureId = FindTextureId(filename);
+	if (textureId != INVALID_TEXTURE && m_Textures[textureId - 1].getNativeHandle() != 0U)
+		return;
+	if (textureId == INVALID_TEXTURE)
+	{
+		textureId = m_IncrementId + 1;
+		m_IncrementId++;
+		m_TexturePaths[textureId - 1] = filename;
+	}
+	//Not referenced until LoadTexture, an unused upload is collected like any other texture
+	m_TextureIdsRefCounts[textureId - 1] = 0U;
+	m_Textures[textureId - 1].loadFromImage(image);
+}
+
 sf::Texture* TextureManager::GetTexture(TextureId textureId)
 {
 	if (textureId == INVALID_TEXTURE)
@@ -174,6 +220,29 @@ std::string TextureManager::GetTexturePath(TextureId textureId)
 	return m_TexturePaths[textureId - 1];
 }
 
+void TextureManager::PinTextures(const std::vector<const sf::Texture*>& textures)
+{
+	std::vector<TextureId> pinnedTextureIds;
+	for (const auto* texture : textures)
+	{
+		const auto textureId = GetTextureId(texture);
+		if (textureId != INVALID_TEXTURE)
+			pinnedTextureIds.push_back(textureId);
+	}
+	std::sort(pinnedTextureIds.begin(), pinnedTextureIds.end());
+	pinnedTextureIds.erase(std::unique(pinnedTextureIds.begin(), pinnedTextureIds.end()), pinnedTextureIds.end());
+	m_PinnedTextureIds.swap(pinnedTextureIds);
+	//Collect skipped the unreferenced textures that were pinned
+	for (const auto textureId : pinnedTextureIds)
+	{
+		if (m_TextureIdsRefCounts[textureId - 1] == 0U &&
+			!std::binary_search(m_PinnedTextureIds.begin(), m_PinnedTextureIds.end(), textureId))
+		{
+			m_Textures[textureId - 1] = sf::Texture();
+		}
+	}
+}
+
 bool TextureManager::HasValidExtension(std::string filename)
 {
 	const std::string::size_type filenameExtensionIndex = filename.find_last_of('.');
@@ -191,6 +260,25 @@ bool TextureManager::HasValidExtension(std::string filename)
 	return true;
 }
 
+TextureId TextureManager::FindTextureId(const std::string& filename) const
+{
+	for (TextureId checkedId = 1U; checkedId <= m_IncrementId; checkedId++)
+	{
+		if (filename == m_TexturePaths[checkedId - 1])
+		{
+			return checkedId;
+		}
+	}
+	return INVALID_TEXTURE;
+}
+
+TextureId TextureManager::GetTextureId(const sf::Texture* texture) const
+{
+	if (texture < m_Textures.data() || texture >= m_Textures.data() + m_Textures.size())
+		return INVALID_TEXTURE;
+	return static_cast<TextureId>(texture - m_Textures.data()) + 1U;
+}
+
 void TextureManager::Clear()
 {
 	for (auto& textureIdsRefCount : m_TextureIdsRefCounts)
@@ -204,7 +292,8 @@ void TextureManager::Collect()
 	std::list<TextureId> unusedTextureIds;
 	for (auto i = 0U; i < m_TextureIdsRefCounts.size(); i++)
 	{
-		if(m_Textures[i].getNativeHandle () != 0U && m_TextureIdsRefCounts[i] == 0U )
+		if(m_Textures[i].getNativeHandle () != 0U && m_TextureIdsRefCounts[i] == 0U &&
+			!std::binary_search(m_PinnedTextureIds.begin(), m_PinnedTextureIds.end(), i + 1))
 		{
 			unusedTextureIds.push_back(i+1);
 		}
@@ -215,4 +304,21 @@ void TextureManager::Collect()
 	}
 }
 
+void TextureManager::ReportMemory(MemoryReport& report) const
+{
+	report.AddContainer("TexturePaths", m_TexturePaths);
+	report.AddContainer("TextureIdsRefCounts", m_TextureIdsRefCounts);
+	size_t textureBytes = 0;
+	for (TextureId textureId = 1U; textureId <= m_IncrementId; textureId++)
+	{
+		const auto& texture = m_Textures[textureId - 1];
+		if (texture.getNativeHandle() != 0U)
+		{
+			const auto size = texture.getSize();
+			textureBytes += static_cast<size_t>(size.x) * size.y * 4;
+		}
+	}
+	report.Add("Textures", m_IncrementId * sizeof(sf::Texture), m_Textures.capacity() * sizeof(sf::Texture), textureBytes);
+}
+
 }
@@ -59,6 +59,11 @@ namespace sfge
 		}
 	}
 
+	const std::vector<sf::Sprite>& Tilemap::GetTileSprites() const
+	{
+		return m_TileSprites;
+	}
+
 	json Tilemap::Save()
 	{
 		json j;
@@ -268,6 +273,7 @@ namespace sfge
 		SingleComponentManager::Init();
 		//m_Transform2dManager = m_Engine.GetTransform2dManager();
 		m_TilemapSystem = m_Engine.GetGraphics2dManager()->GetTilemapSystem();
+		DeclareAccess(0, static_cast<int>(ComponentType::TILEMAP));
 	}
 
 	void TilemapManager::Update(float dt)
@@ -286,6 +292,18 @@ namespace sfge
 		}
 	}
 
+	void TilemapManager::TakeSnapshot(RenderSnapshot& snapshot)
+	{
+		rmt_ScopedCPUSample(TilemapSnapshot, 0)
+		for (Entity tilemap : m_OrderToDrawTilemaps)
+		{
+			for (const auto& tileSprite : m_Components[tilemap].GetTileSprites())
+			{
+				snapshot.AddSprite(tileSprite);
+			}
+		}
+	}
+
 	void TilemapManager::Clear()
 	{
 	}
@@ -297,12 +315,9 @@ namespace sfge
 	json TilemapManager::Save()
 	{
 		json j;
-		for (auto i = 0u; i < m_Components.size(); i++)
+		for (Entity entity : m_EntityManager->View<Tilemap>())
 		{
-			if (m_EntityManager->HasComponent(i + 1, ComponentType::TILEMAP))
-			{
-				j[i] = m_Components[i].Save();
-			}
+			j[entity - 1] = m_Components[entity - 1].Save();
 		}
 		return j;
 	}
@@ -316,7 +331,7 @@ namespace sfge
 			m_Engine.GetTransform2dManager()->AddComponent(entity);
 
 		tilemapInfo.tilemap = &tilemap;
-		m_ConcernedEntities.push_back(entity);
+		AddConcernedEntity(entity);
 
 		m_Tilemaps.push_back(entity);
 		UpdateDrawOrderTilemaps();
@@ -327,9 +342,35 @@ namespace sfge
 
 	void TilemapManager::CreateComponent(json & componentJson, Entity entity)
 	{
-		json tilemapJson;
+		TilemapData tilemapData;
+		if (!ReadTilemapData(componentJson, tilemapData))
+			return;
+		CreateTilemap(entity, tilemapData);
+		UpdateDrawOrderTilemaps();
+	}
+
+	void TilemapManager::CreateComponentsFromJson(const std::vector<Entity>& entities, const std::vector<json*>& componentJsons)
+	{
+		std::vector<TilemapData> tilemapDatas(entities.size());
+		std::vector<char> valid(entities.size(), false);
+		m_Engine.GetJobSystem().ParallelFor(0, entities.size(), 1, [&](size_t start, size_t end)
+		{
+			for (auto i = start; i < end; i++)
+			{
+				valid[i] = ReadTilemapData(*componentJsons[i], tilemapDatas[i]);
+			}
+		});
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			if (valid[i])
+				CreateTilemap(entities[i], tilemapDatas[i]);
+		}
+		UpdateDrawOrderTilemaps();
+	}
 
-		if (CheckJsonExists(componentJson, "path") && CheckJsonParameter(componentJson, "path", nlohmann::detail::value_t::string))
+	bool TilemapManager::ReadTilemapData(const json& componentJson, TilemapData& tilemapData)
+	{
+		if (CheckJsonParameter(componentJson, "path", nlohmann::detail::value_t::string))
 		{
 			std::string path = componentJson["path"].get<std::string>();
 			{
@@ -339,42 +380,49 @@ namespace sfge
 			}
 			const auto tilemapJsonPtr = LoadJson(path);
 
-			if (tilemapJsonPtr != nullptr)
-				tilemapJson = *tilemapJsonPtr;
-			else
+			if (tilemapJsonPtr == nullptr)
 			{
 				Log::GetInstance()->Error("Couldn't load tilemap from path : '" + path + "'.");
-				return;
+				return false;
 			}
-			
+			tilemapData.loadedJson = std::move(*tilemapJsonPtr);
+			tilemapData.tilemapJson = &tilemapData.loadedJson;
 		}
 		else
-			tilemapJson = componentJson;
+			tilemapData.tilemapJson = &componentJson;
+
+		const json& tilemapJson = *tilemapData.tilemapJson;
+		if (CheckJsonParameter(tilemapJson, "map", nlohmann::detail::value_t::array))
+		{
+			DecodeTileTypes(tilemapJson["map"], tilemapData.tileTypeIds, tilemapData.mapSize);
+		}
+		return true;
+	}
 
-		if(CheckJsonExists(tilemapJson, "reference_path") && CheckJsonParameter(tilemapJson, "reference_path", nlohmann::detail::value_t::string))
+	void TilemapManager::CreateTilemap(Entity entity, const TilemapData& tilemapData)
+	{
+		const json& tilemapJson = *tilemapData.tilemapJson;
+		if(CheckJsonParameter(tilemapJson, "reference_path", nlohmann::detail::value_t::string))
 		{
 			m_TilemapSystem->GetTileTypeManager()->LoadTileType(tilemapJson["reference_path"].get<std::string>());		
 		}
 
 		auto & newTilemap = m_Components[entity - 1];
-		auto & newTilemapInfo = m_ComponentsInfo[entity - 1];
-
-		newTilemapInfo.tilemap = &newTilemap;
 
 		if (!m_Engine.GetEntityManager()->HasComponent(entity, ComponentType::TRANSFORM2D))
 			m_Engine.GetTransform2dManager()->AddComponent(entity);
 
-		if (CheckJsonExists(tilemapJson, "is_isometric") && CheckJsonParameter(tilemapJson, "is_isometric", nlohmann::detail::value_t::boolean))
+		if (CheckJsonParameter(tilemapJson, "is_isometric", nlohmann::detail::value_t::boolean))
 		{
 			newTilemap.SetIsometric(tilemapJson["is_isometric"].get<bool>());
 		}
 		
-		if (CheckJsonExists(tilemapJson, "layer") && CheckJsonParameter(tilemapJson, "layer", nlohmann::detail::value_t::number_integer))
+		if (CheckJsonParameter(tilemapJson, "layer", nlohmann::detail::value_t::number_integer))
 		{
 			newTilemap.SetLayer(tilemapJson["layer"].get<int>());
 		}
 
-		if (CheckJsonExists(tilemapJson, "tile_size") && CheckJsonParameter(tilemapJson, "tile_size", nlohmann::detail::value_t::array))
+		if (CheckJsonParameter(tilemapJson, "tile_size", nlohmann::detail::value_t::array))
 		{
 			Vec2f tileSize = Vec2f();
 			tileSize.x = tilemapJson["tile_size"][0].get<unsigned>();
@@ -382,7 +430,7 @@ namespace sfge
 			newTilemap.SetTileSize(tileSize);
 		}
 
-		if (CheckJsonExists(tilemapJson, "map_size") && CheckJsonParameter(tilemapJson, "map_size", nlohmann::detail::value_t::array))
+		if (CheckJsonParameter(tilemapJson, "map_size", nlohmann::detail::value_t::array))
 		{
 			Vec2f mapSize = Vec2f();
 			mapSize.x = tilemapJson["map_size"][0].get<unsigned>();
@@ -390,14 +438,13 @@ namespace sfge
 			newTilemap.ResizeTilemap(mapSize);
 		}
 
-		if(CheckJsonExists(tilemapJson, "map") && CheckJsonParameter(tilemapJson, "map", nlohmann::detail::value_t::array))
+		if (!tilemapData.tileTypeIds.empty())
 		{
-			InitializeMap(entity, tilemapJson["map"]);
+			InitializeMap(entity, tilemapData.tileTypeIds, tilemapData.mapSize);
 		}
 
 		m_Tilemaps.push_back(entity - 1);
-		m_ConcernedEntities.push_back(entity);
-		UpdateDrawOrderTilemaps();
+		AddConcernedEntity(entity);
 	}
 
 	void TilemapManager::UpdateTile(Entity tilemapEntity, Vec2f pos, TileTypeId tileTypeId)
@@ -418,22 +465,35 @@ namespace sfge
 		m_ComponentsInfo.resize(new_size);
 	}
 
+	void TilemapManager::LinkComponentInfo(size_t index)
+	{
+		m_ComponentsInfo[index].tilemap = &m_Components[index];
+	}
+
 	void TilemapManager::InitializeMap(Entity entity, json & map)
+	{
+		std::vector<TileTypeId> tiletypeIds;
+		Vec2f mapSize;
+		if (DecodeTileTypes(map, tiletypeIds, mapSize))
+			InitializeMap(entity, tiletypeIds, mapSize);
+	}
+
+	bool TilemapManager::DecodeTileTypes(const json& map, std::vector<TileTypeId>& tileTypeIds, Vec2f& mapSize)
 	{
 		if (map.empty())
-			return;
+			return false;
 
-		std::vector<TileTypeId> tiletypeIds = std::vector<TileTypeId>(map.size() * map[0].size(), INVALID_TILE_TYPE);
+		tileTypeIds = std::vector<TileTypeId>(map.size() * map[0].size(), INVALID_TILE_TYPE);
 
-		Vec2f mapSize = Vec2f(map.size(), map[0].size());
+		mapSize = Vec2f(map.size(), map[0].size());
 		for (unsigned indexY = 0; indexY < mapSize.y; indexY++)
 		{
 			for (unsigned indexX = 0; indexX < mapSize.x; indexX++)
 			{
-				tiletypeIds[indexY * mapSize.x + indexX] = map[indexY][indexX].get<int>();
+				tileTypeIds[indexY * mapSize.x + indexX] = map[indexY][indexX].get<int>();
 			}
 		}
-		InitializeMap(entity, tiletypeIds, mapSize);
+		return true;
 	}
 
 	void TilemapManager::InitializeMap(Entity entity, std::vector<TileTypeId> tileTypeIds, Vec2f tilemapSize)
@@ -466,7 +526,7 @@ namespace sfge
 		const Vec2f mapSize = tilemap.GetTilemapSize();
 		const auto& tiles = tilemap.GetTiles();
 
-		const Vec2f basePos = m_Engine.GetTransform2dManager()->GetComponentPtr(entity)->Position;
+		const Vec2f basePos = m_Engine.GetTransform2dManager()->GetLocalTransform(entity).Position;
 		const Vec2f tileSize = tilemap.GetTileSize();
 		Vec2f xPos, yPos;
 
@@ -514,7 +574,7 @@ namespace sfge
 		const sf::Vector2i worldPosSf = m_Engine.GetInputManager()->GetMouseManager().GetWorldPosition();
 		Vec2f worldPos = Vec2f(worldPosSf.x, worldPosSf.y);
 
-		Vec2f tilemapPos = m_Engine.GetTransform2dManager()->GetComponentPtr(entity)->Position;
+		Vec2f tilemapPos = m_Engine.GetTransform2dManager()->GetLocalTransform(entity).Position;
 		const Vec2f mapSize = tilemap.GetTilemapSize();
 
 		const Vec2f tileSize = tilemap.GetTileSize();
@@ -586,6 +646,11 @@ namespace sfge
 		m_TilemapManager.Draw(window);
 	}
 
+	void TilemapSystem::TakeSnapshot(RenderSnapshot& snapshot)
+	{
+		m_TilemapManager.TakeSnapshot(snapshot);
+	}
+
 	void TilemapSystem::Destroy()
 	{
 		Clear();
@@ -604,6 +669,12 @@ namespace sfge
 		m_TilemapManager.Collect();
 	}
 
+	void TilemapSystem::ReportMemory(MemoryReport& report) const
+	{
+		report.SetSystem("TilemapManager");
+		m_TilemapManager.ReportMemory(report);
+	}
+
 	json TilemapSystem::Save()
 	{
 		json j;
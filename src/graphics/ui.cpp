@@ -36,6 +36,9 @@ namespace  sfge
 		m_ButtonManager.Init();
 		m_TextManager.Init();
 		m_ImageManager.Init();
+		DeclareAccess(0, 0);
+		AddAccess(m_TextManager.GetAccess());
+		AddAccess(m_ImageManager.GetAccess());
 	}
 
 	void UIManager::Update(float dt)
@@ -64,4 +67,14 @@ namespace  sfge
 	{
 		return &m_ImageManager;
 	}
+
+	void UIManager::ReportMemory(MemoryReport& report) const
+	{
+		report.SetSystem("ButtonManager");
+		m_ButtonManager.ReportMemory(report);
+		report.SetSystem("TextManager");
+		m_TextManager.ReportMemory(report);
+		report.SetSystem("ImageManager");
+		m_ImageManager.ReportMemory(report);
+	}
 }
@@ -45,6 +45,8 @@ MouseManager& InputManager::GetMouseManager()
 
 void InputManager::Init()
 {
+	//The mouse position is read from the window
+	DeclareAccess(0, 0, static_cast<int>(SystemResource::WINDOW));
 }
 
 void InputManager::Update(float dt)
@@ -113,12 +115,17 @@ void MouseManager::Update(float dt)
 		}
 		*/
 	}
+	//The input phase runs before the simulation, while the window is not drawn
+	if (auto* window = m_Engine.GetGraphics2dManager()->GetWindow())
+	{
+		const sf::Vector2i pixelPos = sf::Mouse::getPosition(*window);
+		m_LocalPosition = window->mapPixelToCoords(pixelPos);
+	}
 }
 
 sf::Vector2f MouseManager::GetLocalPosition() const
 {
-	sf::Vector2i pixelPos = sf::Mouse::getPosition(*m_Engine.GetGraphics2dManager()->GetWindow());
-	return m_Engine.GetGraphics2dManager()->GetWindow()->mapPixelToCoords(pixelPos);
+	return m_LocalPosition;
 }
 sf::Vector2i MouseManager::GetWorldPosition() const
 {
@@ -112,18 +112,18 @@ void editor::Body2dInfo::DrawOnInspector()
 		ImGui::InputFloat2("Velocity", velocity);
 		if (ImGui::IsItemHovered())
 		{
-			auto& velocities = m_Velocities;
-			std::vector<float> xValues(velocities.size());
-			std::vector<float> yValues(velocities.size());
-			for (auto vIndex = 0u; vIndex < velocities.size(); vIndex++)
-			{
-				xValues[vIndex] = velocities[vIndex].x;
-				yValues[vIndex] = velocities[vIndex].y;
-			}
-			//Plot last second velocities
+			//Plot last second velocities, read from the deque without copying them
+			auto* velocities = &m_Velocities;
+			const auto velocityNmb = static_cast<int>(m_Velocities.size());
 			ImGui::BeginTooltip();
-			ImGui::PlotLines("X", &xValues[0], xValues.size(), 0, "", -10.0f, 10.0f, ImVec2(0, 120));
-			ImGui::PlotLines("Y", &yValues[0], yValues.size(), 0, "", -10.0f, 10.0f, ImVec2(0, 120));
+			ImGui::PlotLines("X", [](void* data, int index)
+			{
+				return (*static_cast<std::deque<b2Vec2>*>(data))[index].x;
+			}, velocities, velocityNmb, 0, "", -10.0f, 10.0f, ImVec2(0, 120));
+			ImGui::PlotLines("Y", [](void* data, int index)
+			{
+				return (*static_cast<std::deque<b2Vec2>*>(data))[index].y;
+			}, velocities, velocityNmb, 0, "", -10.0f, 10.0f, ImVec2(0, 120));
 			ImGui::EndTooltip();
 		}
 	}
@@ -150,21 +150,20 @@ void Body2dManager::Init()
 	SingleComponentManager::Init();
 	m_Transform2dManager = m_Engine.GetTransform2dManager();
 	m_WorldPtr = m_Engine.GetPhysicsManager()->GetWorld();
+	DeclareAccess(static_cast<int>(ComponentType::BODY2D), static_cast<int>(ComponentType::TRANSFORM2D));
 }
 
 void Body2dManager::FixedUpdate()
 {
-	for (auto i = 0u; i < m_Components.size(); i++)
+	//The velocity history is only drawn by the inspector
+	const bool recordVelocities = m_Engine.GetConfig()->editor;
+	for (Entity entity : m_EntityManager->View<Body2d, Transform2d>())
 	{
-		const Entity entity = i + 1;
-		if (m_EntityManager->HasComponent(entity, ComponentType::BODY2D) &&
-			m_EntityManager->HasComponent(entity, ComponentType::TRANSFORM2D))
-		{
-			auto & transform = m_Transform2dManager->GetComponentRef(entity);
-			auto & body2d = GetComponentRef(entity);
-			m_ComponentsInfo[i].AddVelocity(body2d.GetLinearVelocity());
-			transform.Position = meter2pixel(body2d.GetBody()->GetPosition()) - static_cast<sf::Vector2f>(body2d.GetOffset());
-		}
+		auto & transform = m_Transform2dManager->GetComponentRef(entity);
+		auto & body2d = GetComponentRef(entity);
+		if (recordVelocities)
+			m_ComponentsInfo[entity - 1].AddVelocity(body2d.GetLinearVelocity());
+		transform.Position = meter2pixel(body2d.GetBody()->GetPosition()) - static_cast<sf::Vector2f>(body2d.GetOffset());
 	}
 }
 
@@ -183,11 +182,6 @@ Body2d* Body2dManager::AddComponent(Entity entity)
 		m_Components[entity - 1] = Body2d(transform, sf::Vector2f());
 		m_Components[entity - 1].SetBody(body);
 
-		auto& componentInfo = m_ComponentsInfo[entity-1];
-		componentInfo.body = &m_Components[entity - 1];
-		componentInfo.name = "Body";
-		componentInfo.SetEntity(entity);
-
 		m_EntityManager->AddComponentType(entity, ComponentType::BODY2D);
 		return &m_Components[entity - 1];
 	}
@@ -219,7 +213,6 @@ void Body2dManager::CreateComponent(json& componentJson, Entity entity)
 		auto* body = world->CreateBody(&bodyDef);
 		m_Components[entity - 1] = Body2d(transform, offset);
 		m_Components[entity - 1].SetBody(body);
-		m_ComponentsInfo[entity - 1].body = &m_Components[entity - 1];
 	}
 }
 
@@ -234,5 +227,12 @@ void Body2dManager::OnResize(size_t new_size)
 	m_Components.resize(new_size);
 	m_ComponentsInfo.resize(new_size);
 }
+
+void Body2dManager::LinkComponentInfo(size_t index)
+{
+	auto& componentInfo = m_ComponentsInfo[index];
+	componentInfo.body = &m_Components[index];
+	componentInfo.name = "Body";
+}
 }
 
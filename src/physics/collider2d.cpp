@@ -70,76 +70,100 @@ void ColliderManager::CreateComponent(json& componentJson, Entity entity)
 	Log::GetInstance()->Msg("Create component Collider");
 	if (m_EntityManager->HasComponent(entity, ComponentType::BODY2D))
 	{
-		auto & body = m_BodyManager->GetComponentRef(entity);
-
-		b2FixtureDef fixtureDef;
-
-		if (CheckJsonExists(componentJson, "sensor"))
-		{
-			fixtureDef.isSensor = componentJson["sensor"];
-		}
+		CreateCollider(entity, ReadColliderJson(componentJson));
+	}
+}
 
-		std::unique_ptr<b2Shape> shape = nullptr;
+ColliderDef ColliderManager::ReadColliderJson(const json& componentJson)
+{
+	ColliderDef colliderDef;
+	auto& fixtureDef = colliderDef.fixtureDef;
+	if (CheckJsonExists(componentJson, "sensor"))
+	{
+		fixtureDef.isSensor = componentJson["sensor"];
+	}
 
-		if (CheckJsonExists(componentJson, "collider_type"))
+	if (CheckJsonExists(componentJson, "collider_type"))
+	{
+		ColliderType colliderType = static_cast<ColliderType>(componentJson["collider_type"]);
+		switch (colliderType)
 		{
-			ColliderType colliderType = static_cast<ColliderType>(componentJson["collider_type"]);
-			switch (colliderType)
+		case ColliderType::CIRCLE:
+			colliderDef.shape = std::make_shared<b2CircleShape>();
+			if (CheckJsonNumber(componentJson, "radius"))
 			{
-			case ColliderType::CIRCLE:
-				shape = std::make_unique<b2CircleShape>();
-				if (CheckJsonNumber(componentJson, "radius"))
-				{
-					shape->m_radius = pixel2meter(static_cast<float>(componentJson["radius"]));
-				}
-				break;
-			case ColliderType::BOX:
+				colliderDef.shape->m_radius = pixel2meter(static_cast<float>(componentJson["radius"]));
+			}
+			break;
+		case ColliderType::BOX:
+		{
+			auto boxShape = std::make_shared<b2PolygonShape>();
+			if (CheckJsonExists(componentJson, "size"))
 			{
-				auto boxShape = std::make_unique<b2PolygonShape>();
-				if (CheckJsonExists(componentJson, "size"))
+				auto size = pixel2meter(GetVectorFromJson(componentJson, "size"));
 				{
-					auto size = pixel2meter(GetVectorFromJson(componentJson, "size"));
-					{
-						std::ostringstream oss;
-						oss << "Box physics size: " << size.x << ", " << size.y;
-						Log::GetInstance()->Msg(oss.str());
-					}
-					boxShape->SetAsBox(size.x / 2.0f, size.y / 2.0f);
+					std::ostringstream oss;
+					oss << "Box physics size: " << size.x << ", " << size.y;
+					Log::GetInstance()->Msg(oss.str());
 				}
-				shape = std::move(boxShape);
-			}	
-			break;
-			default:
-			{
-				std::ostringstream oss;
-				oss << "[Error] Collider of type: " << static_cast<int>(colliderType) << " could not be loaded from json: " << componentJson;
-				Log::GetInstance()->Error(oss.str());
+				boxShape->SetAsBox(size.x / 2.0f, size.y / 2.0f);
 			}
-				break;
-			}
-		}
-		if(CheckJsonNumber(componentJson, "bouncing"))
+			colliderDef.shape = std::move(boxShape);
+		}	
+		break;
+		default:
 		{
-			fixtureDef.restitution = componentJson["bouncing"];
+			std::ostringstream oss;
+			oss << "[Error] Collider of type: " << static_cast<int>(colliderType) << " could not be loaded from json: " << componentJson;
+			Log::GetInstance()->Error(oss.str());
 		}
-		if (shape)
-		{
-			fixtureDef.shape = shape.get();
+			break;
+		}
+	}
+	if(CheckJsonNumber(componentJson, "bouncing"))
+	{
+		fixtureDef.restitution = componentJson["bouncing"];
+	}
+	fixtureDef.shape = colliderDef.shape.get();
+	return colliderDef;
+}
 
-			auto index = GetFreeComponentIndex();
-			if(index != -1)
-			{
-				auto fixture = body.GetBody()->CreateFixture(&fixtureDef);
+void ColliderManager::CreateCollider(Entity entity, const ColliderDef& colliderDef)
+{
+	if (!colliderDef.shape)
+		return;
+	auto & body = m_BodyManager->GetComponentRef(entity);
+	auto index = GetFreeComponentIndex();
+	if(index != -1)
+	{
+		auto fixture = body.GetBody()->CreateFixture(&colliderDef.fixtureDef);
 
 
-				ColliderData& colliderData = m_Components[index];
-				colliderData.entity = entity;
-				colliderData.fixture = fixture;
-				colliderData.body = body.GetBody();
-				m_ComponentsInfo[index].data = &colliderData;
-				m_ComponentsInfo[index].SetEntity(entity);
-				fixture->SetUserData(&colliderData);
-			}
+		ColliderData& colliderData = m_Components[index];
+		colliderData.entity = entity;
+		colliderData.fixture = fixture;
+		colliderData.body = body.GetBody();
+		fixture->SetUserData(&colliderData);
+	}
+}
+
+void ColliderManager::ResolvePrefabComponent(PrefabComponent& prefabComponent)
+{
+	prefabComponent.resolvedData = ReadColliderJson(prefabComponent.componentJson);
+}
+
+void ColliderManager::InstantiatePrefabComponents(const PrefabComponent& prefabComponent,
+	const std::vector<Entity>& entities, const std::vector<Vec2f>& positions)
+{
+	(void) positions;
+	const auto* colliderDef = std::any_cast<ColliderDef>(&prefabComponent.resolvedData);
+	if (colliderDef == nullptr)
+		return;
+	for (Entity entity : entities)
+	{
+		if (m_EntityManager->HasComponent(entity, ComponentType::BODY2D))
+		{
+			CreateCollider(entity, *colliderDef);
 		}
 	}
 }
@@ -167,4 +191,19 @@ ColliderData *ColliderManager::GetComponentPtr(Entity entity)
 	(void)entity;
 	return nullptr;
 }
+
+void ColliderManager::DrawOnInspector(Entity entity)
+{
+	if (!m_EntityManager->HasComponent(entity, ComponentType::COLLIDER2D))
+		return;
+	for (auto i = 0u; i < m_Components.size(); i++)
+	{
+		if (m_Components[i].entity != entity)
+			continue;
+		auto& colliderInfo = m_ComponentsInfo[i];
+		colliderInfo.data = &m_Components[i];
+		colliderInfo.SetEntity(entity);
+		colliderInfo.DrawOnInspector();
+	}
+}
 }
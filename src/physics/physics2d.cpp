@@ -43,6 +43,10 @@ void Physics2dManager::Init()
 
 	m_BodyManager.Init();
 	m_ColliderManager.Init();
+	//The step moves the bodies of the colliders and the contact listener runs the PyComponent callbacks
+	DeclareAccess(static_cast<int>(ComponentType::BODY2D) | static_cast<int>(ComponentType::COLLIDER2D), static_cast<int>(ComponentType::BODY2D));
+	AddAccess(m_BodyManager.GetAccess());
+	AddAccess(m_Engine.GetPythonEngine()->GetPyComponentManager().GetAccess());
 }
 
 void Physics2dManager::Update(float dt)
@@ -92,6 +96,46 @@ void Physics2dManager::Collect()
 {
 }
 
+void Physics2dManager::ReportMemory(MemoryReport& report) const
+{
+	report.SetSystem("Body2dManager");
+	m_BodyManager.ReportMemory(report);
+	report.SetSystem("ColliderManager");
+	m_ColliderManager.ReportMemory(report);
+	report.SetSystem("Physics2dManager");
+	if (m_World == nullptr)
+		return;
+	//The b2BlockAllocator is private, its usage is estimated from the objects it holds
+	size_t worldBytes = sizeof(b2World);
+	for (const b2Body* body = m_World->GetBodyList(); body != nullptr; body = body->GetNext())
+	{
+		worldBytes += sizeof(b2Body);
+		for (const b2Fixture* fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext())
+		{
+			worldBytes += sizeof(b2Fixture) + sizeof(b2FixtureProxy);
+			switch (fixture->GetType())
+			{
+			case b2Shape::e_circle:
+				worldBytes += sizeof(b2CircleShape);
+				break;
+			case b2Shape::e_edge:
+				worldBytes += sizeof(b2EdgeShape);
+				break;
+			case b2Shape::e_chain:
+				worldBytes += sizeof(b2ChainShape);
+				break;
+			default:
+				worldBytes += sizeof(b2PolygonShape);
+				break;
+			}
+		}
+	}
+	worldBytes += static_cast<size_t>(m_World->GetContactCount()) * sizeof(b2Contact);
+	worldBytes += static_cast<size_t>(m_World->GetJointCount()) * sizeof(b2RevoluteJoint);
+	worldBytes += static_cast<size_t>(m_World->GetProxyCount()) * sizeof(b2TreeNode);
+	report.AddExternal("b2World", worldBytes);
+}
+
 
 Body2dManager* Physics2dManager::GetBodyManager()
 {
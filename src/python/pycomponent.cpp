@@ -23,6 +23,7 @@
  */
 
 #include <sstream>
+#include <algorithm>
 
 #include <python/pycomponent.h>
 #include <python/python_engine.h>
@@ -377,17 +378,29 @@ InstanceId PyComponentManager::LoadPyComponent(ModuleId moduleId, Entity entity)
 
 std::list<editor::PyComponentInfo> PyComponentManager::GetPyComponentsInfoFromEntity(Entity entity)
 {
+	//The infos are only written with their component, the components tell which slots to read
 	std::list<editor::PyComponentInfo> pyComponentInfos;
-	for(auto& pyInfo : m_ComponentsInfo)
+	for(auto i = 0u; i < m_Components.size(); i++)
 	{
-		if(pyInfo.pyComponent != nullptr && pyInfo.pyComponent->GetEntity() == entity)
+		if(m_Components[i] != nullptr && m_Components[i]->GetEntity() == entity)
 		{
-			pyComponentInfos.push_back(pyInfo);
+			pyComponentInfos.push_back(m_ComponentsInfo[i]);
 		}
 	}
 	return pyComponentInfos;
 }
 
+void PyComponentManager::DrawOnInspector(Entity entity)
+{
+	for(auto i = 0u; i < m_Components.size(); i++)
+	{
+		if(m_Components[i] != nullptr && m_Components[i]->GetEntity() == entity)
+		{
+			m_ComponentsInfo[i].DrawOnInspector();
+		}
+	}
+}
+
 
 
 PyBehavior* PyComponentManager::GetPyComponentFromInstanceId(InstanceId instanceId)
@@ -506,6 +519,9 @@ void PyComponentManager::Init()
 {
 	MultipleComponentManager::Init();
 	m_PythonEngine = m_Engine.GetPythonEngine();
+	//The scripts reach every manager through the SFGE module
+	DeclareAccess(SystemAccess::ALL_COMPONENTS, SystemAccess::ALL_COMPONENTS,
+		static_cast<int>(SystemResource::PYTHON) | static_cast<int>(SystemResource::ENTITIES));
 }
 
 void PyComponentManager::CreateComponent(json &componentJson, Entity entity)
@@ -523,12 +539,68 @@ void PyComponentManager::CreateComponent(json &componentJson, Entity entity)
 	}
 }
 
+void PyComponentManager::ResolvePrefabComponent(PrefabComponent& prefabComponent)
+{
+	auto& componentJson = prefabComponent.componentJson;
+	if (CheckJsonExists(componentJson, "script_path"))
+	{
+		const ModuleId moduleId = m_PythonEngine->LoadPyModule(componentJson["script_path"].get<std::string>());
+		if (moduleId != INVALID_MODULE)
+			prefabComponent.resolvedData = moduleId;
+	}
+}
+
+void PyComponentManager::InstantiatePrefabComponents(const PrefabComponent& prefabComponent,
+	const std::vector<Entity>& entities, const std::vector<Vec2f>& positions)
+{
+	(void) positions;
+	const auto* moduleId = std::any_cast<ModuleId>(&prefabComponent.resolvedData);
+	if (moduleId == nullptr)
+		return;
+	for (Entity entity : entities)
+	{
+		LoadPyComponent(*moduleId, entity);
+	}
+}
+
 void PyComponentManager::DestroyComponent(Entity entity)
 {
 	RemoveConcernedEntity(entity);
 	RemovePyComponentsFrom(entity);
 }
 
+void PyComponentManager::DestroyComponents(const std::vector<Entity>& entities)
+{
+	//One pass over the components and the instances for the whole batch
+	EntityBitset destroyedEntities;
+	for (Entity entity : entities)
+	{
+		RemoveConcernedEntity(entity);
+		destroyedEntities.Set(entity);
+	}
+	for (auto& pyComponent : m_Components)
+	{
+		if (pyComponent != nullptr && destroyedEntities.Test(pyComponent->GetEntity()))
+		{
+			pyComponent = nullptr;
+		}
+	}
+	m_PythonInstances.erase(std::remove_if(m_PythonInstances.begin(), m_PythonInstances.end(), [&destroyedEntities](py::object& pyInstance)
+	{
+		if (pyInstance.is_none() || pyInstance.ptr() == nullptr)
+			return false;
+		try
+		{
+			auto* pyBehavior = pyInstance.cast<PyBehavior*>();
+			return pyBehavior != nullptr && destroyedEntities.Test(pyBehavior->GetEntity());
+		}
+		catch (py::cast_error&)
+		{
+			return false;
+		}
+	}), m_PythonInstances.end());
+}
+
 PyBehavior **PyComponentManager::AddComponent(Entity entity)
 {
 	(void) entity;
@@ -542,18 +614,24 @@ PyBehavior **PyComponentManager::GetComponentPtr(Entity entity)
 }
 void PyComponentManager::InitPyComponents()
 {
+	m_Paused = false;
 	for (auto* pyComponent : m_Components)
 	{
 		if(pyComponent != nullptr)
 			pyComponent->Init();
 	}
 }
+void PyComponentManager::PauseUntilInit()
+{
+	m_Paused = true;
+}
+
 void PyComponentManager::Destroy()
 {
 	System::Destroy();
 	m_Components.clear();
 	m_ComponentsInfo.clear();
-	m_ConcernedEntities.clear();
+	ClearConcernedEntities();
 	m_PythonInstances.clear();
 }
 
@@ -580,6 +658,8 @@ void PyComponentManager::FixedUpdate()
 	System::FixedUpdate();
 
 	rmt_ScopedCPUSample(PyComponentFixedUpdate,0);
+	if (m_Paused)
+		return;
 
 	auto config = m_Engine.GetConfig();
 
@@ -596,6 +676,8 @@ void PyComponentManager::Update(float dt)
 	System::Update(dt);
 
 	rmt_ScopedCPUSample(PyComponentUpdate,0);
+	if (m_Paused)
+		return;
 	for (auto* pyComponent : m_Components)
 	{
 		if (pyComponent != nullptr)
@@ -609,4 +691,10 @@ void PyComponentManager::OnResize(size_t newSize)
 	MultipleComponentManager::OnResize(newSize);
 	m_PythonInstances.resize(newSize);
 }
+
+void PyComponentManager::ReportMemory(MemoryReport& report) const
+{
+	MultipleComponentManager::ReportMemory(report);
+	report.AddContainer("PythonInstances", m_PythonInstances);
+}
 }
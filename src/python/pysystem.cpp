@@ -15,6 +15,12 @@
 namespace sfge
 {
 
+PySystem::PySystem(Engine& engine) : System(engine)
+{
+	DeclareAccess(SystemAccess::ALL_COMPONENTS, SystemAccess::ALL_COMPONENTS,
+		static_cast<int>(SystemResource::PYTHON) | static_cast<int>(SystemResource::ENTITIES));
+}
+
 void PySystem::Init()
 {
 	try
@@ -212,4 +218,11 @@ PySystem *PySystemManager::GetPySystemFromClassName(std::string className)
 	}
 	return nullptr;
 }
+
+void PySystemManager::ReportMemory(MemoryReport& report) const
+{
+	report.AddContainer("PySystems", m_PySystems);
+	report.AddContainer("PySystemNames", m_PySystemNames);
+	report.AddContainer("PythonInstances", m_PythonInstances);
+}
 }
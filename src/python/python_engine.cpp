@@ -82,12 +82,44 @@ PYBIND11_EMBEDDED_MODULE(SFGE, m)
 		.def("init", &System::Init)
 		.def("update", &System::Update)
 		.def("fixed_update", &System::FixedUpdate)
-		.def("draw", &System::Draw);
+		.def("draw", &System::Draw)
+		.def("set_tick_rate", &PySystem::SetTickRate)
+		.def("set_stagger_frame_nmb", &PySystem::SetStaggerFrameNmb)
+		.def("declare_access", [](System& system, int readComponents, int writeComponents)
+		{
+			//Python systems always hold the GIL while they run
+			static_cast<PySystem&>(system).DeclareAccess(readComponents, writeComponents,
+				static_cast<int>(SystemResource::PYTHON));
+		})
+		.def("get_stagger_range", [](const System& system, size_t count)
+		{
+			const auto range = GetStaggerRange(count, system.GetTickPolicy().staggerFrameNmb,
+				system.GetTickState().staggerFrame);
+			return std::make_pair(range.begin, range.end);
+		});
+
+	py::class_<Prefab> prefab(m, "Prefab");
+	prefab
+		.def_readonly("name", &Prefab::name);
 
 	py::class_<SceneManager> sceneManager(m, "SceneManager");
 	sceneManager
 		.def(py::init<Engine&>(), py::return_value_policy::reference)
 		.def("load_scene", &SceneManager::LoadSceneFromName)
+		.def("load_scene_async", &SceneManager::LoadSceneFromNameAsync)
+		.def("is_loading_scene", &SceneManager::IsLoadingScene)
+		.def("get_loading_progress", &SceneManager::GetLoadingProgress)
+		.def("load_prefab", &SceneManager::LoadPrefab, py::return_value_policy::reference)
+		.def("instantiate_prefab", [](SceneManager* sceneManager, const Prefab& prefab, const std::vector<Vec2f>& positions)
+		{
+			const auto range = sceneManager->InstantiatePrefab(prefab, positions);
+			std::vector<Entity> entities(range.size());
+			for (size_t i = 0; i < range.size(); i++)
+			{
+				entities[i] = range[i];
+			}
+			return entities;
+		})
 		.def("get_scenes", &SceneManager::GetAllScenes);
 
 	py::class_<CameraManager> cameraManager(m, "CameraManager");
@@ -144,13 +176,19 @@ PYBIND11_EMBEDDED_MODULE(SFGE, m)
 	transform2dManager
 	    .def(py::init<Engine&>(), py::return_value_policy::reference)
 		.def("add_component", &Transform2dManager::AddComponent, py::return_value_policy::reference)
-	    .def("get_component", &Transform2dManager::GetComponentRef, py::return_value_policy::reference);
+	    .def("get_component", &Transform2dManager::GetComponentRef, py::return_value_policy::reference)
+		.def("set_parent", &Transform2dManager::SetParent)
+		.def("get_parent", &Transform2dManager::GetParent)
+		.def("get_world_transform", &Transform2dManager::GetWorldTransform, py::return_value_policy::reference);
 
 	py::class_<EntityManager> entityManager(m, "EntityManager");
 	entityManager
 	    .def(py::init<Engine&>(), py::return_value_policy::reference)
 	    .def("create_entity", &EntityManager::CreateEntity)
 	    .def("destroy_entity", &EntityManager::DestroyEntity)
+	    .def("is_alive", &EntityManager::IsAlive)
+	    .def("get_entity_handle", &EntityManager::GetEntityHandle)
+	    .def("get_entity_from_handle", &EntityManager::GetEntityFromHandle)
 	    .def("has_component", &EntityManager::HasComponent)
 		.def("resize", &EntityManager::ResizeEntityNmb);
 
@@ -471,6 +509,8 @@ void PythonEngine::Init()
 	System::Init();
 	m_PyComponentManager.Init();
 	m_PySystemManager.Init();
+	DeclareAccess(0, 0, static_cast<int>(SystemResource::PYTHON));
+	AddAccess(m_PyComponentManager.GetAccess());
 
 	py::initialize_interpreter();
 	//Adding reference to c++ engine modules
@@ -615,6 +655,18 @@ void PythonEngine::Collect()
 {
 }
 
+void PythonEngine::ReportMemory(MemoryReport& report) const
+{
+	report.AddContainer("PythonModulePaths", m_PythonModulePaths);
+	report.AddContainer("PyClassNames", m_PyClassNames);
+	report.AddContainer("PyModuleNames", m_PyModuleNames);
+	report.AddContainer("PyModuleObjs", m_PyModuleObjs);
+	report.SetSystem("PyComponentManager");
+	m_PyComponentManager.ReportMemory(report);
+	report.SetSystem("PySystemManager");
+	m_PySystemManager.ReportMemory(report);
+}
+
 void PythonEngine::LoadScripts(std::string dirname)
 {
 	std::function<void(std::string)> LoadAllPyModules;
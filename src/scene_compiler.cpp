@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include <engine/scene_binary.h>
+#include <utility/file_utility.h>
+#include <utility/log.h>
+
+/**
+ * \brief Compile a .scene, or every .scene under a directory, next to its source
+ */
+bool CompileScenePath(std::string path, size_t& sceneNmb)
+{
+	if (sfge::IsDirectory(path))
+	{
+		bool success = true;
+		std::function<void(std::string)> compileEntry = [&](std::string entry)
+		{
+			if (sfge::IsDirectory(entry))
+			{
+				sfge::IterateDirectory(entry, compileEntry);
+			}
+			else if (entry.size() > 6 && entry.compare(entry.size() - 6, 6, ".scene") == 0)
+			{
+				success = CompileScenePath(entry, sceneNmb) && success;
+			}
+		};
+		sfge::IterateDirectory(path, compileEntry);
+		return success;
+	}
+	if (!sfge::IsRegularFile(path))
+	{
+		std::ostringstream oss;
+		oss << "[Error] No scene at " << path;
+		sfge::Log::GetInstance()->Error(oss.str());
+		return false;
+	}
+	sceneNmb++;
+	return sfge::CompileSceneFile(path, sfge::GetCompiledScenePath(path));
+}
+
+/**
+ * \brief SFGE_SCENE_COMPILER path...
+ * Offline conversion of the json scenes to the memory mapped binary layout loaded by SceneManager::LoadSceneFromPath
+ */
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		sfge::Log::GetInstance()->Error("[Error] Usage: SFGE_SCENE_COMPILER <scene file or directory>...");
+		return EXIT_FAILURE;
+	}
+	bool success = true;
+	size_t sceneNmb = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		success = CompileScenePath(argv[i], sceneNmb) && success;
+	}
+	std::ostringstream oss;
+	oss << "Compiled " << sceneNmb << " scenes";
+	sfge::Log::GetInstance()->Msg(oss.str());
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
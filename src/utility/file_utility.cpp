@@ -23,8 +23,23 @@
  */
 #include <utility/file_utility.h>
 
+#ifdef WIN32
+#define NOMINMAX
+#include <windows.h>
+//The sfge functions share these names
+#undef CreateDirectory
+#undef RemoveDirectory
+#undef CopyFile
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #ifdef __APPLE__
 
+#include <ctime>
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
 #else
@@ -86,4 +101,125 @@ bool CopyFile(const std::string& source, const std::string& destination)
 {
 	return fs::copy_file(source, destination);
 }
+
+std::int64_t GetFileWriteTime(const std::string& filename)
+{
+#ifdef __APPLE__
+	//boost::filesystem takes its own error_code and returns a time_t
+	boost::system::error_code error;
+	const std::time_t writeTime = fs::last_write_time(fs::path(filename), error);
+	if (error)
+		return 0;
+	return static_cast<std::int64_t>(writeTime);
+#else
+	std::error_code error;
+	const auto writeTime = fs::last_write_time(fs::path(filename), error);
+	if (error)
+		return 0;
+	return static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+#endif
+}
+
+std::uint64_t GetFileSize(const std::string& filename)
+{
+#ifdef __APPLE__
+	boost::system::error_code error;
+#else
+	std::error_code error;
+#endif
+	const auto fileSize = fs::file_size(fs::path(filename), error);
+	if (error)
+		return 0;
+	return static_cast<std::uint64_t>(fileSize);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+	Close();
+#ifdef WIN32
+	m_File = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_File == INVALID_HANDLE_VALUE)
+	{
+		m_File = nullptr;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_Mapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+	m_Data = static_cast<const std::byte*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	const int file = open(filename.c_str(), O_RDONLY);
+	if (file < 0)
+		return false;
+	struct stat fileStat{};
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+	void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	//The mapping keeps its own reference to the file
+	close(file);
+	if (data == MAP_FAILED)
+		return false;
+	m_Data = static_cast<const std::byte*>(data);
+	m_Size = static_cast<size_t>(fileStat.st_size);
+#endif
+	if (m_Data == nullptr)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef WIN32
+	if (m_Data != nullptr)
+		UnmapViewOfFile(m_Data);
+	if (m_Mapping != nullptr)
+		CloseHandle(m_Mapping);
+	if (m_File != nullptr)
+		CloseHandle(m_File);
+	m_Mapping = nullptr;
+	m_File = nullptr;
+#else
+	if (m_Data != nullptr)
+		munmap(const_cast<std::byte*>(m_Data), m_Size);
+#endif
+	m_Data = nullptr;
+	m_Size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_Data != nullptr;
+}
+
+const std::byte* MappedFile::GetData() const
+{
+	return m_Data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_Size;
+}
 }
@@ -38,24 +38,24 @@ bool IsJsonValueNumeric(const json::value_type & jsonValue)
 		   jsonValue.type() == json::value_t::number_unsigned;
 }
 
-bool CheckJsonExists(const json & jsonObject, std::string parameterName)
+bool CheckJsonExists(const json & jsonObject, const std::string& parameterName)
 {
 	return jsonObject.find(parameterName) != jsonObject.end();
 }
 
-bool CheckJsonParameter(const json& jsonObject, std::string parameterName, json::value_t expectedType)
+bool CheckJsonParameter(const json& jsonObject, const std::string& parameterName, json::value_t expectedType)
 {
-	return CheckJsonExists(jsonObject, parameterName) && jsonObject[parameterName].type() == expectedType;
+	const auto it = jsonObject.find(parameterName);
+	return it != jsonObject.end() && it->type() == expectedType;
 }
 
-bool CheckJsonNumber(const json& jsonObject, std::string parameterName)
+bool CheckJsonNumber(const json& jsonObject, const std::string& parameterName)
 {
-	return CheckJsonParameter(jsonObject, parameterName, json::value_t::number_float) or
-		   CheckJsonParameter(jsonObject, parameterName, json::value_t::number_integer) or
-		   CheckJsonParameter(jsonObject, parameterName, json::value_t::number_unsigned);
+	const auto it = jsonObject.find(parameterName);
+	return it != jsonObject.end() && IsJsonValueNumeric(*it);
 }
 
-sf::Vector2f GetVectorFromJson(const json & jsonObject, std::string parameterName)
+sf::Vector2f GetVectorFromJson(const json & jsonObject, const std::string& parameterName)
 {
 	sf::Vector2f vector = sf::Vector2f();
 	if (CheckJsonParameter(jsonObject, parameterName, json::value_t::array))
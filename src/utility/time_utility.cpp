@@ -85,6 +85,46 @@ void Timer::SetTime(float time)
 {
 	m_Time = time;
 }
+
+FixedTimestep::FixedTimestep(float fixedDeltaTime, unsigned maxSteps) :
+	m_FixedDeltaTime(fixedDeltaTime), m_MaxSteps(maxSteps)
+{
+}
+
+unsigned FixedTimestep::Advance(float dt)
+{
+	m_Accumulator += dt;
+	unsigned steps = 0;
+	while (m_Accumulator >= m_FixedDeltaTime && steps < m_MaxSteps)
+	{
+		m_Accumulator -= m_FixedDeltaTime;
+		steps++;
+	}
+	if (m_Accumulator >= m_FixedDeltaTime)
+	{
+		//Spiral of death: the simulation slows down instead of catching up forever
+		m_Accumulator = 0.0f;
+	}
+	return steps;
+}
+
+float FixedTimestep::GetInterpolationFactor() const
+{
+	return m_Accumulator / m_FixedDeltaTime;
+}
+
+float FixedTimestep::GetFixedDeltaTime() const
+{
+	return m_FixedDeltaTime;
 }
 
+void FixedTimestep::SetFixedDeltaTime(float fixedDeltaTime)
+{
+	m_FixedDeltaTime = fixedDeltaTime;
+}
 
+void FixedTimestep::SetMaxSteps(unsigned maxSteps)
+{
+	m_MaxSteps = maxSteps;
+}
+}
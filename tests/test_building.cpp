@@ -139,10 +139,7 @@ TEST(Building, TestScene)
 		sfge::ext::behavior_tree::BehaviorTreeUtility::LoadNodesFromJson(*sceneJsonPtr, behaviourTree));
 
 	auto dwarfManager = engine.GetPythonEngine()->GetPySystemManager().GetPySystem<sfge::ext::DwarfManager>("DwarfManager");
-	for(auto i = 0; i < 25; i++)
-	{
-		dwarfManager->InstantiateDwarf(sfge::Vec2f(0, 0));
-	}
+	dwarfManager->InstantiateDwarfs(std::vector<sfge::Vec2f>(25, sfge::Vec2f(0, 0)));
 
 	engine.Start();
 }
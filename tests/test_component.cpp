@@ -0,0 +1,429 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include <engine/engine.h>
+#include <engine/config.h>
+#include <engine/component.h>
+#include <engine/entity.h>
+#include <engine/transform2d.h>
+#include <engine/memory_report.h>
+#include <graphics/graphics2d.h>
+#include <graphics/shape2d.h>
+#include <physics/physics2d.h>
+#include <physics/body2d.h>
+#include <physics/collider2d.h>
+
+struct BenchComponent
+{
+	void Update(float dt)
+	{
+		position += velocity * dt;
+	}
+	sfge::Vec2f position;
+	sfge::Vec2f velocity{1.0f, 1.0f};
+	float payload[12] = {};
+};
+
+struct BenchComponentInfo : sfge::editor::ComponentInfo
+{
+	void DrawOnInspector() override {}
+	BenchComponent* component = nullptr;
+};
+
+/**
+ * \brief Entity-indexed layout: one slot per entity, iterated through the concerned entities
+ */
+class EntityIndexedBenchManager :
+	public sfge::SingleComponentManager<BenchComponent, BenchComponentInfo, sfge::ComponentType::NONE>
+{
+public:
+	using SingleComponentManager::SingleComponentManager;
+	BenchComponent* AddComponent(Entity entity) override
+	{
+		AddConcernedEntity(entity);
+		return GetComponentPtr(entity);
+	}
+	void CreateComponent(json& componentJson, Entity entity) override { (void) componentJson; AddComponent(entity); }
+	void DestroyComponent(Entity entity) override { RemoveConcernedEntity(entity); }
+	void Update(float dt) override
+	{
+		for (auto i = 0u; i < m_ConcernedEntities.size(); i++)
+			m_Components[m_ConcernedEntities[i] - 1].Update(dt);
+	}
+};
+
+/**
+ * \brief Packed sparse-set layout: only the live components, contiguous
+ */
+class PackedBenchManager :
+	public sfge::PackedComponentManager<BenchComponent, BenchComponentInfo, sfge::ComponentType::NONE>
+{
+public:
+	using PackedComponentManager::PackedComponentManager;
+	BenchComponent* AddComponent(Entity entity) override
+	{
+		return EmplacePackedComponent(entity);
+	}
+	void CreateComponent(json& componentJson, Entity entity) override { (void) componentJson; AddComponent(entity); }
+	void DestroyComponent(Entity entity) override { RemovePackedComponent(entity); }
+	void Update(float dt) override
+	{
+		for (auto i = 0u; i < m_Components.size(); i++)
+			m_Components[i].Update(dt);
+	}
+protected:
+	void LinkComponentInfo(size_t index) override
+	{
+		m_ComponentsInfo[index].component = &m_Components[index];
+	}
+};
+
+/**
+ * \brief Several components per entity, used to check that a resize keeps them
+ */
+class MultipleBenchManager :
+	public sfge::MultipleComponentManager<BenchComponent, BenchComponentInfo, sfge::ComponentType::NONE>
+{
+public:
+	using MultipleComponentManager::MultipleComponentManager;
+	BenchComponent* AddComponent(Entity entity) override { return &m_Components[(entity - 1) * MULTIPLE_COMPONENTS_MULTIPLIER]; }
+	void CreateComponent(json& componentJson, Entity entity) override { (void) componentJson; AddComponent(entity); }
+	void DestroyComponent(Entity entity) override { (void) entity; }
+	BenchComponent* GetComponentPtr(Entity entity) override { return AddComponent(entity); }
+	void DrawOnInspector(Entity entity) override { (void) entity; }
+protected:
+	int GetFreeComponentIndex() override { return 0; }
+};
+
+TEST(Component, PackedComponentRemoval)
+{
+	sfge::Engine engine;
+	PackedBenchManager manager(engine);
+
+	for (Entity entity = 1; entity <= 5; entity++)
+	{
+		manager.AddComponent(entity)->position = sfge::Vec2f(entity, entity);
+	}
+	manager.DestroyComponent(2);
+
+	EXPECT_EQ(manager.GetComponentPtr(2), nullptr);
+	EXPECT_EQ(manager.GetComponents().size(), 4u);
+	EXPECT_EQ(manager.GetConcernedEntities()[1], 5u);
+	for (Entity entity : {1u, 3u, 4u, 5u})
+	{
+		EXPECT_FLOAT_EQ(manager.GetComponentRef(entity).position.x, static_cast<float>(entity));
+		EXPECT_EQ(manager.GetComponentInfo(entity).GetEntity(), entity);
+		EXPECT_EQ(manager.GetComponentInfo(entity).component, manager.GetComponentPtr(entity));
+	}
+	manager.DestroyComponent(5);
+	manager.DestroyComponent(5);
+	EXPECT_EQ(manager.GetComponents().size(), 3u);
+}
+
+TEST(Component, PackedShapeManager)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+
+	auto* entityManager = engine.GetEntityManager();
+	auto* shapeManager = engine.GetGraphics2dManager()->GetShapeManager();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 3; i++)
+	{
+		const auto entity = entityManager->CreateEntity(INVALID_ENTITY);
+		shapeManager->AddComponent(entity);
+		entities.push_back(entity);
+	}
+	shapeManager->DestroyComponent(entities[0]);
+
+	EXPECT_FALSE(entityManager->HasComponent(entities[0], sfge::ComponentType::SHAPE2D));
+	EXPECT_EQ(shapeManager->GetComponentPtr(entities[0]), nullptr);
+	EXPECT_EQ(shapeManager->GetComponents().size(), 2u);
+	EXPECT_EQ(shapeManager->GetComponentPtr(entities[2]), &shapeManager->GetComponents()[0]);
+
+	entityManager->DestroyEntity(entities[1]);
+	EXPECT_EQ(shapeManager->GetComponents().size(), 1u);
+	engine.Destroy();
+}
+
+TEST(Component, MainCameraTracking)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+
+	auto* entityManager = engine.GetEntityManager();
+	auto* cameraManager = engine.GetGraphics2dManager()->GetCameraManager();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 3; i++)
+	{
+		const auto entity = entityManager->CreateEntity(INVALID_ENTITY);
+		cameraManager->AddComponent(entity)->SetPosition(sfge::Vec2f(static_cast<float>(entity), 0.0f));
+		entities.push_back(entity);
+	}
+	EXPECT_EQ(cameraManager->GetMainCamera(), cameraManager->GetComponentPtr(entities[0]));
+
+	//The entity destruction goes through the camera manager DestroyComponent
+	entityManager->DestroyEntity(entities[0]);
+	EXPECT_FALSE(entityManager->HasComponent(entities[0], sfge::ComponentType::CAMERA));
+	EXPECT_EQ(cameraManager->GetComponents().size(), 2u);
+	auto* mainCamera = cameraManager->GetMainCamera();
+	ASSERT_NE(mainCamera, nullptr);
+
+	//Removing another camera moves the dense slots but not the main camera
+	const auto mainEntity = mainCamera->GetPosition().x == static_cast<float>(entities[1]) ? entities[1] : entities[2];
+	const auto otherEntity = mainEntity == entities[1] ? entities[2] : entities[1];
+	const auto newEntity = entityManager->CreateEntity(INVALID_ENTITY);
+	cameraManager->AddComponent(newEntity);
+	cameraManager->DestroyComponent(otherEntity);
+	EXPECT_EQ(cameraManager->GetMainCamera(), cameraManager->GetComponentPtr(mainEntity));
+	EXPECT_FLOAT_EQ(cameraManager->GetMainCamera()->GetPosition().x, static_cast<float>(mainEntity));
+	engine.Destroy();
+}
+
+TEST(Component, PackedComponentDensity)
+{
+	//The timings of both layouts are in SFGE_BENCH, here they only have to agree
+	const Entity entityNmb = 10'000;
+	const float dt = 0.016f;
+	std::mt19937 generator(42);
+
+	sfge::Engine engine;
+	for (int density : {1, 10, 100})
+	{
+		EntityIndexedBenchManager entityIndexedManager(engine);
+		PackedBenchManager packedManager(engine);
+		entityIndexedManager.OnResize(entityNmb);
+		packedManager.OnResize(entityNmb);
+
+		std::uniform_int_distribution<int> distribution(0, 99);
+		std::vector<Entity> entities;
+		for (Entity entity = 1; entity <= entityNmb; entity++)
+		{
+			if (distribution(generator) < density)
+			{
+				entityIndexedManager.AddComponent(entity);
+				packedManager.AddComponent(entity);
+				entities.push_back(entity);
+			}
+		}
+		ASSERT_EQ(packedManager.GetComponents().size(), entities.size());
+		EXPECT_EQ(entityIndexedManager.GetConcernedEntities().size(), entities.size());
+
+		for (int i = 0; i < 10; i++)
+		{
+			entityIndexedManager.Update(dt);
+			packedManager.Update(dt);
+		}
+		for (Entity entity : entities)
+		{
+			const auto* packedComponent = packedManager.GetComponentPtr(entity);
+			ASSERT_NE(packedComponent, nullptr);
+			EXPECT_FLOAT_EQ(packedComponent->position.x, entityIndexedManager.GetComponentPtr(entity)->position.x);
+		}
+	}
+}
+
+TEST(Component, DestroyHalfEntities)
+{
+	const size_t entityNmb = 100'000;
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+	auto* shapeManager = engine.GetGraphics2dManager()->GetShapeManager();
+
+	const auto range = entityManager->CreateEntities(entityNmb);
+	std::vector<Entity> destroyedEntities;
+	for (size_t i = 0; i < range.size(); i++)
+	{
+		transformManager->AddComponent(range[i]);
+		shapeManager->AddComponent(range[i]);
+		if (i % 2 == 0)
+			destroyedEntities.push_back(range[i]);
+	}
+
+	//Former RemoveConcernedEntity: linear search and erase
+	auto concernedEntities = transformManager->GetConcernedEntities();
+	std::clock_t timer = std::clock();
+	for (Entity entity : destroyedEntities)
+	{
+		const auto it = std::find(concernedEntities.begin(), concernedEntities.end(), entity);
+		if (it != concernedEntities.end())
+			concernedEntities.erase(it);
+	}
+	const auto durationLinear = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	timer = std::clock();
+	entityManager->DestroyEntities(destroyedEntities);
+	const auto durationBatched = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	EXPECT_EQ(transformManager->GetConcernedEntities().size(), entityNmb / 2);
+	EXPECT_EQ(shapeManager->GetComponents().size(), entityNmb / 2);
+	EXPECT_FALSE(entityManager->HasComponent(destroyedEntities[0], sfge::ComponentType::TRANSFORM2D));
+
+	std::cout << "\nDestroy " << destroyedEntities.size() << " of " << entityNmb << " entities"
+		<< "\tLinear concerned removal (transforms only) : " << durationLinear << " ms"
+		<< "\tDestroyEntities : " << durationBatched << " ms\n";
+	engine.Destroy();
+}
+
+TEST(Component, PointerStableResize)
+{
+	const size_t entityNmb = 100'000;
+	sfge::Engine engine;
+	EntityIndexedBenchManager singleManager(engine);
+	MultipleBenchManager multipleManager(engine);
+
+	auto* singleComponent = singleManager.AddComponent(1);
+	singleComponent->position = sfge::Vec2f(1.0f, 2.0f);
+	auto* multipleComponent = multipleManager.AddComponent(INIT_ENTITY_NMB);
+	multipleComponent->position = sfge::Vec2f(3.0f, 4.0f);
+
+	std::clock_t timer = std::clock();
+	singleManager.OnResize(entityNmb);
+	multipleManager.OnResize(entityNmb);
+	const auto duration = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	EXPECT_EQ(singleManager.GetComponentPtr(1), singleComponent);
+	EXPECT_FLOAT_EQ(singleComponent->position.y, 2.0f);
+	EXPECT_EQ(multipleManager.GetComponentPtr(INIT_ENTITY_NMB), multipleComponent);
+	EXPECT_FLOAT_EQ(multipleComponent->position.y, 4.0f);
+	EXPECT_EQ(singleManager.GetComponentInfo(entityNmb).GetEntity(), entityNmb);
+	EXPECT_EQ(multipleManager.GetComponents().size(), entityNmb * MULTIPLE_COMPONENTS_MULTIPLIER);
+
+	std::cout << "\nResize to " << entityNmb << " entities without moving the components : " << duration << " ms\n";
+}
+
+TEST(Component, MemoryReport)
+{
+	const size_t componentNmb = 3000;
+	sfge::Engine engine;
+	PackedBenchManager packedManager(engine);
+	for (Entity entity = 1; entity <= componentNmb; entity++)
+	{
+		packedManager.AddComponent(entity);
+	}
+	sfge::MemoryReport report;
+	report.SetSystem("PackedBenchManager");
+	packedManager.ReportMemory(report);
+	const auto& usages = report.GetUsages();
+	const auto components = std::find_if(usages.begin(), usages.end(), [](const sfge::MemoryUsage& usage)
+	{
+		return usage.container == "Components";
+	});
+	ASSERT_NE(components, usages.end());
+	EXPECT_EQ(components->system, "PackedBenchManager");
+	EXPECT_EQ(components->usedBytes, componentNmb * sizeof(BenchComponent));
+	EXPECT_GE(components->capacityBytes, components->usedBytes);
+
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	report.Clear();
+	engine.ReportMemory(report);
+	const auto totals = report.GetSystemTotals();
+	ASSERT_FALSE(totals.empty());
+	EXPECT_GE(totals.front().capacityBytes + totals.front().externalBytes,
+		totals.back().capacityBytes + totals.back().externalBytes);
+	EXPECT_GE(report.GetCapacityBytes(), report.GetUsedBytes());
+
+	std::cout << "\nEngine containers: " << report.GetUsedBytes() / 1024 << " KB used, "
+		<< report.GetCapacityBytes() / 1024 << " KB allocated, biggest " << totals.front().system << "\n";
+	engine.Destroy();
+}
+
+TEST(Component, LazyInfoWithoutEditor)
+{
+	const size_t entityNmb = 2 * sfge::COMPONENT_CHUNK_SIZE;
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+
+	json sceneJson;
+	sceneJson["name"] = "Lazy Infos";
+	sceneJson["entities"] = json::array();
+	for (size_t i = 0; i < entityNmb; i++)
+	{
+		json transformJson;
+		transformJson["type"] = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+		transformJson["position"] = { 20.0f * i, 0.0f };
+		json bodyJson;
+		bodyJson["type"] = static_cast<int>(sfge::ComponentType::BODY2D);
+		bodyJson["body_type"] = static_cast<int>(b2_dynamicBody);
+		json colliderJson;
+		colliderJson["type"] = static_cast<int>(sfge::ComponentType::COLLIDER2D);
+		colliderJson["collider_type"] = static_cast<int>(sfge::ColliderType::CIRCLE);
+		colliderJson["radius"] = 5.0f;
+		json shapeJson;
+		shapeJson["type"] = static_cast<int>(sfge::ComponentType::SHAPE2D);
+		shapeJson["shape_type"] = static_cast<int>(sfge::ShapeType::CIRCLE);
+		shapeJson["radius"] = 5.0f;
+		json entityJson;
+		entityJson["components"] = json::array({ transformJson, bodyJson, colliderJson, shapeJson });
+		sceneJson["entities"].push_back(entityJson);
+	}
+	engine.GetSceneManager()->LoadSceneFromJson(sceneJson);
+	auto* transformManager = engine.GetTransform2dManager();
+	auto* bodyManager = engine.GetPhysicsManager()->GetBodyManager();
+	auto* colliderManager = engine.GetPhysicsManager()->GetColliderManager();
+	auto* shapeManager = engine.GetGraphics2dManager()->GetShapeManager();
+	ASSERT_EQ(shapeManager->GetComponents().size(), entityNmb);
+
+	//Adding the components writes no info, not a single chunk is allocated
+	EXPECT_EQ(transformManager->GetComponentsInfo().GetAllocatedChunkNmb(), 0u);
+	EXPECT_EQ(bodyManager->GetComponentsInfo().GetAllocatedChunkNmb(), 0u);
+	EXPECT_EQ(colliderManager->GetComponentsInfo().GetAllocatedChunkNmb(), 0u);
+	EXPECT_EQ(shapeManager->GetComponentsInfo().GetAllocatedChunkNmb(), 0u);
+
+	//The info is linked to its component on first access
+	const Entity lastEntity = entityNmb;
+	EXPECT_EQ(transformManager->GetComponentInfo(lastEntity).transform, transformManager->GetComponentPtr(lastEntity));
+	EXPECT_EQ(shapeManager->GetComponentInfo(lastEntity).shapePtr, shapeManager->GetComponentPtr(lastEntity));
+	EXPECT_EQ(shapeManager->GetComponentInfo(lastEntity).GetEntity(), lastEntity);
+	EXPECT_EQ(transformManager->GetComponentsInfo().GetAllocatedChunkNmb(), 1u);
+	EXPECT_EQ(shapeManager->GetComponentsInfo().GetAllocatedChunkNmb(), 1u);
+	engine.Destroy();
+}
@@ -0,0 +1,383 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <ctime>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <engine/engine.h>
+#include <engine/entity.h>
+#include <engine/component.h>
+#include <engine/config.h>
+#include <engine/transform2d.h>
+
+TEST(Entity, FreeListAndGenerations)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+
+	const auto entity1 = entityManager.CreateEntity(INVALID_ENTITY);
+	const auto entity2 = entityManager.CreateEntity(INVALID_ENTITY);
+	EXPECT_EQ(entity1, 1u);
+	EXPECT_EQ(entity2, 2u);
+	EXPECT_EQ(entityManager.CreateEntity(entity2), INVALID_ENTITY);
+
+	const auto handle = entityManager.GetEntityHandle(entity1);
+	EXPECT_EQ(entityManager.GetEntityFromHandle(handle), entity1);
+
+	entityManager.DestroyEntity(entity1);
+	EXPECT_FALSE(entityManager.IsAlive(entity1));
+	EXPECT_EQ(entityManager.GetEntityFromHandle(handle), INVALID_ENTITY);
+
+	const auto reusedEntity = entityManager.CreateEntity(INVALID_ENTITY);
+	EXPECT_EQ(reusedEntity, entity1);
+	EXPECT_EQ(entityManager.GetEntityFromHandle(handle), INVALID_ENTITY);
+	EXPECT_NE(entityManager.GetEntityHandle(reusedEntity), handle);
+	EXPECT_EQ(entityManager.GetEntityInfo(reusedEntity).name, "Entity: 1");
+}
+
+TEST(Entity, GenerationsSurviveClear)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+
+	const auto highEntity = static_cast<Entity>(INIT_ENTITY_NMB * 2);
+	entityManager.ResizeEntityNmb(highEntity);
+	ASSERT_EQ(entityManager.CreateEntity(highEntity), highEntity);
+	const auto handle = entityManager.GetEntityHandle(highEntity);
+
+	//The clear shrinks the entities back, growing them again must not revive the handle
+	entityManager.Clear();
+	entityManager.ResizeEntityNmb(highEntity);
+	ASSERT_EQ(entityManager.CreateEntity(highEntity), highEntity);
+	EXPECT_EQ(entityManager.GetEntityFromHandle(handle), INVALID_ENTITY);
+}
+
+TEST(Entity, CreateEntities)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+
+	entityManager.CreateEntity(INVALID_ENTITY);
+	const auto range = entityManager.CreateEntities(INIT_ENTITY_NMB);
+	ASSERT_EQ(range.size(), static_cast<size_t>(INIT_ENTITY_NMB));
+	EXPECT_EQ(range.first, 2u);
+	for (size_t i = 0; i < range.size(); i++)
+	{
+		EXPECT_TRUE(entityManager.IsAlive(range[i]));
+	}
+	//The range grew the entity arrays and the single allocations continue after it
+	EXPECT_EQ(entityManager.CreateEntity(INVALID_ENTITY), INVALID_ENTITY);
+	entityManager.ResizeEntityNmb(INIT_ENTITY_NMB + 2);
+	EXPECT_EQ(entityManager.CreateEntity(INVALID_ENTITY), static_cast<Entity>(INIT_ENTITY_NMB + 2));
+}
+
+TEST(Entity, CreateEntitiesReuse)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+
+	//Waves of spawns destroyed a frame later, with a few long lived singles, stay in the first entities
+	const size_t waveNmb = 1'000;
+	std::vector<Entity> previousWave;
+	std::vector<Entity> singles;
+	for (int frame = 0; frame < 200; frame++)
+	{
+		entityManager.ReserveEntities(waveNmb);
+		const auto range = entityManager.CreateEntities(waveNmb);
+		ASSERT_EQ(range.size(), waveNmb);
+		EXPECT_LE(range[waveNmb - 1], static_cast<Entity>(3 * waveNmb));
+		for (size_t i = 0; i < range.size(); i++)
+		{
+			EXPECT_TRUE(entityManager.IsAlive(range[i]));
+		}
+		if (frame % 10 == 0)
+		{
+			const auto single = entityManager.CreateEntities(1);
+			ASSERT_EQ(single.size(), 1u);
+			EXPECT_LE(single.first, static_cast<Entity>(3 * waveNmb));
+			singles.push_back(single.first);
+		}
+		entityManager.DestroyEntities(previousWave);
+		previousWave.clear();
+		for (size_t i = 0; i < range.size(); i++)
+		{
+			previousWave.push_back(range[i]);
+		}
+	}
+	EXPECT_LE(entityManager.GetAliveEntities().Count(), waveNmb + singles.size());
+	for (Entity entity : singles)
+	{
+		EXPECT_TRUE(entityManager.IsAlive(entity));
+	}
+	//The free list kept up with the ranges, every single creation finds a free entity
+	entityManager.DestroyEntities(previousWave);
+	for (size_t i = 0; i < waveNmb; i++)
+	{
+		const auto entity = entityManager.CreateEntity(INVALID_ENTITY);
+		ASSERT_NE(entity, INVALID_ENTITY);
+		EXPECT_LE(entity, static_cast<Entity>(3 * waveNmb));
+	}
+}
+
+class DestroyCounter : public sfge::DestroyObserver
+{
+public:
+	void OnDestroy(Entity entity) override
+	{
+		destroyedEntities.push_back(entity);
+	}
+	std::vector<Entity> destroyedEntities;
+};
+
+TEST(Entity, DestroyEntitiesTwice)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+	DestroyCounter destroyCounter;
+	entityManager.AddDestroyObserver(&destroyCounter);
+
+	const auto range = entityManager.CreateEntities(3);
+	ASSERT_EQ(range.size(), 3u);
+	entityManager.DestroyEntities({ range[0], range[2], range[0], range[2] });
+	EXPECT_EQ(destroyCounter.destroyedEntities, std::vector<Entity>({ range[0], range[2] }));
+	EXPECT_FALSE(entityManager.IsAlive(range[0]));
+	EXPECT_TRUE(entityManager.IsAlive(range[1]));
+	EXPECT_FALSE(entityManager.IsAlive(range[2]));
+}
+
+TEST(Entity, CreateEntityPerformance)
+{
+	const size_t entityNmb = 100'000;
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+	entityManager.ResizeEntityNmb(entityNmb);
+
+	std::clock_t timer = std::clock();
+	for (size_t i = 0; i < entityNmb; i++)
+	{
+		const auto entity = entityManager.CreateEntity(INVALID_ENTITY);
+		entityManager.AddComponentType(entity, sfge::ComponentType::TRANSFORM2D);
+	}
+	const auto durationSingle = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	for (Entity entity = 1; entity <= entityNmb; entity += 2)
+	{
+		entityManager.DestroyEntity(entity);
+	}
+	timer = std::clock();
+	for (size_t i = 0; i < entityNmb / 2; i++)
+	{
+		EXPECT_NE(entityManager.CreateEntity(INVALID_ENTITY), INVALID_ENTITY);
+	}
+	const auto durationReuse = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	timer = std::clock();
+	const auto range = entityManager.CreateEntities(entityNmb);
+	const auto durationBulk = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+	EXPECT_EQ(range.size(), entityNmb);
+
+	std::cout << "\nCreate " << entityNmb << " entities : " << durationSingle << " ms"
+		<< "\tReuse " << entityNmb / 2 << " destroyed entities : " << durationReuse << " ms"
+		<< "\tCreateEntities(" << entityNmb << ") : " << durationBulk << " ms\n";
+}
+
+TEST(Entity, View)
+{
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+	entityManager.ResizeEntityNmb(10'000);
+
+	std::vector<Entity> expectedEntities;
+	for (Entity entity = 1; entity <= 10'000; entity++)
+	{
+		entityManager.CreateEntity(entity);
+		entityManager.AddComponentType(entity, sfge::ComponentType::TRANSFORM2D);
+		if (entity % 7 == 0)
+		{
+			entityManager.AddComponentType(entity, sfge::ComponentType::BODY2D);
+			if (entity % 2 == 0)
+				expectedEntities.push_back(entity);
+		}
+	}
+	for (Entity entity = 7; entity <= 10'000; entity += 14)
+	{
+		entityManager.RemoveComponentType(entity, sfge::ComponentType::TRANSFORM2D);
+	}
+
+	std::vector<Entity> viewEntities;
+	const auto view = entityManager.View(static_cast<sfge::EntityMask>(sfge::ComponentType::TRANSFORM2D) |
+		static_cast<sfge::EntityMask>(sfge::ComponentType::BODY2D));
+	for (Entity entity : view)
+	{
+		viewEntities.push_back(entity);
+	}
+	EXPECT_EQ(viewEntities, expectedEntities);
+	EXPECT_EQ(view.Count(), expectedEntities.size());
+
+	entityManager.DestroyEntity(expectedEntities.front());
+	EXPECT_EQ(view.Count(), expectedEntities.size() - 1);
+	EXPECT_TRUE(entityManager.View(static_cast<sfge::EntityMask>(sfge::ComponentType::CAMERA)).Empty());
+}
+
+TEST(Entity, BitsetShrinkWithinWord)
+{
+	sfge::EntityBitset bitset(64);
+	bitset.Set(3);
+	bitset.Set(40);
+	bitset.Set(64);
+
+	bitset.Resize(20);
+	EXPECT_EQ(bitset.Count(), 1u);
+	EXPECT_TRUE(bitset.Test(3));
+	EXPECT_FALSE(bitset.Test(40));
+
+	bitset.Resize(2);
+	EXPECT_EQ(bitset.Count(), 0u);
+	EXPECT_TRUE(bitset.GetSummary()[0] == 0U);
+
+	//Growing back does not revive the masked entities
+	bitset.Resize(64);
+	EXPECT_FALSE(bitset.Test(64));
+	sfge::EntityView view;
+	view.AddBitset(&bitset);
+	EXPECT_TRUE(view.Empty());
+}
+
+TEST(Entity, CommandBuffer)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	const auto destroyedEntity = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto keptEntity = entityManager->CreateEntity(INVALID_ENTITY);
+	transformManager->AddComponent(keptEntity);
+
+	//Each thread records into its own buffer, nothing is applied before the sync point
+	auto& jobSystem = engine.GetJobSystem();
+	const size_t jobNmb = jobSystem.GetThreadNmb() * 4;
+	jobSystem.ParallelFor(0, jobNmb, 1, [entityManager](size_t start, size_t end)
+	{
+		auto& commandBuffer = *entityManager->GetCommandBuffer();
+		for (auto i = start; i < end; i++)
+		{
+			for (int j = 0; j < 100; j++)
+			{
+				const auto entity = commandBuffer.CreateEntity();
+				json transformJson;
+				transformJson["position"] = { j, j };
+				commandBuffer.AddComponent(entity, sfge::ComponentType::TRANSFORM2D, transformJson);
+			}
+		}
+	});
+	auto& mainBuffer = *entityManager->GetCommandBuffer();
+	const auto deferredEntity = mainBuffer.CreateEntity();
+	mainBuffer.AddComponent(deferredEntity, sfge::ComponentType::TRANSFORM2D);
+	mainBuffer.RemoveComponent(keptEntity, sfge::ComponentType::TRANSFORM2D);
+	mainBuffer.DestroyEntity(destroyedEntity);
+	EXPECT_TRUE(entityManager->IsAlive(destroyedEntity));
+	EXPECT_TRUE(sfge::IsDeferredEntity(deferredEntity));
+
+	entityManager->PlaybackCommands();
+
+	EXPECT_FALSE(entityManager->IsAlive(destroyedEntity));
+	EXPECT_FALSE(entityManager->HasComponent(keptEntity, sfge::ComponentType::TRANSFORM2D));
+	const size_t createdNmb = jobNmb * 100 + 1;
+	EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), createdNmb);
+	EXPECT_TRUE(mainBuffer.Empty());
+
+	//A thread outside the JobSystem has no buffer, it would race with the main thread on it
+	sfge::EntityCommandBuffer* foreignBuffer = &mainBuffer;
+	std::thread([entityManager, &foreignBuffer]() { foreignBuffer = entityManager->GetCommandBuffer(); }).join();
+	EXPECT_EQ(foreignBuffer, nullptr);
+	engine.Destroy();
+}
+
+TEST(Entity, CommandBufferOrder)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	const auto replacedEntity = entityManager->CreateEntity(INVALID_ENTITY);
+	transformManager->AddComponent(replacedEntity);
+	const auto removedEntity = entityManager->CreateEntity(INVALID_ENTITY);
+
+	//A removal followed by an addition replaces the component, the opposite order removes it
+	auto& commandBuffer = *entityManager->GetCommandBuffer();
+	commandBuffer.RemoveComponent(replacedEntity, sfge::ComponentType::TRANSFORM2D);
+	json transformJson;
+	transformJson["position"] = { 12, 34 };
+	commandBuffer.AddComponent(replacedEntity, sfge::ComponentType::TRANSFORM2D, transformJson);
+	commandBuffer.AddComponent(removedEntity, sfge::ComponentType::TRANSFORM2D);
+	commandBuffer.RemoveComponent(removedEntity, sfge::ComponentType::TRANSFORM2D);
+
+	entityManager->PlaybackCommands();
+
+	EXPECT_TRUE(entityManager->HasComponent(replacedEntity, sfge::ComponentType::TRANSFORM2D));
+	EXPECT_EQ(transformManager->GetComponentRef(replacedEntity).Position, sfge::Vec2f(12, 34));
+	EXPECT_FALSE(entityManager->HasComponent(removedEntity, sfge::ComponentType::TRANSFORM2D));
+	engine.Destroy();
+}
+
+TEST(Entity, LazyEditorInfo)
+{
+	const size_t entityNmb = 1'000'000;
+	sfge::Engine engine;
+	sfge::EntityManager entityManager(engine);
+	entityManager.Init();
+
+	std::clock_t timer = std::clock();
+	entityManager.ResizeEntityNmb(entityNmb);
+	const auto range = entityManager.CreateEntities(entityNmb);
+	const auto duration = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+	EXPECT_EQ(range.size(), entityNmb);
+	EXPECT_EQ(entityManager.GetEntityInfo(range[entityNmb - 1]).name, "Entity: " + std::to_string(range[entityNmb - 1]));
+
+	sfge::LazyComponentPool<sfge::editor::EntityInfo> infos;
+	infos.resize(entityNmb);
+	EXPECT_EQ(infos.GetAllocatedChunkNmb(), 0u);
+	infos[entityNmb - 1].name = "Last";
+	EXPECT_EQ(infos.GetAllocatedChunkNmb(), 1u);
+	EXPECT_FALSE(infos.IsAllocated(0));
+
+	std::cout << "\nCreate " << entityNmb << " entities without editor infos : " << duration << " ms\n";
+}
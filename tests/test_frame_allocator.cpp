@@ -0,0 +1,244 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <engine/engine.h>
+#include <engine/config.h>
+#include <engine/entity.h>
+#include <engine/transform2d.h>
+#include <engine/frame_allocator.h>
+
+/**
+ * \brief Heap allocations of the test process, counted by the replaced global operator new like in SFGE_BENCH
+ */
+static std::atomic<size_t> g_HeapAllocationNmb{0};
+
+void* operator new(size_t size)
+{
+	g_HeapAllocationNmb.fetch_add(1, std::memory_order_relaxed);
+	if (void* data = std::malloc(size == 0 ? 1 : size))
+		return data;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept
+{
+	std::free(data);
+}
+
+void operator delete(void* data, size_t) noexcept
+{
+	std::free(data);
+}
+
+TEST(FrameAllocator, ArenaReuse)
+{
+	sfge::FrameArena frameArena(1024);
+	EXPECT_EQ(frameArena.GetHeapAllocationNmb(), 1u);
+
+	auto* data1 = frameArena.Allocate(3, 1);
+	auto* data2 = frameArena.Allocate(sizeof(double), alignof(double));
+	EXPECT_NE(data1, data2);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data2) % alignof(double), 0u);
+	EXPECT_EQ(frameArena.GetAllocationNmb(), 2u);
+
+	//The first frame overflows the block, the next ones fit in the merged block
+	for (int frame = 0; frame < 10; frame++)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			frameArena.Allocate(256, 16);
+		}
+		frameArena.Reset();
+		EXPECT_EQ(frameArena.GetUsedBytes(), 0u);
+		EXPECT_EQ(frameArena.GetAllocationNmb(), 0u);
+	}
+	EXPECT_GE(frameArena.GetCapacity(), 16u * 256u);
+	const auto heapAllocationNmb = frameArena.GetHeapAllocationNmb();
+	for (int i = 0; i < 16; i++)
+	{
+		frameArena.Allocate(256, 16);
+	}
+	EXPECT_EQ(frameArena.GetHeapAllocationNmb(), heapAllocationNmb);
+}
+
+TEST(FrameAllocator, FrameVector)
+{
+	const int valueNmb = 10'000;
+	sfge::FrameArena frameArena(1024);
+	std::vector<int> expectedValues(valueNmb);
+	std::iota(expectedValues.begin(), expectedValues.end(), 0);
+
+	//The vector outgrows the first block, each reallocation takes a new block and keeps the values
+	{
+		auto values = sfge::FrameVector<int>(sfge::FrameAllocator<int>(frameArena));
+		for (int i = 0; i < valueNmb; i++)
+		{
+			values.push_back(i);
+		}
+		EXPECT_TRUE(std::equal(values.begin(), values.end(), expectedValues.begin(), expectedValues.end()));
+		EXPECT_GT(frameArena.GetHeapAllocationNmb(), 1u);
+	}
+	frameArena.Reset();
+
+	//The merged block holds the same frame again without going to the heap
+	const auto heapAllocationNmb = frameArena.GetHeapAllocationNmb();
+	for (int frame = 0; frame < 3; frame++)
+	{
+		auto values = sfge::FrameVector<int>(sfge::FrameAllocator<int>(frameArena));
+		for (int i = 0; i < valueNmb; i++)
+		{
+			values.push_back(i);
+		}
+		EXPECT_TRUE(std::equal(values.begin(), values.end(), expectedValues.begin(), expectedValues.end()));
+		frameArena.Reset();
+	}
+	EXPECT_EQ(frameArena.GetHeapAllocationNmb(), heapAllocationNmb);
+
+	//Reset gives back the same storage
+	auto* firstData = frameArena.Allocate(16, 16);
+	frameArena.Reset();
+	EXPECT_EQ(frameArena.Allocate(16, 16), firstData);
+	frameArena.Reset();
+}
+
+TEST(FrameAllocator, Alignment)
+{
+	struct alignas(64) AlignedValue
+	{
+		float value = 0.0f;
+	};
+	sfge::FrameArena frameArena(1024);
+	frameArena.Allocate(3, 1);
+	auto values = sfge::FrameVector<AlignedValue>(sfge::FrameAllocator<AlignedValue>(frameArena));
+	for (int i = 0; i < 100; i++)
+	{
+		values.push_back(AlignedValue{ static_cast<float>(i) });
+		//Also when the growth moved the vector in a new block
+		ASSERT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(AlignedValue), 0u);
+	}
+	EXPECT_FLOAT_EQ(values.back().value, 99.0f);
+	auto* data = frameArena.Allocate(1, 1);
+	auto* alignedData = frameArena.Allocate(sizeof(double), alignof(double));
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(alignedData) % alignof(double), 0u);
+	EXPECT_NE(data, alignedData);
+}
+
+TEST(FrameAllocator, EngineThreadArenas)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+
+	//Each thread bumps its own arena, without lock
+	auto& jobSystem = engine.GetJobSystem();
+	std::mutex arenaMutex;
+	std::set<sfge::FrameArena*> arenas;
+	jobSystem.ParallelFor(0, jobSystem.GetThreadNmb() * 16, 1, [&engine, &arenaMutex, &arenas](size_t start, size_t end)
+	{
+		auto& frameArena = *engine.GetFrameArena();
+		auto values = sfge::FrameVector<float>(sfge::FrameAllocator<float>(frameArena));
+		values.resize(1024 * (end - start), 1.0f);
+		std::lock_guard<std::mutex> lock(arenaMutex);
+		arenas.insert(&frameArena);
+	});
+	EXPECT_GE(arenas.size(), 1u);
+	EXPECT_LE(arenas.size(), jobSystem.GetThreadNmb());
+	//A thread outside the JobSystem has no arena, it would bump the main thread one without lock
+	sfge::FrameArena* foreignArena = *arenas.begin();
+	std::thread([&engine, &foreignArena]() { foreignArena = engine.GetFrameArena(); }).join();
+	EXPECT_EQ(foreignArena, nullptr);
+
+	engine.Step(0.016f);
+	for (auto* frameArena : arenas)
+	{
+		EXPECT_EQ(frameArena->GetUsedBytes(), 0u);
+	}
+	engine.Destroy();
+}
+
+TEST(FrameAllocator, EngineFrameAllocations)
+{
+	const size_t frameNmb = 60;
+	const size_t entityNmb = 1'000;
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	//The commands are played back on the main thread, in its arena
+	auto& frameArena = *engine.GetFrameArena();
+
+	//Each frame destroys the entities of the last frame and creates as many through the command buffer
+	std::vector<Entity> lastEntities;
+	std::vector<size_t> frameAllocations;
+	size_t arenaHeapAllocationNmb = 0;
+	for (size_t frame = 0; frame < frameNmb; frame++)
+	{
+		auto& commandBuffer = *entityManager->GetCommandBuffer();
+		for (const auto entity : lastEntities)
+		{
+			commandBuffer.DestroyEntity(entity);
+		}
+		for (size_t i = 0; i < entityNmb; i++)
+		{
+			commandBuffer.AddComponent(commandBuffer.CreateEntity(), sfge::ComponentType::TRANSFORM2D);
+		}
+		const auto allocationStart = g_HeapAllocationNmb.load(std::memory_order_relaxed);
+		engine.Step(1.0f / 60.0f);
+		frameAllocations.push_back(g_HeapAllocationNmb.load(std::memory_order_relaxed) - allocationStart);
+		if (frame == 0)
+			arenaHeapAllocationNmb = frameArena.GetHeapAllocationNmb();
+
+		lastEntities.clear();
+		for (const auto entity : entityManager->View<sfge::Transform2d>())
+		{
+			lastEntities.push_back(entity);
+		}
+		ASSERT_EQ(lastEntities.size(), entityNmb);
+	}
+	//After the first frame the playback lists fit in the merged arena block
+	EXPECT_EQ(frameArena.GetHeapAllocationNmb(), arenaHeapAllocationNmb);
+	EXPECT_EQ(frameArena.GetUsedBytes(), 0u);
+
+	const auto steadyAllocationNmb = std::accumulate(frameAllocations.begin() + 1, frameAllocations.end(), size_t(0)) /
+		(frameNmb - 1);
+	std::cout << "\nEngine frame with " << entityNmb << " created and destroyed entities: " << frameAllocations.front()
+		<< " heap allocations the first frame, " << steadyAllocationNmb << " per frame after\n";
+	engine.Destroy();
+}
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "engine/component.h"
 #include "graphics/texture.h"
 #include <graphics/graphics2d.h>
+#include <graphics/sprite2d.h>
 
 TEST(Graphics2d, TestSpriteAnimation)
 {
@@ -75,6 +76,69 @@ TEST(Graphics2d, TestSprite)
 }
 
 
+TEST(Graphics2d, TestPipelinedRendering)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->editor = false;
+	config->pipelinedRendering = true;
+	engine.Init(std::move(config));
+
+	json sceneJson;
+	json entityJson;
+	json spriteJson;
+	spriteJson["path"] = "data/sprites/roguelikeDungeon_transparent.png";
+	spriteJson["type"] = static_cast<int>(sfge::ComponentType::SPRITE2D);
+	json animationJson;
+	animationJson["path"] = "data/animSaves/cowboy_walk.json";
+	animationJson["type"] = static_cast<int>(sfge::ComponentType::ANIMATION2D);
+	entityJson["components"] = json::array({ spriteJson });
+	json animationEntityJson;
+	animationEntityJson["components"] = json::array({ animationJson });
+
+	sceneJson["entities"] = json::array({ entityJson, animationEntityJson });
+	sceneJson["name"] = "Test Pipelined Rendering";
+	engine.GetSceneManager()->LoadSceneFromJson(sceneJson);
+
+	engine.Start();
+}
+
+TEST(Graphics2d, DrawOrder)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* spriteManager = engine.GetGraphics2dManager()->GetSpriteManager();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 5; i++)
+	{
+		entities.push_back(entityManager->CreateEntity(INVALID_ENTITY));
+		spriteManager->AddComponent(entities.back());
+	}
+	spriteManager->GetComponentRef(entities[0]).SetLayer(1);
+	const auto drawnEntities = [spriteManager]()
+	{
+		std::vector<Entity> drawOrder;
+		const auto concernedEntities = spriteManager->GetConcernedEntities();
+		for (const auto index : spriteManager->GetDrawOrder())
+			drawOrder.push_back(concernedEntities[index]);
+		return drawOrder;
+	};
+	EXPECT_EQ(drawnEntities(), std::vector<Entity>({ entities[1], entities[2], entities[3], entities[4], entities[0] }));
+
+	//The swap-and-pop moves the last sprite in the hole, the draw order stays by layer then entity
+	spriteManager->DestroyComponent(entities[2]);
+	EXPECT_EQ(drawnEntities(), std::vector<Entity>({ entities[1], entities[3], entities[4], entities[0] }));
+	spriteManager->GetComponentRef(entities[4]).SetLayer(-1);
+	EXPECT_EQ(drawnEntities(), std::vector<Entity>({ entities[4], entities[1], entities[3], entities[0] }));
+	engine.Destroy();
+}
+
 TEST(Graphics2d, TestTexture)
 {
 	sfge::Engine engine;
@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <gtest/gtest.h>
+
+#include <engine/job_system.h>
+
+TEST(JobSystem, ParallelFor)
+{
+	for (size_t workerNmb : {size_t(0), sfge::JobSystem::GetDefaultWorkerNmb(), size_t(3)})
+	{
+		sfge::JobSystem jobSystem;
+		jobSystem.Init(workerNmb);
+		EXPECT_EQ(jobSystem.GetThreadNmb(), workerNmb + 1);
+
+		std::vector<int> values(100'000, 0);
+		jobSystem.ParallelFor(0, values.size(), 64, [&values](size_t start, size_t end)
+		{
+			for (auto i = start; i < end; i++)
+				values[i]++;
+		});
+		EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 100'000);
+		jobSystem.Destroy();
+	}
+}
+
+TEST(JobSystem, NestedJobs)
+{
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(3);
+
+	std::atomic<size_t> count{ 0 };
+	jobSystem.ParallelFor(0, 16, 1, [&jobSystem, &count](size_t start, size_t end)
+	{
+		for (auto i = start; i < end; i++)
+		{
+			//A job waiting on its own jobs keeps running the others instead of blocking its thread
+			sfge::JobGroup group;
+			for (int j = 0; j < 8; j++)
+			{
+				jobSystem.Schedule(group, [&count]() { count++; });
+			}
+			jobSystem.Wait(group);
+		}
+	});
+	EXPECT_EQ(count.load(), 16u * 8u);
+}
+
+TEST(JobSystem, JobGraph)
+{
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(3);
+
+	std::vector<int> order;
+	std::mutex orderMutex;
+	auto record = [&order, &orderMutex](int value)
+	{
+		return [&order, &orderMutex, value]()
+		{
+			std::lock_guard<std::mutex> lock(orderMutex);
+			order.push_back(value);
+		};
+	};
+	sfge::JobGraph graph;
+	const auto first = graph.AddJob(record(0));
+	const auto left = graph.AddJob(record(1));
+	const auto right = graph.AddJob(record(1));
+	const auto last = graph.AddJob(record(2));
+	graph.AddDependency(left, first);
+	graph.AddDependency(right, first);
+	graph.AddDependency(last, left);
+	graph.AddDependency(last, right);
+	graph.Run(jobSystem);
+	EXPECT_EQ(order, std::vector<int>({ 0, 1, 1, 2 }));
+
+	//A cycle is rejected instead of waiting forever
+	graph.AddDependency(first, last);
+	order.clear();
+	graph.Run(jobSystem);
+	EXPECT_TRUE(order.empty());
+}
+
+TEST(JobSystem, ParallelForPerformance)
+{
+	//Wall clock time, std::clock adds up the time of every thread
+	const size_t valueNmb = 10'000'000;
+	std::vector<float> values(valueNmb, 1.0f);
+	auto work = [&values](size_t start, size_t end)
+	{
+		for (auto i = start; i < end; i++)
+			values[i] = values[i] * 0.5f + 1.0f;
+	};
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(sfge::JobSystem::GetDefaultWorkerNmb());
+
+	auto timer = std::chrono::high_resolution_clock::now();
+	work(0, valueNmb);
+	const auto durationSingle = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - timer).count();
+
+	timer = std::chrono::high_resolution_clock::now();
+	jobSystem.ParallelFor(0, valueNmb, 0, work);
+	const auto durationParallel = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - timer).count();
+
+	std::cout << "\n" << valueNmb << " values on one thread : " << durationSingle << " ms"
+		<< "\tParallelFor on " << jobSystem.GetThreadNmb() << " threads : " << durationParallel << " ms\n";
+}
@@ -126,10 +126,7 @@ TEST(AI, PathfindingTilemap)
 	behaviourTree->SetRootNode(sfge::ext::behavior_tree::BehaviorTreeUtility::LoadNodesFromJson(*sceneJsonPtr, behaviourTree));
 
 	auto dwarfManager = engine.GetPythonEngine()->GetPySystemManager().GetPySystem<sfge::ext::DwarfManager>("DwarfManager");
-	for (auto i = 0; i < 100'000; i++)
-	{
-		dwarfManager->InstantiateDwarf(sfge::Vec2f(0, 0));
-	}
+	dwarfManager->InstantiateDwarfs(std::vector<sfge::Vec2f>(100'000, sfge::Vec2f(0, 0)));
 
 	//Start engine
 	engine.Start();
@@ -23,6 +23,7 @@ SOFTWARE.
 */
 #include <engine/engine.h>
 #include <engine/scene.h>
+#include <engine/transform2d.h>
 #include <gtest/gtest.h>
 
 TEST(Physics, TestBallFallingToGround)
@@ -34,4 +35,37 @@ TEST(Physics, TestBallFallingToGround)
 
 	sceneManager->LoadSceneFromPath("data/scenes/test_physics.scene");
 	engine.Start();
-}
\ No newline at end of file
+}
+
+TEST(Physics, HeadlessStep)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	config->fixedStepInterpolation = false;
+	engine.Init(std::move(config));
+
+	json transformJson;
+	transformJson["type"] = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+	transformJson["position"] = { 0, 0 };
+	json bodyJson;
+	bodyJson["type"] = static_cast<int>(sfge::ComponentType::BODY2D);
+	bodyJson["body_type"] = static_cast<int>(b2_dynamicBody);
+	json entityJson;
+	entityJson["components"] = json::array({ transformJson, bodyJson });
+	json sceneJson;
+	sceneJson["name"] = "Headless Step";
+	sceneJson["entities"] = json::array({ entityJson });
+	engine.GetSceneManager()->LoadSceneFromJson(sceneJson);
+
+	//Without window the frames are stepped by hand with a fixed dt
+	const auto fixedDeltaTime = engine.GetConfig()->fixedDeltaTime;
+	for (int frame = 0; frame < 50; frame++)
+	{
+		engine.Step(fixedDeltaTime);
+	}
+	EXPECT_GT(engine.GetTransform2dManager()->GetComponentRef(1).Position.y, 0.0f);
+	engine.Destroy();
+}
@@ -22,9 +22,23 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
 #include <engine/engine.h>
 #include <engine/scene.h>
+#include <engine/scene_binary.h>
+#include <engine/scene_index.h>
+#include <engine/component.h>
+#include <engine/config.h>
+#include <engine/transform2d.h>
+#include <graphics/shape2d.h>
 #include <utility/json_utility.h>
+#include <utility/file_utility.h>
 #include <gtest/gtest.h>
 
 TEST(Scene, TestSwitchScene)
@@ -58,4 +72,367 @@ TEST(Scene, TestSwitchSceneLeak)
 
 
 
-}
\ No newline at end of file
+}
+
+json CreateBinaryTestScene(size_t entityNmb)
+{
+	json sceneJson;
+	sceneJson["name"] = "Binary Scene";
+	sceneJson["systems"] = json::array();
+	sceneJson["entities"] = json::array();
+	for (size_t i = 0; i < entityNmb; i++)
+	{
+		json transformJson;
+		transformJson["type"] = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+		transformJson["position"] = { static_cast<float>(i), 2.0f * i };
+		transformJson["angle"] = 45.0f;
+		json entityJson;
+		entityJson["name"] = "Entity " + std::to_string(i);
+		entityJson["components"] = json::array({ transformJson });
+		if (i % 2 == 0)
+		{
+			json shapeJson;
+			shapeJson["type"] = static_cast<int>(sfge::ComponentType::SHAPE2D);
+			shapeJson["shape_type"] = static_cast<int>(sfge::ShapeType::CIRCLE);
+			shapeJson["radius"] = 5.0f;
+			entityJson["components"].push_back(shapeJson);
+		}
+		sceneJson["entities"].push_back(entityJson);
+	}
+	return sceneJson;
+}
+
+TEST(Scene, BinaryLayout)
+{
+	auto sceneJson = CreateBinaryTestScene(10);
+	json spriteJson;
+	spriteJson["type"] = static_cast<int>(sfge::ComponentType::SPRITE2D);
+	spriteJson["path"] = "data/sprites/other_play.png";
+	spriteJson["layer"] = -1;
+	sceneJson["entities"][3]["components"].push_back(spriteJson);
+	sceneJson["entities"][7]["components"].push_back(spriteJson);
+
+	std::vector<std::byte> binary;
+	ASSERT_TRUE(sfge::CompileScene(sceneJson, binary));
+	const sfge::SceneBinaryView sceneBinary(binary.data(), binary.size());
+	ASSERT_TRUE(sceneBinary.IsValid());
+	EXPECT_EQ(sceneBinary.GetEntityNmb(), 10u);
+	EXPECT_EQ(sceneBinary.GetEntityName(4), "Entity 4");
+	EXPECT_EQ(sceneBinary.GetMetaJson()["name"], "Binary Scene");
+	//Transform, sprite and shape, in increasing type order
+	ASSERT_EQ(sceneBinary.GetBlockNmb(), 3u);
+
+	const auto transformBlock = sceneBinary.GetBlock(0);
+	EXPECT_EQ(transformBlock.componentType, sfge::ComponentType::TRANSFORM2D);
+	EXPECT_EQ(transformBlock.encoding, sfge::SceneBlockEncoding::SOA);
+	ASSERT_EQ(transformBlock.count, 10u);
+	EXPECT_EQ(transformBlock.entityIndices[9], 9u);
+	EXPECT_FLOAT_EQ(transformBlock.GetFloatColumn(1)[9], 18.0f);
+	EXPECT_FLOAT_EQ(transformBlock.GetFloatColumn(2)[9], 1.0f);
+	EXPECT_FLOAT_EQ(transformBlock.GetFloatColumn(4)[9], 45.0f);
+
+	const auto spriteBlock = sceneBinary.GetBlock(1);
+	ASSERT_EQ(spriteBlock.count, 2u);
+	EXPECT_EQ(spriteBlock.entityIndices[1], 7u);
+	//The path is stored once for both sprites
+	EXPECT_EQ(spriteBlock.GetUintColumn(0)[0], spriteBlock.GetUintColumn(0)[1]);
+	EXPECT_EQ(spriteBlock.GetString(spriteBlock.GetUintColumn(0)[0]), "data/sprites/other_play.png");
+	EXPECT_EQ(spriteBlock.GetIntColumn(1)[1], -1);
+
+	const auto shapeBlock = sceneBinary.GetBlock(2);
+	EXPECT_EQ(shapeBlock.encoding, sfge::SceneBlockEncoding::CBOR);
+	ASSERT_EQ(shapeBlock.count, 5u);
+	EXPECT_EQ(shapeBlock.GetComponentJson(2), sceneJson["entities"][4]["components"][1]);
+
+	//Another version or a truncated file is refused
+	auto outdatedBinary = binary;
+	const std::uint32_t oldVersion = sfge::SCENE_BINARY_VERSION + 1;
+	std::memcpy(outdatedBinary.data() + sizeof(std::uint32_t), &oldVersion, sizeof(oldVersion));
+	EXPECT_FALSE(sfge::SceneBinaryView(outdatedBinary.data(), outdatedBinary.size()).IsValid());
+	EXPECT_FALSE(sfge::SceneBinaryView(binary.data(), binary.size() / 2).IsValid());
+}
+
+TEST(Scene, CompiledSceneLoading)
+{
+	const size_t entityNmb = 200'000;
+	const std::string scenePath = "data/scenes/binary_test.scene";
+	auto sceneJson = CreateBinaryTestScene(entityNmb);
+	{
+		std::ofstream sceneFile(scenePath);
+		sceneFile << sceneJson;
+	}
+
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* sceneManager = engine.GetSceneManager();
+
+	auto timer = std::chrono::high_resolution_clock::now();
+	sceneManager->LoadSceneFromPath(scenePath);
+	const auto jsonDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::high_resolution_clock::now() - timer).count();
+
+	ASSERT_TRUE(sfge::CompileSceneFile(scenePath, sfge::GetCompiledScenePath(scenePath)));
+	timer = std::chrono::high_resolution_clock::now();
+	sceneManager->LoadSceneFromPath(scenePath);
+	const auto binaryDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::high_resolution_clock::now() - timer).count();
+
+	auto* entityManager = engine.GetEntityManager();
+	EXPECT_EQ(entityManager->GetAliveEntities().Count(), entityNmb);
+	EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), entityNmb);
+	EXPECT_EQ(entityManager->View(static_cast<sfge::EntityMask>(sfge::ComponentType::SHAPE2D)).Count(), entityNmb / 2);
+	const auto& transform = engine.GetTransform2dManager()->GetComponentRef(static_cast<Entity>(entityNmb));
+	EXPECT_FLOAT_EQ(transform.Position.y, 2.0f * (entityNmb - 1));
+	EXPECT_FLOAT_EQ(transform.EulerAngle, 45.0f);
+
+	std::cout << "\nLoad " << entityNmb << " entities from json: " << jsonDuration << " ms\tfrom binary: " <<
+		binaryDuration << " ms\n";
+	engine.Destroy();
+	std::remove(scenePath.c_str());
+	std::remove(sfge::GetCompiledScenePath(scenePath).c_str());
+}
+
+TEST(Scene, BatchedLoading)
+{
+	const size_t entityNmb = 100'000;
+	auto sceneJson = CreateBinaryTestScene(entityNmb);
+
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* sceneManager = engine.GetSceneManager();
+	sceneManager->LoadSceneFromJson(sceneJson);
+
+	auto* transformManager = engine.GetTransform2dManager();
+	for (Entity entity = 1; entity <= entityNmb; entity += 997)
+	{
+		const auto& transform = transformManager->GetComponentRef(entity);
+		EXPECT_FLOAT_EQ(transform.Position.x, static_cast<float>(entity - 1));
+		EXPECT_FLOAT_EQ(transform.Position.y, 2.0f * (entity - 1));
+		EXPECT_FLOAT_EQ(transform.EulerAngle, 45.0f);
+	}
+	EXPECT_EQ(engine.GetEntityManager()->View<sfge::Transform2d>().Count(), entityNmb);
+
+	//One bulk creation per component type, the transforms first
+	const auto& loadingTimes = sceneManager->GetLoadingTimes();
+	ASSERT_EQ(loadingTimes.components.size(), 2u);
+	EXPECT_EQ(loadingTimes.components[0].first, sfge::ComponentType::TRANSFORM2D);
+	EXPECT_EQ(loadingTimes.components[1].first, sfge::ComponentType::SHAPE2D);
+	std::cout << "\nLoad " << entityNmb << " entities: grouping " << loadingTimes.entities / 1000.0 <<
+		" ms\ttransforms " << loadingTimes.components[0].second / 1000.0 << " ms\tshapes " <<
+		loadingTimes.components[1].second / 1000.0 << " ms\n";
+	engine.Destroy();
+}
+
+TEST(Scene, SceneIndex)
+{
+	const std::string dataDirname = "scene_index_test";
+	const std::string manifestPath = "scene_index_test.json";
+	sfge::RemoveDirectory(dataDirname);
+	sfge::CreateDirectory(dataDirname);
+	sfge::CreateDirectory(dataDirname + "/nested");
+	{
+		//The name comes after a large entity array and is escaped
+		auto sceneJson = CreateBinaryTestScene(10'000);
+		sceneJson["name"] = "Large \"Scene\"";
+		std::ofstream(dataDirname + "/nested/large.scene") << sceneJson;
+		std::ofstream(dataDirname + "/small.scene") << R"({"entities":[{"name":"name"}], "name": "Small"})";
+		std::ofstream(dataDirname + "/unnamed.scene") << R"({"entities":[]})";
+	}
+	EXPECT_EQ(sfge::ReadSceneName(dataDirname + "/nested/large.scene"), "Large \"Scene\"");
+	EXPECT_EQ(sfge::ReadSceneName(dataDirname + "/small.scene"), "Small");
+	EXPECT_EQ(sfge::ReadSceneName(dataDirname + "/unnamed.scene"), "");
+
+	sfge::SceneIndex sceneIndex;
+	EXPECT_FALSE(sceneIndex.Load(manifestPath));
+	EXPECT_EQ(sceneIndex.Update(dataDirname), 3u);
+	ASSERT_TRUE(sceneIndex.Save(manifestPath));
+
+	//Nothing changed, every name comes from the manifest
+	sfge::SceneIndex cachedIndex;
+	ASSERT_TRUE(cachedIndex.Load(manifestPath));
+	EXPECT_EQ(cachedIndex.Update(dataDirname), 0u);
+	EXPECT_FALSE(cachedIndex.IsDirty());
+	EXPECT_EQ(cachedIndex.GetEntries().at(dataDirname + "/small.scene").name, "Small");
+
+	std::ofstream(dataDirname + "/small.scene") << R"({"name": "Renamed", "entities":[]})";
+	std::remove((dataDirname + "/unnamed.scene").c_str());
+	EXPECT_EQ(cachedIndex.Update(dataDirname), 1u);
+	EXPECT_TRUE(cachedIndex.IsDirty());
+	EXPECT_EQ(cachedIndex.GetEntries().size(), 2u);
+	EXPECT_EQ(cachedIndex.GetEntries().at(dataDirname + "/small.scene").name, "Renamed");
+
+	sfge::RemoveDirectory(dataDirname);
+	std::remove(manifestPath.c_str());
+}
+
+TEST(Scene, StreamingLoading)
+{
+	const size_t entityNmb = 100'000;
+	const std::string scenePath = "streaming_test.scene";
+	std::remove(sfge::GetCompiledScenePath(scenePath).c_str());
+	std::ofstream(scenePath) << CreateBinaryTestScene(entityNmb);
+
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* sceneManager = engine.GetSceneManager();
+	auto* entityManager = engine.GetEntityManager();
+	auto currentSceneJson = CreateBinaryTestScene(10);
+	sceneManager->LoadSceneFromJson(currentSceneJson);
+	EXPECT_FALSE(sceneManager->IsLoadingScene());
+
+	ASSERT_TRUE(sceneManager->LoadSceneFromPathAsync(scenePath));
+	EXPECT_FALSE(sceneManager->LoadSceneFromPathAsync(scenePath));
+	//The current scene keeps running until the new one is swapped in, its components are then created over frames
+	size_t frameNmb = 0;
+	size_t instantiationFrameNmb = 0;
+	const auto shapeMask = static_cast<sfge::EntityMask>(sfge::ComponentType::SHAPE2D);
+	while (sceneManager->IsLoadingScene() && frameNmb < 100'000)
+	{
+		const auto transformNmb = entityManager->View<sfge::Transform2d>().Count();
+		const auto shapeNmb = entityManager->View(shapeMask).Count();
+		const auto readyToInstantiate = sceneManager->IsSceneReadyToInstantiate();
+		const auto instantiating = sceneManager->IsInstantiatingScene();
+		engine.Step(1.0f / 60.0f);
+		frameNmb++;
+		if (!instantiating && sceneManager->IsInstantiatingScene())
+		{
+			//The Engine is told the frame before the current scene is cleared, in time to keep its last frame
+			EXPECT_TRUE(readyToInstantiate);
+		}
+		if (!sceneManager->IsInstantiatingScene())
+		{
+			//Nothing of the new scene exists before the swap
+			if (sceneManager->IsLoadingScene())
+			{
+				EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), 10u);
+			}
+			continue;
+		}
+
+		//Swapped in, the transforms are created whole and the shapes a chunk at least per step
+		EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), entityNmb);
+		const auto createdShapeNmb = entityManager->View(shapeMask).Count() - (transformNmb == entityNmb ? shapeNmb : 0);
+		EXPECT_EQ(createdShapeNmb % sfge::SCENE_STREAMING_COMPONENT_CHUNK, 0u);
+		if (transformNmb == entityNmb)
+		{
+			EXPECT_GE(createdShapeNmb, sfge::SCENE_STREAMING_COMPONENT_CHUNK);
+		}
+		//No system ran on the new scene, its world transforms are not computed yet
+		EXPECT_FLOAT_EQ(engine.GetTransform2dManager()->GetWorldTransform(entityNmb).Position.x, 0.0f);
+		instantiationFrameNmb++;
+	}
+	ASSERT_FALSE(sceneManager->IsLoadingScene());
+	EXPECT_FLOAT_EQ(sceneManager->GetLoadingProgress(), 1.0f);
+	EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), entityNmb);
+	EXPECT_EQ(entityManager->View(shapeMask).Count(), entityNmb / 2);
+	//The first step after the swap runs the systems on the whole scene
+	engine.Step(1.0f / 60.0f);
+	EXPECT_FLOAT_EQ(engine.GetTransform2dManager()->GetWorldTransform(entityNmb).Position.x,
+		static_cast<float>(entityNmb - 1));
+
+	//The shapes were created in budgeted chunks, no step did the whole swap
+	EXPECT_GT(instantiationFrameNmb, 1u);
+	const auto& loadingTimes = sceneManager->GetLoadingTimes();
+	std::cout << "\nStream " << entityNmb << " entities over " << frameNmb << " frames: loading thread " <<
+		loadingTimes.parse / 1000.0 << " ms\tswap " << (loadingTimes.GetTotal() - loadingTimes.parse) / 1000.0 <<
+		" ms\n";
+
+	//Destroying the scene manager cancels a streaming in flight, the current scene stays
+	ASSERT_TRUE(sceneManager->LoadSceneFromPathAsync(scenePath));
+	sceneManager->Destroy();
+	EXPECT_FALSE(sceneManager->IsLoadingScene());
+	engine.Step(1.0f / 60.0f);
+	EXPECT_EQ(entityManager->View(shapeMask).Count(), entityNmb / 2);
+	engine.Destroy();
+	std::remove(scenePath.c_str());
+}
+
+TEST(Scene, DeferredLoading)
+{
+	const std::string scenePath = "deferred_test.scene";
+	std::remove(sfge::GetCompiledScenePath(scenePath).c_str());
+	std::ofstream(scenePath) << CreateBinaryTestScene(20);
+
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* sceneManager = engine.GetSceneManager();
+	auto* entityManager = engine.GetEntityManager();
+	auto currentSceneJson = CreateBinaryTestScene(10);
+	sceneManager->LoadSceneFromJson(currentSceneJson);
+
+	//Out of the main thread, like a script of the pipelined simulation, the load waits for the next frame
+	std::thread([sceneManager, &scenePath]() { sceneManager->LoadSceneFromPath(scenePath); }).join();
+	EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), 10u);
+	engine.Step(1.0f / 60.0f);
+	EXPECT_EQ(entityManager->View<sfge::Transform2d>().Count(), 20u);
+	engine.Destroy();
+	std::remove(scenePath.c_str());
+}
+
+TEST(Scene, PrefabInstantiation)
+{
+	const size_t entityNmb = 10'000;
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->editor = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* sceneManager = engine.GetSceneManager();
+	auto* entityManager = engine.GetEntityManager();
+
+	json transformJson;
+	transformJson["type"] = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+	transformJson["position"] = { 1.0f, 2.0f };
+	json shapeJson;
+	shapeJson["type"] = static_cast<int>(sfge::ComponentType::SHAPE2D);
+	shapeJson["shape_type"] = static_cast<int>(sfge::ShapeType::CIRCLE);
+	shapeJson["radius"] = 5.0f;
+	json prefabJson;
+	prefabJson["name"] = "Circle";
+	prefabJson["components"] = json::array({ shapeJson, transformJson });
+	const auto* prefab = sceneManager->LoadPrefabFromJson("Circle", prefabJson);
+	ASSERT_NE(prefab, nullptr);
+	//Resolved once and ordered by component type
+	ASSERT_EQ(prefab->components.size(), 2u);
+	EXPECT_EQ(prefab->components[0].componentType, sfge::ComponentType::TRANSFORM2D);
+
+	std::vector<sfge::Vec2f> positions;
+	positions.reserve(entityNmb);
+	for (size_t i = 0; i < entityNmb; i++)
+	{
+		positions.emplace_back(static_cast<float>(i), 0.0f);
+	}
+	const auto timer = std::chrono::high_resolution_clock::now();
+	const auto entities = sceneManager->InstantiatePrefab(*prefab, positions);
+	const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now() - timer).count();
+
+	ASSERT_EQ(entities.size(), entityNmb);
+	EXPECT_EQ(entities[entityNmb - 1], entities.first + entityNmb - 1);
+	const auto view = entityManager->View(static_cast<sfge::EntityMask>(sfge::ComponentType::TRANSFORM2D) |
+		static_cast<sfge::EntityMask>(sfge::ComponentType::SHAPE2D));
+	EXPECT_EQ(view.Count(), entityNmb);
+	const auto& transform = engine.GetTransform2dManager()->GetComponentRef(entities[entityNmb - 1]);
+	EXPECT_FLOAT_EQ(transform.Position.x, static_cast<float>(entityNmb - 1) + 1.0f);
+	EXPECT_FLOAT_EQ(transform.Position.y, 2.0f);
+
+	std::cout << "\nInstantiate " << entityNmb << " entities from a prefab : " << duration / 1000.0 << " ms\n";
+	engine.Destroy();
+}
@@ -0,0 +1,390 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <engine/engine.h>
+#include <engine/component.h>
+#include <engine/system_graph.h>
+#include <engine/system_profiler.h>
+#include <engine/frame_budget.h>
+#include <engine/scene.h>
+#include <graphics/graphics2d.h>
+#include <physics/physics2d.h>
+#include <python/python_engine.h>
+#include <utility/json_utility.h>
+
+/**
+ * \brief System declaring its component accesses
+ */
+class AccessSystem : public sfge::System
+{
+public:
+	AccessSystem(sfge::Engine& engine, int readComponents, int writeComponents) : System(engine)
+	{
+		DeclareAccess(readComponents, writeComponents);
+	}
+};
+
+TEST(SystemGraph, Dependencies)
+{
+	sfge::Engine engine;
+	const auto transform = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+	const auto shape = static_cast<int>(sfge::ComponentType::SHAPE2D);
+	const auto sound = static_cast<int>(sfge::ComponentType::SOUND);
+	AccessSystem transformSystem(engine, transform, transform);
+	AccessSystem soundSystem(engine, 0, sound);
+	AccessSystem shapeSystem(engine, transform, shape);
+	sfge::System exclusiveSystem(engine);
+
+	std::mutex orderMutex;
+	std::vector<std::string> order;
+	auto record = [&order, &orderMutex](const std::string& name)
+	{
+		return [&order, &orderMutex, name](float)
+		{
+			std::lock_guard<std::mutex> lock(orderMutex);
+			order.push_back(name);
+		};
+	};
+	sfge::SystemGraph graph;
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Transform", transformSystem, record("Transform"));
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Sound", soundSystem, record("Sound"));
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Shape", shapeSystem, record("Shape"));
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Exclusive", exclusiveSystem, record("Exclusive"));
+	graph.Build();
+
+	const auto& nodes = graph.GetNodes(sfge::FramePhase::UPDATE);
+	EXPECT_TRUE(nodes[1].dependencies.empty());
+	EXPECT_EQ(nodes[2].dependencies, std::vector<size_t>({ 0 }));
+	EXPECT_EQ(nodes[3].dependencies, std::vector<size_t>({ 0, 1, 2 }));
+
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(3);
+	for (int frame = 0; frame < 100; frame++)
+	{
+		order.clear();
+		graph.Run(sfge::FramePhase::UPDATE, 0.016f, jobSystem);
+		ASSERT_EQ(order.size(), 4u);
+		const auto position = [&order](const std::string& name)
+		{
+			return std::find(order.begin(), order.end(), name) - order.begin();
+		};
+		EXPECT_LT(position("Transform"), position("Shape"));
+		EXPECT_EQ(order.back(), "Exclusive");
+	}
+	EXPECT_TRUE(graph.GetNodes(sfge::FramePhase::INPUT).empty());
+}
+
+TEST(SystemGraph, IndependentSystems)
+{
+	sfge::Engine engine;
+	const auto sprite = static_cast<int>(sfge::ComponentType::SPRITE2D);
+	const auto sound = static_cast<int>(sfge::ComponentType::SOUND);
+	AccessSystem spriteSystem(engine, 0, sprite);
+	AccessSystem soundSystem(engine, 0, sound);
+	sfge::SystemGraph graph;
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Sprite", spriteSystem, [](float) {});
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Sound", soundSystem, [](float) {});
+	graph.Build();
+	const auto& nodes = graph.GetNodes(sfge::FramePhase::UPDATE);
+	EXPECT_EQ(nodes[0].segment, nodes[1].segment);
+	EXPECT_TRUE(nodes[1].dependencies.empty());
+
+	//The engine systems declare their accesses, the transforms of the world and of the UI are updated together
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	EXPECT_FALSE(engine.GetPhysicsManager()->GetAccess().exclusive);
+	EXPECT_FALSE(engine.GetPythonEngine()->GetAccess().exclusive);
+	EXPECT_FALSE(engine.GetGraphics2dManager()->GetAccess().exclusive);
+	EXPECT_FALSE(engine.GetSceneManager()->GetAccess().exclusive);
+	const auto& renderNodes = engine.GetSystemGraph().GetNodes(sfge::FramePhase::RENDER_PREP);
+	const auto findNode = [&renderNodes](const std::string& name)
+	{
+		return std::find_if(renderNodes.begin(), renderNodes.end(),
+			[&name](const sfge::SystemNode& node) { return node.name == name; });
+	};
+	const auto transformNode = findNode("Transform2dManager");
+	const auto rectTransformNode = findNode("RectTransformManager");
+	ASSERT_NE(transformNode, renderNodes.end());
+	ASSERT_NE(rectTransformNode, renderNodes.end());
+	EXPECT_EQ(transformNode->segment, rectTransformNode->segment);
+	const auto transformIndex = static_cast<size_t>(transformNode - renderNodes.begin());
+	EXPECT_EQ(std::find(rectTransformNode->dependencies.begin(), rectTransformNode->dependencies.end(), transformIndex),
+		rectTransformNode->dependencies.end());
+	engine.Destroy();
+}
+
+TEST(SystemGraph, Profiler)
+{
+	sfge::ProfileRingBuffer ringBuffer;
+	ringBuffer.Resize(8);
+	for (int i = 0; i < 20; i++)
+	{
+		ringBuffer.Push({ "Sample", i, 1 });
+	}
+	const auto samples = ringBuffer.GetSamples();
+	ASSERT_EQ(samples.size(), 8u);
+	EXPECT_EQ(samples.front().start, 12);
+	EXPECT_EQ(samples.back().start, 19);
+
+	sfge::Engine engine;
+	const auto transform = static_cast<int>(sfge::ComponentType::TRANSFORM2D);
+	AccessSystem transformSystem(engine, transform, transform);
+	AccessSystem soundSystem(engine, 0, static_cast<int>(sfge::ComponentType::SOUND));
+
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(3);
+	sfge::SystemProfiler profiler;
+	profiler.Init(jobSystem, 1024);
+	profiler.SetEnabled(true);
+
+	sfge::SystemGraph graph;
+	graph.SetProfiler(&profiler);
+	graph.AddSystem(sfge::FramePhase::UPDATE, "Transform", transformSystem, [](float) {});
+	graph.AddSystem(sfge::FramePhase::FIXED_UPDATE, "Sound", soundSystem, [](float) {});
+	graph.Build();
+	const int frameNmb = 100;
+	for (int frame = 0; frame < frameNmb; frame++)
+	{
+		graph.Run(sfge::FramePhase::FIXED_UPDATE, 0.02f, jobSystem);
+		graph.Run(sfge::FramePhase::UPDATE, 0.016f, jobSystem);
+	}
+
+	const auto stats = profiler.ComputeStats();
+	ASSERT_EQ(stats.size(), 2u);
+	EXPECT_EQ(stats[0].name, "Fixed Update/Sound");
+	EXPECT_EQ(stats[1].name, "Update/Transform");
+	for (const auto& systemStats : stats)
+	{
+		EXPECT_EQ(systemStats.sampleNmb, static_cast<size_t>(frameNmb));
+		EXPECT_LE(systemStats.min, systemStats.avg);
+		EXPECT_LE(systemStats.avg, systemStats.p99);
+	}
+
+	const std::string tracePath = "system_graph_trace.json";
+	ASSERT_TRUE(profiler.ExportChromeTrace(tracePath));
+	const auto traceJson = sfge::LoadJson(tracePath);
+	ASSERT_NE(traceJson, nullptr);
+	EXPECT_EQ((*traceJson)["traceEvents"].size(), static_cast<size_t>(2 * frameNmb));
+	EXPECT_EQ((*traceJson)["traceEvents"][0]["ph"], "X");
+	std::remove(tracePath.c_str());
+
+	//A thread outside the job system does not write in the buffer of the main thread
+	profiler.Clear();
+	std::thread([&profiler]()
+	{
+		const auto now = sfge::ProfilerClock::now();
+		profiler.Record("Loading", now, now);
+	}).join();
+	EXPECT_TRUE(profiler.ComputeStats().empty());
+
+	//The names are escaped in the trace
+	const auto now = sfge::ProfilerClock::now();
+	profiler.Record(profiler.InternName("Py \"System\"\\"), now, now);
+	ASSERT_TRUE(profiler.ExportChromeTrace(tracePath));
+	const auto escapedTraceJson = sfge::LoadJson(tracePath);
+	ASSERT_NE(escapedTraceJson, nullptr);
+	EXPECT_EQ((*escapedTraceJson)["traceEvents"][0]["name"], "Py \"System\"\\");
+	std::remove(tracePath.c_str());
+
+	profiler.SetEnabled(false);
+	profiler.Clear();
+	graph.Run(sfge::FramePhase::UPDATE, 0.016f, jobSystem);
+	EXPECT_TRUE(profiler.ComputeStats().empty());
+	jobSystem.Destroy();
+}
+
+/**
+ * \brief System declaring its tick policy
+ */
+class TickSystem : public sfge::System
+{
+public:
+	TickSystem(sfge::Engine& engine, float frequency, size_t staggerFrameNmb) : System(engine)
+	{
+		SetTickRate(frequency);
+		SetStaggerFrameNmb(staggerFrameNmb);
+	}
+};
+
+TEST(SystemGraph, TickRate)
+{
+	sfge::Engine engine;
+	TickSystem economySystem1(engine, 2.0f, 1);
+	TickSystem economySystem2(engine, 2.0f, 1);
+	TickSystem staggeredSystem(engine, 0.0f, 4);
+
+	std::vector<int> economyFrames1;
+	std::vector<int> economyFrames2;
+	std::vector<size_t> processed(10, 0);
+	int frame = 0;
+	sfge::SystemGraph graph;
+	graph.AddSystem(sfge::FramePhase::FIXED_UPDATE, "Economy1", economySystem1, [&](float dt)
+	{
+		economyFrames1.push_back(frame);
+		EXPECT_EQ(economySystem1.GetTickState().stepNmb, 4u);
+		EXPECT_NEAR(dt, 0.5f, 0.001f);
+	});
+	graph.AddSystem(sfge::FramePhase::FIXED_UPDATE, "Economy2", economySystem2, [&](float)
+	{
+		economyFrames2.push_back(frame);
+	});
+	graph.AddSystem(sfge::FramePhase::FIXED_UPDATE, "Staggered", staggeredSystem, [&](float)
+	{
+		const auto range = sfge::GetStaggerRange(processed.size(), 4, staggeredSystem.GetTickState().staggerFrame);
+		for (auto i = range.begin; i < range.end; i++)
+		{
+			processed[i]++;
+		}
+	});
+	graph.Build();
+
+	sfge::JobSystem jobSystem;
+	jobSystem.Init(0);
+	for (frame = 0; frame < 100; frame++)
+	{
+		graph.Run(sfge::FramePhase::FIXED_UPDATE, 0.125f, jobSystem);
+		if (frame == 3)
+		{
+			//Each entity processed once every 4 frames
+			EXPECT_EQ(processed, std::vector<size_t>(10, 1));
+			EXPECT_FLOAT_EQ(staggeredSystem.GetTickState().staggerDeltaTime, 0.5f);
+		}
+	}
+	//12.5 seconds at 2 Hz, the two systems are spread half a period apart
+	EXPECT_EQ(economyFrames1.size(), 25u);
+	ASSERT_EQ(economyFrames2.size(), 25u);
+	for (size_t i = 0; i < economyFrames1.size(); i++)
+	{
+		EXPECT_NE(economyFrames1[i], economyFrames2[i]);
+	}
+	EXPECT_EQ(processed, std::vector<size_t>(10, 25));
+	jobSystem.Destroy();
+}
+
+TEST(SystemGraph, FrameBudget)
+{
+	sfge::FrameBudget frameBudget;
+	frameBudget.Init(16'000);
+	const auto id = frameBudget.RegisterWorkload("PathFinding", 100, 1'000);
+	EXPECT_EQ(frameBudget.RegisterWorkload("PathFinding", 0, 0), id);
+	EXPECT_EQ(frameBudget.GetBudget(id), 1'000);
+
+	//Late frames shrink the budget down to its min
+	frameBudget.EndFrame(20'000);
+	EXPECT_EQ(frameBudget.GetBudget(id), 750);
+	for (int frame = 0; frame < 20; frame++)
+	{
+		frameBudget.EndFrame(20'000);
+	}
+	EXPECT_EQ(frameBudget.GetBudget(id), 100);
+	//Fast frames grow it back once the average has the headroom
+	for (int frame = 0; frame < 100; frame++)
+	{
+		frameBudget.EndFrame(5'000);
+	}
+	EXPECT_EQ(frameBudget.GetBudget(id), 1'000);
+
+	frameBudget.BeginFrame();
+	{
+		sfge::BudgetTimer budgetTimer(frameBudget, id);
+		EXPECT_TRUE(budgetTimer.HasTimeLeft());
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		EXPECT_FALSE(budgetTimer.HasTimeLeft());
+	}
+	EXPECT_LE(frameBudget.GetRemaining(id), -1'000);
+	frameBudget.EndFrame(10'000);
+	EXPECT_GE(frameBudget.GetWorkloads()[id].lastUsed, 2'000);
+	EXPECT_EQ(frameBudget.GetRemaining(id), frameBudget.GetBudget(id));
+
+	frameBudget.SetEnabled(false);
+	frameBudget.EndFrame(50'000);
+	EXPECT_EQ(frameBudget.GetBudget(id), 1'000);
+}
+
+TEST(SystemGraph, BudgetCursorFairness)
+{
+	//Four stagger slices of dwarfs under a budget that only lets one chunk run each frame
+	const size_t sliceNmb = 4;
+	const size_t chunkSize = 8;
+	const std::vector<size_t> sliceCounts = { 50, 37, 64, 21 };
+	sfge::BudgetCursor budgetCursor(sliceNmb);
+	std::vector<std::vector<int>> lastTicked(sliceNmb);
+	for (size_t slice = 0; slice < sliceNmb; slice++)
+	{
+		lastTicked[slice].resize(sliceCounts[slice], -1);
+	}
+
+	const int frameNmb = 200;
+	for (int frame = 0; frame < frameNmb; frame++)
+	{
+		const auto slice = frame % sliceNmb;
+		const auto count = sliceCounts[slice];
+		const auto doneNmb = budgetCursor.Run(slice, count, chunkSize, []() { return false; },
+			[&](size_t begin, size_t end)
+		{
+			ASSERT_LE(end, count);
+			for (auto i = begin; i < end; i++)
+			{
+				//Ticked again at the latest once the cursor went around its own slice
+				const auto runsPerTurn = static_cast<int>((count + chunkSize - 1) / chunkSize) + 1;
+				if (lastTicked[slice][i] >= 0)
+				{
+					EXPECT_LE(frame - lastTicked[slice][i], runsPerTurn * static_cast<int>(sliceNmb));
+				}
+				lastTicked[slice][i] = frame;
+			}
+		});
+		EXPECT_GE(doneNmb, 1u);
+		EXPECT_LE(doneNmb, chunkSize);
+	}
+	for (size_t slice = 0; slice < sliceNmb; slice++)
+	{
+		for (size_t i = 0; i < sliceCounts[slice]; i++)
+		{
+			//Every dwarf was ticked within the last turn of its slice
+			const auto runsPerTurn = static_cast<int>((sliceCounts[slice] + chunkSize - 1) / chunkSize) + 1;
+			EXPECT_GE(lastTicked[slice][i], frameNmb - runsPerTurn * static_cast<int>(sliceNmb));
+		}
+	}
+
+	//With time left a whole slice runs and its cursor comes back where it was
+	std::vector<size_t> ticked(sliceCounts[0], 0);
+	const auto runNmb = budgetCursor.Run(0, sliceCounts[0], chunkSize, []() { return true; }, [&](size_t begin, size_t end)
+	{
+		for (auto i = begin; i < end; i++)
+		{
+			ticked[i]++;
+		}
+	});
+	EXPECT_EQ(runNmb, sliceCounts[0]);
+	EXPECT_EQ(ticked, std::vector<size_t>(sliceCounts[0], 1));
+}
@@ -0,0 +1,332 @@
+/*
+MIT License
+
+Copyright (c) 2017 SAE Institute Switzerland AG
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <ctime>
+#include <gtest/gtest.h>
+
+#include <engine/engine.h>
+#include <engine/config.h>
+#include <engine/transform2d.h>
+#include <engine/transform2d_soa.h>
+#include <utility/time_utility.h>
+#include <graphics/graphics2d.h>
+#include <graphics/shape2d.h>
+
+TEST(Transform, StreamsKernels)
+{
+	sfge::Transform2dStreams streams;
+	streams.Resize(13);
+	streams[12].SetEulerAngle(179.0f);
+	std::vector<float> velocities(13, 2.0f);
+
+	streams.Translate(0, 13, sfge::Vec2f(1.0f, -1.0f));
+	streams.Scale(0, 13, 3.0f);
+	streams.Rotate(0, 13, 2.0f);
+	streams.IntegrateVelocity(0, 13, velocities.data(), velocities.data(), 0.5f);
+
+	for (size_t i = 0; i < 12; i++)
+	{
+		EXPECT_FLOAT_EQ(streams[i].GetPosition().x, 2.0f);
+		EXPECT_FLOAT_EQ(streams[i].GetPosition().y, 0.0f);
+		EXPECT_FLOAT_EQ(streams[i].GetScale().x, 3.0f);
+		EXPECT_FLOAT_EQ(streams[i].GetEulerAngle(), 2.0f);
+	}
+	//The scalar tail wraps the angle like the vector body
+	EXPECT_FLOAT_EQ(streams[12].GetEulerAngle(), -179.0f);
+}
+
+TEST(Transform, StreamsLoadStore)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; i++)
+	{
+		const auto entity = entityManager->CreateEntity(INVALID_ENTITY);
+		transformManager->AddComponent(entity)->Position = sfge::Vec2f(i, 0.0f);
+		entities.push_back(entity);
+	}
+	sfge::Transform2dStreams streams;
+	streams.Load(*transformManager, entities);
+	streams.Translate(0, streams.Size(), sfge::Vec2f(0.0f, 5.0f));
+	streams.Store(*transformManager, entities);
+
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		const sfge::Transform2d transform = streams[i];
+		EXPECT_FLOAT_EQ(transformManager->GetComponentRef(entities[i]).Position.y, 5.0f);
+		EXPECT_FLOAT_EQ(transform.Position.x, static_cast<float>(i));
+	}
+	engine.Destroy();
+}
+
+TEST(Transform, StreamsPositions)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; i++)
+	{
+		const auto entity = entityManager->CreateEntity(INVALID_ENTITY);
+		auto* transform = transformManager->AddComponent(entity);
+		transform->Position = sfge::Vec2f(i, 0.0f);
+		transform->Scale = sfge::Vec2f(2.0f, 2.0f);
+		entities.push_back(entity);
+	}
+	std::vector<float> velocitiesX(entities.size(), 1.0f);
+	std::vector<float> velocitiesY(entities.size(), -1.0f);
+	sfge::Transform2dStreams streams;
+	streams.LoadPositions(*transformManager, entities);
+	streams.IntegrateVelocity(0, streams.Size(), velocitiesX.data(), velocitiesY.data(), 3.0f);
+	streams.StorePositions(*transformManager, entities);
+
+	//Only the positions go back, the scales in the streams are not the transform ones
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		const auto& transform = transformManager->GetComponentRef(entities[i]);
+		EXPECT_FLOAT_EQ(transform.Position.x, i + 3.0f);
+		EXPECT_FLOAT_EQ(transform.Position.y, -3.0f);
+		EXPECT_FLOAT_EQ(transform.Scale.x, 2.0f);
+	}
+	engine.Destroy();
+}
+
+TEST(Transform, StreamsPerformance)
+{
+	const size_t transformNmb = 100'000;
+	const int iterationNmb = 100;
+	const float dt = 0.016f;
+	std::vector<sfge::Transform2d> transforms(transformNmb);
+	std::vector<sfge::Vec2f> velocities(transformNmb, sfge::Vec2f(1.0f, 2.0f));
+	sfge::Transform2dStreams streams;
+	streams.Resize(transformNmb);
+	std::vector<float> velocitiesX(transformNmb, 1.0f);
+	std::vector<float> velocitiesY(transformNmb, 2.0f);
+
+	std::clock_t timer = std::clock();
+	for (int iteration = 0; iteration < iterationNmb; iteration++)
+	{
+		for (size_t i = 0; i < transformNmb; i++)
+		{
+			transforms[i].Position += velocities[i] * dt;
+			transforms[i].EulerAngle += 1.0f;
+			transforms[i].Update();
+		}
+	}
+	const auto durationAos = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	timer = std::clock();
+	for (int iteration = 0; iteration < iterationNmb; iteration++)
+	{
+		streams.IntegrateVelocity(0, transformNmb, velocitiesX.data(), velocitiesY.data(), dt);
+		streams.Rotate(0, transformNmb, 1.0f);
+	}
+	const auto durationSoa = 1000.0 * (std::clock() - timer) / CLOCKS_PER_SEC;
+
+	EXPECT_NEAR(streams[0].GetPosition().x, transforms[0].Position.x, 1e-3f);
+	EXPECT_NEAR(streams[0].GetEulerAngle(), transforms[0].EulerAngle, 1e-3f);
+	std::cout << "\nMove and rotate " << transformNmb << " transforms " << iterationNmb << " times"
+		<< "\tAoS : " << durationAos << " ms\tSoA kernels : " << durationSoa << " ms\n";
+}
+
+TEST(Transform, Hierarchy)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	const auto parent = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto child = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto grandChild = entityManager->CreateEntity(INVALID_ENTITY);
+	auto* parentTransform = transformManager->AddComponent(parent);
+	parentTransform->Position = sfge::Vec2f(10.0f, 0.0f);
+	parentTransform->EulerAngle = 90.0f;
+	transformManager->AddComponent(child)->Position = sfge::Vec2f(5.0f, 0.0f);
+	transformManager->AddComponent(grandChild)->Position = sfge::Vec2f(1.0f, 0.0f);
+
+	EXPECT_TRUE(transformManager->SetParent(grandChild, child));
+	EXPECT_TRUE(transformManager->SetParent(child, parent));
+	EXPECT_FALSE(transformManager->SetParent(parent, grandChild));
+	EXPECT_EQ(transformManager->GetHierarchy(), std::vector<Entity>({ parent, child, grandChild }));
+
+	transformManager->Update(0.0f);
+	EXPECT_NEAR(transformManager->GetWorldTransform(child).Position.x, 10.0f, 1e-4f);
+	EXPECT_NEAR(transformManager->GetWorldTransform(child).Position.y, 5.0f, 1e-4f);
+	EXPECT_NEAR(transformManager->GetWorldTransform(grandChild).Position.y, 6.0f, 1e-4f);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(grandChild).EulerAngle, 90.0f);
+
+	//Only the parent moved, the change reaches the whole subtree
+	transformManager->GetComponentRef(parent).Position = sfge::Vec2f(0.0f, 0.0f);
+	transformManager->Update(0.0f);
+	EXPECT_NEAR(transformManager->GetWorldTransform(grandChild).Position.x, 0.0f, 1e-4f);
+
+	transformManager->DestroyComponent(child);
+	EXPECT_EQ(transformManager->GetParent(grandChild), INVALID_ENTITY);
+	transformManager->Update(0.0f);
+	EXPECT_NEAR(transformManager->GetWorldTransform(grandChild).Position.x, 1.0f, 1e-4f);
+	engine.Destroy();
+}
+
+TEST(Transform, DirtySubtrees)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	const auto parent = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto child = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto other = entityManager->CreateEntity(INVALID_ENTITY);
+	transformManager->AddComponent(parent);
+	transformManager->AddComponent(child)->Position = sfge::Vec2f(1.0f, 0.0f);
+	auto* otherTransform = transformManager->AddComponent(other);
+	transformManager->SetParent(child, parent);
+	transformManager->Update(0.0f);
+	const auto childVersion = transformManager->GetVersion(child);
+	const auto otherVersion = transformManager->GetVersion(other);
+
+	//Writing the parent recomputes its subtree, the other root is not visited
+	transformManager->GetComponentRef(parent).Position = sfge::Vec2f(10.0f, 0.0f);
+	transformManager->Update(0.0f);
+	EXPECT_NE(transformManager->GetVersion(child), childVersion);
+	EXPECT_EQ(transformManager->GetVersion(other), otherVersion);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(child).Position.x, 11.0f);
+
+	//Reading does not mark the transform
+	EXPECT_FLOAT_EQ(transformManager->GetLocalTransform(other).Position.x, 0.0f);
+	transformManager->Update(0.0f);
+	EXPECT_EQ(transformManager->GetVersion(other), otherVersion);
+
+	//A pointer kept from an earlier frame needs an explicit mark
+	otherTransform->Position = sfge::Vec2f(5.0f, 0.0f);
+	transformManager->MarkDirty(other);
+	transformManager->Update(0.0f);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(other).Position.x, 5.0f);
+	engine.Destroy();
+}
+
+TEST(Transform, ShapeSkipsUnchangedTransforms)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+	auto* shapeManager = engine.GetGraphics2dManager()->GetShapeManager();
+
+	const auto entity = entityManager->CreateEntity(INVALID_ENTITY);
+	auto* transform = transformManager->AddComponent(entity);
+	transform->Position = sfge::Vec2f(10.0f, 20.0f);
+	auto* shape = shapeManager->AddComponent(entity);
+	shape->SetShape(std::make_unique<sf::CircleShape>(1.0f));
+
+	transformManager->Update(0.0f);
+	shapeManager->Update(0.0f);
+	EXPECT_FLOAT_EQ(shape->GetShape()->getPosition().x, 10.0f);
+	const auto version = transformManager->GetVersion(entity);
+
+	//A static transform keeps its version and the shape is not touched
+	shape->GetShape()->setPosition(0.0f, 0.0f);
+	transformManager->Update(0.0f);
+	shapeManager->Update(0.0f);
+	EXPECT_EQ(transformManager->GetVersion(entity), version);
+	EXPECT_FLOAT_EQ(shape->GetShape()->getPosition().x, 0.0f);
+
+	transformManager->GetComponentRef(entity).Position = sfge::Vec2f(30.0f, 20.0f);
+	transformManager->Update(0.0f);
+	shapeManager->Update(0.0f);
+	EXPECT_NE(transformManager->GetVersion(entity), version);
+	EXPECT_FLOAT_EQ(shape->GetShape()->getPosition().x, 30.0f);
+	engine.Destroy();
+}
+
+TEST(Transform, FixedStepInterpolation)
+{
+	sfge::Engine engine;
+	auto config = std::make_unique<sfge::Configuration>();
+	config->devMode = false;
+	config->windowLess = true;
+	engine.Init(std::move(config));
+	auto* entityManager = engine.GetEntityManager();
+	auto* transformManager = engine.GetTransform2dManager();
+
+	const auto body = entityManager->CreateEntity(INVALID_ENTITY);
+	const auto scenery = entityManager->CreateEntity(INVALID_ENTITY);
+	auto* bodyTransform = transformManager->AddComponent(body);
+	auto* sceneryTransform = transformManager->AddComponent(scenery);
+	entityManager->AddComponentType(body, sfge::ComponentType::BODY2D);
+
+	transformManager->SaveFixedStepState();
+	bodyTransform->Position = sfge::Vec2f(10.0f, 0.0f);
+	sceneryTransform->Position = sfge::Vec2f(10.0f, 0.0f);
+
+	transformManager->SetInterpolationFactor(0.25f);
+	transformManager->Update(0.0f);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(body).Position.x, 2.5f);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(scenery).Position.x, 10.0f);
+	//The simulation state is not touched
+	EXPECT_FLOAT_EQ(bodyTransform->Position.x, 10.0f);
+
+	transformManager->SetInterpolationFactor(1.0f);
+	transformManager->Update(0.0f);
+	EXPECT_FLOAT_EQ(transformManager->GetWorldTransform(body).Position.x, 10.0f);
+	engine.Destroy();
+}
+
+TEST(Transform, FixedTimestepCatchUp)
+{
+	sfge::FixedTimestep fixedTimestep(0.02f, 5);
+	//A 60 ms frame runs three fixed steps instead of slowing the simulation down
+	EXPECT_EQ(fixedTimestep.Advance(0.06f + 1e-4f), 3u);
+	EXPECT_EQ(fixedTimestep.Advance(0.01f), 0u);
+	EXPECT_NEAR(fixedTimestep.GetInterpolationFactor(), 0.5f, 1e-2f);
+	EXPECT_EQ(fixedTimestep.Advance(0.01f), 1u);
+
+	//Past the cap the backlog is dropped
+	EXPECT_EQ(fixedTimestep.Advance(1.0f), 5u);
+	EXPECT_EQ(fixedTimestep.Advance(0.0f), 0u);
+	EXPECT_LT(fixedTimestep.GetInterpolationFactor(), 1.0f);
+}
@@ -157,18 +157,14 @@ namespace sfge::tools
 			}
 		}
 
-		auto components = m_TilemapCreator->GetTilemapManager()->GetComponents();
 		if (ImGui::CollapsingHeader("List of Tilemap"))
 		{
-			for (auto i = 0u; i < components.size(); i++)
+			for (Entity entity : m_EntityManager->View<Tilemap>())
 			{
-				if (m_EntityManager->HasComponent(i + 1, ComponentType::TILEMAP))
-				{
-					bool selectedOne = m_SelectedTilemap == i + 1;
-					ImGui::Selectable(m_EntityManager->GetEntityInfo(i + 1).name.c_str(), &selectedOne);
-					if (selectedOne)
-						m_SelectedTilemap = i + 1;
-				}
+				bool selectedOne = m_SelectedTilemap == entity;
+				ImGui::Selectable(m_EntityManager->GetEntityInfo(entity).name.c_str(), &selectedOne);
+				if (selectedOne)
+					m_SelectedTilemap = entity;
 			}
 		}
 